@@ -150,6 +150,27 @@ extern OCIOEXPORT const char * GetVersion();
  */
 extern OCIOEXPORT int GetVersionHex();
 
+/**
+ * \brief Get a description of the host CPU, i.e. the vendor, the model name and the list
+ * of SIMD instruction sets the library may use on it (e.g., "GenuineIntel Intel(R) Xeon(R)
+ * ... (SSE2 SSE3 SSSE3 SSE4 SSE4.2 AVX AVX2 F16C)").
+ *
+ * Instruction sets disabled at build time are not listed. This is mainly intended for
+ * reporting purposes (e.g. benchmark results).
+ */
+extern OCIOEXPORT const char * GetCPUInfo();
+
+/**
+ * \brief Set the maximum number of threads the library may create for its own processing, i.e.
+ * the evaluation of the lattices the optimizations resample some ops into.
+ *
+ * The default value 0 uses all the hardware threads, and 1 disables the threads so that all the
+ * processing happens on the calling thread (e.g. for hosts managing their own thread pools).
+ */
+extern OCIOEXPORT void SetMaxThreads(unsigned maxThreads) noexcept;
+/// Get the maximum number of threads the library may create, 0 meaning all the hardware threads.
+extern OCIOEXPORT unsigned GetMaxThreads() noexcept;
+
 /**
  * \brief Get the global logging level.
  * 
@@ -2655,6 +2676,22 @@ public:
     void apply(const ImageDesc & imgDesc) const;
     void apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const;
 
+    /**
+     * \brief Apply to an image using the values from the overrides in place of the values of
+     * the dynamic properties of the processor.
+     *
+     * The dynamic properties of the processor are not changed so several threads can share
+     * the processor while applying different values. The values of property types that the
+     * processor does not have are ignored.
+     *
+     * \note The ops using an overridden property are prepared again for each call so prefer
+     * calls processing many pixels.
+     */
+    void apply(const ImageDesc & imgDesc, const DynamicPropertyOverrides & values) const;
+    void apply(const ImageDesc & srcImgDesc,
+               ImageDesc & dstImgDesc,
+               const DynamicPropertyOverrides & values) const;
+
     /**
      * Apply to a single pixel respecting that the input and output bit-depths
      * be 32-bit float and the image buffer be packed RGB/RGBA.
@@ -2667,6 +2704,18 @@ public:
     void applyRGB(float * pixel) const;
     void applyRGBA(float * pixel) const;
 
+    /**
+     * \brief Get the number of CPU renderers used to process an image, including the ones
+     * converting from the input bit-depth and to the output bit-depth.
+     */
+    unsigned getNumRenderers() const noexcept;
+    /**
+     * Get the class name of a CPU renderer (e.g. "Lut1DRendererHalfCode<...>") in processing
+     * order. This identifies the optimized implementation selected for the ops and the host
+     * CPU, for instance when reporting benchmark results.
+     */
+    const char * getRendererName(unsigned index) const;
+
     CPUProcessor(const CPUProcessor &) = delete;
     CPUProcessor& operator= (const CPUProcessor &) = delete;
     /// Do not use (needed only for pybind11).
@@ -2698,7 +2747,16 @@ public:
 
     const char * getCacheID() const;
 
-    /// Extract & Store the shader information to implement the color processing.
+    /**
+     * Extract & Store the shader information to implement the color processing.
+     *
+     * \note
+     *   The shader information is cached so extracting an identical processor again in an
+     *   empty shader desc (i.e. with the same settings) does not regenerate the shader program.
+     *   The shader descs then share the texture values. The shader programs using uniforms are
+     *   not cached. The shader desc cache ID is stable across sessions so it could also key a
+     *   persistent cache of compiled shader programs.
+     */
     void extractGpuShaderInfo(GpuShaderDescRcPtr & shaderDesc) const;
 
     /// Extract the shader information using a custom GpuShaderCreator class.
@@ -3214,6 +3272,88 @@ public:
     virtual void setAllowTexture1D(bool allowed) = 0;
     virtual bool getAllowTexture1D() const = 0;
 
+    /**
+     * Format of the LUT texture values. The 16-bit formats halve the memory and the bandwidth
+     * used by the LUT textures, at the cost of some precision.
+     */
+    enum TextureFormat
+    {
+        TEXTURE_FORMAT_FLOAT32 = 0, ///< 32-bit float values (default)
+        TEXTURE_FORMAT_HALF,        ///< 16-bit float values
+        TEXTURE_FORMAT_UNORM16      ///< 16-bit normalized integer values, the shader program
+                                    ///< rescales the sampled values to the LUT range (falls
+                                    ///< back to half float values when not precise enough)
+    };
+
+    /**
+     * Request a texture format for the LUT textures. The 16-bit values are then available from
+     * GpuShaderDesc::getTexturePackedValues() & GpuShaderDesc::get3DTexturePackedValues().
+     *
+     * \note
+     *   Only the shader descs created by GpuShaderDesc::CreateShaderDesc() support the 16-bit
+     *   formats, other shader creators always get 32-bit float values.
+     */
+    void setTextureFormat(TextureFormat format) noexcept;
+    TextureFormat getTextureFormat() const noexcept;
+
+    /**
+     * Pack all the uniforms in a single uniform block, using the std140 layout for GLSL and a
+     * cbuffer with the same layout for HLSL. A host then updates all the dynamic values of the
+     * shader program using GpuShaderDesc::fillUniformBlock() and one buffer upload.
+     *
+     * \note
+     *   Only the shader descs created by GpuShaderDesc::CreateShaderDesc() support the uniform
+     *   block, and only for GPU_LANGUAGE_GLSL_4_0, GPU_LANGUAGE_GLSL_ES_3_0 and
+     *   GPU_LANGUAGE_HLSL_DX11. Otherwise, the uniforms are declared individually.
+     */
+    void setUseUniformBlock(bool use) noexcept;
+    bool getUseUniformBlock() const noexcept;
+
+    /// Pixel layout of the compute kernel buffers, all holding RGBA pixels without padding.
+    enum ComputeBufferFormat
+    {
+        COMPUTE_BUFFER_RGBA_FLOAT32 = 0, ///< 32-bit float channels (default)
+        COMPUTE_BUFFER_RGBA_HALF,        ///< 16-bit float channels
+        COMPUTE_BUFFER_RGBA_UINT8,       ///< 8-bit normalized integer channels
+        COMPUTE_BUFFER_RGBA_UINT16       ///< 16-bit normalized integer channels
+    };
+
+    /**
+     * Generate a complete compute kernel around the OCIO shader function. The kernel processes
+     * the pixels of an image, stored row by row in an input buffer, into an output buffer. The
+     * image size (i.e. width & height in pixels) is the "<prefix>_imageSize" uniform and the
+     * host dispatches (width / workgroup width) x (height / workgroup height) workgroups,
+     * rounded up.
+     *
+     * * GPU_LANGUAGE_GLSL_4_0: The shader program must be compiled as a GLSL 4.3 (or later)
+     *   compute shader. The input & output storage buffers use the bindings 0 & 1.
+     * * GPU_LANGUAGE_HLSL_DX11: The entry point is "<function name>Kernel" and the input &
+     *   output buffers are the "<prefix>_inputPixels" & "<prefix>_outputPixels" structured
+     *   buffers.
+     *
+     * The shader program creation throws for the other GPU languages.
+     */
+    void setComputeKernel(bool enabled) noexcept;
+    bool getComputeKernel() const noexcept;
+
+    void setComputeBufferFormats(ComputeBufferFormat inFormat, ComputeBufferFormat outFormat) noexcept;
+    ComputeBufferFormat getComputeInputFormat() const noexcept;
+    ComputeBufferFormat getComputeOutputFormat() const noexcept;
+
+    /// Size of the compute kernel workgroups, 8 x 8 by default.
+    void setComputeWorkgroupSize(unsigned width, unsigned height);
+    unsigned getComputeWorkgroupWidth() const noexcept;
+    unsigned getComputeWorkgroupHeight() const noexcept;
+
+    /**
+     * Compact the shader program text. The comments, the indentation and the empty lines are
+     * removed, and the ops with identical helper functions or constant arrays share a single
+     * copy of them (e.g. identical 1D LUT lookups or RGB curves). The resource names (i.e.
+     * textures & uniforms) are unchanged and so is the numerical output. The default is false.
+     */
+    void setCompactShaderText(bool compact) noexcept;
+    bool getCompactShaderText() const noexcept;
+
     /**
      * To avoid global texture sampler and uniform name clashes always append an increasing index
      * to the resource name.
@@ -3309,6 +3449,7 @@ public:
 
     // Methods to specialize parts of a OCIO shader program
     virtual void addToDeclareShaderCode(const char * shaderCode);
+    /// Note that a helper code identical to an already added one is ignored.
     virtual void addToHelperShaderCode(const char * shaderCode);
     virtual void addToFunctionHeaderShaderCode(const char * shaderCode);
     virtual void addToFunctionShaderCode(const char * shaderCode);
@@ -3533,6 +3674,31 @@ public:
     /// Returns name of uniform and data as parameter.
     virtual const char * getUniform(unsigned index, UniformData & data) const = 0;
 
+    /**
+     * The uniform block related methods (see GpuShaderCreator::setUseUniformBlock()).
+     *
+     * The size of the uniform block in bytes, 0 when the uniforms are declared individually.
+     */
+    virtual unsigned getUniformBlockSize() const noexcept;
+    /// Name of the uniform block (i.e. the GLSL block name or the HLSL cbuffer name).
+    virtual const char * getUniformBlockName() const noexcept;
+    /// Byte offset of the uniform in the uniform block. Throws if the uniforms are not packed.
+    virtual unsigned getUniformBlockOffset(unsigned index) const;
+    /**
+     * Write the current values of all the uniforms in the buffer which must hold at least
+     * getUniformBlockSize() bytes. Throws if the uniforms are not packed.
+     */
+    virtual void fillUniformBlock(void * buffer) const;
+
+    /**
+     * Compare the current values of the uniforms with their values at the previous call and
+     * return the number of uniforms that changed (i.e. all the uniforms at the first call). After
+     * a dynamic property edit, only these uniforms need to be uploaded again.
+     */
+    virtual unsigned updateChangedUniforms();
+    /// Index (see getUniform()) of one of the uniforms found by the last updateChangedUniforms().
+    virtual unsigned getChangedUniform(unsigned index) const;
+
     // 1D lut related methods
     virtual unsigned getNumTextures() const noexcept = 0;
     virtual void getTexture(unsigned index,
@@ -3543,7 +3709,23 @@ public:
                             TextureType & channel,
                             TextureDimensions & dimensions,
                             Interpolation & interpolation) const = 0;
+    /**
+     * The values of identical LUTs are shared between the shader descs (from the same or from
+     * different processors) so comparing the pointers allows to only upload a texture once.
+     */
     virtual void getTextureValues(unsigned index, const float *& values) const = 0;
+    /**
+     * Get the 16-bit values of the texture when the texture format is TEXTURE_FORMAT_HALF or
+     * TEXTURE_FORMAT_UNORM16 (i.e. half float bits or normalized integers). Throws otherwise.
+     */
+    virtual void getTexturePackedValues(unsigned index, const uint16_t *& values) const;
+    /**
+     * Get the format of the 16-bit values of the texture. It could differ from the requested
+     * one as TEXTURE_FORMAT_UNORM16 falls back to TEXTURE_FORMAT_HALF for the LUTs whose
+     * values are too wide (or not finite) for the normalized integers, and for the half domain
+     * LUTs. Returns TEXTURE_FORMAT_FLOAT32 when the values are not packed.
+     */
+    virtual TextureFormat getTexturePackedFormat(unsigned index) const;
 
     // 3D lut related methods
     virtual unsigned getNum3DTextures() const noexcept = 0;
@@ -3552,7 +3734,12 @@ public:
                               const char *& samplerName,
                               unsigned & edgelen,
                               Interpolation & interpolation) const = 0;
+    /// The values are shared in the same way as the 1D LUT ones.
     virtual void get3DTextureValues(unsigned index, const float *& values) const = 0;
+    /// Get the 16-bit values of the 3D texture, same as getTexturePackedValues().
+    virtual void get3DTexturePackedValues(unsigned index, const uint16_t *& values) const;
+    /// Get the format of the 16-bit values of the 3D texture, same as getTexturePackedFormat().
+    virtual TextureFormat get3DTexturePackedFormat(unsigned index) const;
 
     /// Get the complete OCIO shader program.
     const char * getShaderText() const noexcept;
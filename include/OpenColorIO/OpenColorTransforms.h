@@ -808,6 +808,79 @@ protected:
     DynamicPropertyGradingTone() = default;
 };
 
+/**
+ * Holds the values of dynamic properties to be used by one CPU processor apply call in place
+ * of the values of the processor's own dynamic properties (see \ref CPUProcessor::apply).
+ * It allows a single CPU processor to be shared between threads processing images with
+ * different parameter sets, without changing its dynamic properties. Only the values that
+ * are set are overridden.
+ *
+ * \code{.cpp}
+ *
+ *    OCIO::DynamicPropertyOverridesRcPtr values = OCIO::DynamicPropertyOverrides::Create();
+ *    values->setDouble(OCIO::DYNAMIC_PROPERTY_EXPOSURE, 1.1);
+ *    cpuProcessor->apply(imgDesc, *values);
+ * \endcode
+ */
+class OCIOEXPORT DynamicPropertyOverrides
+{
+public:
+    static DynamicPropertyOverridesRcPtr Create();
+
+    DynamicPropertyOverridesRcPtr createEditableCopy() const;
+
+    /// True if a value is set for that type of dynamic property.
+    bool hasValue(DynamicPropertyType type) const noexcept;
+    /// Remove the value of that type of dynamic property (if any).
+    void removeValue(DynamicPropertyType type) noexcept;
+    /// Remove all the values.
+    void clear() noexcept;
+
+    /**
+     * Set the value of a dynamic property holding a double such as DYNAMIC_PROPERTY_EXPOSURE.
+     * Will throw for other types.
+     */
+    void setDouble(DynamicPropertyType type, double value);
+    /// Will throw if the type does not hold a double or if the value is not set.
+    double getDouble(DynamicPropertyType type) const;
+
+    /**
+     * Set the value of the DYNAMIC_PROPERTY_GRADING_PRIMARY property. The value is validated
+     * against the style of the op when applied.
+     */
+    void setGradingPrimary(const GradingPrimary & value);
+    /// Will throw if the value is not set.
+    const GradingPrimary & getGradingPrimary() const;
+
+    /// Set the value of the DYNAMIC_PROPERTY_GRADING_RGBCURVE property. Will throw if null.
+    void setGradingRGBCurve(const ConstGradingRGBCurveRcPtr & value);
+    /// Will throw if the value is not set.
+    const ConstGradingRGBCurveRcPtr & getGradingRGBCurve() const;
+
+    /**
+     * Set the value of the DYNAMIC_PROPERTY_GRADING_TONE property. The value is validated when
+     * applied.
+     */
+    void setGradingTone(const GradingTone & value);
+    /// Will throw if the value is not set.
+    const GradingTone & getGradingTone() const;
+
+    DynamicPropertyOverrides(const DynamicPropertyOverrides &) = delete;
+    DynamicPropertyOverrides & operator=(const DynamicPropertyOverrides &) = delete;
+    /// Do not use (needed only for pybind11).
+    ~DynamicPropertyOverrides();
+
+private:
+    DynamicPropertyOverrides();
+
+    static void deleter(DynamicPropertyOverrides * c);
+
+    class Impl;
+    Impl * m_impl;
+    Impl * getImpl() { return m_impl; }
+    const Impl * getImpl() const { return m_impl; }
+};
+
 
 /**
  * \brief Represents exponent transform: pow( clamp(color), value ).
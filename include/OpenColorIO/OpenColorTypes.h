@@ -167,6 +167,10 @@ class OCIOEXPORT DynamicPropertyGradingTone;
 typedef OCIO_SHARED_PTR<const DynamicPropertyGradingTone> ConstDynamicPropertyGradingToneRcPtr;
 typedef OCIO_SHARED_PTR<DynamicPropertyGradingTone> DynamicPropertyGradingToneRcPtr;
 
+class OCIOEXPORT DynamicPropertyOverrides;
+typedef OCIO_SHARED_PTR<const DynamicPropertyOverrides> ConstDynamicPropertyOverridesRcPtr;
+typedef OCIO_SHARED_PTR<DynamicPropertyOverrides> DynamicPropertyOverridesRcPtr;
+
 class OCIOEXPORT ExponentTransform;
 typedef OCIO_SHARED_PTR<const ExponentTransform> ConstExponentTransformRcPtr;
 typedef OCIO_SHARED_PTR<ExponentTransform> ExponentTransformRcPtr;
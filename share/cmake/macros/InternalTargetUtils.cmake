@@ -0,0 +1,87 @@
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright Contributors to the OpenColorIO Project.
+#
+# Utilities for the executables compiling the OpenColorIO library sources (i.e. the unit tests
+# and the benchmarks) to access the library internals.
+#
+
+# Add the SIMD compile options to the library sources needing them. Note that source properties
+# are only visible to the targets created in the calling directory and that these files are
+# gated by preprocessors to remove them based on the OCIO_USE_* vars.
+function(ocio_set_simd_source_properties)
+    if(NOT (OCIO_USE_SIMD AND (OCIO_ARCH_X86 OR OCIO_USE_SSE2NEON)))
+        return()
+    endif()
+
+    set(OCIO_SRC_DIR "${PROJECT_SOURCE_DIR}/src/OpenColorIO")
+
+    foreach(OP lut1d/Lut1DOpCPU lut3d/Lut3DOpCPU)
+        set_property(SOURCE "${OCIO_SRC_DIR}/ops/${OP}_SSE2.cpp" APPEND PROPERTY COMPILE_OPTIONS ${OCIO_SSE2_ARGS})
+        set_property(SOURCE "${OCIO_SRC_DIR}/ops/${OP}_AVX.cpp" APPEND PROPERTY COMPILE_OPTIONS ${OCIO_AVX_ARGS})
+        set_property(SOURCE "${OCIO_SRC_DIR}/ops/${OP}_AVX2.cpp" APPEND PROPERTY COMPILE_OPTIONS ${OCIO_AVX2_ARGS})
+        set_property(SOURCE "${OCIO_SRC_DIR}/ops/${OP}_AVX512.cpp" APPEND PROPERTY COMPILE_OPTIONS ${OCIO_AVX512_ARGS})
+    endforeach()
+endfunction()
+
+# Configure a target compiling the library sources in place of linking to the library i.e. the
+# library dependencies, the platform libraries & definitions and the compile & link options.
+function(ocio_add_library_internals TARGET)
+    find_package(Threads REQUIRED)
+
+    target_compile_definitions(${TARGET}
+        PRIVATE
+            OpenColorIO_SKIP_IMPORTS
+    )
+
+    target_link_libraries(${TARGET}
+        PRIVATE
+            expat::expat
+            Imath::Imath
+            pystring::pystring
+            sampleicc::sampleicc
+            utils::from_chars
+            utils::strings
+            ${YAML_CPP_LIBRARIES}
+            MINIZIP::minizip-ng
+            xxHash
+            Threads::Threads
+    )
+
+    if(OCIO_USE_SIMD AND OCIO_USE_SSE2NEON AND COMPILER_SUPPORTS_SSE_WITH_SSE2NEON)
+        target_link_libraries(${TARGET} PRIVATE sse2neon)
+    endif()
+
+    if(APPLE)
+        # Frameworks needed to access the ICC monitor profile.
+        target_link_libraries(${TARGET}
+            PRIVATE
+                "-framework ColorSync"
+                "-framework CoreFoundation"
+                "-framework CoreGraphics"
+                "-framework IOKit"
+        )
+    endif(APPLE)
+
+    if(WIN32)
+        # A windows application linking to eXpat static libraries must
+        # have the global macro XML_STATIC defined
+        target_compile_definitions(${TARGET}
+            PRIVATE
+                XML_STATIC
+        )
+
+        if (OCIO_USE_WINDOWS_UNICODE)
+            # Add Unicode definitions to use Unicode functions
+            target_compile_definitions(${TARGET}
+                PRIVATE
+                    UNICODE
+                    _UNICODE
+            )
+        endif()
+    endif(WIN32)
+
+    set_target_properties(${TARGET} PROPERTIES
+        COMPILE_OPTIONS "${PLATFORM_COMPILE_OPTIONS}"
+        LINK_OPTIONS "${PLATFORM_LINK_OPTIONS}"
+    )
+endfunction()
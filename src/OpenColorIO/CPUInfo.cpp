@@ -2,8 +2,11 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 
-#include "CPUInfo.h"
 #include <string.h>
+#include <string>
+
+#include "CPUInfo.h"
+#include "utils/StringUtils.h"
 
 #if _WIN32
 #include <limits.h>
@@ -229,4 +232,35 @@ CPUInfo& CPUInfo::instance()
     return singleton;
 }
 
+const char * GetCPUInfo()
+{
+    static const std::string info = []()
+    {
+        const CPUInfo & cpu = CPUInfo::instance();
+
+        std::string str = StringUtils::Trim(cpu.getVendor());
+        str += " ";
+        str += StringUtils::Trim(cpu.getName());
+
+        std::string isa;
+        if (cpu.hasSSE2())   isa += " SSE2";
+        if (cpu.hasSSE3())   isa += " SSE3";
+        if (cpu.hasSSSE3())  isa += " SSSE3";
+        if (cpu.hasSSE4())   isa += " SSE4";
+        if (cpu.hasSSE42())  isa += " SSE4.2";
+        if (cpu.hasAVX())    isa += " AVX";
+        if (cpu.hasAVX2())   isa += " AVX2";
+        if (cpu.hasAVX512()) isa += " AVX512";
+        if (cpu.hasF16C())   isa += " F16C";
+
+        str += " (";
+        str += isa.empty() ? std::string("no SIMD") : isa.substr(1);
+        str += ")";
+
+        return str;
+    }();
+
+    return info.c_str();
+}
+
 } // namespace OCIO_NAMESPACE
\ No newline at end of file
@@ -1,7 +1,15 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
 #include <string.h>
+#include <typeinfo>
+
+#if defined(__GNUC__) || defined(__clang__)
+#include <cxxabi.h>
+#endif
 
 #include <OpenColorIO/OpenColorIO.h>
 
@@ -364,6 +372,7 @@ void CPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
     m_inBitDepthOp = nullptr;
     m_outBitDepthOp = nullptr;
     CreateCPUEngine(ops, in, out, oFlags, m_inBitDepthOp, m_cpuOps, m_outBitDepthOp);
+    m_rendererNames.clear();
 
     // Compute the cache id.
 
@@ -376,32 +385,68 @@ void CPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
     m_cacheID = ss.str();
 }
 
-void CPUProcessor::Impl::apply(const ImageDesc & imgDesc) const
-{   
-    // Get the ScanlineHelper for this thread (no significant performance impact).
-    std::unique_ptr<ScanlineHelper> 
-        scanlineBuilder(CreateScanlineHelper(m_inBitDepth, m_inBitDepthOp,
-                                             m_outBitDepth, m_outBitDepthOp));
-
-    // Prepare the processing.
-    scanlineBuilder->init(imgDesc);
+namespace
+{
 
+void ProcessScanlines(ScanlineHelper & scanlineBuilder, const ConstOpCPURcPtrVec & cpuOps)
+{
     float * rgbaBuffer = nullptr;
     long numPixels = 0;
 
     while(true)
     {
-        scanlineBuilder->prepRGBAScanline(&rgbaBuffer, numPixels);
+        scanlineBuilder.prepRGBAScanline(&rgbaBuffer, numPixels);
         if(numPixels == 0) break;
 
-        const size_t numOps = m_cpuOps.size();
+        const size_t numOps = cpuOps.size();
         for(size_t i = 0; i<numOps; ++i)
         {
-            m_cpuOps[i]->apply(rgbaBuffer, rgbaBuffer, numPixels);
+            cpuOps[i]->apply(rgbaBuffer, rgbaBuffer, numPixels);
         }
 
-        scanlineBuilder->finishRGBAScanline();
+        scanlineBuilder.finishRGBAScanline();
+    }
+}
+
+ConstOpCPURcPtr OverrideDynamicProperties(const ConstOpCPURcPtr & op,
+                                          const DynamicPropertyOverrides & values)
+{
+    ConstOpCPURcPtr res = op->overrideDynamicProperties(values);
+    return res ? res : op;
+}
+
+} // anonymous namespace
+
+void CPUProcessor::Impl::overrideDynamicProperties(const DynamicPropertyOverrides & values,
+                                                   ConstOpCPURcPtr & inBitDepthOp,
+                                                   ConstOpCPURcPtrVec & cpuOps,
+                                                   ConstOpCPURcPtr & outBitDepthOp) const
+{
+    // Only the CPU ops using an overridden dynamic property are replaced, the other ones
+    // are shared with the processor.
+
+    inBitDepthOp = OverrideDynamicProperties(m_inBitDepthOp, values);
+
+    cpuOps.reserve(m_cpuOps.size());
+    for (const auto & op : m_cpuOps)
+    {
+        cpuOps.push_back(OverrideDynamicProperties(op, values));
     }
+
+    outBitDepthOp = OverrideDynamicProperties(m_outBitDepthOp, values);
+}
+
+void CPUProcessor::Impl::apply(const ImageDesc & imgDesc) const
+{   
+    // Get the ScanlineHelper for this thread (no significant performance impact).
+    std::unique_ptr<ScanlineHelper> 
+        scanlineBuilder(CreateScanlineHelper(m_inBitDepth, m_inBitDepthOp,
+                                             m_outBitDepth, m_outBitDepthOp));
+
+    // Prepare the processing.
+    scanlineBuilder->init(imgDesc);
+
+    ProcessScanlines(*scanlineBuilder, m_cpuOps);
 }
 
 void CPUProcessor::Impl::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const
@@ -414,22 +459,40 @@ void CPUProcessor::Impl::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgD
     // Prepare the processing.
     scanlineBuilder->init(srcImgDesc, dstImgDesc);
 
-    float * rgbaBuffer = nullptr;
-    long numPixels = 0;
+    ProcessScanlines(*scanlineBuilder, m_cpuOps);
+}
 
-    while(true)
-    {
-        scanlineBuilder->prepRGBAScanline(&rgbaBuffer, numPixels);
-        if(numPixels == 0) break;
+void CPUProcessor::Impl::apply(const ImageDesc & imgDesc,
+                               const DynamicPropertyOverrides & values) const
+{
+    ConstOpCPURcPtr inBitDepthOp, outBitDepthOp;
+    ConstOpCPURcPtrVec cpuOps;
+    overrideDynamicProperties(values, inBitDepthOp, cpuOps, outBitDepthOp);
 
-        const size_t numOps = m_cpuOps.size();
-        for(size_t i = 0; i<numOps; ++i)
-        {
-            m_cpuOps[i]->apply(rgbaBuffer, rgbaBuffer, numPixels);
-        }
+    std::unique_ptr<ScanlineHelper> 
+        scanlineBuilder(CreateScanlineHelper(m_inBitDepth, inBitDepthOp,
+                                             m_outBitDepth, outBitDepthOp));
 
-        scanlineBuilder->finishRGBAScanline();
-    }
+    scanlineBuilder->init(imgDesc);
+
+    ProcessScanlines(*scanlineBuilder, cpuOps);
+}
+
+void CPUProcessor::Impl::apply(const ImageDesc & srcImgDesc,
+                               ImageDesc & dstImgDesc,
+                               const DynamicPropertyOverrides & values) const
+{
+    ConstOpCPURcPtr inBitDepthOp, outBitDepthOp;
+    ConstOpCPURcPtrVec cpuOps;
+    overrideDynamicProperties(values, inBitDepthOp, cpuOps, outBitDepthOp);
+
+    std::unique_ptr<ScanlineHelper> 
+        scanlineBuilder(CreateScanlineHelper(m_inBitDepth, inBitDepthOp,
+                                             m_outBitDepth, outBitDepthOp));
+
+    scanlineBuilder->init(srcImgDesc, dstImgDesc);
+
+    ProcessScanlines(*scanlineBuilder, cpuOps);
 }
 
 void CPUProcessor::Impl::applyRGB(float * pixel) const
@@ -464,6 +527,107 @@ void CPUProcessor::Impl::applyRGBA(float * pixel) const
     m_outBitDepthOp->apply(pixel, pixel, 1);
 }
 
+namespace
+{
+
+std::string GetClassName(const std::type_info & info)
+{
+    std::string name(info.name());
+
+#if defined(__GNUC__) || defined(__clang__)
+    int status = 0;
+    char * demangled = abi::__cxa_demangle(info.name(), nullptr, nullptr, &status);
+    if (demangled)
+    {
+        if (status == 0)
+        {
+            name = demangled;
+        }
+        free(demangled);
+    }
+#endif
+
+    return name;
+}
+
+// Remove the keywords MSVC adds to the type names (e.g. "class OpenColorIO_v2_4::Foo<enum
+// OpenColorIO_v2_4::BitDepth 1>"), only when they are whole words.
+void RemoveTypeKeywords(std::string & name)
+{
+    for (const std::string keyword : { "class ", "struct ", "enum " })
+    {
+        size_t pos = name.find(keyword);
+        while (pos != std::string::npos)
+        {
+            const bool wordStart = pos == 0
+                                || !(std::isalnum(static_cast<unsigned char>(name[pos - 1]))
+                                     || name[pos - 1] == '_');
+            if (wordStart)
+            {
+                name.erase(pos, keyword.size());
+                pos = name.find(keyword, pos);
+            }
+            else
+            {
+                pos = name.find(keyword, pos + keyword.size());
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+std::string GetOpCPUClassName(const OpCPU & op)
+{
+    // The library namespace is versioned so find it from a known class name. The keywords are
+    // removed from both names, otherwise the MSVC prefix (i.e. "class OpenColorIO_v2_4::") would
+    // never match the names of the template arguments.
+    static const std::string nsPrefix = []()
+    {
+        std::string prefix = GetClassName(typeid(CPUProcessor));
+        RemoveTypeKeywords(prefix);
+        return StringUtils::Replace(prefix, "CPUProcessor", "");
+    }();
+
+    std::string name = GetClassName(typeid(op));
+
+    RemoveTypeKeywords(name);
+    StringUtils::ReplaceInPlace(name, "(anonymous namespace)::", "");
+    StringUtils::ReplaceInPlace(name, "`anonymous namespace'::", "");
+    if (!nsPrefix.empty())
+    {
+        StringUtils::ReplaceInPlace(name, nsPrefix, "");
+    }
+
+    return name;
+}
+
+const char * CPUProcessor::Impl::getRendererName(unsigned index) const
+{
+    const unsigned numRenderers = getNumRenderers();
+    if (index >= numRenderers)
+    {
+        std::ostringstream oss;
+        oss << "CPU renderer access error: index = " << index
+            << " where size = " << numRenderers;
+        throw Exception(oss.str().c_str());
+    }
+
+    AutoMutex lock(m_mutex);
+
+    if (m_rendererNames.empty())
+    {
+        m_rendererNames.push_back(GetOpCPUClassName(*m_inBitDepthOp));
+        for (const auto & op : m_cpuOps)
+        {
+            m_rendererNames.push_back(GetOpCPUClassName(*op));
+        }
+        m_rendererNames.push_back(GetOpCPUClassName(*m_outBitDepthOp));
+    }
+
+    return m_rendererNames[index].c_str();
+}
+
 
 
 
@@ -543,6 +707,18 @@ void CPUProcessor::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) c
     getImpl()->apply(srcImgDesc, dstImgDesc);
 }
 
+void CPUProcessor::apply(const ImageDesc & imgDesc, const DynamicPropertyOverrides & values) const
+{
+    getImpl()->apply(imgDesc, values);
+}
+
+void CPUProcessor::apply(const ImageDesc & srcImgDesc,
+                         ImageDesc & dstImgDesc,
+                         const DynamicPropertyOverrides & values) const
+{
+    getImpl()->apply(srcImgDesc, dstImgDesc, values);
+}
+
 void CPUProcessor::applyRGB(float * pixel) const
 {
     getImpl()->applyRGB(pixel);
@@ -553,4 +729,14 @@ void CPUProcessor::applyRGBA(float * pixel) const
     getImpl()->applyRGBA(pixel);
 }
 
+unsigned CPUProcessor::getNumRenderers() const noexcept
+{
+    return getImpl()->getNumRenderers();
+}
+
+const char * CPUProcessor::getRendererName(unsigned index) const
+{
+    return getImpl()->getRendererName(index);
+}
+
 } // namespace OCIO_NAMESPACE
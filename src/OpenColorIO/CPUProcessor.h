@@ -9,6 +9,7 @@
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "Op.h"
+#include "utils/StringUtils.h"
 
 
 namespace OCIO_NAMESPACE
@@ -46,11 +47,22 @@ public:
     void apply(const ImageDesc & imgDesc) const;
     void apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const;
 
+    void apply(const ImageDesc & imgDesc, const DynamicPropertyOverrides & values) const;
+    void apply(const ImageDesc & srcImgDesc,
+               ImageDesc & dstImgDesc,
+               const DynamicPropertyOverrides & values) const;
+
     // Note that the method only accepts one packed RGB and 32-bit float pixel.
     void applyRGB(float * pixel) const;
     // Note that the method only accepts one packed RGBA and 32-bit float pixel.
     void applyRGBA(float * pixel) const;
 
+    unsigned getNumRenderers() const noexcept
+    {
+        return static_cast<unsigned>(m_cpuOps.size() + 2);
+    }
+    const char * getRendererName(unsigned index) const;
+
     ////////////////////////////////////////////
     //
     // Functions not exposed to the OCIO public API.
@@ -58,6 +70,12 @@ public:
     void finalize(const OpRcPtrVec & rawOps, BitDepth in, BitDepth out, OptimizationFlags oFlags);
 
 private:
+    // Get the CPU ops using the values from the overrides.
+    void overrideDynamicProperties(const DynamicPropertyOverrides & values,
+                                   ConstOpCPURcPtr & inBitDepthOp,
+                                   ConstOpCPURcPtrVec & cpuOps,
+                                   ConstOpCPURcPtr & outBitDepthOp) const;
+
     ConstOpCPURcPtr    m_inBitDepthOp; // Converts from in to F32. It could be done by the first op.
     ConstOpCPURcPtrVec m_cpuOps;       // It could be empty if the OpVec only contains a 1D LUT op
                                        // (e.g. the 1D LUT CPUOp instance would be in the m_inBitDepthOp).
@@ -69,9 +87,19 @@ private:
     bool               m_isIdentity = false;
     bool               m_hasChannelCrosstalk = true;
     std::string        m_cacheID;
-    Mutex              m_mutex;
+
+    // Built on demand as only needed for reporting.
+    mutable StringUtils::StringVec m_rendererNames;
+
+    mutable Mutex      m_mutex;
 };
 
+// Get the CPU op converting an RGBA image buffer from the in to the out bit-depth.
+ConstOpCPURcPtr CreateGenericBitDepthHelper(BitDepth in, BitDepth out);
+
+// Get the class name of the CPU op without the library namespace (e.g. "ScaleRenderer").
+std::string GetOpCPUClassName(const OpCPU & op);
+
 } // namespace OCIO_NAMESPACE
 
 #endif // INCLUDED_OCIO_CPUPROCESSOR_H
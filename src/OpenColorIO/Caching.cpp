@@ -4,7 +4,12 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "builtinconfigs/BuiltinConfigRegistry.h"
 #include "Caching.h"
+#include "ConfigUtils.h"
+#include "GPUProcessor.h"
+#include "ops/noop/NoOps.h"
+#include "transforms/builtins/BuiltinTransformRegistry.h"
 #include "transforms/CDLTransform.h"
 #include "PathUtils.h"
 #include "transforms/FileTransform.h"
@@ -25,5 +30,10 @@ void ClearAllCaches()
 {
     ClearPathCaches();
     ClearFileTransformCaches();
+    ClearBuiltinTransformCaches();
+    ClearBuiltinConfigCaches();
+    ConfigUtils::ClearHeuristicsCaches();
+    ClearGpuShaderCaches();
+    ClearLatticeCaches();
 }
 } // namespace OCIO_NAMESPACE
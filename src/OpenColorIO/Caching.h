@@ -76,6 +76,14 @@ public:
         return isEnabled() ? m_entries[key] : dummy;
     }
 
+    // Get the number of cache entries.
+    // To only use when lock is on to protect the cache access.
+    size_t size() const noexcept { return m_entries.size(); }
+
+    // Remove all the cache entries.
+    // To only use when lock is on to protect the cache access.
+    void clearEntries() noexcept { m_entries.clear(); }
+
     Iterator begin() noexcept { return m_entries.begin(); }
     Iterator end()   noexcept { return m_entries.end();   }
 
@@ -3,6 +3,7 @@
 
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include <OpenColorIO/OpenColorIO.h>
 
@@ -27,10 +28,12 @@ public:
         {
             clear();
 
-            for (auto & cs: rhs.m_colorSpaces)
-            {
-                m_colorSpaces.push_back(cs->createEditableCopy());
-            }
+            // The color spaces are never modified once added to a set (i.e. an update always
+            // replaces the instance) so they can be shared between the sets.
+            m_colorSpaces = rhs.m_colorSpaces;
+
+            // The copied color spaces are identical, so is the index.
+            m_index = rhs.m_index;
         }
         return *this;
     }
@@ -91,21 +94,10 @@ public:
         // Search for name and aliases.
         if (csName && *csName)
         {
-            const std::string str = StringUtils::Lower(csName);
-            for (size_t idx = 0; idx < m_colorSpaces.size(); ++idx)
+            const auto it = m_index.find(StringUtils::Lower(csName));
+            if (it != m_index.end())
             {
-                if (StringUtils::Compare(m_colorSpaces[idx]->getName(), str))
-                {
-                    return static_cast<int>(idx);
-                }
-                const size_t numAliases = m_colorSpaces[idx]->getNumAliases();
-                for (size_t aidx = 0; aidx < numAliases; ++aidx)
-                {
-                    if (StringUtils::Compare(m_colorSpaces[idx]->getAlias(aidx), str))
-                    {
-                        return static_cast<int>(idx);
-                    }
-                }
+                return static_cast<int>(it->second);
             }
         }
 
@@ -163,11 +155,14 @@ public:
         if (replaceIdx != (size_t)-1)
         {
             // The color space replaces the existing one.
+            removeFromIndex(*m_colorSpaces[replaceIdx]);
             m_colorSpaces[replaceIdx] = cs->createEditableCopy();
+            addToIndex(*m_colorSpaces[replaceIdx], replaceIdx);
             return;
         }
 
         m_colorSpaces.push_back(cs->createEditableCopy());
+        addToIndex(*m_colorSpaces.back(), m_colorSpaces.size() - 1);
     }
 
     void add(const Impl & rhs)
@@ -183,12 +178,28 @@ public:
         const std::string name = StringUtils::Lower(csName);
         if (name.empty()) return;
 
-        for (auto itr = m_colorSpaces.begin(); itr != m_colorSpaces.end(); ++itr)
+        const auto it = m_index.find(name);
+        if (it == m_index.end())
+        {
+            return;
+        }
+
+        // Only the color space name is used to remove a color space (i.e. not the aliases).
+        const size_t idx = it->second;
+        if (StringUtils::Lower(m_colorSpaces[idx]->getName()) != name)
         {
-            if (StringUtils::Lower((*itr)->getName())==name)
+            return;
+        }
+
+        removeFromIndex(*m_colorSpaces[idx]);
+        m_colorSpaces.erase(m_colorSpaces.begin() + idx);
+
+        // Color spaces after the removed one are shifted down by one.
+        for (auto & entry : m_index)
+        {
+            if (entry.second > idx)
             {
-                m_colorSpaces.erase(itr);
-                return;
+                --entry.second;
             }
         }
     }
@@ -204,11 +215,39 @@ public:
     void clear()
     {
         m_colorSpaces.clear();
+        m_index.clear();
     }
 
 private:
-    typedef std::vector<ColorSpaceRcPtr> ColorSpaceVec;
+    void addToIndex(const ColorSpace & cs, size_t idx)
+    {
+        m_index[StringUtils::Lower(cs.getName())] = idx;
+
+        const size_t numAliases = cs.getNumAliases();
+        for (size_t aidx = 0; aidx < numAliases; ++aidx)
+        {
+            m_index[StringUtils::Lower(cs.getAlias(aidx))] = idx;
+        }
+    }
+
+    void removeFromIndex(const ColorSpace & cs)
+    {
+        m_index.erase(StringUtils::Lower(cs.getName()));
+
+        const size_t numAliases = cs.getNumAliases();
+        for (size_t aidx = 0; aidx < numAliases; ++aidx)
+        {
+            m_index.erase(StringUtils::Lower(cs.getAlias(aidx)));
+        }
+    }
+
+    typedef std::vector<ConstColorSpaceRcPtr> ColorSpaceVec;
     ColorSpaceVec m_colorSpaces;
+
+    // Lower case color space names and aliases to their index in m_colorSpaces. The add()
+    // method guarantees that a name or an alias is only used by one color space, so the index
+    // gives the same result as a linear search over the names and aliases.
+    std::unordered_map<std::string, size_t> m_index;
 };
 
 
@@ -2,11 +2,13 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
 #include <set>
 #include <sstream>
 #include <fstream>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <regex>
@@ -17,6 +19,7 @@
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "builtinconfigs/BuiltinConfigRegistry.h"
+#include "Caching.h"
 #include "ConfigUtils.h"
 #include "ContextVariableUtils.h"
 #include "Display.h"
@@ -36,6 +39,7 @@
 #include "Platform.h"
 #include "PrivateTypes.h"
 #include "Processor.h"
+#include "TransformHash.h"
 #include "transforms/FileTransform.h"
 #include "utils/StringUtils.h"
 #include "ViewingRules.h"
@@ -106,6 +110,21 @@ int GetVersionHex()
     return OCIO_VERSION_HEX;
 }
 
+namespace
+{
+std::atomic<unsigned> g_maxThreads{ 0 };
+}
+
+void SetMaxThreads(unsigned maxThreads) noexcept
+{
+    g_maxThreads = maxThreads;
+}
+
+unsigned GetMaxThreads() noexcept
+{
+    return g_maxThreads;
+}
+
 namespace
 {
 ConstConfigRcPtr g_currentConfig;
@@ -131,6 +150,17 @@ void SetCurrentConfig(const ConstConfigRcPtr & config)
     g_currentConfig = config->createEditableCopy();
 }
 
+namespace
+{
+// The built-in configs parsed once, per config text.
+GenericCache<const char *, ConstConfigRcPtr> g_builtinConfigCache;
+}
+
+void ClearBuiltinConfigCaches()
+{
+    g_builtinConfigCache.clear();
+}
+
 namespace
 {
 
@@ -170,6 +200,92 @@ void GetFileReferences(std::set<std::string> & files, const ConstTransformRcPtr
     }
 }
 
+// Add the hash of a config element (using the previous hash if any) & collect its file references.
+template<typename ElementHashes, typename T, typename HashFunc, typename TransformsFunc>
+void AddElementHash(Hasher & hasher,
+                    const ElementHashes & previous,
+                    ElementHashes & current,
+                    std::set<std::string> & files,
+                    const std::shared_ptr<T> & element,
+                    HashFunc hashFunc,
+                    TransformsFunc transformsFunc)
+{
+    const void * key = element.get();
+
+    auto it = current.find(key);
+    if (it == current.end())
+    {
+        auto prev = previous.find(key);
+        if (prev != previous.end())
+        {
+            it = current.emplace(key, prev->second).first;
+        }
+        else
+        {
+            typename ElementHashes::mapped_type elementHash;
+            elementHash.m_element = element;
+            elementHash.m_hash    = hashFunc(*element);
+
+            std::set<std::string> elementFiles;
+            for (const auto & transform : transformsFunc(*element))
+            {
+                GetFileReferences(elementFiles, transform);
+            }
+            elementHash.m_files.assign(elementFiles.begin(), elementFiles.end());
+
+            it = current.emplace(key, std::move(elementHash)).first;
+        }
+    }
+
+    hasher.addValue(it->second.m_hash);
+    files.insert(it->second.m_files.begin(), it->second.m_files.end());
+}
+
+void AddViewsHash(Hasher & hasher, const ViewVec & views)
+{
+    hasher.addValue(views.size());
+    for (const auto & view : views)
+    {
+        hasher.addString(view.m_name);
+        hasher.addString(view.m_viewTransform);
+        hasher.addString(view.m_colorspace);
+        hasher.addString(view.m_looks);
+        hasher.addString(view.m_rule);
+        hasher.addString(view.m_description);
+    }
+}
+
+void AddDisplayHash(Hasher & hasher, const Display & display)
+{
+    hasher.addValue(display.m_temporary);
+    AddViewsHash(hasher, display.m_views);
+
+    hasher.addValue(display.m_sharedViews.size());
+    for (const auto & view : display.m_sharedViews)
+    {
+        hasher.addString(view);
+    }
+}
+
+void AddStringVecHash(Hasher & hasher, const StringUtils::StringVec & strings)
+{
+    hasher.addValue(strings.size());
+    for (const auto & str : strings)
+    {
+        hasher.addString(str);
+    }
+}
+
+void AddStringMapHash(Hasher & hasher, const StringMap & strings)
+{
+    hasher.addValue(strings.size());
+    for (const auto & str : strings)
+    {
+        hasher.addString(str.first);
+        hasher.addString(str.second);
+    }
+}
+
 // Return the list of all color spaces referenced by the transform (including all sub-transforms in
 // a group). All legal context variables are expanded, so if any are remaining, the caller may want
 // to throw.
@@ -327,10 +443,38 @@ public:
     mutable Mutex m_cacheidMutex;
     mutable StringMap m_cacheids;
     mutable std::string m_cacheidnocontext;
+    // Structural hash & file references of a config element (i.e. color space, look, view
+    // transform or named transform).
+    struct ElementHash
+    {
+        // Keep the element alive so that its address cannot be reused by another element.
+        std::shared_ptr<const void> m_element;
+        std::uint64_t m_hash = 0;
+        StringUtils::StringVec m_files;
+    };
+    // The key is the element address as config elements are never modified once added to a
+    // config (i.e. any edit replaces the element instance). The element hashes survive the
+    // config edits so only the new elements need to be hashed.
+    using ElementHashes = std::unordered_map<const void *, ElementHash>;
+    mutable ElementHashes m_elementHashes;
+    // All the file references of the config (built with the cacheidnocontext).
+    mutable StringUtils::StringVec m_fileReferences;
     FileRulesRcPtr m_fileRules;
 
     mutable ProcessorCacheFlags m_cacheFlags { PROCESSOR_CACHE_DEFAULT };
     mutable ProcessorCache<std::size_t, ProcessorRcPtr> m_processorCache;
+    // True if the cached processors were copied from another config instance.
+    mutable bool m_inheritedProcessors = false;
+
+    // Cache of the file rules results to speed-up the classification of many files (e.g. image
+    // sequences). The cache is flushed by any config change & when it reaches its maximum size.
+    struct FileRulesResult
+    {
+        const char * m_colorSpace = nullptr;
+        size_t m_ruleIndex = 0;
+    };
+    static constexpr size_t FileRulesCacheMaxSize = 4096;
+    mutable ProcessorCache<std::string, FileRulesResult> m_fileRulesCache;
 
     Impl() :
         m_majorVersion(LastSupportedMajorVersion),
@@ -342,31 +486,15 @@ public:
         m_validation(VALIDATION_UNKNOWN),
         m_fileRules(FileRules::Create())
     {
-        std::string activeDisplays;
-        Platform::Getenv(OCIO_ACTIVE_DISPLAYS_ENVVAR, activeDisplays);
-        activeDisplays = StringUtils::Trim(activeDisplays);
-        if (!activeDisplays.empty())
-        {
-            m_activeDisplaysEnvOverride = SplitStringEnvStyle(activeDisplays);
-        }
-
-        std::string activeViews;
-        Platform::Getenv(OCIO_ACTIVE_VIEWS_ENVVAR, activeViews);
-        activeViews = StringUtils::Trim(activeViews);
-        if (!activeViews.empty())
-        {
-            m_activeViewsEnvOverride = SplitStringEnvStyle(activeViews);
-        }
+        loadEnvOverrides();
 
         m_defaultLumaCoefs.resize(3);
         m_defaultLumaCoefs[0] = DEFAULT_LUMA_COEFF_R;
         m_defaultLumaCoefs[1] = DEFAULT_LUMA_COEFF_G;
         m_defaultLumaCoefs[2] = DEFAULT_LUMA_COEFF_B;
 
-        Platform::Getenv(OCIO_INACTIVE_COLORSPACES_ENVVAR, m_inactiveColorSpaceNamesEnv);
-        m_inactiveColorSpaceNamesEnv = StringUtils::Trim(m_inactiveColorSpaceNamesEnv);
-
         m_processorCache.enable((m_cacheFlags & PROCESSOR_CACHE_ENABLED) == PROCESSOR_CACHE_ENABLED);
+        m_fileRulesCache.enable((m_cacheFlags & PROCESSOR_CACHE_ENABLED) == PROCESSOR_CACHE_ENABLED);
 
         // This is used to allow the YAML writer to not save any virtual displays that were
         // instantiated.
@@ -389,31 +517,24 @@ public:
             m_familySeparator = rhs.m_familySeparator;
             m_description = rhs.m_description;
 
-            // Deep copy the colorspaces.
-            m_allColorSpaces = rhs.m_allColorSpaces->createEditableCopy();
+            // The color space set is shared until one of the configs modifies it (refer to
+            // getEditableColorSpaces()).
+            m_allColorSpaces = rhs.m_allColorSpaces;
             m_activeColorSpaceNames       = rhs.m_activeColorSpaceNames;
             m_inactiveColorSpaceNames     = rhs.m_inactiveColorSpaceNames;
             m_inactiveColorSpaceNamesConf = rhs.m_inactiveColorSpaceNamesConf;
             m_inactiveColorSpaceNamesEnv  = rhs.m_inactiveColorSpaceNamesEnv;
             m_inactiveColorSpaceNamesAPI  = rhs.m_inactiveColorSpaceNamesAPI;
 
-            // Deep copy the looks.
-            m_looksList.clear();
-            m_looksList.reserve(rhs.m_looksList.size());
-            for (const auto & look : rhs.m_looksList)
-            {
-                m_looksList.push_back(look->createEditableCopy());
-            }
+            // The config elements (i.e. looks, named transforms & view transforms) are never
+            // modified once added to a config (i.e. an edit always replaces the instance) so
+            // they are shared between the config copies.
+            m_looksList = rhs.m_looksList;
 
             // Assignment operator will suffice for these.
             m_roles = rhs.m_roles;
 
-            m_allNamedTransforms.clear();
-            m_allNamedTransforms.reserve(rhs.m_allNamedTransforms.size());
-            for (const auto & nt : rhs.m_allNamedTransforms)
-            {
-                m_allNamedTransforms.push_back(nt->createEditableCopy());
-            }
+            m_allNamedTransforms = rhs.m_allNamedTransforms;
             m_activeNamedTransformNames = rhs.m_activeNamedTransformNames;
             m_inactiveNamedTransformNames = rhs.m_inactiveNamedTransformNames;
 
@@ -429,13 +550,7 @@ public:
 
             m_virtualDisplay = rhs.m_virtualDisplay;
 
-            // Deep copy view transforms.
-            m_viewTransforms.clear();
-            m_viewTransforms.reserve(rhs.m_viewTransforms.size());
-            for (const auto & vt : rhs.m_viewTransforms)
-            {
-                m_viewTransforms.push_back(vt->createEditableCopy());
-            }
+            m_viewTransforms = rhs.m_viewTransforms;
             m_defaultViewTransform = rhs.m_defaultViewTransform;
             m_defaultLumaCoefs = rhs.m_defaultLumaCoefs;
             m_strictParsing = rhs.m_strictParsing;
@@ -443,8 +558,14 @@ public:
             m_validation = rhs.m_validation;
             m_validationtext = rhs.m_validationtext;
 
-            m_cacheids = rhs.m_cacheids;
-            m_cacheidnocontext = rhs.m_cacheidnocontext;
+            {
+                AutoMutex lock(rhs.m_cacheidMutex);
+
+                m_cacheids = rhs.m_cacheids;
+                m_cacheidnocontext = rhs.m_cacheidnocontext;
+                m_elementHashes = rhs.m_elementHashes;
+                m_fileReferences = rhs.m_fileReferences;
+            }
 
             m_fileRules = rhs.m_fileRules->createEditableCopy();
             
@@ -452,10 +573,39 @@ public:
 
             m_processorCache.clear();
             m_processorCache.enable((m_cacheFlags & PROCESSOR_CACHE_ENABLED) == PROCESSOR_CACHE_ENABLED);
+            m_inheritedProcessors = false;
+
+            // The processors only depend on the config content & context which are identical,
+            // so the copy can reuse them until its first edit.
+            if (m_processorCache.isEnabled() && rhs.m_processorCache.isEnabled())
+            {
+                AutoMutex guard(m_processorCache.lock());
+                AutoMutex guardRhs(rhs.m_processorCache.lock());
+
+                for (const auto & entry : rhs.m_processorCache)
+                {
+                    m_processorCache[entry.first] = entry.second;
+                }
+                m_inheritedProcessors = true;
+            }
+
+            m_fileRulesCache.clear();
+            m_fileRulesCache.enable((m_cacheFlags & PROCESSOR_CACHE_ENABLED) == PROCESSOR_CACHE_ENABLED);
         }
         return *this;
     }
 
+    // As the color space set could be shared with config copies, only use the returned
+    // instance to modify the set.
+    const ColorSpaceSetRcPtr & getEditableColorSpaces()
+    {
+        if (m_allColorSpaces.use_count() > 1)
+        {
+            m_allColorSpaces = m_allColorSpaces->createEditableCopy();
+        }
+        return m_allColorSpaces;
+    }
+
     ConstColorSpaceRcPtr getColorSpace(const char * name) const
     {
         // Check to see if the name is a color space.
@@ -581,6 +731,63 @@ public:
     // thread safe manner by acquiring the m_cacheidMutex.
     void resetCacheIDs();
 
+    // Read the active displays & views, and the inactive color spaces, env. variables.
+    void loadEnvOverrides()
+    {
+        m_activeDisplaysEnvOverride.clear();
+        m_activeViewsEnvOverride.clear();
+
+        std::string activeDisplays;
+        Platform::Getenv(OCIO_ACTIVE_DISPLAYS_ENVVAR, activeDisplays);
+        activeDisplays = StringUtils::Trim(activeDisplays);
+        if (!activeDisplays.empty())
+        {
+            m_activeDisplaysEnvOverride = SplitStringEnvStyle(activeDisplays);
+        }
+
+        std::string activeViews;
+        Platform::Getenv(OCIO_ACTIVE_VIEWS_ENVVAR, activeViews);
+        activeViews = StringUtils::Trim(activeViews);
+        if (!activeViews.empty())
+        {
+            m_activeViewsEnvOverride = SplitStringEnvStyle(activeViews);
+        }
+
+        m_inactiveColorSpaceNamesEnv.clear();
+        Platform::Getenv(OCIO_INACTIVE_COLORSPACES_ENVVAR, m_inactiveColorSpaceNamesEnv);
+        m_inactiveColorSpaceNamesEnv = StringUtils::Trim(m_inactiveColorSpaceNamesEnv);
+    }
+
+    // Restore the context variables to the defaults of the config, and then reload the
+    // environment (i.e. including the env. variable overrides) like when the config is read.
+    void resetEnvironment()
+    {
+        if (m_context->getEnvironmentMode() == ENV_ENVIRONMENT_LOAD_ALL)
+        {
+            m_context->clearStringVars();
+        }
+
+        for (const auto & env : m_env)
+        {
+            m_context->setStringVar(env.first.c_str(), env.second.c_str());
+        }
+
+        m_context->loadEnvironment();
+
+        loadEnvOverrides();
+        m_displayCache.clear();
+
+        AutoMutex lock(m_cacheidMutex);
+        resetCacheIDs();
+        refreshActiveColorSpaces();
+    }
+
+    // Compute the cache identifier of the config (without the file references) from the
+    // structural hashes of its elements.
+    void computeCacheIDNoContext() const;
+    // Compute the hash of the config file references once resolved using the context.
+    std::string computeFileReferencesHash(const Context & context) const;
+
     // Get all internal transforms (to generate cacheIDs, validation, etc).
     // This currently crawls colorspaces + looks + view transforms.
     void getAllInternalTransforms(ConstTransformVec & transformVec) const;
@@ -928,8 +1135,52 @@ public:
 
     void setProcessorCacheFlags(ProcessorCacheFlags flags) const noexcept
     {
+        // The processors inherited from the source config of a copy were created with the
+        // flags of that config.
+        if (m_inheritedProcessors && flags != m_cacheFlags)
+        {
+            m_processorCache.clear();
+            m_inheritedProcessors = false;
+        }
+
         m_cacheFlags = flags;
         m_processorCache.enable((m_cacheFlags & PROCESSOR_CACHE_ENABLED) == PROCESSOR_CACHE_ENABLED);
+        m_fileRulesCache.enable((m_cacheFlags & PROCESSOR_CACHE_ENABLED) == PROCESSOR_CACHE_ENABLED);
+    }
+
+    const char * getColorSpaceFromFilepath(const Config & config,
+                                           const char * filePath,
+                                           size_t & ruleIndex) const
+    {
+        if (!m_fileRulesCache.isEnabled())
+        {
+            return m_fileRules->getImpl()->getColorSpaceFromFilepath(config, filePath, ruleIndex);
+        }
+
+        AutoMutex guard(m_fileRulesCache.lock());
+
+        if (m_fileRulesCache.exists(filePath))
+        {
+            const FileRulesResult & res = m_fileRulesCache[filePath];
+            ruleIndex = res.m_ruleIndex;
+            return res.m_colorSpace;
+        }
+
+        // Note that the returned color space name is owned either by the file rules or by the
+        // config itself, so it stays valid until the next config change which flushes the cache.
+        const char * colorSpace
+            = m_fileRules->getImpl()->getColorSpaceFromFilepath(config, filePath, ruleIndex);
+
+        if (m_fileRulesCache.size() >= FileRulesCacheMaxSize)
+        {
+            m_fileRulesCache.clearEntries();
+        }
+
+        FileRulesResult & res = m_fileRulesCache[filePath];
+        res.m_colorSpace = colorSpace;
+        res.m_ruleIndex  = ruleIndex;
+
+        return colorSpace;
     }
 
     ConstProcessorRcPtr getProcessorWithoutCaching(
@@ -1031,7 +1282,7 @@ public:
             cs->setTransform(file, COLORSPACE_DIR_FROM_REFERENCE);
 
             // Note that it adds it or updates the existing one.
-            m_allColorSpaces->addColorSpace(cs);
+            getEditableColorSpaces()->addColorSpace(cs);
         }
         catch(const Exception & /* ex */)
         {
@@ -1041,7 +1292,7 @@ public:
                 m_displays.erase(iter);
             }
 
-            m_allColorSpaces->removeColorSpace(colorSpaceName.c_str());
+            getEditableColorSpaces()->removeColorSpace(colorSpaceName.c_str());
 
             throw;
         }
@@ -1251,14 +1502,34 @@ ConstConfigRcPtr Config::CreateFromBuiltinConfig(const char * configName)
         builtinConfigName = match.str(1).c_str();
     }
 
-    ConstConfigRcPtr builtinConfig;
     const BuiltinConfigRegistry & reg = BuiltinConfigRegistry::Get();
 
     // getBuiltinConfigByName will throw if config name not found.
     const char * builtinConfigStr = reg.getBuiltinConfigByName(builtinConfigName.c_str());
-    std::istringstream iss;
-    iss.str(builtinConfigStr);
-    builtinConfig = Config::CreateFromStream(iss);
+
+    // The config text is only parsed once.
+    ConstConfigRcPtr parsedConfig;
+    {
+        AutoMutex guard(g_builtinConfigCache.lock());
+
+        if (g_builtinConfigCache.exists(builtinConfigStr))
+        {
+            parsedConfig = g_builtinConfigCache[builtinConfigStr];
+        }
+        else
+        {
+            std::istringstream iss;
+            iss.str(builtinConfigStr);
+            parsedConfig = Config::CreateFromStream(iss);
+
+            g_builtinConfigCache[builtinConfigStr] = parsedConfig;
+        }
+    }
+
+    // The copy shares all the config elements with the parsed config but the context variables
+    // must reflect the current environment.
+    ConfigRcPtr builtinConfig = parsedConfig->createEditableCopy();
+    builtinConfig->getImpl()->resetEnvironment();
 
     return builtinConfig;
 }
@@ -2622,7 +2893,7 @@ void Config::addColorSpace(const ConstColorSpaceRcPtr & original)
     }
 
     // This is verifying that name and aliases are fine with other color spaces.
-    getImpl()->m_allColorSpaces->addColorSpace(original);
+    getImpl()->getEditableColorSpaces()->addColorSpace(original);
 
     AutoMutex lock(getImpl()->m_cacheidMutex);
     getImpl()->resetCacheIDs();
@@ -2631,7 +2902,7 @@ void Config::addColorSpace(const ConstColorSpaceRcPtr & original)
 
 void Config::removeColorSpace(const char * name)
 {
-    getImpl()->m_allColorSpaces->removeColorSpace(name);
+    getImpl()->getEditableColorSpaces()->removeColorSpace(name);
 
     AutoMutex lock(getImpl()->m_cacheidMutex);
     getImpl()->resetCacheIDs();
@@ -2754,7 +3025,7 @@ bool Config::isColorSpaceUsed(const char * name) const noexcept
 
 void Config::clearColorSpaces()
 {
-    getImpl()->m_allColorSpaces->clearColorSpaces();
+    getImpl()->getEditableColorSpaces()->clearColorSpaces();
 
     AutoMutex lock(getImpl()->m_cacheidMutex);
     getImpl()->resetCacheIDs();
@@ -4269,21 +4540,20 @@ void Config::setFileRules(ConstFileRulesRcPtr fileRules)
 
 const char * Config::getColorSpaceFromFilepath(const char * filePath) const
 {
-    return getImpl()->m_fileRules->getImpl()->getColorSpaceFromFilepath(*this,
-                                                                        filePath ? filePath : "");
+    size_t ruleIndex = 0;
+    return getImpl()->getColorSpaceFromFilepath(*this, filePath ? filePath : "", ruleIndex);
 }
 
 const char * Config::getColorSpaceFromFilepath(const char * filePath, size_t & ruleIndex) const
 {
-    return getImpl()->m_fileRules->getImpl()->getColorSpaceFromFilepath(*this,
-                                                                        filePath ? filePath : "",
-                                                                        ruleIndex);
+    return getImpl()->getColorSpaceFromFilepath(*this, filePath ? filePath : "", ruleIndex);
 }
 
 bool Config::filepathOnlyMatchesDefaultRule(const char * filePath) const
 {
-    return getImpl()->m_fileRules->getImpl()->filepathOnlyMatchesDefaultRule(*this,
-                                                                             filePath ? filePath : "");
+    size_t ruleIndex = 0;
+    getImpl()->getColorSpaceFromFilepath(*this, filePath ? filePath : "", ruleIndex);
+    return (ruleIndex + 1) == getImpl()->m_fileRules->getNumEntries();
 }
 
 
@@ -4417,17 +4687,6 @@ ConstProcessorRcPtr Config::getProcessor(const ConstContextRcPtr & context,
     }
 
 
-    // The goal of the usedContext is to only contain the context vars that are actually used for
-    // this transform.  This allows the cache to be more efficient. However, there are still some
-    // various TODOs since the usedContext will sometimes contain more vars than are needed.
-
-    ContextRcPtr usedContext = Context::Create();
-    usedContext->setSearchPath(context->getSearchPath());
-    usedContext->setWorkingDir(context->getWorkingDir());
-    usedContext->setConfigIOProxy(context->getConfigIOProxy());
-
-    const bool needContextVariables = CollectContextVariables(*this, *context, transform, usedContext);
-
     // Create helper method.
     auto CreateProcessor = [](const Config & config, 
                               const ConstContextRcPtr & context,
@@ -4443,16 +4702,54 @@ ConstProcessorRcPtr Config::getProcessor(const ConstContextRcPtr & context,
 
     if (getImpl()->m_processorCache.isEnabled())
     {
-        AutoMutex guard(getImpl()->m_processorCache.lock());
+        // Note that the keys include a structural hash of the transform which does not include
+        // the LUT file content (just the arguments of the FileTransforms for LUTs). The values of
+        // the LUT transforms are only hashed once per transform instance.
+        Hasher transformHasher;
+        AddTransformHash(transformHasher, *transform);
+        transformHasher.addValue(direction);
+        const std::uint64_t transformHash = transformHasher.digest();
 
-        // Note that the key includes a string description of the transform which does not include
-        // all the LUT entries (just the arguments of the FileTransforms for LUTs).
-        std::ostringstream oss;
-        oss << (needContextVariables ? std::string(usedContext->getCacheID()) : "")
-            << *transform
-            << direction;
+        // The first key uses the complete context identifier (i.e. computed once per context
+        // instance) so that a cache hit with the same context neither allocates nor collects
+        // the context variables used by the transform.
+        Hasher contextHasher;
+        contextHasher.addString(context->getCacheID());
+        contextHasher.addValue(transformHash);
+        const std::size_t contextKey = static_cast<std::size_t>(contextHasher.digest());
 
-        const std::size_t key = std::hash<std::string>{}(oss.str());
+        {
+            AutoMutex guard(getImpl()->m_processorCache.lock());
+
+            if (getImpl()->m_processorCache.exists(contextKey))
+            {
+                return getImpl()->m_processorCache[contextKey];
+            }
+        }
+
+        // The goal of the usedContext is to only contain the context vars that are actually
+        // used for this transform.  This allows the cache to be more efficient (i.e. to share
+        // the processor between contexts only differing by unused variables). However, there
+        // are still some various TODOs since the usedContext will sometimes contain more vars
+        // than are needed.
+
+        ContextRcPtr usedContext = Context::Create();
+        usedContext->setSearchPath(context->getSearchPath());
+        usedContext->setWorkingDir(context->getWorkingDir());
+        usedContext->setConfigIOProxy(context->getConfigIOProxy());
+
+        const bool needContextVariables
+            = CollectContextVariables(*this, *context, transform, usedContext);
+
+        // A 'used context' key is never equal to a complete context one thanks to the prefix.
+        Hasher hasher;
+        hasher.addString("used context:");
+        hasher.addString(needContextVariables ? usedContext->getCacheID() : "");
+        hasher.addValue(transformHash);
+
+        const std::size_t key = static_cast<std::size_t>(hasher.digest());
+
+        AutoMutex guard(getImpl()->m_processorCache.lock());
 
         // As the entry is a shared pointer instance, having an empty one means that the entry does
         // not exist in the cache. So, it provides a fast existence check & access in one call.
@@ -4492,6 +4789,8 @@ ConstProcessorRcPtr Config::getProcessor(const ConstContextRcPtr & context,
             }
         }
 
+        getImpl()->m_processorCache[contextKey] = processor;
+
         return processor;
     }
     else
@@ -4875,50 +5174,17 @@ const char * Config::getCacheID(const ConstContextRcPtr & context) const
         return cacheiditer->second.c_str();
     }
 
-    // Include the hash of the yaml config serialization
+    // Include the structural hash of the config.
     if(getImpl()->m_cacheidnocontext.empty())
     {
-        std::ostringstream cacheid;
-        serialize(cacheid);
-        const std::string fullstr = cacheid.str();
-        getImpl()->m_cacheidnocontext = CacheIDHash(fullstr.c_str(), fullstr.size());
+        getImpl()->computeCacheIDNoContext();
     }
 
     // Also include all file references, using the context (if specified)
     std::string fileReferencesFastHash;
     if(context)
     {
-        std::ostringstream filehash;
-
-        ConstTransformVec allTransforms;
-        getImpl()->getAllInternalTransforms(allTransforms);
-
-        std::set<std::string> files;
-        for(const auto & transform : allTransforms)
-        {
-            GetFileReferences(files, transform);
-        }
-
-        for(const auto & iter : files)
-        {
-            if(iter.empty()) continue;
-
-            filehash << iter << "=";
-
-            try
-            {
-                const std::string resolvedLocation = context->resolveFileLocation(iter.c_str());
-                filehash << GetFastFileHash(resolvedLocation, *context) << " ";
-            }
-            catch(...)
-            {
-                filehash << "? ";
-                continue;
-            }
-        }
-
-        const std::string fullstr = filehash.str();
-        fileReferencesFastHash = CacheIDHash(fullstr.c_str(), fullstr.size());
+        fileReferencesFastHash = getImpl()->computeFileReferencesHash(*context);
     }
 
     getImpl()->m_cacheids[contextcacheid] = getImpl()->m_cacheidnocontext + ":" + fileReferencesFastHash;
@@ -4957,6 +5223,8 @@ void Config::setProcessorCacheFlags(ProcessorCacheFlags flags) const noexcept
 void Config::clearProcessorCache() noexcept
 {
     getImpl()->m_processorCache.clear();
+    getImpl()->m_inheritedProcessors = false;
+    getImpl()->m_fileRulesCache.clear();
 }
 
 ///////////////////////////////////////////////////////////////////////////
@@ -5079,12 +5347,15 @@ void Config::Impl::resetCacheIDs()
 {
     m_cacheids.clear();
     m_cacheidnocontext = "";
+    m_fileReferences.clear();
     m_validation = VALIDATION_UNKNOWN;
     m_validationtext = "";
 
     // As any changes could impact the cache keys, it's better to always flush the cache
     // of processors to not keep in memory useless instances.
     m_processorCache.clear();
+    m_inheritedProcessors = false;
+    m_fileRulesCache.clear();
 }
 
 void Config::Impl::getAllInternalTransforms(ConstTransformVec & transformVec) const
@@ -5159,6 +5430,143 @@ void Config::Impl::getAllInternalTransforms(ConstTransformVec & transformVec) co
     }
 }
 
+void Config::Impl::computeCacheIDNoContext() const
+{
+    // Same validation as the serialization.
+    checkVersionConsistency();
+
+    Hasher hasher;
+
+    // Hash all the config properties.
+
+    hasher.addValue(m_majorVersion);
+    hasher.addValue(m_minorVersion);
+    hasher.addString(m_name);
+    hasher.addString(m_description);
+    hasher.addValue(m_familySeparator);
+    hasher.addValue(m_strictParsing);
+    hasher.addValues(m_defaultLumaCoefs.data(), m_defaultLumaCoefs.size());
+
+    AddStringMapHash(hasher, m_env);
+    hasher.addString(m_context->getSearchPath());
+
+    AddStringMapHash(hasher, m_roles);
+
+    AddFileRulesHash(hasher, *m_fileRules);
+    AddViewingRulesHash(hasher, *m_viewingRules);
+
+    AddViewsHash(hasher, m_sharedViews);
+    hasher.addValue(m_displays.size());
+    for (const auto & display : m_displays)
+    {
+        hasher.addString(display.first);
+        AddDisplayHash(hasher, display.second);
+    }
+    AddDisplayHash(hasher, m_virtualDisplay);
+
+    AddStringVecHash(hasher, m_activeDisplays);
+    AddStringVecHash(hasher, m_activeDisplaysEnvOverride);
+    AddStringVecHash(hasher, m_activeViews);
+    AddStringVecHash(hasher, m_activeViewsEnvOverride);
+
+    hasher.addString(m_inactiveColorSpaceNamesAPI);
+    hasher.addString(m_inactiveColorSpaceNamesEnv);
+    hasher.addString(m_inactiveColorSpaceNamesConf);
+
+    hasher.addString(m_defaultViewTransform);
+
+    // Add the hashes of all the elements, only hashing the new ones.
+
+    ElementHashes elementHashes;
+    std::set<std::string> files;
+
+    const int numColorSpaces = m_allColorSpaces->getNumColorSpaces();
+    hasher.addValue(numColorSpaces);
+    for (int idx = 0; idx < numColorSpaces; ++idx)
+    {
+        AddElementHash(hasher, m_elementHashes, elementHashes, files,
+                       m_allColorSpaces->getColorSpaceByIndex(idx),
+                       GetColorSpaceHash,
+                       [](const ColorSpace & cs)
+                       {
+                           return ConstTransformVec{ cs.getTransform(COLORSPACE_DIR_TO_REFERENCE),
+                                                     cs.getTransform(COLORSPACE_DIR_FROM_REFERENCE) };
+                       });
+    }
+
+    hasher.addValue(m_looksList.size());
+    for (const auto & look : m_looksList)
+    {
+        AddElementHash(hasher, m_elementHashes, elementHashes, files, look,
+                       GetLookHash,
+                       [](const Look & lk)
+                       {
+                           return ConstTransformVec{ lk.getTransform(), lk.getInverseTransform() };
+                       });
+    }
+
+    hasher.addValue(m_viewTransforms.size());
+    for (const auto & vt : m_viewTransforms)
+    {
+        AddElementHash(hasher, m_elementHashes, elementHashes, files, vt,
+                       GetViewTransformHash,
+                       [](const ViewTransform & v)
+                       {
+                           return ConstTransformVec{ v.getTransform(VIEWTRANSFORM_DIR_TO_REFERENCE),
+                                                     v.getTransform(VIEWTRANSFORM_DIR_FROM_REFERENCE) };
+                       });
+    }
+
+    hasher.addValue(m_allNamedTransforms.size());
+    for (const auto & nt : m_allNamedTransforms)
+    {
+        AddElementHash(hasher, m_elementHashes, elementHashes, files, nt,
+                       GetNamedTransformHash,
+                       [](const NamedTransform & n)
+                       {
+                           return ConstTransformVec{ n.getTransform(TRANSFORM_DIR_FORWARD),
+                                                     n.getTransform(TRANSFORM_DIR_INVERSE) };
+                       });
+    }
+
+    // Only keep the hashes of the current elements.
+    m_elementHashes.swap(elementHashes);
+
+    m_fileReferences.assign(files.begin(), files.end());
+
+    const std::uint64_t hash = hasher.digest();
+    m_cacheidnocontext = CacheIDHash(reinterpret_cast<const char *>(&hash), sizeof(hash));
+}
+
+std::string Config::Impl::computeFileReferencesHash(const Context & context) const
+{
+    // Note that the file hashes are cached by resolved file path, so they are shared between
+    // all the contexts resolving to the same files.
+
+    std::ostringstream filehash;
+
+    for (const auto & file : m_fileReferences)
+    {
+        if (file.empty()) continue;
+
+        filehash << file << "=";
+
+        try
+        {
+            const std::string resolvedLocation = context.resolveFileLocation(file.c_str());
+            filehash << GetFastFileHash(resolvedLocation, context) << " ";
+        }
+        catch(...)
+        {
+            filehash << "? ";
+            continue;
+        }
+    }
+
+    const std::string fullstr = filehash.str();
+    return CacheIDHash(fullstr.c_str(), fullstr.size());
+}
+
 ConstConfigRcPtr Config::Impl::Read(std::istream & istream, const char * filename)
 {
     ConfigRcPtr config = Config::Create();
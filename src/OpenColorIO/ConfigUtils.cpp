@@ -3,6 +3,7 @@
 
 #include <pystring.h>
 
+#include "Caching.h"
 #include "ConfigUtils.h"
 #include "MathUtils.h"
 #include "utils/StringUtils.h"
@@ -246,32 +247,241 @@ const char * getDataSpaceName(const ConstConfigRcPtr & cfg)
     return "";
 }
 
-// Return false if the supplied Processor modifies any of the supplied float values
-// by more than the supplied absolute tolerance amount.
+// Return the CPU Processor converting between a color space and an interchange color space
+// of the supplied config, in the direction requested.  This is one side of the conversion built
+// by Config::GetProcessorFromConfigs, and it reports missing color spaces in the same way.
 //
-bool isIdentityTransform(const ConstProcessorRcPtr & proc, 
-                         std::vector<float> & RGBAvals, 
-                         float absTolerance)
+// config -- The source or destination config of the conversion.
+// isSrc -- True for the source side (to the interchange space), false for the destination side.
+//
+ConstCPUProcessorRcPtr getCPUProcessor(const ConstConfigRcPtr & config, 
+                                       bool isSrc,
+                                       const char * colorSpaceName, 
+                                       const char * interchangeName)
 {
-    std::vector<float> out(RGBAvals.size(), 0.f);
+    const char * side = isSrc ? "source" : "destination";
+
+    ConstColorSpaceRcPtr cs = config->getColorSpace(colorSpaceName);
+    if (!cs)
+    {
+        std::ostringstream os;
+        os << "Could not find " << side << " color space '" << colorSpaceName << "'.";
+        throw Exception(os.str().c_str());
+    }
+
+    ConstColorSpaceRcPtr exCs = config->getColorSpace(interchangeName);
+    if (!exCs)
+    {
+        std::ostringstream os;
+        os << "Could not find " << side << " interchange color space '" << interchangeName << "'.";
+        throw Exception(os.str().c_str());
+    }
+
+    ConstProcessorRcPtr proc = isSrc ? config->getProcessor(cs, exCs) 
+                                     : config->getProcessor(exCs, cs);
+    return proc->getOptimizedCPUProcessor(OPTIMIZATION_NONE);
+}
+
+// Send the supplied RGBA values through a CPU Processor.
+//
+void applyToRGBA(const ConstCPUProcessorRcPtr & cpu, 
+                 std::vector<float> & RGBAvals, 
+                 std::vector<float> & out)
+{
+    out.resize(RGBAvals.size());
 
     PackedImageDesc desc( &RGBAvals[0], (long) RGBAvals.size() / 4, 1, CHANNEL_ORDERING_RGBA );
     PackedImageDesc descDst( &out[0], (long) RGBAvals.size() / 4, 1, CHANNEL_ORDERING_RGBA );
 
-    ConstCPUProcessorRcPtr cpu  = proc->getOptimizedCPUProcessor(OPTIMIZATION_NONE);
     cpu->apply(desc, descDst);
+}
 
-    for (size_t i = 0; i < out.size(); i++)
+// Test a set of candidate conversions that all start with the same source config side,
+// returning the index of the first candidate that does not modify any of the supplied 
+// float values by more than the supplied absolute tolerance amount, or -1 if none.
+//
+// Rather than building one combined Processor per candidate (which would rebuild the source 
+// side every time), the source side is applied once to the values and the intermediate values 
+// are then sent through the built-in side of each candidate.  Null candidates are skipped.
+//
+int findIdentityCandidate(const ConstCPUProcessorRcPtr & srcSide,
+                          const std::vector<ConstCPUProcessorRcPtr> & builtinSides,
+                          std::vector<float> & RGBAvals, 
+                          float absTolerance)
+{
+    std::vector<float> intermediate;
+    applyToRGBA(srcSide, RGBAvals, intermediate);
+
+    std::vector<float> out;
+    for (size_t c = 0; c < builtinSides.size(); c++)
+    {
+        if (!builtinSides[c])
+        {
+            continue;
+        }
+
+        applyToRGBA(builtinSides[c], intermediate, out);
+
+        bool isIdentity = true;
+        for (size_t i = 0; i < out.size() && isIdentity; i++)
+        {
+            isIdentity = EqualWithAbsError(RGBAvals[i], out[i], absTolerance);
+        }
+
+        if (isIdentity)
+        {
+            return static_cast<int>(c);
+        }
+    }
+
+    return -1;
+}
+
+// The built-in config side of the candidate conversions tested by the heuristics.  They do
+// not depend on the source color space being tested so they are only built once, when first
+// needed, rather than once per source color space.
+//
+class BuiltinCandidates
+{
+public:
+    BuiltinCandidates() = delete;
+    BuiltinCandidates(const BuiltinCandidates &) = delete;
+    BuiltinCandidates & operator=(const BuiltinCandidates &) = delete;
+
+    explicit BuiltinCandidates(const ConstConfigRcPtr & builtinConfig)
+        : m_builtinConfig(builtinConfig)
     {
-        if (!EqualWithAbsError(RGBAvals[i], out[i], absTolerance))
+    }
+
+    // Conversions from each of the built-in linear spaces to the built-in sRGB texture space,
+    // the candidate index being the index into the list of built-in linear spaces.
+    const std::vector<ConstCPUProcessorRcPtr> & getSRGBCandidates()
+    {
+        if (m_srgbCandidates.empty())
         {
-            return false;
+            for (int i = 0; i < getNumberOfbuiltinLinearSpaces(); i++)
+            {
+                m_srgbCandidates.push_back(getCPUProcessor(m_builtinConfig,
+                                                           false,
+                                                           getSRGBColorSpaceName(),
+                                                           getBuiltinLinearSpaceName(i)));
+            }
         }
+        return m_srgbCandidates;
     }
 
-    return true;
+    // Conversions between all the pairs of built-in linear spaces, the candidate index being
+    // i * getNumberOfbuiltinLinearSpaces() + j for the conversion from the candidate interchange
+    // space j to the space i.
+    // The built-in side is never an identity since if both the src side and built-in side
+    // were an identity, it would seem as though the reference space has been identified,
+    // but in fact it would not be.  So the candidates where i == j are null.
+    const std::vector<ConstCPUProcessorRcPtr> & getLinearCandidates()
+    {
+        if (m_linearCandidates.empty())
+        {
+            for (int i = 0; i < getNumberOfbuiltinLinearSpaces(); i++)
+            {
+                for (int j = 0; j < getNumberOfbuiltinLinearSpaces(); j++)
+                {
+                    m_linearCandidates.push_back(
+                        i == j ? ConstCPUProcessorRcPtr()
+                               : getCPUProcessor(m_builtinConfig,
+                                                 false,
+                                                 getBuiltinLinearSpaceName(i),
+                                                 getBuiltinLinearSpaceName(j)));
+                }
+            }
+        }
+        return m_linearCandidates;
+    }
+
+private:
+    ConstConfigRcPtr m_builtinConfig;
+    std::vector<ConstCPUProcessorRcPtr> m_srgbCandidates;
+    std::vector<ConstCPUProcessorRcPtr> m_linearCandidates;
+};
+
+namespace
+{
+
+// The results of the heuristics are memoized since they are expensive (many Processors need
+// to be built) and applications typically repeat the same queries for the same configs, for 
+// instance each time a cross-config conversion is requested.  The keys are built from the 
+// cache IDs of both configs so any edit of a config leads to a new entry.
+
+// Index into the list of built-in linear spaces identifying the source config reference space,
+// or -1 if it could not be identified.
+GenericCache<std::string, int> g_interchangeSpaceCache;
+// Name of the source config color space equivalent to the built-in color space, or an empty 
+// string if none was found.
+GenericCache<std::string, std::string> g_builtinColorSpaceCache;
+
+// Bound the memory used by the caches when many config variations are queried.
+constexpr size_t HeuristicsCacheMaxSize = 256;
+
+// Return the key of the heuristics results for the supplied configs and built-in color space,
+// or an empty string if the configs do not have a usable cache ID.
+//
+std::string getHeuristicsCacheKey(const ConstConfigRcPtr & srcConfig, 
+                                  const ConstConfigRcPtr & builtinConfig,
+                                  const char * builtinColorSpaceName)
+{
+    try
+    {
+        std::string key{ srcConfig->getCacheID() };
+        key += "|";
+        key += builtinConfig->getCacheID();
+        key += "|";
+        key += builtinColorSpaceName;
+        return key;
+    }
+    catch (const Exception &)
+    {
+        // Inconsistent configs are not memoized, the heuristics report the problems if any.
+        return "";
+    }
+}
+
+template<typename EntryType>
+bool getCachedResult(GenericCache<std::string, EntryType> & cache, 
+                     const std::string & key, 
+                     EntryType & result)
+{
+    if (key.empty())
+    {
+        return false;
+    }
+
+    AutoMutex guard(cache.lock());
+    if (cache.exists(key))
+    {
+        result = cache[key];
+        return true;
+    }
+    return false;
+}
+
+template<typename EntryType>
+void setCachedResult(GenericCache<std::string, EntryType> & cache, 
+                     const std::string & key, 
+                     const EntryType & result)
+{
+    if (key.empty())
+    {
+        return;
+    }
+
+    AutoMutex guard(cache.lock());
+    if (cache.size() >= HeuristicsCacheMaxSize)
+    {
+        cache.clearEntries();
+    }
+    cache[key] = result;
 }
 
+} // anon.
+
 // Determine whether a Processor contains a MatrixTransform with off-diagonal coefficients.
 //
 bool hasNonTrivialMatrixTransform(const ConstProcessorRcPtr & proc)
@@ -418,13 +628,13 @@ bool excludeColorSpaceFromHeuristics(const ConstColorSpaceRcPtr & cs,
 // srcConfig -- Source config object.
 // srcRefName -- Name of a scene-referred reference color space in the src config.
 // cs -- Color space from the source config to test.
-// builtinConfig -- The built-in config object.
+// builtinCandidates -- The built-in side of the conversions to test.
 // Returns the index into the list of built-in linear spaces.
 //
 int getReferenceSpaceFromLinearSpace(const ConstConfigRcPtr & srcConfig, 
                                      const char * srcRefName,
                                      const ConstColorSpaceRcPtr & cs,
-                                     const ConstConfigRcPtr & builtinConfig)
+                                     BuiltinCandidates & builtinCandidates)
 {
     // Define a set of (somewhat arbitrary) RGB values to test whether the combined transform is 
     // enough of an identity.
@@ -438,32 +648,15 @@ int getReferenceSpaceFromLinearSpace(const ConstConfigRcPtr & srcConfig,
     // of the built-in linear color spaces.  If one of them results in an identity, that identifies
     // what the source color space and reference space are.
 
-    for (int i = 0; i < getNumberOfbuiltinLinearSpaces(); i++)
-    {
-        for (int j = 0; j < getNumberOfbuiltinLinearSpaces(); j++)
-        {
-            // Ensure the built-in side of the conversion is never an identity, since if
-            // both the src side and built-in side are an identity, it would seem as though
-            // the reference space has been identified, but in fact it would not be.
-            if (i != j)
-            {
-                ConstProcessorRcPtr proc = Config::GetProcessorFromConfigs(
-                    srcConfig,
-                    cs->getName(),
-                    srcRefName,
-                    builtinConfig,
-                    getBuiltinLinearSpaceName(i),
-                    getBuiltinLinearSpaceName(j));
-
-                if (isIdentityTransform(proc, vals, 1e-3f))
-                {
-                    return j;
-                }
-            }
-        }
-    }
+    ConstCPUProcessorRcPtr srcSide = getCPUProcessor(srcConfig, true, cs->getName(), srcRefName);
 
-    return -1;
+    const int candidate = findIdentityCandidate(srcSide,
+                                                builtinCandidates.getLinearCandidates(),
+                                                vals,
+                                                1e-3f);
+
+    // The candidate index encodes the pair of built-in linear spaces, return the interchange one.
+    return candidate < 0 ? -1 : candidate % getNumberOfbuiltinLinearSpaces();
 }
 
 // Test the supplied color space against a set of color spaces in the built-in config
@@ -475,13 +668,13 @@ int getReferenceSpaceFromLinearSpace(const ConstConfigRcPtr & srcConfig,
 // srcConfig -- Source config object.
 // srcRefName -- Name of a scene-referred reference color space in the src config.
 // cs -- Color space from the source config to test.
-// builtinConfig -- The built-in config object.
+// builtinCandidates -- The built-in side of the conversions to test.
 // Returns the index into the list of built-in linear spaces.
 //
 int getReferenceSpaceFromSRGBSpace(const ConstConfigRcPtr & srcConfig, 
                                    const char * srcRefName,
                                    const ConstColorSpaceRcPtr & cs,
-                                   const ConstConfigRcPtr & builtinConfig)
+                                   BuiltinCandidates & builtinCandidates)
 {
     // Get a transform in the to-reference direction.
     ConstTransformRcPtr toRefTransform;
@@ -579,21 +772,88 @@ int getReferenceSpaceFromSRGBSpace(const ConstConfigRcPtr & srcConfig,
 
     // At this point, cs has the expected non-linearity and a non-trivial matrix to its reference space.
     // Now try to identify the matrix.
-    for (int i = 0; i < getNumberOfbuiltinLinearSpaces(); i++)
-    {
-        ConstProcessorRcPtr proc = Config::GetProcessorFromConfigs(srcConfig,
-                                                                   cs->getName(),
-                                                                   srcRefName,
-                                                                   builtinConfig,
-                                                                   getSRGBColorSpaceName(),
-                                                                   getBuiltinLinearSpaceName(i));
-        if (isIdentityTransform(proc, vals, 1e-3f))
+    ConstCPUProcessorRcPtr srcSide = getCPUProcessor(srcConfig, true, cs->getName(), srcRefName);
+
+    return findIdentityCandidate(srcSide,
+                                 builtinCandidates.getSRGBCandidates(),
+                                 vals,
+                                 1e-3f);
+}
+
+// Identify the reference space of the source config by searching for a color space matching
+// one of the known built-in color spaces.
+//
+// srcConfig -- Source config object.
+// srcRefName -- Name of a scene-referred reference color space in the src config.
+// builtinConfig -- Built-in config object.
+// Returns the index into the list of built-in linear spaces, or -1 if not found.
+//
+int identifyReferenceSpace(const ConstConfigRcPtr & srcConfig,
+                           const char * srcRefName,
+                           const ConstConfigRcPtr & builtinConfig)
+{
+    // The heuristics need to create a lot of Processors and send RGB values through
+    // them to try and identify a known color space.  Turn off the Processor cache in
+    // the configs to avoid polluting the cache with transforms that won't be reused
+    // and avoid the overhead of maintaining the cache.
+    SuspendCacheGuard srcGuard(srcConfig);
+    SuspendCacheGuard builtinGuard(builtinConfig);
+
+    BuiltinCandidates builtinCandidates(builtinConfig);
+
+    // Check for an sRGB texture space.
+    int refColorSpacePrimsIndex = -1;
+    int nbCs = srcConfig->getNumColorSpaces();
+    for (int i = 0; i < nbCs; i++)
+    {
+        ConstColorSpaceRcPtr cs = srcConfig->getColorSpace(srcConfig->getColorSpaceNameByIndex(i));
+
+        if (containsSRGB(cs))
         {
-            return i;
+            // Exclude color spaces that may be too expensive to test or otherwise inappropriate.
+            // Currently only handling scene-referred spaces in the heuristics.
+            if (excludeColorSpaceFromHeuristics(cs, REFERENCE_SPACE_SCENE, true))
+            {
+                continue;
+            }
+
+            refColorSpacePrimsIndex = getReferenceSpaceFromSRGBSpace(srcConfig, 
+                                                                     srcRefName,
+                                                                     cs, 
+                                                                     builtinCandidates);
+            // Break out when a match is found.
+            if (refColorSpacePrimsIndex > -1) break; 
         }
     }
 
-    return -1;
+    if (refColorSpacePrimsIndex < 0)
+    {
+        // Check for a scene-linear space with known primaries.
+        nbCs = srcConfig->getNumColorSpaces();
+        for (int i = 0; i < nbCs; i++)
+        {
+            ConstColorSpaceRcPtr cs = srcConfig->getColorSpace(srcConfig->getColorSpaceNameByIndex(i));
+
+            // Exclude color spaces that may be too expensive to test or otherwise inappropriate.
+            // Currently only handling scene-referred spaces in the heuristics.
+            if (excludeColorSpaceFromHeuristics(cs, REFERENCE_SPACE_SCENE, true))
+            {
+                continue;
+            }
+
+            if (srcConfig->isColorSpaceLinear(cs->getName(), REFERENCE_SPACE_SCENE))
+            {
+                refColorSpacePrimsIndex = getReferenceSpaceFromLinearSpace(srcConfig,
+                                                                           srcRefName,
+                                                                           cs, 
+                                                                           builtinCandidates);
+                // Break out when a match is found.
+                if (refColorSpacePrimsIndex > -1) break; 
+            }
+        }
+    }
+
+    return refColorSpacePrimsIndex;
 }
 
 // Identify the interchange spaces of the source config and the built-in default config
@@ -655,63 +915,15 @@ void IdentifyInterchangeSpace(const char ** srcInterchange,
         throw Exception(os.str().c_str());
     }
 
-    // The heuristics need to create a lot of Processors and send RGB values through
-    // them to try and identify a known color space.  Turn off the Processor cache in
-    // the configs to avoid polluting the cache with transforms that won't be reused
-    // and avoid the overhead of maintaining the cache.
-    SuspendCacheGuard srcGuard(srcConfig);
-    SuspendCacheGuard builtinGuard(builtinConfig);
+    // Reuse the result of a previous identification for the same pair of configs, which
+    // does not depend on the color spaces to convert.
+    const std::string cacheKey = getHeuristicsCacheKey(srcConfig, builtinConfig, "");
 
-    // Check for an sRGB texture space.
     int refColorSpacePrimsIndex = -1;
-    int nbCs = srcConfig->getNumColorSpaces();
-    for (int i = 0; i < nbCs; i++)
+    if (!getCachedResult(g_interchangeSpaceCache, cacheKey, refColorSpacePrimsIndex))
     {
-        ConstColorSpaceRcPtr cs = srcConfig->getColorSpace(srcConfig->getColorSpaceNameByIndex(i));
-
-        if (containsSRGB(cs))
-        {
-            // Exclude color spaces that may be too expensive to test or otherwise inappropriate.
-            // Currently only handling scene-referred spaces in the heuristics.
-            if (excludeColorSpaceFromHeuristics(cs, REFERENCE_SPACE_SCENE, true))
-            {
-                continue;
-            }
-
-            refColorSpacePrimsIndex = getReferenceSpaceFromSRGBSpace(srcConfig, 
-                                                                     *srcInterchange,
-                                                                     cs, 
-                                                                     builtinConfig);
-            // Break out when a match is found.
-            if (refColorSpacePrimsIndex > -1) break; 
-        }
-    }
-
-    if (refColorSpacePrimsIndex < 0)
-    {
-        // Check for a scene-linear space with known primaries.
-        nbCs = srcConfig->getNumColorSpaces();
-        for (int i = 0; i < nbCs; i++)
-        {
-            ConstColorSpaceRcPtr cs = srcConfig->getColorSpace(srcConfig->getColorSpaceNameByIndex(i));
-
-            // Exclude color spaces that may be too expensive to test or otherwise inappropriate.
-            // Currently only handling scene-referred spaces in the heuristics.
-            if (excludeColorSpaceFromHeuristics(cs, REFERENCE_SPACE_SCENE, true))
-            {
-                continue;
-            }
-
-            if (srcConfig->isColorSpaceLinear(cs->getName(), REFERENCE_SPACE_SCENE))
-            {
-                refColorSpacePrimsIndex = getReferenceSpaceFromLinearSpace(srcConfig,
-                                                                           *srcInterchange,
-                                                                           cs, 
-                                                                           builtinConfig);
-                // Break out when a match is found.
-                if (refColorSpacePrimsIndex > -1) break; 
-            }
-        }
+        refColorSpacePrimsIndex = identifyReferenceSpace(srcConfig, *srcInterchange, builtinConfig);
+        setCachedResult(g_interchangeSpaceCache, cacheKey, refColorSpacePrimsIndex);
     }
 
     if (refColorSpacePrimsIndex > -1)
@@ -769,6 +981,25 @@ const char * IdentifyBuiltinColorSpace(const ConstConfigRcPtr & srcConfig,
 
     ReferenceSpaceType builtinRefSpaceType = builtinColorSpace->getReferenceSpaceType();
 
+    // Reuse the result of a previous search for the same configs and built-in color space.
+    const std::string cacheKey = getHeuristicsCacheKey(srcConfig, builtinConfig, builtinColorSpaceName);
+
+    std::string cachedName;
+    if (getCachedResult(g_builtinColorSpaceCache, cacheKey, cachedName))
+    {
+        ConstColorSpaceRcPtr cs = cachedName.empty() ? ConstColorSpaceRcPtr()
+                                                     : srcConfig->getColorSpace(cachedName.c_str());
+        if (cs)
+        {
+            return cs->getName();
+        }
+
+        std::ostringstream os;
+        os  << "Heuristics were not able to find an equivalent to the requested color space: "
+            << builtinColorSpaceName << ".";
+        throw Exception(os.str().c_str());
+    }
+
     // Identify interchange spaces.  Passing an empty string for the source color space
     // means that only the builtinColorSpace will be used to determine the reference
     // space type of the interchange role.  Will throw if the space cannot be found.
@@ -792,6 +1023,10 @@ const char * IdentifyBuiltinColorSpace(const ConstConfigRcPtr & srcConfig,
 
     if (*builtinInterchangeName)
     {
+        // The built-in side of the conversion does not depend on the source color space
+        // so it is only built once, for the first color space to test.
+        std::vector<ConstCPUProcessorRcPtr> builtinSide;
+
         std::vector<float> vals = { 0.7f,  0.4f,  0.02f, 0.f,
                                     0.02f, 0.6f,  0.2f,  0.f,
                                     0.3f,  0.02f, 0.5f,  0.f,
@@ -817,25 +1052,42 @@ const char * IdentifyBuiltinColorSpace(const ConstConfigRcPtr & srcConfig,
                 continue;
             }
 
-            ConstProcessorRcPtr proc = Config::GetProcessorFromConfigs(srcConfig,
-                                                                       cs->getName(),
-                                                                       srcInterchangeName,
-                                                                       builtinConfig,
-                                                                       builtinColorSpaceName,
-                                                                       builtinInterchangeName);
-            if (isIdentityTransform(proc, vals, 1e-3f))
+            ConstCPUProcessorRcPtr srcSide 
+                = getCPUProcessor(srcConfig, true, cs->getName(), srcInterchangeName);
+
+            if (builtinSide.empty())
+            {
+                builtinSide.push_back(getCPUProcessor(builtinConfig, 
+                                                      false, 
+                                                      builtinColorSpaceName, 
+                                                      builtinInterchangeName));
+            }
+
+            if (findIdentityCandidate(srcSide,
+                                      builtinSide,
+                                      vals,
+                                      1e-3f) == 0)
             {
+                setCachedResult(g_builtinColorSpaceCache, cacheKey, std::string(cs->getName()));
                 return cs->getName();
             }
         }
     }
 
+    setCachedResult(g_builtinColorSpaceCache, cacheKey, std::string());
+
     std::ostringstream os;
     os  << "Heuristics were not able to find an equivalent to the requested color space: "
         << builtinColorSpaceName << ".";
     throw Exception(os.str().c_str());
 }
 
+void ClearHeuristicsCaches()
+{
+    g_interchangeSpaceCache.clear();
+    g_builtinColorSpaceCache.clear();
+}
+
 }  // namespace ConfigUtils
 
 }  // namespace OCIO_NAMESPACE
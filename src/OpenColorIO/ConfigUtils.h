@@ -31,6 +31,9 @@ const char * IdentifyBuiltinColorSpace(const ConstConfigRcPtr & srcConfig,
                                        const ConstConfigRcPtr & builtinConfig, 
                                        const char * builtinColorSpaceName);
 
+// Clear the memoized results of the heuristics used by the functions above.
+void ClearHeuristicsCaches();
+
 // Temporarily deactivate the Processor cache on a Config object.
 // Currently, this also clears the cache.
 //
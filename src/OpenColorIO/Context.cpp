@@ -50,6 +50,10 @@ public:
     mutable ResolvedStringCache m_resultsStringCache;
     // Cache for resolved & expanded file paths containing context variables.
     mutable ResolvedStringCache m_resultsFilepathCache;
+    // Compiled strings containing context variables. They only depend on the names of the
+    // context variables so they survive changes of the values.
+    using TemplateCache = std::map<std::string, ConstContextVariableTemplateRcPtr>;
+    mutable TemplateCache m_templateCache;
     mutable Mutex m_resultsCacheMutex;
 
     ConfigIOProxyRcPtr m_configIOProxy;
@@ -71,6 +75,7 @@ public:
 
             m_resultsStringCache   = rhs.m_resultsStringCache;
             m_resultsFilepathCache = rhs.m_resultsFilepathCache;
+            m_templateCache        = rhs.m_templateCache;
 
             m_cacheID = rhs.m_cacheID;
 
@@ -104,7 +109,8 @@ public:
 
         // Search some context variables to replace.
         UsedEnvs envs;
-        const std::string resolvedString = ResolveContextVariables(string, m_envMap, envs);
+        const std::string resolvedString
+            = ResolveContextVariables(*getTemplate(string), string, m_envMap, envs);
         m_resultsStringCache[string] = std::make_pair(resolvedString, envs);
 
         if (usedContextVars)
@@ -120,12 +126,33 @@ public:
         return m_resultsStringCache[string].first.c_str();
     }
 
+    // Get the compiled version of a string containing context variables.
+    ConstContextVariableTemplateRcPtr getTemplate(const std::string & string) const
+    {
+        TemplateCache::const_iterator iter = m_templateCache.find(string);
+        if (iter != m_templateCache.end())
+        {
+            return iter->second;
+        }
+
+        auto tmpl = std::make_shared<ContextVariableTemplate>(string, m_envMap);
+        m_templateCache[string] = tmpl;
+        return tmpl;
+    }
+
     void clearCaches()
     {
         m_resultsStringCache.clear();
         m_resultsFilepathCache.clear();
         m_cacheID.clear();     
     }
+
+    // The compiled strings must be flushed when a context variable is added or removed.
+    void clearAllCaches()
+    {
+        clearCaches();
+        m_templateCache.clear();
+    }
 };
 
 ///////////////////////////////////////////////////////////////////////////
@@ -282,7 +309,7 @@ void Context::loadEnvironment() noexcept
     LoadEnvironment(getImpl()->m_envMap, update);
 
     AutoMutex lock(getImpl()->m_resultsCacheMutex);
-    getImpl()->clearCaches();
+    getImpl()->clearAllCaches();
 }
 
 void Context::setStringVar(const char * name, const char * value) noexcept
@@ -313,6 +340,7 @@ void Context::setStringVar(const char * name, const char * value) noexcept
         else
         {
             getImpl()->m_envMap[name] = value;
+            getImpl()->m_templateCache.clear();
         }
     }
     // If a null value is specified, erase it.
@@ -322,6 +350,7 @@ void Context::setStringVar(const char * name, const char * value) noexcept
         if (iter != getImpl()->m_envMap.end())
         {
             getImpl()->m_envMap.erase(iter);
+            getImpl()->m_templateCache.clear();
         }
     }
 
@@ -381,7 +410,10 @@ void Context::addStringVars(const ConstContextRcPtr & ctx) noexcept
 
 void Context::clearStringVars()
 {
+    AutoMutex lock(getImpl()->m_resultsCacheMutex);
+
     getImpl()->m_envMap.clear();
+    getImpl()->clearAllCaches();
 }
 
 const char * Context::resolveStringVar(const char * string) const  noexcept
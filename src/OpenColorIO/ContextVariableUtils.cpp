@@ -2,6 +2,8 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 
+#include <algorithm>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "ContextVariableUtils.h"
@@ -165,6 +167,168 @@ std::string ResolveContextVariables(const std::string & str, const EnvMap & map,
     return orig;
 }
 
+namespace
+{
+
+// True if the end of the literal is the beginning of the pattern i.e. the pattern could match
+// across the literal and the value of the following variable.
+bool EndsWithPartialMatch(const std::string & literal, const std::string & pattern)
+{
+    const size_t start = literal.size() >= pattern.size() ? literal.size() - pattern.size() + 1 : 0;
+    for (size_t pos = literal.find(pattern[0], start); pos != std::string::npos;
+         pos = literal.find(pattern[0], pos + 1))
+    {
+        if (0 == literal.compare(pos, std::string::npos, pattern, 0, literal.size() - pos))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // anon.
+
+ContextVariableTemplate::ContextVariableTemplate(const std::string & str, const EnvMap & map)
+{
+    m_segments.push_back(Segment{ str, -1 });
+
+    if (!ContainsContextVariables(str))
+    {
+        return;
+    }
+
+    // Replay the expansion order of ResolveContextVariables() (i.e. variables from the longest
+    // to the shortest name) on the literal segments only. That gives the same result as long as
+    // no pattern could match across a literal and a variable value, and the resulting literals
+    // do not contain reserved tokens anymore (i.e. no recursive expansion is needed).
+
+    for (const auto & entry : map)
+    {
+        const std::string patterns[3] = { "${" + entry.first + "}",
+                                          "$" + entry.first,
+                                          "%" + entry.first + "%" };
+
+        for (const auto & pattern : patterns)
+        {
+            std::vector<Segment> segments;
+            segments.reserve(m_segments.size());
+
+            for (size_t idx = 0; idx < m_segments.size(); ++idx)
+            {
+                const Segment & segment = m_segments[idx];
+                if (segment.m_varIndex != -1)
+                {
+                    segments.push_back(segment);
+                    continue;
+                }
+
+                const std::string & literal = segment.m_literal;
+
+                if (idx + 1 < m_segments.size() && EndsWithPartialMatch(literal, pattern))
+                {
+                    m_compiled = false;
+                    return;
+                }
+
+                size_t start = 0;
+                for (size_t pos = literal.find(pattern); pos != std::string::npos;
+                     pos = literal.find(pattern, start))
+                {
+                    if (pos != start)
+                    {
+                        segments.push_back(Segment{ literal.substr(start, pos - start), -1 });
+                    }
+
+                    const auto it = std::find(m_varNames.begin(), m_varNames.end(), entry.first);
+                    const int varIndex = static_cast<int>(it - m_varNames.begin());
+                    if (it == m_varNames.end())
+                    {
+                        m_varNames.push_back(entry.first);
+                    }
+                    segments.push_back(Segment{ "", varIndex });
+
+                    start = pos + pattern.size();
+                }
+
+                if (start == 0)
+                {
+                    segments.push_back(segment);
+                }
+                else if (start < literal.size())
+                {
+                    segments.push_back(Segment{ literal.substr(start), -1 });
+                }
+            }
+
+            m_segments.swap(segments);
+        }
+    }
+
+    for (const auto & segment : m_segments)
+    {
+        if (segment.m_varIndex == -1 && ContainsContextVariableToken(segment.m_literal))
+        {
+            m_compiled = false;
+            return;
+        }
+    }
+}
+
+bool ContextVariableTemplate::resolve(const EnvMap & map, std::string & result, UsedEnvs & envs) const
+{
+    if (!m_compiled)
+    {
+        return false;
+    }
+
+    // Look up each variable only once.
+    std::vector<const std::string *> values(m_varNames.size(), nullptr);
+    for (size_t idx = 0; idx < m_varNames.size(); ++idx)
+    {
+        EnvMap::const_iterator iter = map.find(m_varNames[idx]);
+        if (iter == map.end() || ContainsContextVariableToken(iter->second))
+        {
+            return false;
+        }
+        values[idx] = &iter->second;
+    }
+
+    size_t length = 0;
+    for (const auto & segment : m_segments)
+    {
+        length += segment.m_varIndex == -1 ? segment.m_literal.size()
+                                           : values[segment.m_varIndex]->size();
+    }
+
+    result.clear();
+    result.reserve(length);
+    for (const auto & segment : m_segments)
+    {
+        result += segment.m_varIndex == -1 ? segment.m_literal : *values[segment.m_varIndex];
+    }
+
+    for (size_t idx = 0; idx < m_varNames.size(); ++idx)
+    {
+        envs[m_varNames[idx]] = *values[idx];
+    }
+
+    return true;
+}
+
+std::string ResolveContextVariables(const ContextVariableTemplate & tmpl,
+                                    const std::string & str,
+                                    const EnvMap & map,
+                                    UsedEnvs & envs)
+{
+    std::string result;
+    if (tmpl.resolve(map, result, envs))
+    {
+        return result;
+    }
+
+    return ResolveContextVariables(str, map, envs);
+}
+
 bool CollectContextVariables(const Config & config, 
                              const Context & context,
                              ConstTransformRcPtr transform,
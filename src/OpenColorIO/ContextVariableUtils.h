@@ -8,7 +8,9 @@
 
 #include <functional>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <OpenColorIO/OpenColorIO.h>
 
@@ -53,6 +55,50 @@ typedef std::map<std::string, std::string> UsedEnvs;
 // TODO: Keep the resolution order?
 std::string ResolveContextVariables(const std::string & str, const EnvMap & map, UsedEnvs & envs);
 
+// A string containing context variables (e.g. a file path or a CCC id) compiled once against the
+// names of the context variables, as a list of literal segments and variable slots. Each
+// variable name is only stored once so resolving the string with new values only requires one
+// lookup per variable and a concatenation, without parsing the string again. The template
+// stays valid as long as the names of the context variables do not change.
+class ContextVariableTemplate
+{
+public:
+    ContextVariableTemplate(const std::string & str, const EnvMap & map);
+
+    // Resolve the string using the values from the map, and add the used variables to envs.
+    // Return false (and leave envs unchanged) if the string must be resolved with
+    // ResolveContextVariables() i.e. recursive or ambiguous expansions, or variable names that
+    // are no longer in the map.
+    bool resolve(const EnvMap & map, std::string & result, UsedEnvs & envs) const;
+
+    // The (unique) names of the context variables used by the string.
+    const std::vector<std::string> & getVariableNames() const noexcept { return m_varNames; }
+
+    // False when the string always needs ResolveContextVariables() to be resolved.
+    bool isCompiled() const noexcept { return m_compiled; }
+
+private:
+    struct Segment
+    {
+        std::string m_literal;
+        // Index in m_varNames, or -1 for a literal segment.
+        int m_varIndex = -1;
+    };
+
+    std::vector<Segment> m_segments;
+    std::vector<std::string> m_varNames;
+    bool m_compiled = true;
+};
+
+typedef std::shared_ptr<const ContextVariableTemplate> ConstContextVariableTemplateRcPtr;
+
+// Resolve a string with its compiled template, falling back to ResolveContextVariables() when
+// the template cannot resolve it.
+std::string ResolveContextVariables(const ContextVariableTemplate & tmpl,
+                                    const std::string & str,
+                                    const EnvMap & map,
+                                    UsedEnvs & envs);
+
 
 // Return true if an instance of a transform uses a context variable, either directly or indirectly. 
 // Add any context variables that are used to usedContextVars.
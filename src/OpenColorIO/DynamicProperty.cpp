@@ -135,6 +135,7 @@ DynamicPropertyGradingPrimaryImpl::DynamicPropertyGradingPrimaryImpl(GradingStyl
     , m_value(value)
 {
     m_preRenderValues.update(m_style, m_direction, m_value);
+    publish();
 }
 
 DynamicPropertyGradingPrimaryImpl::DynamicPropertyGradingPrimaryImpl(GradingStyle style,
@@ -148,10 +149,12 @@ DynamicPropertyGradingPrimaryImpl::DynamicPropertyGradingPrimaryImpl(GradingStyl
     , m_value(value)
     , m_preRenderValues(comp)
 {
+    publish();
 }
 
 DynamicPropertyGradingPrimaryImplRcPtr DynamicPropertyGradingPrimaryImpl::createEditableCopy() const
 {
+    AutoMutex guard(m_mutex);
     return std::make_shared<DynamicPropertyGradingPrimaryImpl>(m_style,
                                                                m_direction,
                                                                m_value,
@@ -161,28 +164,39 @@ DynamicPropertyGradingPrimaryImplRcPtr DynamicPropertyGradingPrimaryImpl::create
 
 void DynamicPropertyGradingPrimaryImpl::setValue(const GradingPrimary & value)
 {
+    AutoMutex guard(m_mutex);
     value.validate(m_style);
     m_value = value;
     m_preRenderValues.update(m_style, m_direction, m_value);
+    publish();
 }
 
 void DynamicPropertyGradingPrimaryImpl::setStyle(GradingStyle style)
 {
+    AutoMutex guard(m_mutex);
     m_style = style;
     // Reset values to style defaults.
     m_value = GradingPrimary(m_style);
     m_preRenderValues.update(m_style, m_direction, m_value);
+    publish();
 }
 
-void DynamicPropertyGradingPrimaryImpl::setDirection(TransformDirection dir) noexcept
+void DynamicPropertyGradingPrimaryImpl::setDirection(TransformDirection dir)
 {
+    AutoMutex guard(m_mutex);
     if (m_direction != dir)
     {
         m_direction = dir;
         m_preRenderValues.update(m_style, m_direction, m_value);
+        publish();
     }
 }
 
+void DynamicPropertyGradingPrimaryImpl::publish()
+{
+    m_snapshots.publish(std::make_shared<const Snapshot>(m_value, m_preRenderValues));
+}
+
 DynamicPropertyGradingRGBCurveImpl::DynamicPropertyGradingRGBCurveImpl(
     const ConstGradingRGBCurveRcPtr & value, bool dynamic)
     : DynamicPropertyImpl(DYNAMIC_PROPERTY_GRADING_RGBCURVE, dynamic)
@@ -201,6 +215,7 @@ void DynamicPropertyGradingRGBCurveImpl::setValue(const ConstGradingRGBCurveRcPt
 {
     value->validate();
 
+    AutoMutex guard(m_mutex);
     m_gradingRGBCurve = value->createEditableCopy();
     // Convert control points from the UI into knots and coefficients for the apply.
     precompute();
@@ -251,28 +266,103 @@ unsigned int DynamicPropertyGradingRGBCurveImpl::GetMaxCoefs()
     return GradingBSplineCurveImpl::KnotsCoefs::MAX_NUM_COEFS;
 }
 
+namespace
+{
+// The fit of a curve depends on its control points and on its slopes.
+bool IsSameFit(const GradingBSplineCurve & lhs, const GradingBSplineCurve & rhs)
+{
+    if (lhs != rhs)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.getNumControlPoints(); ++i)
+    {
+        if (lhs.getSlope(i) != rhs.getSlope(i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+} // anonymous namespace
+
 void DynamicPropertyGradingRGBCurveImpl::precompute()
 {
+    // Compute knots and coefficients for each curve. Interactive edits usually change one curve
+    // at a time, so only the curves that changed since the previous computation are fit again.
+    for (const auto c : { RGB_RED, RGB_GREEN, RGB_BLUE, RGB_MASTER })
+    {
+        ConstGradingBSplineCurveRcPtr curve = m_gradingRGBCurve->getCurve(c);
+        if (!m_fitCurves[c] || !IsSameFit(*m_fitCurves[c], *curve))
+        {
+            auto & curveKnotsCoefs = m_curveKnotsCoefs[c];
+            curveKnotsCoefs.m_knotsArray.resize(0);
+            curveKnotsCoefs.m_coefsArray.resize(0);
+
+            auto curveImpl = dynamic_cast<const GradingBSplineCurveImpl *>(curve.get());
+            curveImpl->computeKnotsAndCoefs(curveKnotsCoefs, 0);
+            m_fitCurves[c] = curve;
+        }
+    }
+
+    // Pack all knots and coefs of all curves in one knots array and one coef array, using an
+    // offset array to find specific curve data.
     m_knotsCoefs.m_localBypass = false;
     m_knotsCoefs.m_knotsArray.resize(0);
     m_knotsCoefs.m_coefsArray.resize(0);
 
-    // Compute knots and coefficients for each control point and pack all knots and coefs of
-    // all curves in one knots array and one coef array, using an offset array to find specific
-    // curve data.
     for (const auto c : { RGB_RED, RGB_GREEN, RGB_BLUE, RGB_MASTER })
     {
-        ConstGradingBSplineCurveRcPtr curve = m_gradingRGBCurve->getCurve(c);
-        auto curveImpl = dynamic_cast<const GradingBSplineCurveImpl *>(curve.get());
-        curveImpl->computeKnotsAndCoefs(m_knotsCoefs, static_cast<int>(c));
+        const auto & curveKnotsCoefs = m_curveKnotsCoefs[c];
+        if (curveKnotsCoefs.m_knotsOffsetsArray[0] == -1)
+        {
+            // Identity curve: offset is -1 and count is 0.
+            m_knotsCoefs.m_knotsOffsetsArray[c * 2] = -1;
+            m_knotsCoefs.m_knotsOffsetsArray[c * 2 + 1] = 0;
+            m_knotsCoefs.m_coefsOffsetsArray[c * 2] = -1;
+            m_knotsCoefs.m_coefsOffsetsArray[c * 2 + 1] = 0;
+            continue;
+        }
+
+        const int numKnots = static_cast<int>(m_knotsCoefs.m_knotsArray.size());
+        const int newKnots = static_cast<int>(curveKnotsCoefs.m_knotsArray.size());
+        const int numCoefs = static_cast<int>(m_knotsCoefs.m_coefsArray.size());
+        const int newCoefs = static_cast<int>(curveKnotsCoefs.m_coefsArray.size());
+
+        if (numKnots + newKnots > GradingBSplineCurveImpl::KnotsCoefs::MAX_NUM_KNOTS ||
+            numCoefs + newCoefs > GradingBSplineCurveImpl::KnotsCoefs::MAX_NUM_COEFS)
+        {
+            throw Exception("RGB curve: maximum number of control points reached.");
+        }
+
+        m_knotsCoefs.m_knotsOffsetsArray[c * 2] = numKnots;
+        m_knotsCoefs.m_knotsOffsetsArray[c * 2 + 1] = newKnots;
+        m_knotsCoefs.m_coefsOffsetsArray[c * 2] = numCoefs;
+        m_knotsCoefs.m_coefsOffsetsArray[c * 2 + 1] = newCoefs;
+
+        m_knotsCoefs.m_knotsArray.insert(m_knotsCoefs.m_knotsArray.end(),
+                                         curveKnotsCoefs.m_knotsArray.begin(),
+                                         curveKnotsCoefs.m_knotsArray.end());
+        m_knotsCoefs.m_coefsArray.insert(m_knotsCoefs.m_coefsArray.end(),
+                                         curveKnotsCoefs.m_coefsArray.begin(),
+                                         curveKnotsCoefs.m_coefsArray.end());
     }
     if (m_knotsCoefs.m_knotsArray.empty()) m_knotsCoefs.m_localBypass = true;
+
+    publish();
+}
+
+void DynamicPropertyGradingRGBCurveImpl::publish()
+{
+    m_snapshots.publish(std::make_shared<const GradingBSplineCurveImpl::KnotsCoefs>(m_knotsCoefs));
 }
 
 DynamicPropertyGradingRGBCurveImplRcPtr DynamicPropertyGradingRGBCurveImpl::createEditableCopy() const
 {
+    AutoMutex guard(m_mutex);
     auto res = std::make_shared<DynamicPropertyGradingRGBCurveImpl>(getValue(), isDynamic());
     res->m_knotsCoefs = m_knotsCoefs;
+    res->publish();
     return res;
 }
 
@@ -284,6 +374,7 @@ DynamicPropertyGradingToneImpl::DynamicPropertyGradingToneImpl(const GradingTone
     , m_preRenderValues(style)
 {
     m_preRenderValues.update(m_value);
+    publish();
 }
 
 DynamicPropertyGradingToneImpl::DynamicPropertyGradingToneImpl(const GradingTone & value,
@@ -293,10 +384,12 @@ DynamicPropertyGradingToneImpl::DynamicPropertyGradingToneImpl(const GradingTone
     , m_value(value)
     , m_preRenderValues(comp)
 {
+    publish();
 }
 
 DynamicPropertyGradingToneImplRcPtr DynamicPropertyGradingToneImpl::createEditableCopy() const
 {
+    AutoMutex guard(m_mutex);
     return std::make_shared<DynamicPropertyGradingToneImpl>(m_value, m_preRenderValues, isDynamic());
 }
 
@@ -304,16 +397,171 @@ void DynamicPropertyGradingToneImpl::setValue(const GradingTone & value)
 {
     value.validate();
 
+    AutoMutex guard(m_mutex);
     m_value = value;
     m_preRenderValues.update(m_value);
+    publish();
 }
 
 void DynamicPropertyGradingToneImpl::setStyle(GradingStyle style)
 {
+    AutoMutex guard(m_mutex);
     // Reset values to style defaults.
     m_value = GradingTone(style);
     m_preRenderValues.setStyle(style);
     m_preRenderValues.update(m_value);
+    publish();
+}
+
+void DynamicPropertyGradingToneImpl::publish()
+{
+    m_snapshots.publish(std::make_shared<const Snapshot>(m_value, m_preRenderValues));
+}
+
+namespace
+{
+bool IsDoubleProperty(DynamicPropertyType type) noexcept
+{
+    return type == DYNAMIC_PROPERTY_EXPOSURE
+        || type == DYNAMIC_PROPERTY_CONTRAST
+        || type == DYNAMIC_PROPERTY_GAMMA;
+}
+
+constexpr int NumDynamicPropertyTypes = DYNAMIC_PROPERTY_GRADING_TONE + 1;
+} // anonymous namespace
+
+class DynamicPropertyOverrides::Impl
+{
+public:
+    Impl() = default;
+    Impl(const Impl &) = default;
+    Impl & operator=(const Impl &) = default;
+    ~Impl() = default;
+
+    void checkValue(DynamicPropertyType type) const
+    {
+        if (!m_hasValue[type])
+        {
+            throw Exception("Dynamic property override value is not set.");
+        }
+    }
+
+    bool m_hasValue[NumDynamicPropertyTypes]{};
+
+    double m_doubles[DYNAMIC_PROPERTY_GAMMA + 1]{ 0., 1., 1. };
+    GradingPrimary m_primary{ GRADING_LOG };
+    ConstGradingRGBCurveRcPtr m_rgbCurve;
+    GradingTone m_tone{ GRADING_LOG };
+};
+
+DynamicPropertyOverridesRcPtr DynamicPropertyOverrides::Create()
+{
+    return DynamicPropertyOverridesRcPtr(new DynamicPropertyOverrides(), &deleter);
+}
+
+void DynamicPropertyOverrides::deleter(DynamicPropertyOverrides * c)
+{
+    delete c;
+}
+
+DynamicPropertyOverrides::DynamicPropertyOverrides()
+    : m_impl(new DynamicPropertyOverrides::Impl)
+{
+}
+
+DynamicPropertyOverrides::~DynamicPropertyOverrides()
+{
+    delete m_impl;
+    m_impl = nullptr;
+}
+
+DynamicPropertyOverridesRcPtr DynamicPropertyOverrides::createEditableCopy() const
+{
+    DynamicPropertyOverridesRcPtr values = DynamicPropertyOverrides::Create();
+    *values->m_impl = *m_impl;
+    return values;
+}
+
+bool DynamicPropertyOverrides::hasValue(DynamicPropertyType type) const noexcept
+{
+    return type >= 0 && type < NumDynamicPropertyTypes && getImpl()->m_hasValue[type];
+}
+
+void DynamicPropertyOverrides::removeValue(DynamicPropertyType type) noexcept
+{
+    if (type >= 0 && type < NumDynamicPropertyTypes)
+    {
+        getImpl()->m_hasValue[type] = false;
+    }
+    if (type == DYNAMIC_PROPERTY_GRADING_RGBCURVE)
+    {
+        getImpl()->m_rgbCurve.reset();
+    }
+}
+
+void DynamicPropertyOverrides::clear() noexcept
+{
+    *m_impl = Impl();
+}
+
+void DynamicPropertyOverrides::setDouble(DynamicPropertyType type, double value)
+{
+    if (!IsDoubleProperty(type))
+    {
+        throw Exception("Dynamic property override value is not a double.");
+    }
+    getImpl()->m_doubles[type] = value;
+    getImpl()->m_hasValue[type] = true;
+}
+
+double DynamicPropertyOverrides::getDouble(DynamicPropertyType type) const
+{
+    if (!IsDoubleProperty(type))
+    {
+        throw Exception("Dynamic property override value is not a double.");
+    }
+    getImpl()->checkValue(type);
+    return getImpl()->m_doubles[type];
+}
+
+void DynamicPropertyOverrides::setGradingPrimary(const GradingPrimary & value)
+{
+    getImpl()->m_primary = value;
+    getImpl()->m_hasValue[DYNAMIC_PROPERTY_GRADING_PRIMARY] = true;
+}
+
+const GradingPrimary & DynamicPropertyOverrides::getGradingPrimary() const
+{
+    getImpl()->checkValue(DYNAMIC_PROPERTY_GRADING_PRIMARY);
+    return getImpl()->m_primary;
+}
+
+void DynamicPropertyOverrides::setGradingRGBCurve(const ConstGradingRGBCurveRcPtr & value)
+{
+    if (!value)
+    {
+        throw Exception("Dynamic property override value is a null grading RGB curve.");
+    }
+    getImpl()->m_rgbCurve = value;
+    getImpl()->m_hasValue[DYNAMIC_PROPERTY_GRADING_RGBCURVE] = true;
+}
+
+const ConstGradingRGBCurveRcPtr & DynamicPropertyOverrides::getGradingRGBCurve() const
+{
+    getImpl()->checkValue(DYNAMIC_PROPERTY_GRADING_RGBCURVE);
+    return getImpl()->m_rgbCurve;
+}
+
+void DynamicPropertyOverrides::setGradingTone(const GradingTone & value)
+{
+    getImpl()->m_tone = value;
+    getImpl()->m_hasValue[DYNAMIC_PROPERTY_GRADING_TONE] = true;
+}
+
+const GradingTone & DynamicPropertyOverrides::getGradingTone() const
+{
+    getImpl()->checkValue(DYNAMIC_PROPERTY_GRADING_TONE);
+    return getImpl()->m_tone;
 }
 
 } // namespace OCIO_NAMESPACE
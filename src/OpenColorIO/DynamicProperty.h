@@ -4,8 +4,13 @@
 #ifndef INCLUDED_OCIO_DYNAMICPROPERTY_H
 #define INCLUDED_OCIO_DYNAMICPROPERTY_H
 
+#include <atomic>
+#include <memory>
+#include <thread>
+
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Mutex.h"
 #include "ops/gradingprimary/GradingPrimary.h"
 #include "ops/gradingrgbcurve/GradingBSplineCurve.h"
 #include "ops/gradingtone/GradingTone.h"
@@ -13,6 +18,65 @@
 namespace OCIO_NAMESPACE
 {
 
+// The CPU renderers read the values of a dynamic property while another thread (e.g. a UI) may
+// change them. So, each change publishes a new immutable snapshot of the values, and an apply call
+// reads one snapshot at its start and uses it for all the pixels.
+//
+// The snapshots are double buffered. Reading is lock-free: a reader only retries when a publish
+// happens at the same time. A publish waits for the readers still copying the snapshot pointer it
+// replaces, and the publishing threads are serialized.
+template<typename T>
+class SnapshotBuffer
+{
+public:
+    using ConstSnapshotRcPtr = std::shared_ptr<const T>;
+
+    SnapshotBuffer() = default;
+    SnapshotBuffer(const SnapshotBuffer &) = delete;
+    SnapshotBuffer & operator=(const SnapshotBuffer &) = delete;
+
+    ConstSnapshotRcPtr get() const noexcept
+    {
+        for (;;)
+        {
+            const unsigned version = m_version.load();
+            const unsigned slot = version & 1u;
+
+            ++m_numReaders[slot];
+            if (m_version.load() == version)
+            {
+                ConstSnapshotRcPtr snapshot = m_slots[slot];
+                --m_numReaders[slot];
+                return snapshot;
+            }
+            --m_numReaders[slot];
+        }
+    }
+
+    void publish(ConstSnapshotRcPtr snapshot)
+    {
+        AutoMutex guard(m_publishMutex);
+
+        const unsigned version = m_version.load();
+        const unsigned slot = (version + 1) & 1u;
+
+        // The slot holds the snapshot before the current one.
+        while (m_numReaders[slot].load() != 0)
+        {
+            std::this_thread::yield();
+        }
+
+        m_slots[slot].swap(snapshot);
+        m_version.store(version + 1);
+    }
+
+private:
+    ConstSnapshotRcPtr m_slots[2];
+    std::atomic<unsigned> m_version{ 0 };
+    mutable std::atomic<int> m_numReaders[2]{ {0}, {0} };
+    Mutex m_publishMutex;
+};
+
 class DynamicPropertyImpl;
 typedef OCIO_SHARED_PTR<DynamicPropertyImpl> DynamicPropertyImplRcPtr;
 
@@ -75,13 +139,14 @@ public:
     DynamicPropertyDoubleImpl() = delete;
     DynamicPropertyDoubleImpl(DynamicPropertyType type, double val, bool dynamic);
     ~DynamicPropertyDoubleImpl() = default;
-    double getValue() const override { return m_value; }
-    void setValue(double value) override { m_value = value; }
+    // The value is atomic so, the renderers never read a partially written value.
+    double getValue() const override { return m_value.load(); }
+    void setValue(double value) override { m_value.store(value); }
 
     DynamicPropertyDoubleImplRcPtr createEditableCopy() const;
 
 private:
-    double m_value;
+    std::atomic<double> m_value;
 };
 
 class DynamicPropertyGradingPrimaryImpl;
@@ -108,7 +173,7 @@ public:
     void setValue(const GradingPrimary & value) override;
 
     void setStyle(GradingStyle style);
-    void setDirection(TransformDirection dir) noexcept;
+    void setDirection(TransformDirection dir);
     TransformDirection getDirection() const noexcept { return m_direction; }
     const GradingPrimaryPreRender & getComputedValue() const { return m_preRenderValues; }
 
@@ -127,11 +192,32 @@ public:
 
     DynamicPropertyGradingPrimaryImplRcPtr createEditableCopy() const;
 
+    // The values used by the CPU renderers (see SnapshotBuffer).
+    struct Snapshot
+    {
+        Snapshot(const GradingPrimary & value, const GradingPrimaryPreRender & computed)
+            : m_value(value)
+            , m_computed(computed)
+        {
+        }
+
+        GradingPrimary m_value;
+        GradingPrimaryPreRender m_computed;
+    };
+    std::shared_ptr<const Snapshot> getSnapshot() const noexcept { return m_snapshots.get(); }
+
 private:
+    void publish();
+
     GradingStyle m_style{ GRADING_LOG };
     TransformDirection m_direction{ TRANSFORM_DIR_FORWARD };
     GradingPrimary m_value;
     GradingPrimaryPreRender m_preRenderValues;
+
+    SnapshotBuffer<Snapshot> m_snapshots;
+    // Serializes the setters so that each snapshot is built from the values of a single change.
+    mutable Mutex m_mutex;
+
 };
 
 
@@ -164,13 +250,31 @@ public:
 
     DynamicPropertyGradingRGBCurveImplRcPtr createEditableCopy() const;
 
+    // The knots & coefficients used by the CPU renderers (see SnapshotBuffer).
+    std::shared_ptr<const GradingBSplineCurveImpl::KnotsCoefs> getSnapshot() const noexcept
+    {
+        return m_snapshots.get();
+    }
+
 private:
     void precompute();
+    void publish();
 
     ConstGradingRGBCurveRcPtr m_gradingRGBCurve;
 
     // Holds curve data as knots and coefs. There are 4 curves.
     GradingBSplineCurveImpl::KnotsCoefs m_knotsCoefs{ 4 };
+
+    // The curves that were last fit and their knots & coefs, so that precompute() only fits
+    // again the curves that changed.
+    ConstGradingBSplineCurveRcPtr m_fitCurves[4];
+    std::vector<GradingBSplineCurveImpl::KnotsCoefs> m_curveKnotsCoefs
+        = std::vector<GradingBSplineCurveImpl::KnotsCoefs>(4, GradingBSplineCurveImpl::KnotsCoefs(1));
+
+    SnapshotBuffer<GradingBSplineCurveImpl::KnotsCoefs> m_snapshots;
+    // Serializes the setters so that each snapshot is built from the values of a single change.
+    mutable Mutex m_mutex;
+
 };
 
 class DynamicPropertyGradingToneImpl;
@@ -198,10 +302,30 @@ public:
 
     DynamicPropertyGradingToneImplRcPtr createEditableCopy() const;
 
+    // The values used by the CPU renderers (see SnapshotBuffer).
+    struct Snapshot
+    {
+        Snapshot(const GradingTone & value, const GradingTonePreRender & computed)
+            : m_value(value)
+            , m_computed(computed)
+        {
+        }
+
+        GradingTone m_value;
+        GradingTonePreRender m_computed;
+    };
+    std::shared_ptr<const Snapshot> getSnapshot() const noexcept { return m_snapshots.get(); }
+
 private:
+    void publish();
 
     GradingTone m_value;
     GradingTonePreRender m_preRenderValues;
+
+    SnapshotBuffer<Snapshot> m_snapshots;
+    // Serializes the setters so that each snapshot is built from the values of a single change.
+    mutable Mutex m_mutex;
+
 };
 
 } // namespace OCIO_NAMESPACE
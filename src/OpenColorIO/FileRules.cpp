@@ -5,6 +5,7 @@
 #include <cctype>
 #include <cstring>
 #include <map>
+#include <memory>
 #include <regex>
 #include <sstream>
 
@@ -260,7 +261,10 @@ std::string BuildRegularExpression(const char * filePathPattern, const char * fi
     return res;
 }
 
-void ValidateRegularExpression(const char * regex)
+using ConstRegexRcPtr = std::shared_ptr<const std::regex>;
+
+// Validate & compile the regular expression.
+ConstRegexRcPtr CompileRegularExpression(const char * regex)
 {
     if (!regex || !*regex)
     {
@@ -270,7 +274,7 @@ void ValidateRegularExpression(const char * regex)
     try
     {
         // Throws an exception if the expression is ill-formed.
-        const std::regex reg(regex);
+        return std::make_shared<const std::regex>(regex);
     }
     catch (std::regex_error & ex)
     {
@@ -284,10 +288,61 @@ void ValidateRegularExpression(const char * regex)
     }
 }
 
-void ValidateRegularExpression(const char * filePathPattern, const char * fileNameExtension)
+ConstRegexRcPtr CompileRegularExpression(const char * filePathPattern,
+                                         const char * fileNameExtension)
 {
     const std::string exp = BuildRegularExpression(filePathPattern, fileNameExtension);
-    ValidateRegularExpression(exp.c_str());
+    return CompileRegularExpression(exp.c_str());
+}
+
+bool IsWildcardOnly(const std::string & globPattern)
+{
+    return globPattern.find_first_not_of('*') == std::string::npos;
+}
+
+// True if the glob pattern is a literal file extension (e.g. 'exr' or 'tar.gz') which is then
+// matched case insensitively.
+bool IsLiteralExtension(const std::string & globPattern)
+{
+    if (globPattern.empty())
+    {
+        return false;
+    }
+
+    for (const char c : globPattern)
+    {
+        if (!isalnum(static_cast<unsigned char>(c)) && c != '.' && c != '_' && c != '-')
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool HasLineTerminator(const char * path)
+{
+    // The regular expression '.' does not match line terminators.
+    return strpbrk(path, "\n\r") != nullptr;
+}
+
+bool EndsWithNoCase(const char * str, const std::string & lowerSuffix)
+{
+    const size_t length = strlen(str);
+    if (length < lowerSuffix.size())
+    {
+        return false;
+    }
+
+    const char * end = str + length - lowerSuffix.size();
+    for (size_t idx = 0; idx < lowerSuffix.size(); ++idx)
+    {
+        if (StringUtils::Lower(static_cast<unsigned char>(end[idx])) !=
+                static_cast<unsigned char>(lowerSuffix[idx]))
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 }
@@ -329,6 +384,7 @@ public:
             m_pattern   = "*";
             m_extension = "*";
             m_type      = FILE_RULE_GLOB;
+            updateGlobMatch(CompileRegularExpression(m_pattern.c_str(), m_extension.c_str()));
         }
     }
 
@@ -343,6 +399,11 @@ public:
         rule->m_regex      = m_regex;
         rule->m_type       = m_type;
 
+        // The compiled regular expression is immutable so it could be shared.
+        rule->m_compiledRegex  = m_compiledRegex;
+        rule->m_fastMatch      = m_fastMatch;
+        rule->m_lowerExtension = m_lowerExtension;
+
         return rule;
     }
 
@@ -376,10 +437,11 @@ public:
             {
                 throw Exception("File rules: The file name pattern is empty.");
             }
-            ValidateRegularExpression(pattern, m_extension.c_str());
+            ConstRegexRcPtr compiledRegex = CompileRegularExpression(pattern, m_extension.c_str());
             m_pattern = pattern;
             m_regex = "";
             m_type = FILE_RULE_GLOB;
+            updateGlobMatch(compiledRegex);
         }
     }
 
@@ -408,10 +470,11 @@ public:
             {
                 throw Exception("File rules: The file extension pattern is empty.");
             }
-            ValidateRegularExpression(m_pattern.c_str(), extension);
+            ConstRegexRcPtr compiledRegex = CompileRegularExpression(m_pattern.c_str(), extension);
             m_extension = extension;
             m_regex = "";
             m_type = FILE_RULE_GLOB;
+            updateGlobMatch(compiledRegex);
         }
     }
 
@@ -436,11 +499,13 @@ public:
         }
         else
         {
-            ValidateRegularExpression(regex);
+            m_compiledRegex = CompileRegularExpression(regex);
             m_regex = regex;
             m_pattern = "";
             m_extension = "";
             m_type = FILE_RULE_REGEX;
+            m_fastMatch = FAST_MATCH_NONE;
+            m_lowerExtension = "";
         }
     }
 
@@ -469,35 +534,37 @@ public:
         }
     }
 
-    bool matches(const Config & config, const char * path) const
+    // Note that colorSpace is only set when the rule matches.
+    bool matches(const Config & config, const char * path, const char *& colorSpace) const
     {
         switch (m_type)
         {
         case FILE_RULE_DEFAULT:
+            colorSpace = m_colorSpace.c_str();
             return true;
         case FILE_RULE_PARSE_FILEPATH:
         {
             const int rightMostColorSpaceIndex = ParseColorSpaceFromString(config, path);
             if (rightMostColorSpaceIndex >= 0)
             {
-                m_colorSpace = config.getColorSpaceNameByIndex(SEARCH_REFERENCE_SPACE_ALL,
-                                                               COLORSPACE_ALL,
-                                                               rightMostColorSpaceIndex);
+                // The color space name from the config remains valid until the config changes.
+                colorSpace = config.getColorSpaceNameByIndex(SEARCH_REFERENCE_SPACE_ALL,
+                                                             COLORSPACE_ALL,
+                                                             rightMostColorSpaceIndex);
+                m_colorSpace = colorSpace;
                 return true;
             }
             return false;
         }
         case FILE_RULE_REGEX:
-        {
-            const std::regex reg(m_regex.c_str());
-            return regex_match(path, reg);
-        }
         case FILE_RULE_GLOB:
         {
-            const std::string exp = BuildRegularExpression(m_pattern.c_str(),
-                                                           m_extension.c_str());
-            const std::regex reg(exp.c_str());
-            return regex_match(path, reg);
+            if (matchesPattern(path))
+            {
+                colorSpace = m_colorSpace.c_str();
+                return true;
+            }
+            return false;
         }
         }
         return false;
@@ -526,12 +593,59 @@ public:
 
 private:
 
+    // Glob rules only filtering on the file extension (e.g. pattern '*' and extension 'exr')
+    // are the most common ones. They are evaluated without the regular expression.
+    enum FastMatch
+    {
+        FAST_MATCH_NONE = 0,
+        FAST_MATCH_ANY_EXTENSION,   // i.e. pattern '*' & extension '*'
+        FAST_MATCH_EXTENSION        // i.e. pattern '*' & literal extension
+    };
+
+    void updateGlobMatch(const ConstRegexRcPtr & compiledRegex)
+    {
+        m_compiledRegex = compiledRegex;
+        m_fastMatch = FAST_MATCH_NONE;
+        m_lowerExtension = "";
+
+        if (IsWildcardOnly(m_pattern))
+        {
+            if (IsWildcardOnly(m_extension))
+            {
+                m_fastMatch = FAST_MATCH_ANY_EXTENSION;
+            }
+            else if (IsLiteralExtension(m_extension))
+            {
+                m_fastMatch = FAST_MATCH_EXTENSION;
+                m_lowerExtension = "." + StringUtils::Lower(m_extension);
+            }
+        }
+    }
+
+    bool matchesPattern(const char * path) const
+    {
+        if (m_fastMatch != FAST_MATCH_NONE && !HasLineTerminator(path))
+        {
+            if (m_fastMatch == FAST_MATCH_ANY_EXTENSION)
+            {
+                return strchr(path, '.') != nullptr;
+            }
+            return EndsWithNoCase(path, m_lowerExtension);
+        }
+
+        return std::regex_match(path, *m_compiledRegex);
+    }
+
     std::string m_name;
     mutable std::string m_colorSpace;
     std::string m_pattern;
     std::string m_extension;
     std::string m_regex;
     RuleType m_type{ FILE_RULE_GLOB };
+
+    ConstRegexRcPtr m_compiledRegex;
+    FastMatch m_fastMatch{ FAST_MATCH_NONE };
+    std::string m_lowerExtension;
 };
 
 FileRules::FileRules()
@@ -635,10 +749,11 @@ const char * FileRules::Impl::getRuleFromFilepath(const Config & config, const c
     const auto numRules = m_rules.size();
     for (size_t i = 0; i < numRules; ++i)
     {
-        if (m_rules[i]->matches(config, filePath))
+        const char * colorSpace = nullptr;
+        if (m_rules[i]->matches(config, filePath, colorSpace))
         {
             ruleIndex = i;
-            return m_rules[i]->getColorSpace();
+            return colorSpace;
         }
     }
     // Should not be reached since the default rule always matches.
@@ -5,9 +5,11 @@
 #include <cctype>
 #include <cstring>
 #include <sstream>
+#include <vector>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Caching.h"
 #include "GPUProcessor.h"
 #include "GpuShader.h"
 #include "GpuShaderUtils.h"
@@ -67,7 +69,131 @@ void WriteShaderFooter(GpuShaderCreatorRcPtr & shaderCreator)
     shaderCreator->addToFunctionFooterShaderCode(ss.string().c_str());
 }
 
+// The complete shader program information extracted in a GenericGpuShaderDesc. As the
+// texture values are immutable, they are shared with the shader descs.
+struct ShaderCacheEntry
+{
+    struct Texture
+    {
+        std::string m_textureName;
+        std::string m_samplerName;
+        unsigned m_width = 0; // Edge length for the 3D textures.
+        unsigned m_height = 0;
+        GpuShaderDesc::TextureType m_channel = GpuShaderDesc::TEXTURE_RGB_CHANNEL;
+        GpuShaderDesc::TextureDimensions m_dimensions = GpuShaderDesc::TEXTURE_2D;
+        Interpolation m_interpolation = INTERP_DEFAULT;
+        ConstGpuTextureValuesRcPtr m_values;
+        ConstGpuTexturePackedValuesRcPtr m_packedValues;
+    };
+
+    std::string m_shaderText;
+    // Number of resource indices used by the shader program.
+    unsigned m_numResources = 0;
+    std::vector<Texture> m_textures;
+    std::vector<Texture> m_textures3D;
+};
+
+typedef std::shared_ptr<const ShaderCacheEntry> ConstShaderCacheEntryRcPtr;
+
+// Shader programs are generated again and again for the same processors (e.g. a viewer
+// rebuilding its display pipelines) so the results are cached. The key is the resource
+// name key (i.e. the shader creator & processor cache IDs) and the texture limits.
+ProcessorCache<std::string, ConstShaderCacheEntryRcPtr> g_shaderCache;
+
+// The entries hold the texture values so limit their number.
+constexpr size_t ShaderCacheMaxSize = 256;
+
+// Only a shader desc without any content could receive a cached shader program. Note that
+// the uniforms depend on the dynamic properties of the processor instance so the shader
+// programs using them are never cached.
+bool IsShaderCacheable(const GenericGpuShaderDesc & shaderDesc)
+{
+    return shaderDesc.getNumTextures() == 0
+        && shaderDesc.getNum3DTextures() == 0
+        && shaderDesc.getNumUniforms() == 0
+        && shaderDesc.getNumDynamicProperties() == 0
+        && !shaderDesc.hasShaderCode();
+}
+
+std::string GetShaderCacheKey(const GenericGpuShaderDesc & shaderDesc, const std::string & key)
+{
+    std::ostringstream oss;
+    oss << key << " " << shaderDesc.getTextureMaxWidth() << " " << shaderDesc.getAllowTexture1D();
+    return oss.str();
+}
+
+ConstShaderCacheEntryRcPtr CreateShaderCacheEntry(const GenericGpuShaderDesc & shaderDesc,
+                                                  unsigned firstResourceIndex)
+{
+    auto entry = std::make_shared<ShaderCacheEntry>();
+
+    entry->m_shaderText   = shaderDesc.getShaderText();
+    entry->m_numResources = shaderDesc.getNumResources() - firstResourceIndex;
+
+    for (unsigned idx = 0; idx < shaderDesc.getNumTextures(); ++idx)
+    {
+        ShaderCacheEntry::Texture t;
+
+        const char * textureName = nullptr;
+        const char * samplerName = nullptr;
+        shaderDesc.getTexture(idx, textureName, samplerName, t.m_width, t.m_height,
+                              t.m_channel, t.m_dimensions, t.m_interpolation);
+        shaderDesc.getSharedTextureValues(idx, t.m_values, t.m_packedValues);
+
+        t.m_textureName = textureName;
+        t.m_samplerName = samplerName;
+
+        entry->m_textures.push_back(t);
+    }
+
+    for (unsigned idx = 0; idx < shaderDesc.getNum3DTextures(); ++idx)
+    {
+        ShaderCacheEntry::Texture t;
+
+        const char * textureName = nullptr;
+        const char * samplerName = nullptr;
+        shaderDesc.get3DTexture(idx, textureName, samplerName, t.m_width, t.m_interpolation);
+        shaderDesc.getShared3DTextureValues(idx, t.m_values, t.m_packedValues);
+
+        t.m_textureName = textureName;
+        t.m_samplerName = samplerName;
+
+        entry->m_textures3D.push_back(t);
+    }
+
+    return entry;
+}
+
+void RestoreShaderCacheEntry(const ShaderCacheEntry & entry, GenericGpuShaderDesc & shaderDesc)
+{
+    for (const auto & t : entry.m_textures)
+    {
+        shaderDesc.addSharedTexture(t.m_textureName.c_str(), t.m_samplerName.c_str(),
+                                    t.m_width, t.m_height, t.m_channel, t.m_dimensions,
+                                    t.m_interpolation, t.m_values, t.m_packedValues);
+    }
+
+    for (const auto & t : entry.m_textures3D)
+    {
+        shaderDesc.addShared3DTexture(t.m_textureName.c_str(), t.m_samplerName.c_str(),
+                                      t.m_width, t.m_interpolation, t.m_values, t.m_packedValues);
+    }
+
+    // Consume the same resource indices as the shader program generation.
+    for (unsigned idx = 0; idx < entry.m_numResources; ++idx)
+    {
+        shaderDesc.getNextResourceIndex();
+    }
 
+    // The shader text is already complete, so it is not finalized again.
+    shaderDesc.createShaderText(entry.m_shaderText.c_str(), "", "", "", "");
+}
+
+} // anon.
+
+void ClearGpuShaderCaches()
+{
+    g_shaderCache.clear();
 }
 
 void GPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps, OptimizationFlags oFlags)
@@ -188,6 +314,37 @@ void GPUProcessor::extractGpuShaderInfo(GpuShaderCreatorRcPtr & shaderCreator) c
                              [](char const & c) -> bool { return !std::isalnum(c) && c!='_'; } ),
               key.end());
 
+    // Reuse the shader program information when the processor was already extracted using
+    // an identical shader desc.
+
+    auto genericDesc = DynamicPtrCast<GenericGpuShaderDesc>(shaderCreator);
+    const bool cacheable = genericDesc && g_shaderCache.isEnabled() && IsShaderCacheable(*genericDesc);
+
+    std::string cacheKey;
+    unsigned firstResourceIndex = 0;
+    if (cacheable)
+    {
+        cacheKey = GetShaderCacheKey(*genericDesc, key);
+        firstResourceIndex = genericDesc->getNumResources();
+
+        ConstShaderCacheEntryRcPtr entry;
+        {
+            AutoMutex guard(g_shaderCache.lock());
+            if (g_shaderCache.exists(cacheKey))
+            {
+                entry = g_shaderCache[cacheKey];
+            }
+        }
+
+        if (entry)
+        {
+            shaderCreator->begin(key.c_str());
+            RestoreShaderCacheEntry(*entry, *genericDesc);
+            shaderCreator->end();
+            return;
+        }
+    }
+
     // Extract the information to fully build the fragment shader program.
 
     shaderCreator->begin(key.c_str());
@@ -203,6 +360,18 @@ void GPUProcessor::extractGpuShaderInfo(GpuShaderCreatorRcPtr & shaderCreator) c
     }
 
     shaderCreator->end();
+
+    if (cacheable && genericDesc->getNumUniforms() == 0 && genericDesc->getNumDynamicProperties() == 0)
+    {
+        ConstShaderCacheEntryRcPtr entry = CreateShaderCacheEntry(*genericDesc, firstResourceIndex);
+
+        AutoMutex guard(g_shaderCache.lock());
+        if (g_shaderCache.size() >= ShaderCacheMaxSize)
+        {
+            g_shaderCache.clearEntries();
+        }
+        g_shaderCache[cacheKey] = entry;
+    }
 }
 
 
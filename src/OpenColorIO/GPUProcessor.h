@@ -45,6 +45,9 @@ private:
     mutable Mutex m_mutex;
 };
 
+// Flush the shader programs cached by GPUProcessor::extractGpuShaderInfo().
+void ClearGpuShaderCaches();
+
 
 } // namespace OCIO_NAMESPACE
 
@@ -2,17 +2,23 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <vector>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Caching.h"
 #include "DynamicProperty.h"
 #include "GpuShader.h"
+#include "GpuShaderUtils.h"
+#include "MathUtils.h"
 #include "ops/lut3d/Lut3DOpData.h"
 #include "Platform.h"
+#include "utils/StringUtils.h"
 
 namespace OCIO_NAMESPACE
 {
@@ -20,10 +26,9 @@ namespace OCIO_NAMESPACE
 namespace
 {
 
-static void  CreateArray(const float * buf,
-                         unsigned w, unsigned h, unsigned d,
-                         GpuShaderDesc::TextureType type,
-                         std::vector<float> & res)
+static ConstGpuTextureValuesRcPtr CreateArray(const float * buf,
+                                              unsigned w, unsigned h, unsigned d,
+                                              GpuShaderDesc::TextureType type)
 {
     if(buf==nullptr)
     {
@@ -32,9 +37,224 @@ static void  CreateArray(const float * buf,
 
     const size_t size
         = w * h * d * (type==GpuShaderDesc::TEXTURE_RGB_CHANNEL ? 3 : 1);
-    res.resize(size);
-    std::memcpy(&res[0], buf, size * sizeof(float));
+
+    auto res = std::make_shared<std::vector<float>>(size);
+    std::memcpy(res->data(), buf, size * sizeof(float));
+
+    // The payload keeps the vector alive.
+    return ConstGpuTextureValuesRcPtr(res, res->data());
+}
+
+// The texture payloads currently in use, indexed by content. The payloads are only weakly
+// referenced so they are released as soon as no shader desc uses them anymore.
+GenericCache<std::string, std::weak_ptr<const float>> g_textureValues;
+GenericCache<std::string, std::weak_ptr<const GpuTexturePackedValues>> g_texturePackedValues;
+
+// Limit the number of entries, some of them being possibly expired.
+constexpr size_t TextureValuesMaxSize = 1024;
+
+template<typename T>
+std::shared_ptr<const T> GetSharedPayload(GenericCache<std::string, std::weak_ptr<const T>> & cache,
+                                          const std::string & contentKey,
+                                          const std::function<std::shared_ptr<const T>()> & create)
+{
+    AutoMutex guard(cache.lock());
+
+    if (cache.exists(contentKey))
+    {
+        std::shared_ptr<const T> payload = cache[contentKey].lock();
+        if (payload)
+        {
+            return payload;
+        }
+    }
+
+    std::shared_ptr<const T> payload = create();
+
+    if (cache.size() >= TextureValuesMaxSize)
+    {
+        // Payloads in use are not released, they are only no longer shared with new ones.
+        cache.clearEntries();
+    }
+
+    cache[contentKey] = payload;
+    return payload;
+}
+
+void PackHalf(const float * values, size_t numValues, GpuTexturePackedValues & packed)
+{
+    packed.m_format = GpuShaderCreator::TEXTURE_FORMAT_HALF;
+    packed.m_values.resize(numValues);
+    for (size_t idx = 0; idx < numValues; ++idx)
+    {
+        // Out of range values are clamped rather than becoming infinite.
+        const half h(Clamp(values[idx], -HALF_MAX, HALF_MAX));
+        packed.m_values[idx] = h.bits();
+    }
+}
+
+// The largest range of a channel for the TEXTURE_FORMAT_UNORM16 format: the quantization error
+// (i.e. half of the step) is then below 2^-13, well below half of a 12-bit code value.
+constexpr float Unorm16MaxRange = 16.0f;
+
+// Pack the values using a scale & an offset per channel, the channels being interleaved. Return
+// false when the normalized integers are not precise enough (i.e. a channel range is too wide)
+// or cannot represent some values (i.e. the infinities & NaNs), the caller then falls back to
+// the half float values. Note that the sanitized texture values of the 1D LUTs replace the
+// infinities by the largest float values.
+bool PackUnorm16(const float * values, size_t numValues, unsigned numChannels,
+                 GpuTexturePackedValues & packed)
+{
+    float minValue[3] = {  std::numeric_limits<float>::max(),
+                           std::numeric_limits<float>::max(),
+                           std::numeric_limits<float>::max() };
+    float maxValue[3] = { -std::numeric_limits<float>::max(),
+                          -std::numeric_limits<float>::max(),
+                          -std::numeric_limits<float>::max() };
+
+    for (size_t idx = 0; idx < numValues; ++idx)
+    {
+        const float value = values[idx];
+        if (!std::isfinite(value) || std::abs(value) >= std::numeric_limits<float>::max())
+        {
+            return false;
+        }
+
+        const size_t channel = idx % numChannels;
+        minValue[channel] = std::min(minValue[channel], value);
+        maxValue[channel] = std::max(maxValue[channel], value);
+    }
+
+    for (unsigned channel = 0; channel < 3; ++channel)
+    {
+        // A single channel texture is sampled for the three channels.
+        const unsigned c = channel % numChannels;
+        if (maxValue[c] - minValue[c] > Unorm16MaxRange)
+        {
+            return false;
+        }
+
+        // The GPU sampling returns value / 65535 so the actual value is sample * scale + offset.
+        // As the interpolations are weighted averages, the rescaling can be done after them.
+        packed.m_offset[channel] = minValue[c];
+        packed.m_scale[channel]  = (maxValue[c] > minValue[c]) ? (maxValue[c] - minValue[c]) : 1.0f;
+    }
+
+    packed.m_format = GpuShaderCreator::TEXTURE_FORMAT_UNORM16;
+    packed.m_values.resize(numValues);
+    for (size_t idx = 0; idx < numValues; ++idx)
+    {
+        const size_t channel = idx % numChannels;
+        const float normalized = (values[idx] - packed.m_offset[channel]) / packed.m_scale[channel];
+        packed.m_values[idx] = static_cast<uint16_t>(Clamp(normalized, 0.0f, 1.0f) * 65535.0f + 0.5f);
+    }
+
+    return true;
+}
+
+} // anon.
+
+const char * TextureFormatToString(GpuShaderCreator::TextureFormat format)
+{
+    switch (format)
+    {
+        case GpuShaderCreator::TEXTURE_FORMAT_FLOAT32: return "float32";
+        case GpuShaderCreator::TEXTURE_FORMAT_HALF:    return "half";
+        case GpuShaderCreator::TEXTURE_FORMAT_UNORM16: return "unorm16";
+    }
+
+    throw Exception("Unknown texture format.");
+}
+
+ConstGpuTextureValuesRcPtr GetSharedTextureValues(const std::string & contentKey,
+                                                  const std::function<ConstGpuTextureValuesRcPtr()> & create)
+{
+    return GetSharedPayload(g_textureValues, contentKey, create);
+}
+
+GpuShaderCreator::TextureFormat GetSupportedTextureFormat(const GpuShaderCreatorRcPtr & shaderCreator)
+{
+    // Only the generic shader desc holds the packed values.
+    return DynamicPtrCast<GenericGpuShaderDesc>(shaderCreator)
+        ? shaderCreator->getTextureFormat()
+        : GpuShaderCreator::TEXTURE_FORMAT_FLOAT32;
 }
+
+ConstGpuTexturePackedValuesRcPtr GetSharedTexturePackedValues(const std::string & contentKey,
+                                                              GpuShaderCreator::TextureFormat format,
+                                                              const ConstGpuTextureValuesRcPtr & values,
+                                                              size_t numValues,
+                                                              unsigned numChannels)
+{
+    if (format == GpuShaderCreator::TEXTURE_FORMAT_FLOAT32)
+    {
+        throw Exception("The 32-bit float texture values are not packed.");
+    }
+
+    if (!values || numValues == 0 || (numChannels != 1 && numChannels != 3))
+    {
+        throw Exception("The buffer is invalid");
+    }
+
+    const std::string key = std::string(TextureFormatToString(format)) + " " + contentKey;
+
+    return GetSharedPayload<GpuTexturePackedValues>(
+        g_texturePackedValues,
+        key,
+        [format, &values, numValues, numChannels]()
+        {
+            auto packed = std::make_shared<GpuTexturePackedValues>();
+            if (format != GpuShaderCreator::TEXTURE_FORMAT_UNORM16
+                || !PackUnorm16(values.get(), numValues, numChannels, *packed))
+            {
+                PackHalf(values.get(), numValues, *packed);
+            }
+            return ConstGpuTexturePackedValuesRcPtr(packed);
+        });
+}
+
+void AddTexture(GpuShaderCreatorRcPtr & shaderCreator,
+                const char * textureName,
+                const char * samplerName,
+                unsigned width, unsigned height,
+                GpuShaderDesc::TextureType channel,
+                GpuShaderDesc::TextureDimensions dimensions,
+                Interpolation interpolation,
+                const ConstGpuTextureValuesRcPtr & values,
+                const ConstGpuTexturePackedValuesRcPtr & packedValues)
+{
+    auto genericDesc = DynamicPtrCast<GenericGpuShaderDesc>(shaderCreator);
+    if (genericDesc)
+    {
+        genericDesc->addSharedTexture(textureName, samplerName, width, height,
+                                      channel, dimensions, interpolation, values, packedValues);
+    }
+    else
+    {
+        // Other shader creators copy the values if they need them.
+        shaderCreator->addTexture(textureName, samplerName, width, height,
+                                  channel, dimensions, interpolation, values.get());
+    }
+}
+
+void Add3DTexture(GpuShaderCreatorRcPtr & shaderCreator,
+                  const char * textureName,
+                  const char * samplerName,
+                  unsigned edgelen,
+                  Interpolation interpolation,
+                  const ConstGpuTextureValuesRcPtr & values,
+                  const ConstGpuTexturePackedValuesRcPtr & packedValues)
+{
+    auto genericDesc = DynamicPtrCast<GenericGpuShaderDesc>(shaderCreator);
+    if (genericDesc)
+    {
+        genericDesc->addShared3DTexture(textureName, samplerName, edgelen, interpolation,
+                                        values, packedValues);
+    }
+    else
+    {
+        shaderCreator->add3DTexture(textureName, samplerName, edgelen, interpolation, values.get());
+    }
 }
 
 namespace GPUShaderImpl
@@ -52,8 +272,56 @@ public:
                 unsigned dimensions,
                 Interpolation interpolation,
                 const float * v)
-            :   m_textureName(textureName)
-            ,   m_samplerName(samplerName)
+            :   Texture(textureName, samplerName, w, h, d, channel, dimensions, interpolation)
+        {
+            // An unfortunate copy is mandatory to allow the creation of a GPU shader cache.
+            // The cache needs a decoupling of the processor and shader instances forbidding
+            // shared naked pointer usage.
+            m_values = CreateArray(v, m_width, m_height, m_depth, m_type);
+        }
+
+        Texture(const char * textureName,
+                const char * samplerName,
+                unsigned w, unsigned h, unsigned d,
+                GpuShaderDesc::TextureType channel,
+                unsigned dimensions,
+                Interpolation interpolation,
+                const ConstGpuTextureValuesRcPtr & v)
+            :   Texture(textureName, samplerName, w, h, d, channel, dimensions, interpolation)
+        {
+            if (!v)
+            {
+                throw Exception("The buffer is invalid");
+            }
+
+            // The values are immutable so they are shared rather than copied.
+            m_values = v;
+        }
+
+        std::string m_textureName;
+        std::string m_samplerName;
+        unsigned m_width;
+        unsigned m_height;
+        unsigned m_depth;
+        GpuShaderDesc::TextureType m_type;
+        unsigned m_dimensions;
+        Interpolation m_interp;
+
+        ConstGpuTextureValuesRcPtr m_values;
+        // Only for the 16-bit texture formats.
+        ConstGpuTexturePackedValuesRcPtr m_packedValues;
+
+        Texture() = delete;
+
+    private:
+        Texture(const char * textureName,
+                const char * samplerName,
+                unsigned w, unsigned h, unsigned d,
+                GpuShaderDesc::TextureType channel,
+                unsigned dimensions,
+                Interpolation interpolation)
+            :   m_textureName(textureName ? textureName : "")
+            ,   m_samplerName(samplerName ? samplerName : "")
             ,   m_width(w)
             ,   m_height(h)
             ,   m_depth(d)
@@ -79,25 +347,7 @@ public:
 
                 throw Exception(ss.str().c_str());
             }
-
-            // An unfortunate copy is mandatory to allow the creation of a GPU shader cache.
-            // The cache needs a decoupling of the processor and shader instances forbidding
-            // shared naked pointer usage.
-            CreateArray(v, m_width, m_height, m_depth, m_type, m_values);
         }
-
-        std::string m_textureName;
-        std::string m_samplerName;
-        unsigned m_width;
-        unsigned m_height;
-        unsigned m_depth;
-        GpuShaderDesc::TextureType m_type;
-        unsigned m_dimensions;
-        Interpolation m_interp;
-
-        std::vector<float> m_values;
-
-        Texture() = delete;
     };
 
     typedef std::vector<Texture> Textures;
@@ -160,6 +410,18 @@ public:
 
     typedef std::vector<Uniform> Uniforms;
 
+    // A member of the uniform block, the offset following the std140 layout rules.
+    struct UniformBlockMember
+    {
+        std::string m_name;
+        UniformDataType m_type = UNIFORM_UNKNOWN;
+        unsigned m_arraySize = 0;
+        unsigned m_offset = 0;
+        unsigned m_uniformIndex = 0;
+    };
+
+    typedef std::vector<UniformBlockMember> UniformBlockMembers;
+
 public:
     PrivateImpl() : m_max1DLUTWidth(4 * 1024), m_allowTexture1D(true) {}
     PrivateImpl(const PrivateImpl & rhs) = delete;
@@ -175,13 +437,16 @@ public:
     inline bool getAllowTexture1D() const { return m_allowTexture1D; }
     inline void setAllowTexture1D(bool allowed) { m_allowTexture1D = allowed; }
 
+    // The values are either copied (const float *) or shared (ConstGpuTextureValuesRcPtr).
+    template<typename Values>
     void addTexture(const char * textureName,
                     const char * samplerName,
                     unsigned width, unsigned height,
                     GpuShaderDesc::TextureType channel,
                     GpuShaderDesc::TextureDimensions dimensions,
                     Interpolation interpolation,
-                    const float * values)
+                    const Values & values,
+                    const ConstGpuTexturePackedValuesRcPtr & packedValues = nullptr)
     {
         if(width > get1dLutMaxWidth())
         {
@@ -193,6 +458,7 @@ public:
 
         unsigned numDimensions = static_cast<unsigned>(dimensions);
         Texture t(textureName, samplerName, width, height, 1, channel, numDimensions, interpolation, values);
+        t.m_packedValues = packedValues;
         m_textures.push_back(t);
     }
 
@@ -240,14 +506,66 @@ public:
         }
 
         const Texture & t = m_textures[index];
-        values   = &t.m_values[0];
+        values   = t.m_values.get();
     }
 
+    void getSharedTextureValues(unsigned index,
+                                ConstGpuTextureValuesRcPtr & values,
+                                ConstGpuTexturePackedValuesRcPtr & packedValues) const
+    {
+        if(index >= m_textures.size())
+        {
+            std::ostringstream ss;
+            ss << "1D LUT access error: index = " << index
+               << " where size = " << m_textures.size();
+            throw Exception(ss.str().c_str());
+        }
+
+        const Texture & t = m_textures[index];
+        values       = t.m_values;
+        packedValues = t.m_packedValues;
+    }
+
+    void getTexturePackedValues(unsigned index, const uint16_t *& values) const
+    {
+        if(index >= m_textures.size())
+        {
+            std::ostringstream ss;
+            ss << "1D LUT access error: index = " << index
+               << " where size = " << m_textures.size();
+            throw Exception(ss.str().c_str());
+        }
+
+        const Texture & t = m_textures[index];
+        if (!t.m_packedValues)
+        {
+            throw Exception("The 1D LUT texture values are not packed.");
+        }
+        values = t.m_packedValues->m_values.data();
+    }
+
+    GpuShaderCreator::TextureFormat getTexturePackedFormat(unsigned index) const
+    {
+        if(index >= m_textures.size())
+        {
+            std::ostringstream ss;
+            ss << "1D LUT access error: index = " << index
+               << " where size = " << m_textures.size();
+            throw Exception(ss.str().c_str());
+        }
+
+        const Texture & t = m_textures[index];
+        return t.m_packedValues ? t.m_packedValues->m_format
+                                : GpuShaderCreator::TEXTURE_FORMAT_FLOAT32;
+    }
+
+    template<typename Values>
     void add3DTexture(const char * textureName,
                       const char * samplerName,
                       unsigned edgelen,
                       Interpolation interpolation,
-                      const float * values)
+                      const Values & values,
+                      const ConstGpuTexturePackedValuesRcPtr & packedValues = nullptr)
     {
         if(edgelen > get3dLutMaxLength())
         {
@@ -260,6 +578,7 @@ public:
         Texture t(textureName, samplerName, edgelen, edgelen, edgelen,
                   GpuShaderDesc::TEXTURE_RGB_CHANNEL, 3,
                   interpolation, values);
+        t.m_packedValues = packedValues;
         m_textures3D.push_back(t);
     }
 
@@ -295,7 +614,57 @@ public:
         }
 
         const Texture & t = m_textures3D[index];
-        values = &t.m_values[0];
+        values = t.m_values.get();
+    }
+
+    void getShared3DTextureValues(unsigned index,
+                                  ConstGpuTextureValuesRcPtr & values,
+                                  ConstGpuTexturePackedValuesRcPtr & packedValues) const
+    {
+        if(index >= m_textures3D.size())
+        {
+            std::ostringstream ss;
+            ss << "3D LUT access error: index = " << index
+               << " where size = " << m_textures3D.size();
+            throw Exception(ss.str().c_str());
+        }
+
+        const Texture & t = m_textures3D[index];
+        values       = t.m_values;
+        packedValues = t.m_packedValues;
+    }
+
+    void get3DTexturePackedValues(unsigned index, const uint16_t *& values) const
+    {
+        if(index >= m_textures3D.size())
+        {
+            std::ostringstream ss;
+            ss << "3D LUT access error: index = " << index
+               << " where size = " << m_textures3D.size();
+            throw Exception(ss.str().c_str());
+        }
+
+        const Texture & t = m_textures3D[index];
+        if (!t.m_packedValues)
+        {
+            throw Exception("The 3D LUT texture values are not packed.");
+        }
+        values = t.m_packedValues->m_values.data();
+    }
+
+    GpuShaderCreator::TextureFormat get3DTexturePackedFormat(unsigned index) const
+    {
+        if(index >= m_textures3D.size())
+        {
+            std::ostringstream ss;
+            ss << "3D LUT access error: index = " << index
+               << " where size = " << m_textures3D.size();
+            throw Exception(ss.str().c_str());
+        }
+
+        const Texture & t = m_textures3D[index];
+        return t.m_packedValues ? t.m_packedValues->m_format
+                                : GpuShaderCreator::TEXTURE_FORMAT_FLOAT32;
     }
 
     unsigned getNumUniforms() const
@@ -374,10 +743,192 @@ public:
         m_uniforms.emplace_back(name, getSize, getVectorInt);
         return true;
     }
+    void addUniformBlockMember(const char * name, UniformDataType type, unsigned arraySize)
+    {
+        const std::string memberName(name ? name : "");
+
+        for (const auto & member : m_uniformBlock)
+        {
+            if (member.m_name == memberName)
+            {
+                // Member is already there.
+                return;
+            }
+        }
+
+        UniformBlockMember member;
+        member.m_name      = memberName;
+        member.m_type      = type;
+        member.m_arraySize = arraySize;
+
+        for (member.m_uniformIndex = 0; member.m_uniformIndex < m_uniforms.size(); ++member.m_uniformIndex)
+        {
+            if (m_uniforms[member.m_uniformIndex].m_name == memberName)
+            {
+                break;
+            }
+        }
+
+        if (member.m_uniformIndex == m_uniforms.size())
+        {
+            std::ostringstream ss;
+            ss << "The uniform '" << memberName << "' of the uniform block does not exist.";
+            throw Exception(ss.str().c_str());
+        }
+
+        // The std140 layout: scalars are 4-byte aligned, a vec3 is 16-byte aligned and each
+        // array element is 16-byte aligned.
+        unsigned alignment = 4;
+        unsigned size      = 4;
+        switch (type)
+        {
+            case UNIFORM_DOUBLE:
+            case UNIFORM_BOOL:
+                break;
+            case UNIFORM_FLOAT3:
+                alignment = 16;
+                size      = 12;
+                break;
+            case UNIFORM_VECTOR_FLOAT:
+            case UNIFORM_VECTOR_INT:
+                alignment = 16;
+                size      = 16 * arraySize;
+                break;
+            case UNIFORM_UNKNOWN:
+                throw Exception("Unknown uniform type.");
+        }
+
+        member.m_offset = (m_uniformBlockEnd + alignment - 1) / alignment * alignment;
+        m_uniformBlockEnd = member.m_offset + size;
+
+        m_uniformBlock.push_back(member);
+    }
+
+    unsigned getUniformBlockSize() const
+    {
+        // The block size is a multiple of a vec4.
+        return (m_uniformBlockEnd + 15) / 16 * 16;
+    }
+
+    unsigned getUniformBlockOffset(unsigned index) const
+    {
+        for (const auto & member : m_uniformBlock)
+        {
+            if (member.m_uniformIndex == index)
+            {
+                return member.m_offset;
+            }
+        }
+
+        std::ostringstream ss;
+        ss << "Uniform block access error: the uniform " << index << " is not in the uniform block.";
+        throw Exception(ss.str().c_str());
+    }
+
+    void fillUniformBlock(void * buffer) const
+    {
+        if (m_uniformBlock.empty())
+        {
+            throw Exception("There is no uniform block.");
+        }
+
+        char * block = static_cast<char *>(buffer);
+        std::memset(block, 0, getUniformBlockSize());
+
+        for (const auto & member : m_uniformBlock)
+        {
+            const GpuShaderDesc::UniformData & data = m_uniforms[member.m_uniformIndex].m_data;
+            char * dst = block + member.m_offset;
+
+            switch (member.m_type)
+            {
+                case UNIFORM_DOUBLE:
+                {
+                    const float value = static_cast<float>(data.m_getDouble());
+                    std::memcpy(dst, &value, sizeof(float));
+                    break;
+                }
+                case UNIFORM_BOOL:
+                {
+                    const uint32_t value = data.m_getBool() ? 1 : 0;
+                    std::memcpy(dst, &value, sizeof(uint32_t));
+                    break;
+                }
+                case UNIFORM_FLOAT3:
+                {
+                    const Float3 & value = data.m_getFloat3();
+                    std::memcpy(dst, value.data(), 3 * sizeof(float));
+                    break;
+                }
+                case UNIFORM_VECTOR_FLOAT:
+                {
+                    const unsigned size = std::min(unsigned(data.m_vectorFloat.m_getSize()),
+                                                   member.m_arraySize);
+                    const float * values = data.m_vectorFloat.m_getVector();
+                    for (unsigned idx = 0; idx < size; ++idx)
+                    {
+                        std::memcpy(dst + 16 * idx, &values[idx], sizeof(float));
+                    }
+                    break;
+                }
+                case UNIFORM_VECTOR_INT:
+                {
+                    const unsigned size = std::min(unsigned(data.m_vectorInt.m_getSize()),
+                                                   member.m_arraySize);
+                    const int * values = data.m_vectorInt.m_getVector();
+                    for (unsigned idx = 0; idx < size; ++idx)
+                    {
+                        std::memcpy(dst + 16 * idx, &values[idx], sizeof(int));
+                    }
+                    break;
+                }
+                case UNIFORM_UNKNOWN:
+                    break;
+            }
+        }
+    }
+
+    unsigned updateChangedUniforms()
+    {
+        m_uniformValues.resize(m_uniforms.size());
+        m_changedUniforms.clear();
+
+        std::vector<double> values;
+        for (unsigned idx = 0; idx < (unsigned)m_uniforms.size(); ++idx)
+        {
+            GetUniformValues(m_uniforms[idx].m_data, values);
+
+            UniformValues & previous = m_uniformValues[idx];
+            if (!previous.m_isSet || previous.m_values != values)
+            {
+                previous.m_isSet  = true;
+                previous.m_values = values;
+                m_changedUniforms.push_back(idx);
+            }
+        }
+
+        return (unsigned)m_changedUniforms.size();
+    }
+
+    unsigned getChangedUniform(unsigned index) const
+    {
+        if (index >= (unsigned)m_changedUniforms.size())
+        {
+            std::ostringstream ss;
+            ss << "Changed uniforms access error: index = " << index
+               << " where size = " << m_changedUniforms.size();
+            throw Exception(ss.str().c_str());
+        }
+        return m_changedUniforms[index];
+    }
+
     Textures m_textures;
     Textures m_textures3D;
     Uniforms m_uniforms;
 
+    UniformBlockMembers m_uniformBlock;
+    std::string m_uniformBlockName;
+
 private:
     bool uniformNameUsed(const char * name) const
     {
@@ -390,8 +941,60 @@ private:
         }
         return false;
     }
+    static void GetUniformValues(const GpuShaderDesc::UniformData & data,
+                                 std::vector<double> & values)
+    {
+        values.clear();
+        switch (data.m_type)
+        {
+            case UNIFORM_DOUBLE:
+            {
+                values.push_back(data.m_getDouble());
+                break;
+            }
+            case UNIFORM_BOOL:
+            {
+                values.push_back(data.m_getBool() ? 1. : 0.);
+                break;
+            }
+            case UNIFORM_FLOAT3:
+            {
+                const Float3 & value = data.m_getFloat3();
+                values.insert(values.end(), value.begin(), value.end());
+                break;
+            }
+            case UNIFORM_VECTOR_FLOAT:
+            {
+                const int size = data.m_vectorFloat.m_getSize();
+                const float * vector = data.m_vectorFloat.m_getVector();
+                values.insert(values.end(), vector, vector + size);
+                break;
+            }
+            case UNIFORM_VECTOR_INT:
+            {
+                const int size = data.m_vectorInt.m_getSize();
+                const int * vector = data.m_vectorInt.m_getVector();
+                values.insert(values.end(), vector, vector + size);
+                break;
+            }
+            case UNIFORM_UNKNOWN:
+                break;
+        }
+    }
+
+    // The uniform values at the previous updateChangedUniforms() call.
+    struct UniformValues
+    {
+        bool m_isSet = false;
+        std::vector<double> m_values;
+    };
+
     unsigned m_max1DLUTWidth;
     bool m_allowTexture1D;
+    unsigned m_uniformBlockEnd = 0;
+
+    std::vector<UniformValues> m_uniformValues;
+    std::vector<unsigned> m_changedUniforms;
 };
 
 } // namespace GPUShaderImpl
@@ -430,6 +1033,118 @@ const char * GenericGpuShaderDesc::getUniform(unsigned index, GpuShaderDesc::Uni
     return getImplGeneric()->getUniform(index, data);
 }
 
+bool GenericGpuShaderDesc::usesUniformBlock() const noexcept
+{
+    return getUseUniformBlock() && IsUniformBlockSupported(getLanguage());
+}
+
+void GenericGpuShaderDesc::addUniformBlockMember(const char * name,
+                                                 UniformDataType type,
+                                                 unsigned arraySize)
+{
+    getImplGeneric()->addUniformBlockMember(name, type, arraySize);
+}
+
+unsigned GenericGpuShaderDesc::getUniformBlockSize() const noexcept
+{
+    return getImplGeneric()->getUniformBlockSize();
+}
+
+const char * GenericGpuShaderDesc::getUniformBlockName() const noexcept
+{
+    return getImplGeneric()->m_uniformBlockName.c_str();
+}
+
+unsigned GenericGpuShaderDesc::getUniformBlockOffset(unsigned index) const
+{
+    return getImplGeneric()->getUniformBlockOffset(index);
+}
+
+void GenericGpuShaderDesc::fillUniformBlock(void * buffer) const
+{
+    getImplGeneric()->fillUniformBlock(buffer);
+}
+
+unsigned GenericGpuShaderDesc::updateChangedUniforms()
+{
+    return getImplGeneric()->updateChangedUniforms();
+}
+
+unsigned GenericGpuShaderDesc::getChangedUniform(unsigned index) const
+{
+    return getImplGeneric()->getChangedUniform(index);
+}
+
+void GenericGpuShaderDesc::finalize()
+{
+    const auto & members = getImplGeneric()->m_uniformBlock;
+
+    if (!members.empty())
+    {
+        getImplGeneric()->m_uniformBlockName
+            = StringUtils::Replace(std::string(getResourcePrefix()) + "_uniforms", "__", "_");
+
+        const bool isHLSL = getLanguage() == GPU_LANGUAGE_HLSL_DX11;
+
+        GpuShaderText st(getLanguage());
+
+        st.newLine();
+        if (isHLSL)
+        {
+            st.newLine() << "cbuffer " << getImplGeneric()->m_uniformBlockName;
+        }
+        else
+        {
+            st.newLine() << "layout(std140) uniform " << getImplGeneric()->m_uniformBlockName;
+        }
+        st.newLine() << "{";
+        st.indent();
+
+        for (const auto & member : members)
+        {
+            std::ostringstream oss;
+
+            switch (member.m_type)
+            {
+                case UNIFORM_DOUBLE:
+                    oss << st.floatKeyword() << " " << member.m_name;
+                    break;
+                case UNIFORM_BOOL:
+                    oss << "bool " << member.m_name;
+                    break;
+                case UNIFORM_FLOAT3:
+                    oss << st.float3Keyword() << " " << member.m_name;
+                    break;
+                case UNIFORM_VECTOR_FLOAT:
+                    oss << st.floatKeyword() << " " << member.m_name << "[" << member.m_arraySize << "]";
+                    break;
+                case UNIFORM_VECTOR_INT:
+                    oss << st.intKeyword() << " " << member.m_name << "[" << member.m_arraySize << "]";
+                    break;
+                case UNIFORM_UNKNOWN:
+                    break;
+            }
+
+            if (isHLSL)
+            {
+                // Enforce the std140 offsets i.e. the register and the component.
+                static const char components[] = { 'x', 'y', 'z', 'w' };
+                oss << " : packoffset(c" << member.m_offset / 16 << "."
+                    << components[(member.m_offset % 16) / 4] << ")";
+            }
+
+            st.newLine() << oss.str() << ";";
+        }
+
+        st.dedent();
+        st.newLine() << "};";
+
+        addToDeclareShaderCode(st.string().c_str());
+    }
+
+    GpuShaderDesc::finalize();
+}
+
 bool GenericGpuShaderDesc::addUniform(const char * name, const DoubleGetter & getter)
 {
     return getImplGeneric()->addUniform(name, getter);
@@ -496,6 +1211,19 @@ void GenericGpuShaderDesc::addTexture(const char * textureName,
     getImplGeneric()->addTexture(textureName, samplerName, width, height, channel, dimensions, interpolation, values);
 }
 
+void GenericGpuShaderDesc::addSharedTexture(const char * textureName,
+                                            const char * samplerName,
+                                            unsigned width, unsigned height,
+                                            TextureType channel,
+                                            TextureDimensions dimensions,
+                                            Interpolation interpolation,
+                                            const ConstGpuTextureValuesRcPtr & values,
+                                            const ConstGpuTexturePackedValuesRcPtr & packedValues)
+{
+    getImplGeneric()->addTexture(textureName, samplerName, width, height, channel, dimensions, interpolation,
+                                 values, packedValues);
+}
+
 void GenericGpuShaderDesc::getTexture(unsigned index,
                                       const char *& textureName,
                                       const char *& samplerName,
@@ -512,6 +1240,23 @@ void GenericGpuShaderDesc::getTextureValues(unsigned index, const float *& value
     getImplGeneric()->getTextureValues(index, values);
 }
 
+void GenericGpuShaderDesc::getTexturePackedValues(unsigned index, const uint16_t *& values) const
+{
+    getImplGeneric()->getTexturePackedValues(index, values);
+}
+
+GpuShaderCreator::TextureFormat GenericGpuShaderDesc::getTexturePackedFormat(unsigned index) const
+{
+    return getImplGeneric()->getTexturePackedFormat(index);
+}
+
+void GenericGpuShaderDesc::getSharedTextureValues(unsigned index,
+                                                  ConstGpuTextureValuesRcPtr & values,
+                                                  ConstGpuTexturePackedValuesRcPtr & packedValues) const
+{
+    getImplGeneric()->getSharedTextureValues(index, values, packedValues);
+}
+
 unsigned GenericGpuShaderDesc::getNum3DTextures() const noexcept
 {
     return unsigned(getImplGeneric()->m_textures3D.size());
@@ -526,6 +1271,16 @@ void GenericGpuShaderDesc::add3DTexture(const char * textureName,
     getImplGeneric()->add3DTexture(textureName, samplerName, edgelen, interpolation, values);
 }
 
+void GenericGpuShaderDesc::addShared3DTexture(const char * textureName,
+                                              const char * samplerName,
+                                              unsigned edgelen,
+                                              Interpolation interpolation,
+                                              const ConstGpuTextureValuesRcPtr & values,
+                                              const ConstGpuTexturePackedValuesRcPtr & packedValues)
+{
+    getImplGeneric()->add3DTexture(textureName, samplerName, edgelen, interpolation, values, packedValues);
+}
+
 void GenericGpuShaderDesc::get3DTexture(unsigned index,
                                         const char *& textureName,
                                         const char *& samplerName,
@@ -540,6 +1295,23 @@ void GenericGpuShaderDesc::get3DTextureValues(unsigned index, const float *& val
     getImplGeneric()->get3DTextureValues(index, values);
 }
 
+void GenericGpuShaderDesc::get3DTexturePackedValues(unsigned index, const uint16_t *& values) const
+{
+    getImplGeneric()->get3DTexturePackedValues(index, values);
+}
+
+GpuShaderCreator::TextureFormat GenericGpuShaderDesc::get3DTexturePackedFormat(unsigned index) const
+{
+    return getImplGeneric()->get3DTexturePackedFormat(index);
+}
+
+void GenericGpuShaderDesc::getShared3DTextureValues(unsigned index,
+                                                    ConstGpuTextureValuesRcPtr & values,
+                                                    ConstGpuTexturePackedValuesRcPtr & packedValues) const
+{
+    getImplGeneric()->getShared3DTextureValues(index, values, packedValues);
+}
+
 void GenericGpuShaderDesc::Deleter(GenericGpuShaderDesc* c)
 {
     delete c;
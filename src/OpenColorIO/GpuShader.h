@@ -5,12 +5,76 @@
 #define INCLUDED_OCIO_GPU_SHADER_H
 
 
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 
 namespace OCIO_NAMESPACE
 {
 
+// Immutable texture values. The shared pointer keeps the actual owner of the values alive (e.g.
+// the LUT op data or a padded copy of its values) so shader descs never need to copy them.
+typedef std::shared_ptr<const float> ConstGpuTextureValuesRcPtr;
+
+// Return the texture values already in use for the same content (e.g. identical LUTs from
+// different processors or from several extractions of the same processor), or the new values
+// created by the supplied function. The content key must identify the values.
+ConstGpuTextureValuesRcPtr GetSharedTextureValues(const std::string & contentKey,
+                                                  const std::function<ConstGpuTextureValuesRcPtr()> & create);
+
+const char * TextureFormatToString(GpuShaderCreator::TextureFormat format);
+
+// The 16-bit texture values of the TEXTURE_FORMAT_HALF & TEXTURE_FORMAT_UNORM16 formats. For the
+// latter, the values sampled by the GPU (i.e. on [0, 1]) must be rescaled per channel using
+// m_scale & m_offset. The format is the one actually used, the half float values being the
+// fallback when the normalized integers cannot represent the values precisely enough.
+struct GpuTexturePackedValues
+{
+    GpuShaderCreator::TextureFormat m_format = GpuShaderCreator::TEXTURE_FORMAT_HALF;
+    std::vector<uint16_t> m_values;
+    float m_scale[3] = { 1.0f, 1.0f, 1.0f };
+    float m_offset[3] = { 0.0f, 0.0f, 0.0f };
+};
+
+typedef std::shared_ptr<const GpuTexturePackedValues> ConstGpuTexturePackedValuesRcPtr;
+
+// Return the texture format the shader creator actually supports for the requested one.
+GpuShaderCreator::TextureFormat GetSupportedTextureFormat(const GpuShaderCreatorRcPtr & shaderCreator);
+
+// Convert the texture values to the 16-bit format (which must not be TEXTURE_FORMAT_FLOAT32),
+// the conversion being only done once for identical values (see GetSharedTextureValues). The
+// channels (i.e. 1 or 3) are interleaved.
+ConstGpuTexturePackedValuesRcPtr GetSharedTexturePackedValues(const std::string & contentKey,
+                                                              GpuShaderCreator::TextureFormat format,
+                                                              const ConstGpuTextureValuesRcPtr & values,
+                                                              size_t numValues,
+                                                              unsigned numChannels);
+
+// Add a texture to the shader creator. The values are shared without any copy when the creator
+// is a GenericGpuShaderDesc, other creators get the regular add methods. The packed values are
+// only needed for the 16-bit texture formats.
+void AddTexture(GpuShaderCreatorRcPtr & shaderCreator,
+                const char * textureName,
+                const char * samplerName,
+                unsigned width, unsigned height,
+                GpuShaderDesc::TextureType channel,
+                GpuShaderDesc::TextureDimensions dimensions,
+                Interpolation interpolation,
+                const ConstGpuTextureValuesRcPtr & values,
+                const ConstGpuTexturePackedValuesRcPtr & packedValues);
+
+void Add3DTexture(GpuShaderCreatorRcPtr & shaderCreator,
+                  const char * textureName,
+                  const char * samplerName,
+                  unsigned edgelen,
+                  Interpolation interpolation,
+                  const ConstGpuTextureValuesRcPtr & values,
+                  const ConstGpuTexturePackedValuesRcPtr & packedValues);
+
 ///////////////////////////////////////////////////////////////////////////
 
 // GenericGpuShaderDesc
@@ -46,6 +110,26 @@ public:
                     const SizeGetter & getSize,
                     const VectorIntGetter & getVectorInt) override;
 
+    // Accessors to the uniform block
+    //
+    unsigned getUniformBlockSize() const noexcept override;
+    const char * getUniformBlockName() const noexcept override;
+    unsigned getUniformBlockOffset(unsigned index) const override;
+    void fillUniformBlock(void * buffer) const override;
+
+    // Accessors to the uniforms changed since the previous call
+    //
+    unsigned updateChangedUniforms() override;
+    unsigned getChangedUniform(unsigned index) const override;
+
+    // True when the uniforms are packed in the uniform block.
+    bool usesUniformBlock() const noexcept;
+    // Declare an existing uniform as a member of the uniform block.
+    void addUniformBlockMember(const char * name, UniformDataType type, unsigned arraySize);
+
+    // Add the uniform block declaration before building the shader program.
+    void finalize() override;
+
     // Accessors to the 1D & 2D textures built from 1D LUT
     //
     unsigned getNumTextures() const noexcept override;
@@ -64,6 +148,22 @@ public:
                     TextureDimensions & dimensions,
                     Interpolation & interpolation) const override;
     void getTextureValues(unsigned index, const float *& values) const override;
+    void getTexturePackedValues(unsigned index, const uint16_t *& values) const override;
+    TextureFormat getTexturePackedFormat(unsigned index) const override;
+
+    // Same as addTexture but the values are shared instead of copied.
+    void addSharedTexture(const char * textureName,
+                          const char * samplerName,
+                          unsigned width, unsigned height,
+                          TextureType channel,
+                          TextureDimensions dimensions,
+                          Interpolation interpolation,
+                          const ConstGpuTextureValuesRcPtr & values,
+                          const ConstGpuTexturePackedValuesRcPtr & packedValues);
+    // Get the shared values, the packed values being null for the 32-bit float format.
+    void getSharedTextureValues(unsigned index,
+                                ConstGpuTextureValuesRcPtr & values,
+                                ConstGpuTexturePackedValuesRcPtr & packedValues) const;
 
     // Accessors to the 3D textures built from 3D LUT
     //
@@ -79,6 +179,26 @@ public:
                       unsigned & edgelen,
                       Interpolation & interpolation) const override;
     void get3DTextureValues(unsigned index, const float *& value) const override;
+    void get3DTexturePackedValues(unsigned index, const uint16_t *& values) const override;
+    TextureFormat get3DTexturePackedFormat(unsigned index) const override;
+
+    // Same as add3DTexture but the values are shared instead of copied.
+    void addShared3DTexture(const char * textureName,
+                            const char * samplerName,
+                            unsigned edgelen,
+                            Interpolation interpolation,
+                            const ConstGpuTextureValuesRcPtr & values,
+                            const ConstGpuTexturePackedValuesRcPtr & packedValues);
+    void getShared3DTextureValues(unsigned index,
+                                  ConstGpuTextureValuesRcPtr & values,
+                                  ConstGpuTexturePackedValuesRcPtr & packedValues) const;
+
+    // Accessors to the shader creator state needed by the shader cache (see GPUProcessor.cpp).
+    //
+    // True when some shader code is already present.
+    bool hasShaderCode() const noexcept;
+    // The number of resource indices already used.
+    unsigned getNumResources() const noexcept;
 
 private:
 
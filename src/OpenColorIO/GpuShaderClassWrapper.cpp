@@ -39,6 +39,18 @@ std::unique_ptr<GpuShaderClassWrapper> GpuShaderClassWrapper::CreateClassWrapper
     }
 }
 
+std::unique_ptr<GpuShaderClassWrapper>
+    GpuShaderClassWrapper::CreateComputeClassWrapper(GpuLanguage language,
+                                                     GpuShaderCreator::ComputeBufferFormat inFormat,
+                                                     GpuShaderCreator::ComputeBufferFormat outFormat,
+                                                     unsigned workgroupWidth,
+                                                     unsigned workgroupHeight)
+{
+    return std::unique_ptr<ComputeShaderClassWrapper>(
+        new ComputeShaderClassWrapper(language, inFormat, outFormat,
+                                      workgroupWidth, workgroupHeight));
+}
+
 std::unique_ptr<GpuShaderClassWrapper> NullGpuShaderClassWrapper::clone() const
 {
     return std::unique_ptr<NullGpuShaderClassWrapper>(new NullGpuShaderClassWrapper());
@@ -421,4 +433,242 @@ MetalShaderClassWrapper& MetalShaderClassWrapper::operator=(const MetalShaderCla
     return *this;
 }
 
+ComputeShaderClassWrapper::ComputeShaderClassWrapper(GpuLanguage language,
+                                                     GpuShaderCreator::ComputeBufferFormat inFormat,
+                                                     GpuShaderCreator::ComputeBufferFormat outFormat,
+                                                     unsigned workgroupWidth,
+                                                     unsigned workgroupHeight)
+    :   GpuShaderClassWrapper()
+    ,   m_language(language)
+    ,   m_inFormat(inFormat)
+    ,   m_outFormat(outFormat)
+    ,   m_workgroupWidth(workgroupWidth)
+    ,   m_workgroupHeight(workgroupHeight)
+{
+}
+
+void ComputeShaderClassWrapper::prepareClassWrapper(const std::string & resourcePrefix,
+                                                    const std::string & functionName,
+                                                    const std::string & /*originalHeader*/)
+{
+    if (m_language != GPU_LANGUAGE_GLSL_4_0 && m_language != GPU_LANGUAGE_HLSL_DX11)
+    {
+        std::ostringstream oss;
+        oss << "The compute kernel is not supported for the GPU language '"
+            << GpuLanguageToString(m_language) << "'.";
+        throw Exception(oss.str().c_str());
+    }
+
+    m_resourcePrefix = resourcePrefix;
+    m_functionName   = functionName;
+}
+
+std::string ComputeShaderClassWrapper::getResourceName(const std::string & name) const
+{
+    return m_resourcePrefix.empty() ? name : m_resourcePrefix + "_" + name;
+}
+
+std::string
+    ComputeShaderClassWrapper::getBufferElementType(GpuShaderCreator::ComputeBufferFormat format) const
+{
+    const bool isGLSL = m_language == GPU_LANGUAGE_GLSL_4_0;
+
+    // The 16-bit channels are packed by pair and the 8-bit channels by four in 32-bit integers.
+    switch (format)
+    {
+        case GpuShaderCreator::COMPUTE_BUFFER_RGBA_FLOAT32:
+            return isGLSL ? "vec4" : "float4";
+        case GpuShaderCreator::COMPUTE_BUFFER_RGBA_HALF:
+        case GpuShaderCreator::COMPUTE_BUFFER_RGBA_UINT16:
+            return isGLSL ? "uvec2" : "uint2";
+        case GpuShaderCreator::COMPUTE_BUFFER_RGBA_UINT8:
+            return "uint";
+    }
+
+    throw Exception("Unknown compute buffer format.");
+}
+
+std::string ComputeShaderClassWrapper::getClassWrapperHeader(const std::string & originalHeader)
+{
+    GpuShaderText st(m_language);
+
+    const std::string inType  = getBufferElementType(m_inFormat);
+    const std::string outType = getBufferElementType(m_outFormat);
+
+    const std::string inBuffer  = getResourceName("inputPixels");
+    const std::string outBuffer = getResourceName("outputPixels");
+    const std::string imageSize = getResourceName("imageSize");
+    const std::string unpack    = getResourceName("unpackPixel");
+    const std::string pack      = getResourceName("packPixel");
+
+    st.newLine() << "";
+    st.newLine() << "// Declaration of the compute kernel resources";
+    st.newLine() << "";
+
+    if (m_language == GPU_LANGUAGE_GLSL_4_0)
+    {
+        st.newLine() << "layout(local_size_x = " << m_workgroupWidth
+                     << ", local_size_y = " << m_workgroupHeight << ") in;";
+        st.newLine() << "";
+        st.newLine() << "layout(std430, binding = 0) readonly buffer "
+                     << getResourceName("inputBuffer") << " { "
+                     << inType << " " << inBuffer << "[]; };";
+        st.newLine() << "layout(std430, binding = 1) writeonly buffer "
+                     << getResourceName("outputBuffer") << " { "
+                     << outType << " " << outBuffer << "[]; };";
+        st.newLine() << "";
+        st.newLine() << "uniform uvec2 " << imageSize << ";";
+
+        st.newLine() << "";
+        st.newLine() << "vec4 " << unpack << "(" << inType << " pixel)";
+        st.newLine() << "{";
+        st.indent();
+        switch (m_inFormat)
+        {
+            case GpuShaderCreator::COMPUTE_BUFFER_RGBA_FLOAT32:
+                st.newLine() << "return pixel;";
+                break;
+            case GpuShaderCreator::COMPUTE_BUFFER_RGBA_HALF:
+                st.newLine() << "return vec4(unpackHalf2x16(pixel.x), unpackHalf2x16(pixel.y));";
+                break;
+            case GpuShaderCreator::COMPUTE_BUFFER_RGBA_UINT8:
+                st.newLine() << "return unpackUnorm4x8(pixel);";
+                break;
+            case GpuShaderCreator::COMPUTE_BUFFER_RGBA_UINT16:
+                st.newLine() << "return vec4(unpackUnorm2x16(pixel.x), unpackUnorm2x16(pixel.y));";
+                break;
+        }
+        st.dedent();
+        st.newLine() << "}";
+
+        st.newLine() << "";
+        st.newLine() << outType << " " << pack << "(vec4 pixel)";
+        st.newLine() << "{";
+        st.indent();
+        switch (m_outFormat)
+        {
+            case GpuShaderCreator::COMPUTE_BUFFER_RGBA_FLOAT32:
+                st.newLine() << "return pixel;";
+                break;
+            case GpuShaderCreator::COMPUTE_BUFFER_RGBA_HALF:
+                st.newLine() << "return uvec2(packHalf2x16(pixel.rg), packHalf2x16(pixel.ba));";
+                break;
+            case GpuShaderCreator::COMPUTE_BUFFER_RGBA_UINT8:
+                st.newLine() << "return packUnorm4x8(pixel);";
+                break;
+            case GpuShaderCreator::COMPUTE_BUFFER_RGBA_UINT16:
+                st.newLine() << "return uvec2(packUnorm2x16(pixel.rg), packUnorm2x16(pixel.ba));";
+                break;
+        }
+        st.dedent();
+        st.newLine() << "}";
+    }
+    else
+    {
+        st.newLine() << "StructuredBuffer<" << inType << "> " << inBuffer << ";";
+        st.newLine() << "RWStructuredBuffer<" << outType << "> " << outBuffer << ";";
+        st.newLine() << "";
+        st.newLine() << "uniform uint2 " << imageSize << ";";
+
+        st.newLine() << "";
+        st.newLine() << "float4 " << unpack << "(" << inType << " pixel)";
+        st.newLine() << "{";
+        st.indent();
+        switch (m_inFormat)
+        {
+            case GpuShaderCreator::COMPUTE_BUFFER_RGBA_FLOAT32:
+                st.newLine() << "return pixel;";
+                break;
+            case GpuShaderCreator::COMPUTE_BUFFER_RGBA_HALF:
+                st.newLine() << "return f16tof32(uint4(pixel.x, pixel.x >> 16, pixel.y, pixel.y >> 16));";
+                break;
+            case GpuShaderCreator::COMPUTE_BUFFER_RGBA_UINT8:
+                st.newLine() << "return float4(uint4(pixel, pixel >> 8, pixel >> 16, pixel >> 24) & 0xFF) / 255.0;";
+                break;
+            case GpuShaderCreator::COMPUTE_BUFFER_RGBA_UINT16:
+                st.newLine() << "return float4(uint4(pixel.x, pixel.x >> 16, pixel.y, pixel.y >> 16) & 0xFFFF) / 65535.0;";
+                break;
+        }
+        st.dedent();
+        st.newLine() << "}";
+
+        st.newLine() << "";
+        st.newLine() << outType << " " << pack << "(float4 pixel)";
+        st.newLine() << "{";
+        st.indent();
+        switch (m_outFormat)
+        {
+            case GpuShaderCreator::COMPUTE_BUFFER_RGBA_FLOAT32:
+                st.newLine() << "return pixel;";
+                break;
+            case GpuShaderCreator::COMPUTE_BUFFER_RGBA_HALF:
+                st.newLine() << "uint4 h = f32tof16(pixel);";
+                st.newLine() << "return uint2(h.x | (h.y << 16), h.z | (h.w << 16));";
+                break;
+            case GpuShaderCreator::COMPUTE_BUFFER_RGBA_UINT8:
+                st.newLine() << "uint4 c = uint4(round(saturate(pixel) * 255.0));";
+                st.newLine() << "return c.x | (c.y << 8) | (c.z << 16) | (c.w << 24);";
+                break;
+            case GpuShaderCreator::COMPUTE_BUFFER_RGBA_UINT16:
+                st.newLine() << "uint4 c = uint4(round(saturate(pixel) * 65535.0));";
+                st.newLine() << "return uint2(c.x | (c.y << 16), c.z | (c.w << 16));";
+                break;
+        }
+        st.dedent();
+        st.newLine() << "}";
+    }
+
+    return originalHeader + st.string();
+}
+
+std::string ComputeShaderClassWrapper::getClassWrapperFooter(const std::string & originalFooter)
+{
+    GpuShaderText st(m_language);
+
+    const std::string imageSize = getResourceName("imageSize");
+
+    st.newLine() << "";
+    st.newLine() << "// Declaration of the compute kernel";
+    st.newLine() << "";
+
+    if (m_language == GPU_LANGUAGE_GLSL_4_0)
+    {
+        st.newLine() << "void main()";
+        st.newLine() << "{";
+        st.indent();
+        st.newLine() << "uvec2 pos = gl_GlobalInvocationID.xy;";
+    }
+    else
+    {
+        st.newLine() << "[numthreads(" << m_workgroupWidth << ", " << m_workgroupHeight << ", 1)]";
+        st.newLine() << "void " << m_functionName << "Kernel(uint3 id : SV_DispatchThreadID)";
+        st.newLine() << "{";
+        st.indent();
+        st.newLine() << "uint2 pos = id.xy;";
+    }
+
+    // The image size is rarely a multiple of the workgroup size.
+    st.newLine() << "if (pos.x >= " << imageSize << ".x || pos.y >= " << imageSize << ".y)";
+    st.newLine() << "{";
+    st.indent();
+    st.newLine() << "return;";
+    st.dedent();
+    st.newLine() << "}";
+    st.newLine() << "";
+    st.newLine() << "uint index = pos.y * " << imageSize << ".x + pos.x;";
+    st.newLine() << getResourceName("outputPixels") << "[index] = "
+                 << getResourceName("packPixel") << "(" << m_functionName << "("
+                 << getResourceName("unpackPixel") << "(" << getResourceName("inputPixels")
+                 << "[index])));";
+    st.dedent();
+    st.newLine() << "}";
+
+    return originalFooter + st.string();
+}
+
+std::unique_ptr<GpuShaderClassWrapper> ComputeShaderClassWrapper::clone() const
+{
+    return std::unique_ptr<ComputeShaderClassWrapper>(new ComputeShaderClassWrapper(*this));
+}
+
 } // namespace OCIO_NAMESPACE
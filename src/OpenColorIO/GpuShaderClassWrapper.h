@@ -24,6 +24,14 @@ public:
     // Factory method to blindly get the right class wrapper.
     static std::unique_ptr<GpuShaderClassWrapper> CreateClassWrapper(GpuLanguage language);
 
+    // Factory method to get the class wrapper generating a compute kernel.
+    static std::unique_ptr<GpuShaderClassWrapper>
+        CreateComputeClassWrapper(GpuLanguage language,
+                                  GpuShaderCreator::ComputeBufferFormat inFormat,
+                                  GpuShaderCreator::ComputeBufferFormat outFormat,
+                                  unsigned workgroupWidth,
+                                  unsigned workgroupHeight);
+
     virtual void prepareClassWrapper(const std::string & resourcePrefix,
                                      const std::string & functionName,
                                      const std::string & originalHeader) = 0;
@@ -112,6 +120,38 @@ private:
     std::vector<FunctionParam> m_functionParameters;
 };
 
+// Generate a compute kernel processing a buffer of pixels with the OCIO shader function.
+class ComputeShaderClassWrapper : public GpuShaderClassWrapper
+{
+public:
+    ComputeShaderClassWrapper(GpuLanguage language,
+                              GpuShaderCreator::ComputeBufferFormat inFormat,
+                              GpuShaderCreator::ComputeBufferFormat outFormat,
+                              unsigned workgroupWidth,
+                              unsigned workgroupHeight);
+
+    void prepareClassWrapper(const std::string & resourcePrefix,
+                             const std::string & functionName,
+                             const std::string & originalHeader) final;
+    std::string getClassWrapperHeader(const std::string & originalHeader) final;
+    std::string getClassWrapperFooter(const std::string & originalFooter) final;
+
+    std::unique_ptr<GpuShaderClassWrapper> clone() const final;
+
+private:
+    std::string getBufferElementType(GpuShaderCreator::ComputeBufferFormat format) const;
+    std::string getResourceName(const std::string & name) const;
+
+    GpuLanguage m_language;
+    GpuShaderCreator::ComputeBufferFormat m_inFormat;
+    GpuShaderCreator::ComputeBufferFormat m_outFormat;
+    unsigned m_workgroupWidth;
+    unsigned m_workgroupHeight;
+
+    std::string m_resourcePrefix;
+    std::string m_functionName;
+};
+
 } // namespace OCIO_NAMESPACE
 
 #endif
@@ -3,6 +3,7 @@
 
 #include <sstream>
 #include <memory>
+#include <unordered_set>
 
 #include <OpenColorIO/OpenColorIO.h>
 
@@ -28,6 +29,18 @@ public:
     std::string m_resourcePrefix;
     std::string m_pixelName;
     unsigned m_numResources = 0;
+    GpuShaderCreator::TextureFormat m_textureFormat = GpuShaderCreator::TEXTURE_FORMAT_FLOAT32;
+    bool m_useUniformBlock = false;
+
+    bool m_computeKernel = false;
+    GpuShaderCreator::ComputeBufferFormat m_computeInFormat
+        = GpuShaderCreator::COMPUTE_BUFFER_RGBA_FLOAT32;
+    GpuShaderCreator::ComputeBufferFormat m_computeOutFormat
+        = GpuShaderCreator::COMPUTE_BUFFER_RGBA_FLOAT32;
+    unsigned m_workgroupWidth  = 8;
+    unsigned m_workgroupHeight = 8;
+
+    bool m_compactShaderText = false;
 
     mutable std::string m_cacheID;
     mutable Mutex m_cacheIDMutex;
@@ -38,6 +51,10 @@ public:
     std::string m_functionBody;
     std::string m_functionFooter;
 
+    // The helper codes already added, and the number of duplicated ones which were ignored.
+    std::unordered_set<std::string> m_helperCodes;
+    unsigned m_numSharedHelpers = 0;
+
     std::string m_shaderCode;
     std::string m_shaderCodeID;
 
@@ -67,6 +84,14 @@ public:
             m_resourcePrefix = rhs.m_resourcePrefix;
             m_pixelName      = rhs.m_pixelName;
             m_numResources   = rhs.m_numResources;
+            m_textureFormat  = rhs.m_textureFormat;
+            m_useUniformBlock = rhs.m_useUniformBlock;
+            m_computeKernel    = rhs.m_computeKernel;
+            m_computeInFormat  = rhs.m_computeInFormat;
+            m_computeOutFormat = rhs.m_computeOutFormat;
+            m_workgroupWidth   = rhs.m_workgroupWidth;
+            m_workgroupHeight  = rhs.m_workgroupHeight;
+            m_compactShaderText = rhs.m_compactShaderText;
             m_cacheID        = rhs.m_cacheID;
 
             m_declarations   = rhs.m_declarations;
@@ -74,6 +99,9 @@ public:
             m_functionHeader = rhs.m_functionHeader;
             m_functionBody   = rhs.m_functionBody;
             m_functionFooter = rhs.m_functionFooter;
+
+            m_helperCodes      = rhs.m_helperCodes;
+            m_numSharedHelpers = rhs.m_numSharedHelpers;
             
             m_classWrappingInterface = rhs.m_classWrappingInterface->clone();
 
@@ -82,6 +110,18 @@ public:
         }
         return *this;
     }
+
+    void resetClassWrapper()
+    {
+        m_classWrappingInterface
+            = m_computeKernel
+                ? GpuShaderClassWrapper::CreateComputeClassWrapper(m_language,
+                                                                   m_computeInFormat,
+                                                                   m_computeOutFormat,
+                                                                   m_workgroupWidth,
+                                                                   m_workgroupHeight)
+                : GpuShaderClassWrapper::CreateClassWrapper(m_language);
+    }
 };
 
 GpuShaderCreator::GpuShaderCreator()
@@ -112,8 +152,7 @@ void GpuShaderCreator::setLanguage(GpuLanguage lang) noexcept
     AutoMutex lock(getImpl()->m_cacheIDMutex);
        
     getImpl()->m_language = lang;
-    getImpl()->m_classWrappingInterface
-        = GpuShaderClassWrapper::CreateClassWrapper(getImpl()->m_language);
+    getImpl()->resetClassWrapper();
 
     getImpl()->m_cacheID.clear();
 }
@@ -162,6 +201,99 @@ const char * GpuShaderCreator::getPixelName() const noexcept
     return getImpl()->m_pixelName.c_str();
 }
 
+void GpuShaderCreator::setTextureFormat(TextureFormat format) noexcept
+{
+    AutoMutex lock(getImpl()->m_cacheIDMutex);
+    getImpl()->m_textureFormat = format;
+    getImpl()->m_cacheID.clear();
+}
+
+GpuShaderCreator::TextureFormat GpuShaderCreator::getTextureFormat() const noexcept
+{
+    return getImpl()->m_textureFormat;
+}
+
+void GpuShaderCreator::setUseUniformBlock(bool use) noexcept
+{
+    AutoMutex lock(getImpl()->m_cacheIDMutex);
+    getImpl()->m_useUniformBlock = use;
+    getImpl()->m_cacheID.clear();
+}
+
+bool GpuShaderCreator::getUseUniformBlock() const noexcept
+{
+    return getImpl()->m_useUniformBlock;
+}
+
+void GpuShaderCreator::setComputeKernel(bool enabled) noexcept
+{
+    AutoMutex lock(getImpl()->m_cacheIDMutex);
+    getImpl()->m_computeKernel = enabled;
+    getImpl()->resetClassWrapper();
+    getImpl()->m_cacheID.clear();
+}
+
+bool GpuShaderCreator::getComputeKernel() const noexcept
+{
+    return getImpl()->m_computeKernel;
+}
+
+void GpuShaderCreator::setComputeBufferFormats(ComputeBufferFormat inFormat,
+                                               ComputeBufferFormat outFormat) noexcept
+{
+    AutoMutex lock(getImpl()->m_cacheIDMutex);
+    getImpl()->m_computeInFormat  = inFormat;
+    getImpl()->m_computeOutFormat = outFormat;
+    getImpl()->resetClassWrapper();
+    getImpl()->m_cacheID.clear();
+}
+
+GpuShaderCreator::ComputeBufferFormat GpuShaderCreator::getComputeInputFormat() const noexcept
+{
+    return getImpl()->m_computeInFormat;
+}
+
+GpuShaderCreator::ComputeBufferFormat GpuShaderCreator::getComputeOutputFormat() const noexcept
+{
+    return getImpl()->m_computeOutFormat;
+}
+
+void GpuShaderCreator::setComputeWorkgroupSize(unsigned width, unsigned height)
+{
+    if (width == 0 || height == 0)
+    {
+        throw Exception("The compute workgroup size must not be null.");
+    }
+
+    AutoMutex lock(getImpl()->m_cacheIDMutex);
+    getImpl()->m_workgroupWidth  = width;
+    getImpl()->m_workgroupHeight = height;
+    getImpl()->resetClassWrapper();
+    getImpl()->m_cacheID.clear();
+}
+
+unsigned GpuShaderCreator::getComputeWorkgroupWidth() const noexcept
+{
+    return getImpl()->m_workgroupWidth;
+}
+
+unsigned GpuShaderCreator::getComputeWorkgroupHeight() const noexcept
+{
+    return getImpl()->m_workgroupHeight;
+}
+
+void GpuShaderCreator::setCompactShaderText(bool compact) noexcept
+{
+    AutoMutex lock(getImpl()->m_cacheIDMutex);
+    getImpl()->m_compactShaderText = compact;
+    getImpl()->m_cacheID.clear();
+}
+
+bool GpuShaderCreator::getCompactShaderText() const noexcept
+{
+    return getImpl()->m_compactShaderText;
+}
+
 unsigned GpuShaderCreator::getNextResourceIndex() noexcept
 {
     return getImpl()->m_numResources++;
@@ -243,6 +375,29 @@ const char * GpuShaderCreator::getCacheID() const noexcept
         os << getImpl()->m_pixelName << " ";
         os << getImpl()->m_numResources << " ";
         os << getImpl()->m_shaderCodeID;
+        if (getImpl()->m_textureFormat != TEXTURE_FORMAT_FLOAT32)
+        {
+            // The texture values differ.
+            os << " " << TextureFormatToString(getImpl()->m_textureFormat);
+        }
+        if (getImpl()->m_useUniformBlock)
+        {
+            // The uniform declarations differ.
+            os << " uniform_block";
+        }
+        if (getImpl()->m_computeKernel)
+        {
+            // The kernel wraps the shader function.
+            os << " compute " << getImpl()->m_computeInFormat
+               << " " << getImpl()->m_computeOutFormat
+               << " " << getImpl()->m_workgroupWidth
+               << "x" << getImpl()->m_workgroupHeight;
+        }
+        if (getImpl()->m_compactShaderText)
+        {
+            // The helper names differ.
+            os << " compact";
+        }
         getImpl()->m_cacheID = os.str();
     }
 
@@ -260,11 +415,24 @@ void GpuShaderCreator::addToDeclareShaderCode(const char * shaderCode)
 
 void GpuShaderCreator::addToHelperShaderCode(const char * shaderCode)
 {
+    if (!shaderCode || !*shaderCode)
+    {
+        return;
+    }
+
+    // Ops with identical helpers (e.g. several ops using the same dynamic property) share
+    // them, as declaring them again would fail the shader program compilation.
+    if (!getImpl()->m_helperCodes.insert(shaderCode).second)
+    {
+        ++getImpl()->m_numSharedHelpers;
+        return;
+    }
+
     if(getImpl()->m_helperMethods.empty())
     {
         getImpl()->m_helperMethods += "\n// Declaration of all helper methods\n\n";
     }
-    getImpl()->m_helperMethods += (shaderCode && *shaderCode) ? shaderCode : "";
+    getImpl()->m_helperMethods += shaderCode;
 }
 
 void GpuShaderCreator::addToFunctionShaderCode(const char * shaderCode)
@@ -318,6 +486,23 @@ void GpuShaderCreator::finalize()
     getImpl()->m_functionFooter
         = getImpl()->m_classWrappingInterface->getClassWrapperFooter(getImpl()->m_functionFooter);
 
+    // Remove everything not needed by the shader compiler.
+
+    const size_t fullSize = getImpl()->m_declarations.size()
+                          + getImpl()->m_helperMethods.size()
+                          + getImpl()->m_functionHeader.size()
+                          + getImpl()->m_functionBody.size()
+                          + getImpl()->m_functionFooter.size();
+
+    if (getImpl()->m_compactShaderText)
+    {
+        getImpl()->m_declarations   = CompactShaderText(getImpl()->m_declarations);
+        getImpl()->m_helperMethods  = CompactShaderText(getImpl()->m_helperMethods);
+        getImpl()->m_functionHeader = CompactShaderText(getImpl()->m_functionHeader);
+        getImpl()->m_functionBody   = CompactShaderText(getImpl()->m_functionBody);
+        getImpl()->m_functionFooter = CompactShaderText(getImpl()->m_functionFooter);
+    }
+
     // Build the complete shader program.
 
     createShaderText(getImpl()->m_declarations.c_str(),
@@ -333,7 +518,13 @@ void GpuShaderCreator::finalize()
         oss << std::endl
             << "**" << std::endl
             << "GPU Fragment Shader program" << std::endl
-            << getImpl()->m_shaderCode << std::endl;
+            << getImpl()->m_shaderCode << std::endl
+            << "Size: " << getImpl()->m_shaderCode.size() << " bytes";
+        if (getImpl()->m_compactShaderText)
+        {
+            oss << " (" << fullSize << " bytes before compaction)";
+        }
+        oss << ", shared helpers: " << getImpl()->m_numSharedHelpers << std::endl;
 
         LogDebug(oss.str());
     }
@@ -363,9 +554,82 @@ GpuShaderCreatorRcPtr GpuShaderDesc::clone() const
     return DynamicPtrCast<GpuShaderCreator>(gpuDesc);
 }
 
+void GpuShaderDesc::getTexturePackedValues(unsigned, const uint16_t *&) const
+{
+    throw Exception("The shader desc does not support packed texture values.");
+}
+
+void GpuShaderDesc::get3DTexturePackedValues(unsigned, const uint16_t *&) const
+{
+    throw Exception("The shader desc does not support packed texture values.");
+}
+
+GpuShaderCreator::TextureFormat GpuShaderDesc::getTexturePackedFormat(unsigned) const
+{
+    return TEXTURE_FORMAT_FLOAT32;
+}
+
+GpuShaderCreator::TextureFormat GpuShaderDesc::get3DTexturePackedFormat(unsigned) const
+{
+    return TEXTURE_FORMAT_FLOAT32;
+}
+
+unsigned GpuShaderDesc::getUniformBlockSize() const noexcept
+{
+    return 0;
+}
+
+const char * GpuShaderDesc::getUniformBlockName() const noexcept
+{
+    return "";
+}
+
+unsigned GpuShaderDesc::getUniformBlockOffset(unsigned) const
+{
+    throw Exception("The shader desc does not support the uniform block.");
+}
+
+void GpuShaderDesc::fillUniformBlock(void *) const
+{
+    throw Exception("The shader desc does not support the uniform block.");
+}
+
+unsigned GpuShaderDesc::updateChangedUniforms()
+{
+    // Without any change tracking, all the uniforms are reported as changed.
+    return getNumUniforms();
+}
+
+unsigned GpuShaderDesc::getChangedUniform(unsigned index) const
+{
+    if (index >= getNumUniforms())
+    {
+        std::ostringstream ss;
+        ss << "Changed uniforms access error: index = " << index
+           << " where size = " << getNumUniforms();
+        throw Exception(ss.str().c_str());
+    }
+    return index;
+}
+
 const char * GpuShaderDesc::getShaderText() const noexcept
 {
     return getImpl()->m_shaderCode.c_str();
 }
 
+bool GenericGpuShaderDesc::hasShaderCode() const noexcept
+{
+    return !getImpl()->m_declarations.empty()
+        || !getImpl()->m_helperMethods.empty()
+        || !getImpl()->m_functionHeader.empty()
+        || !getImpl()->m_functionBody.empty()
+        || !getImpl()->m_functionFooter.empty()
+        || !getImpl()->m_shaderCode.empty();
+}
+
+unsigned GenericGpuShaderDesc::getNumResources() const noexcept
+{
+    return getImpl()->m_numResources;
+}
+
 } // namespace OCIO_NAMESPACE
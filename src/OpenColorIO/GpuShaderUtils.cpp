@@ -5,6 +5,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "GpuShader.h"
 #include "GpuShaderUtils.h"
 #include "MathUtils.h"
 #include "utils/StringUtils.h"
@@ -168,7 +169,9 @@ std::string getTexSample(GpuLanguage lang,
         }
         case GPU_LANGUAGE_HLSL_DX11:
         {
-            kw << textureName << ".Sample(" << samplerName << ", " << coords << ")";
+            // The LUT textures have no mipmaps so, sampling the level 0 is equivalent to Sample()
+            // which is only available to the pixel shaders (i.e. not to the compute shaders).
+            kw << textureName << ".SampleLevel(" << samplerName << ", " << coords << ", 0)";
             break;
         }
         case GPU_LANGUAGE_GLSL_4_0:
@@ -1158,6 +1161,80 @@ std::string BuildResourceName(GpuShaderCreatorRcPtr & shaderCreator, const std::
     return name;
 }
 
+bool IsUniformBlockSupported(GpuLanguage lang)
+{
+    switch (lang)
+    {
+        case GPU_LANGUAGE_GLSL_4_0:
+        case GPU_LANGUAGE_GLSL_ES_3_0:
+        case GPU_LANGUAGE_HLSL_DX11:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void DeclareUniform(GpuShaderCreatorRcPtr & shaderCreator, const std::string & name,
+                    UniformDataType type, unsigned arraySize)
+{
+    auto genericDesc = DynamicPtrCast<GenericGpuShaderDesc>(shaderCreator);
+    if (genericDesc && genericDesc->usesUniformBlock())
+    {
+        genericDesc->addUniformBlockMember(name.c_str(), type, arraySize);
+        return;
+    }
+
+    GpuShaderText stDecl(shaderCreator->getLanguage());
+    switch (type)
+    {
+        case UNIFORM_DOUBLE:
+            stDecl.declareUniformFloat(name);
+            break;
+        case UNIFORM_BOOL:
+            stDecl.declareUniformBool(name);
+            break;
+        case UNIFORM_FLOAT3:
+            stDecl.declareUniformFloat3(name);
+            break;
+        case UNIFORM_VECTOR_FLOAT:
+            stDecl.declareUniformArrayFloat(name, arraySize);
+            break;
+        case UNIFORM_VECTOR_INT:
+            stDecl.declareUniformArrayInt(name, arraySize);
+            break;
+        case UNIFORM_UNKNOWN:
+            throw Exception("Unknown uniform type.");
+    }
+    shaderCreator->addToDeclareShaderCode(stDecl.string().c_str());
+}
+
+std::string CompactShaderText(const std::string & shaderText)
+{
+    std::string compacted;
+    compacted.reserve(shaderText.size());
+
+    for (const auto & line : StringUtils::SplitByLines(shaderText))
+    {
+        std::string code = line.substr(0, line.find("//"));
+        code = StringUtils::Trim(code);
+
+        // Some class wrappers use the C-style comments.
+        if (StringUtils::StartsWith(code, "/*") && StringUtils::EndsWith(code, "*/")
+            && code.find("*/") == code.size() - 2)
+        {
+            continue;
+        }
+
+        if (!code.empty())
+        {
+            compacted += code;
+            compacted += "\n";
+        }
+    }
+
+    return compacted;
+}
+
 //
 // Convert scene-linear values to "grading log".  Grading Log is in units of F-Stops
 // with 0 being 18% grey.  Above about -5, it is pretty much exactly F-Stops but below
@@ -251,6 +251,19 @@ private:
 std::string BuildResourceName(GpuShaderCreatorRcPtr & shaderCreator, const std::string & prefix,
                               const std::string & base);
 
+// Is the GPU language able to pack the uniforms in a uniform block?
+bool IsUniformBlockSupported(GpuLanguage lang);
+
+// Declare a uniform already added to the shaderCreator, either individually or as a member of
+// the uniform block (see GpuShaderCreator::setUseUniformBlock). The array size is only needed
+// by the UNIFORM_VECTOR_FLOAT & UNIFORM_VECTOR_INT types.
+void DeclareUniform(GpuShaderCreatorRcPtr & shaderCreator, const std::string & name,
+                    UniformDataType type, unsigned arraySize = 0);
+
+// Remove the comments, the indentation and the empty lines of a shader program text. The line
+// breaks are preserved as preprocessor directives need them.
+std::string CompactShaderText(const std::string & shaderText);
+
 //
 // Math functions used by multiple GPU renderers.
 //
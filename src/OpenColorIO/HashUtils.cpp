@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <cstring>
 #include <sstream>
 
 #include <OpenColorIO/OpenColorIO.h>
@@ -25,4 +26,23 @@ std::string CacheIDHash(const char * array, std::size_t size)
     return oss.str();
 }
 
+void Hasher::addBytes(const void * data, std::size_t size) noexcept
+{
+    // Chain the hashes by using the current hash as the seed.
+    m_hash = XXH3_64bits_withSeed(data, size, m_hash);
+}
+
+void Hasher::addString(const char * str) noexcept
+{
+    const std::size_t length = str ? strlen(str) : 0;
+    addValue(length);
+    addBytes(str, length);
+}
+
+void Hasher::addString(const std::string & str) noexcept
+{
+    addValue(str.size());
+    addBytes(str.c_str(), str.size());
+}
+
 } // namespace OCIO_NAMESPACE
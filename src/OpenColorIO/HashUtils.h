@@ -7,13 +7,50 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include <cstdint>
 #include <string>
+#include <type_traits>
 
 namespace OCIO_NAMESPACE
 {
 
 std::string CacheIDHash(const char * array, std::size_t size);
 
+// Incremental 64-bit hash used to build structural hashes (i.e. computed from the values and not
+// from a string serialization of the values).
+class Hasher
+{
+public:
+    Hasher() = default;
+
+    void addBytes(const void * data, std::size_t size) noexcept;
+
+    template<typename T>
+    void addValue(T value) noexcept
+    {
+        static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                      "Only arithmetic and enum types are supported.");
+        addBytes(&value, sizeof(T));
+    }
+
+    template<typename T>
+    void addValues(const T * values, std::size_t numValues) noexcept
+    {
+        static_assert(std::is_arithmetic<T>::value, "Only arithmetic types are supported.");
+        addValue(numValues);
+        addBytes(values, numValues * sizeof(T));
+    }
+
+    // Note that a null string and an empty string have the same hash.
+    void addString(const char * str) noexcept;
+    void addString(const std::string & str) noexcept;
+
+    std::uint64_t digest() const noexcept { return m_hash; }
+
+private:
+    std::uint64_t m_hash = 0;
+};
+
 } // namespace OCIO_NAMESPACE
 
 #endif
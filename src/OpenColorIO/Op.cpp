@@ -40,6 +40,11 @@ DynamicPropertyRcPtr OpCPU::getDynamicProperty(DynamicPropertyType /* type */) c
     throw Exception("Op does not implement dynamic property.");
 }
 
+ConstOpCPURcPtr OpCPU::overrideDynamicProperties(const DynamicPropertyOverrides & /* values */) const
+{
+    return ConstOpCPURcPtr();
+}
+
 OpData::OpData()
     :   m_metadata()
 { }
@@ -48,6 +48,10 @@ public:
     virtual bool isDynamic() const;
     virtual bool hasDynamicProperty(DynamicPropertyType type) const;
     virtual DynamicPropertyRcPtr getDynamicProperty(DynamicPropertyType type) const;
+
+    // Create a renderer using the values from the overrides in place of the current values of
+    // its dynamic properties. Return null if none of its dynamic properties is overridden.
+    virtual ConstOpCPURcPtr overrideDynamicProperties(const DynamicPropertyOverrides & values) const;
 };
 
 class OpData;
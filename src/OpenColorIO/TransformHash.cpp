@@ -0,0 +1,591 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <sstream>
+#include <typeinfo>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "TransformHash.h"
+#include "transforms/Lut1DTransform.h"
+#include "transforms/Lut3DTransform.h"
+
+
+namespace OCIO_NAMESPACE
+{
+
+namespace
+{
+
+void AddRGBM(Hasher & hasher, const GradingRGBM & value)
+{
+    hasher.addValue(value.m_red);
+    hasher.addValue(value.m_green);
+    hasher.addValue(value.m_blue);
+    hasher.addValue(value.m_master);
+}
+
+void AddRGBMSW(Hasher & hasher, const GradingRGBMSW & value)
+{
+    hasher.addValue(value.m_red);
+    hasher.addValue(value.m_green);
+    hasher.addValue(value.m_blue);
+    hasher.addValue(value.m_master);
+    hasher.addValue(value.m_start);
+    hasher.addValue(value.m_width);
+}
+
+void AddHash(Hasher & hasher, const AllocationTransform & t)
+{
+    hasher.addValue(t.getAllocation());
+
+    const int numVars = t.getNumVars();
+    std::vector<float> vars(numVars);
+    if (numVars > 0)
+    {
+        t.getVars(vars.data());
+    }
+    hasher.addValues(vars.data(), vars.size());
+}
+
+void AddHash(Hasher & hasher, const CDLTransform & t)
+{
+    hasher.addValue(t.getStyle());
+
+    double sop[9];
+    t.getSOP(sop);
+    hasher.addValues(sop, 9);
+    hasher.addValue(t.getSat());
+}
+
+void AddHash(Hasher & hasher, const ExponentTransform & t)
+{
+    double values[4];
+    t.getValue(values);
+    hasher.addValues(values, 4);
+    hasher.addValue(t.getNegativeStyle());
+}
+
+void AddHash(Hasher & hasher, const ExponentWithLinearTransform & t)
+{
+    double gamma[4];
+    t.getGamma(gamma);
+    hasher.addValues(gamma, 4);
+
+    double offset[4];
+    t.getOffset(offset);
+    hasher.addValues(offset, 4);
+
+    hasher.addValue(t.getNegativeStyle());
+}
+
+void AddHash(Hasher & hasher, const ExposureContrastTransform & t)
+{
+    hasher.addValue(t.getStyle());
+    hasher.addValue(t.getExposure());
+    hasher.addValue(t.isExposureDynamic());
+    hasher.addValue(t.getContrast());
+    hasher.addValue(t.isContrastDynamic());
+    hasher.addValue(t.getGamma());
+    hasher.addValue(t.isGammaDynamic());
+    hasher.addValue(t.getPivot());
+    hasher.addValue(t.getLogExposureStep());
+    hasher.addValue(t.getLogMidGray());
+}
+
+void AddHash(Hasher & hasher, const FixedFunctionTransform & t)
+{
+    hasher.addValue(t.getStyle());
+
+    const size_t numParams = t.getNumParams();
+    std::vector<double> params(numParams);
+    if (numParams > 0)
+    {
+        t.getParams(params.data());
+    }
+    hasher.addValues(params.data(), params.size());
+}
+
+void AddHash(Hasher & hasher, const GradingPrimaryTransform & t)
+{
+    hasher.addValue(t.getStyle());
+    hasher.addValue(t.isDynamic());
+
+    const GradingPrimary & value = t.getValue();
+    AddRGBM(hasher, value.m_brightness);
+    AddRGBM(hasher, value.m_contrast);
+    AddRGBM(hasher, value.m_gamma);
+    AddRGBM(hasher, value.m_offset);
+    AddRGBM(hasher, value.m_exposure);
+    AddRGBM(hasher, value.m_lift);
+    AddRGBM(hasher, value.m_gain);
+    hasher.addValue(value.m_saturation);
+    hasher.addValue(value.m_pivot);
+    hasher.addValue(value.m_pivotBlack);
+    hasher.addValue(value.m_pivotWhite);
+    hasher.addValue(value.m_clampBlack);
+    hasher.addValue(value.m_clampWhite);
+}
+
+void AddHash(Hasher & hasher, const GradingRGBCurveTransform & t)
+{
+    hasher.addValue(t.getStyle());
+    hasher.addValue(t.isDynamic());
+    hasher.addValue(t.getBypassLinToLog());
+
+    const ConstGradingRGBCurveRcPtr value = t.getValue();
+    for (int c = 0; c < RGB_NUM_CURVES; ++c)
+    {
+        const ConstGradingBSplineCurveRcPtr curve = value->getCurve(static_cast<RGBCurveType>(c));
+        const size_t numPoints = curve->getNumControlPoints();
+        hasher.addValue(numPoints);
+        for (size_t p = 0; p < numPoints; ++p)
+        {
+            const GradingControlPoint & pt = curve->getControlPoint(p);
+            hasher.addValue(pt.m_x);
+            hasher.addValue(pt.m_y);
+            hasher.addValue(curve->getSlope(p));
+        }
+    }
+}
+
+void AddHash(Hasher & hasher, const GradingToneTransform & t)
+{
+    hasher.addValue(t.getStyle());
+    hasher.addValue(t.isDynamic());
+
+    const GradingTone & value = t.getValue();
+    AddRGBMSW(hasher, value.m_blacks);
+    AddRGBMSW(hasher, value.m_shadows);
+    AddRGBMSW(hasher, value.m_midtones);
+    AddRGBMSW(hasher, value.m_highlights);
+    AddRGBMSW(hasher, value.m_whites);
+    hasher.addValue(value.m_scontrast);
+}
+
+void AddHash(Hasher & hasher, const GroupTransform & t)
+{
+    const int numTransforms = t.getNumTransforms();
+    hasher.addValue(numTransforms);
+    for (int idx = 0; idx < numTransforms; ++idx)
+    {
+        AddTransformHash(hasher, t.getTransform(idx));
+    }
+}
+
+template<typename T>
+void AddLogParams(Hasher & hasher, const T & t)
+{
+    hasher.addValue(t.getBase());
+
+    double values[3];
+    t.getLogSideSlopeValue(values);
+    hasher.addValues(values, 3);
+    t.getLogSideOffsetValue(values);
+    hasher.addValues(values, 3);
+    t.getLinSideSlopeValue(values);
+    hasher.addValues(values, 3);
+    t.getLinSideOffsetValue(values);
+    hasher.addValues(values, 3);
+}
+
+void AddHash(Hasher & hasher, const LogCameraTransform & t)
+{
+    AddLogParams(hasher, t);
+
+    double values[3];
+    t.getLinSideBreakValue(values);
+    hasher.addValues(values, 3);
+
+    const bool hasLinearSlope = t.getLinearSlopeValue(values);
+    hasher.addValue(hasLinearSlope);
+    if (hasLinearSlope)
+    {
+        hasher.addValues(values, 3);
+    }
+}
+
+void AddHash(Hasher & hasher, const Lut1DTransform & t)
+{
+    const Lut1DTransformImpl & impl = static_cast<const Lut1DTransformImpl &>(t);
+    const Lut1DOpData & data = impl.data();
+
+    hasher.addValue(t.getFileOutputBitDepth());
+    hasher.addValue(data.getInterpolation());
+    hasher.addValue(data.isInputHalfDomain());
+    hasher.addValue(data.isOutputRawHalfs());
+    hasher.addValue(data.getHueAdjust());
+
+    // The LUT values are only hashed once per transform instance.
+    hasher.addValue(impl.getValuesHash());
+}
+
+void AddHash(Hasher & hasher, const Lut3DTransform & t)
+{
+    const Lut3DTransformImpl & impl = static_cast<const Lut3DTransformImpl &>(t);
+    const Lut3DOpData & data = impl.data();
+
+    hasher.addValue(t.getFileOutputBitDepth());
+    hasher.addValue(data.getInterpolation());
+    hasher.addValue(t.getGridSize());
+
+    // The LUT values are only hashed once per transform instance.
+    hasher.addValue(impl.getValuesHash());
+}
+
+void AddHash(Hasher & hasher, const MatrixTransform & t)
+{
+    hasher.addValue(t.getFileInputBitDepth());
+    hasher.addValue(t.getFileOutputBitDepth());
+
+    double m44[16];
+    t.getMatrix(m44);
+    hasher.addValues(m44, 16);
+
+    double offset4[4];
+    t.getOffset(offset4);
+    hasher.addValues(offset4, 4);
+}
+
+void AddHash(Hasher & hasher, const RangeTransform & t)
+{
+    hasher.addValue(t.getStyle());
+    hasher.addValue(t.getFileInputBitDepth());
+    hasher.addValue(t.getFileOutputBitDepth());
+
+    hasher.addValue(t.hasMinInValue());
+    hasher.addValue(t.hasMinInValue() ? t.getMinInValue() : 0.);
+    hasher.addValue(t.hasMaxInValue());
+    hasher.addValue(t.hasMaxInValue() ? t.getMaxInValue() : 0.);
+    hasher.addValue(t.hasMinOutValue());
+    hasher.addValue(t.hasMinOutValue() ? t.getMinOutValue() : 0.);
+    hasher.addValue(t.hasMaxOutValue());
+    hasher.addValue(t.hasMaxOutValue() ? t.getMaxOutValue() : 0.);
+}
+
+} // anon.
+
+void AddTransformHash(Hasher & hasher, const Transform & transform)
+{
+    const TransformType type = transform.getTransformType();
+    hasher.addValue(type);
+    hasher.addValue(transform.getDirection());
+
+    switch (type)
+    {
+        case TRANSFORM_TYPE_ALLOCATION:
+        {
+            AddHash(hasher, static_cast<const AllocationTransform &>(transform));
+            break;
+        }
+        case TRANSFORM_TYPE_BUILTIN:
+        {
+            hasher.addString(static_cast<const BuiltinTransform &>(transform).getStyle());
+            break;
+        }
+        case TRANSFORM_TYPE_CDL:
+        {
+            AddHash(hasher, static_cast<const CDLTransform &>(transform));
+            break;
+        }
+        case TRANSFORM_TYPE_COLORSPACE:
+        {
+            const auto & t = static_cast<const ColorSpaceTransform &>(transform);
+            hasher.addString(t.getSrc());
+            hasher.addString(t.getDst());
+            hasher.addValue(t.getDataBypass());
+            break;
+        }
+        case TRANSFORM_TYPE_DISPLAY_VIEW:
+        {
+            const auto & t = static_cast<const DisplayViewTransform &>(transform);
+            hasher.addString(t.getSrc());
+            hasher.addString(t.getDisplay());
+            hasher.addString(t.getView());
+            hasher.addValue(t.getLooksBypass());
+            hasher.addValue(t.getDataBypass());
+            break;
+        }
+        case TRANSFORM_TYPE_EXPONENT:
+        {
+            AddHash(hasher, static_cast<const ExponentTransform &>(transform));
+            break;
+        }
+        case TRANSFORM_TYPE_EXPONENT_WITH_LINEAR:
+        {
+            AddHash(hasher, static_cast<const ExponentWithLinearTransform &>(transform));
+            break;
+        }
+        case TRANSFORM_TYPE_EXPOSURE_CONTRAST:
+        {
+            AddHash(hasher, static_cast<const ExposureContrastTransform &>(transform));
+            break;
+        }
+        case TRANSFORM_TYPE_FILE:
+        {
+            const auto & t = static_cast<const FileTransform &>(transform);
+            hasher.addString(t.getSrc());
+            hasher.addString(t.getCCCId());
+            hasher.addValue(t.getCDLStyle());
+            hasher.addValue(t.getInterpolation());
+            break;
+        }
+        case TRANSFORM_TYPE_FIXED_FUNCTION:
+        {
+            AddHash(hasher, static_cast<const FixedFunctionTransform &>(transform));
+            break;
+        }
+        case TRANSFORM_TYPE_GRADING_PRIMARY:
+        {
+            AddHash(hasher, static_cast<const GradingPrimaryTransform &>(transform));
+            break;
+        }
+        case TRANSFORM_TYPE_GRADING_RGB_CURVE:
+        {
+            AddHash(hasher, static_cast<const GradingRGBCurveTransform &>(transform));
+            break;
+        }
+        case TRANSFORM_TYPE_GRADING_TONE:
+        {
+            AddHash(hasher, static_cast<const GradingToneTransform &>(transform));
+            break;
+        }
+        case TRANSFORM_TYPE_GROUP:
+        {
+            AddHash(hasher, static_cast<const GroupTransform &>(transform));
+            break;
+        }
+        case TRANSFORM_TYPE_LOG_AFFINE:
+        {
+            AddLogParams(hasher, static_cast<const LogAffineTransform &>(transform));
+            break;
+        }
+        case TRANSFORM_TYPE_LOG_CAMERA:
+        {
+            AddHash(hasher, static_cast<const LogCameraTransform &>(transform));
+            break;
+        }
+        case TRANSFORM_TYPE_LOG:
+        {
+            hasher.addValue(static_cast<const LogTransform &>(transform).getBase());
+            break;
+        }
+        case TRANSFORM_TYPE_LOOK:
+        {
+            const auto & t = static_cast<const LookTransform &>(transform);
+            hasher.addString(t.getSrc());
+            hasher.addString(t.getDst());
+            hasher.addString(t.getLooks());
+            hasher.addValue(t.getSkipColorSpaceConversion());
+            break;
+        }
+        case TRANSFORM_TYPE_LUT1D:
+        {
+            AddHash(hasher, static_cast<const Lut1DTransform &>(transform));
+            break;
+        }
+        case TRANSFORM_TYPE_LUT3D:
+        {
+            AddHash(hasher, static_cast<const Lut3DTransform &>(transform));
+            break;
+        }
+        case TRANSFORM_TYPE_MATRIX:
+        {
+            AddHash(hasher, static_cast<const MatrixTransform &>(transform));
+            break;
+        }
+        case TRANSFORM_TYPE_RANGE:
+        {
+            AddHash(hasher, static_cast<const RangeTransform &>(transform));
+            break;
+        }
+        default:
+        {
+            std::ostringstream error;
+            error << "Unknown transform type for hashing: "
+                  << typeid(transform).name();
+
+            throw Exception(error.str().c_str());
+        }
+    }
+}
+
+void AddTransformHash(Hasher & hasher, const ConstTransformRcPtr & transform)
+{
+    if (transform)
+    {
+        AddTransformHash(hasher, *transform);
+    }
+    else
+    {
+        hasher.addValue(-1);
+    }
+}
+
+std::uint64_t GetTransformHash(const Transform & transform)
+{
+    Hasher hasher;
+    AddTransformHash(hasher, transform);
+    return hasher.digest();
+}
+
+namespace
+{
+
+template<typename T>
+void AddAliases(Hasher & hasher, const T & element)
+{
+    const size_t numAliases = element.getNumAliases();
+    hasher.addValue(numAliases);
+    for (size_t idx = 0; idx < numAliases; ++idx)
+    {
+        hasher.addString(element.getAlias(idx));
+    }
+}
+
+template<typename T>
+void AddCategories(Hasher & hasher, const T & element)
+{
+    const int numCategories = element.getNumCategories();
+    hasher.addValue(numCategories);
+    for (int idx = 0; idx < numCategories; ++idx)
+    {
+        hasher.addString(element.getCategory(idx));
+    }
+}
+
+} // anon.
+
+std::uint64_t GetColorSpaceHash(const ColorSpace & cs)
+{
+    Hasher hasher;
+
+    hasher.addString(cs.getName());
+    AddAliases(hasher, cs);
+    hasher.addString(cs.getFamily());
+    hasher.addString(cs.getEqualityGroup());
+    hasher.addString(cs.getDescription());
+    hasher.addString(cs.getEncoding());
+    AddCategories(hasher, cs);
+
+    hasher.addValue(cs.getReferenceSpaceType());
+    hasher.addValue(cs.getBitDepth());
+    hasher.addValue(cs.isData());
+
+    hasher.addValue(cs.getAllocation());
+    std::vector<float> vars(cs.getAllocationNumVars());
+    if (!vars.empty())
+    {
+        cs.getAllocationVars(vars.data());
+    }
+    hasher.addValues(vars.data(), vars.size());
+
+    AddTransformHash(hasher, cs.getTransform(COLORSPACE_DIR_TO_REFERENCE));
+    AddTransformHash(hasher, cs.getTransform(COLORSPACE_DIR_FROM_REFERENCE));
+
+    return hasher.digest();
+}
+
+std::uint64_t GetLookHash(const Look & look)
+{
+    Hasher hasher;
+
+    hasher.addString(look.getName());
+    hasher.addString(look.getProcessSpace());
+    hasher.addString(look.getDescription());
+
+    AddTransformHash(hasher, look.getTransform());
+    AddTransformHash(hasher, look.getInverseTransform());
+
+    return hasher.digest();
+}
+
+std::uint64_t GetViewTransformHash(const ViewTransform & vt)
+{
+    Hasher hasher;
+
+    hasher.addString(vt.getName());
+    hasher.addString(vt.getFamily());
+    hasher.addString(vt.getDescription());
+    AddCategories(hasher, vt);
+    hasher.addValue(vt.getReferenceSpaceType());
+
+    AddTransformHash(hasher, vt.getTransform(VIEWTRANSFORM_DIR_TO_REFERENCE));
+    AddTransformHash(hasher, vt.getTransform(VIEWTRANSFORM_DIR_FROM_REFERENCE));
+
+    return hasher.digest();
+}
+
+std::uint64_t GetNamedTransformHash(const NamedTransform & nt)
+{
+    Hasher hasher;
+
+    hasher.addString(nt.getName());
+    AddAliases(hasher, nt);
+    hasher.addString(nt.getFamily());
+    hasher.addString(nt.getDescription());
+    hasher.addString(nt.getEncoding());
+    AddCategories(hasher, nt);
+
+    AddTransformHash(hasher, nt.getTransform(TRANSFORM_DIR_FORWARD));
+    AddTransformHash(hasher, nt.getTransform(TRANSFORM_DIR_INVERSE));
+
+    return hasher.digest();
+}
+
+void AddFileRulesHash(Hasher & hasher, const FileRules & rules)
+{
+    const size_t numRules = rules.getNumEntries();
+    hasher.addValue(numRules);
+    for (size_t idx = 0; idx < numRules; ++idx)
+    {
+        hasher.addString(rules.getName(idx));
+        hasher.addString(rules.getColorSpace(idx));
+        hasher.addString(rules.getPattern(idx));
+        hasher.addString(rules.getExtension(idx));
+        hasher.addString(rules.getRegex(idx));
+
+        const size_t numKeys = rules.getNumCustomKeys(idx);
+        hasher.addValue(numKeys);
+        for (size_t key = 0; key < numKeys; ++key)
+        {
+            hasher.addString(rules.getCustomKeyName(idx, key));
+            hasher.addString(rules.getCustomKeyValue(idx, key));
+        }
+    }
+}
+
+void AddViewingRulesHash(Hasher & hasher, const ViewingRules & rules)
+{
+    const size_t numRules = rules.getNumEntries();
+    hasher.addValue(numRules);
+    for (size_t idx = 0; idx < numRules; ++idx)
+    {
+        hasher.addString(rules.getName(idx));
+
+        const size_t numColorSpaces = rules.getNumColorSpaces(idx);
+        hasher.addValue(numColorSpaces);
+        for (size_t cs = 0; cs < numColorSpaces; ++cs)
+        {
+            hasher.addString(rules.getColorSpace(idx, cs));
+        }
+
+        const size_t numEncodings = rules.getNumEncodings(idx);
+        hasher.addValue(numEncodings);
+        for (size_t enc = 0; enc < numEncodings; ++enc)
+        {
+            hasher.addString(rules.getEncoding(idx, enc));
+        }
+
+        const size_t numKeys = rules.getNumCustomKeys(idx);
+        hasher.addValue(numKeys);
+        for (size_t key = 0; key < numKeys; ++key)
+        {
+            hasher.addString(rules.getCustomKeyName(idx, key));
+            hasher.addString(rules.getCustomKeyValue(idx, key));
+        }
+    }
+}
+
+} // namespace OCIO_NAMESPACE
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_TRANSFORMHASH_H
+#define INCLUDED_OCIO_TRANSFORMHASH_H
+
+#include <cstdint>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "HashUtils.h"
+
+
+namespace OCIO_NAMESPACE
+{
+
+// Add the structural hash of the transform i.e. the hash of all the values used to build its ops
+// (including the ones of the nested transforms for a group transform) but not the format
+// metadata. Unlike the string serialization, the LUT values are fully part of the hash.
+void AddTransformHash(Hasher & hasher, const Transform & transform);
+// Same as above but a null transform is also accepted.
+void AddTransformHash(Hasher & hasher, const ConstTransformRcPtr & transform);
+
+std::uint64_t GetTransformHash(const Transform & transform);
+
+// Structural hashes of the config elements i.e. all their properties including the structural
+// hashes of their transforms. They are the building blocks of the config cache identifier.
+std::uint64_t GetColorSpaceHash(const ColorSpace & cs);
+std::uint64_t GetLookHash(const Look & look);
+std::uint64_t GetViewTransformHash(const ViewTransform & vt);
+std::uint64_t GetNamedTransformHash(const NamedTransform & nt);
+
+void AddFileRulesHash(Hasher & hasher, const FileRules & rules);
+void AddViewingRulesHash(Hasher & hasher, const ViewingRules & rules);
+
+} // namespace OCIO_NAMESPACE
+
+#endif
@@ -99,6 +99,9 @@ private:
     BuiltinConfigs m_builtinConfigs;
 };
 
+// Flush the built-in configs parsed by Config::CreateFromBuiltinConfig().
+void ClearBuiltinConfigCaches();
+
 } // namespace OCIO_NAMESPACE
 
 #endif // INCLUDED_OCIO_BUILTIN_CONFIGS_REGISTRY_H
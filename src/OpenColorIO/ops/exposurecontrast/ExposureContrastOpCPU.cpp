@@ -28,10 +28,12 @@ public:
     bool isDynamic() const override;
     bool hasDynamicProperty(DynamicPropertyType type) const override;
     DynamicPropertyRcPtr getDynamicProperty(DynamicPropertyType type) const override;
+    ConstOpCPURcPtr overrideDynamicProperties(const DynamicPropertyOverrides & values) const override;
 
 protected:
     virtual void updateData(ConstExposureContrastOpDataRcPtr & ec) = 0;
 
+    ConstExposureContrastOpDataRcPtr m_data;
     DynamicPropertyDoubleImplRcPtr m_exposure;
     DynamicPropertyDoubleImplRcPtr m_contrast;
     DynamicPropertyDoubleImplRcPtr m_gamma;
@@ -42,6 +44,7 @@ protected:
 
 ECRendererBase::ECRendererBase(ConstExposureContrastOpDataRcPtr & ec)
     : OpCPU()
+    , m_data(ec)
 {
     // Initialized with the instances from the processor and decouple them.
     m_exposure = ec->getExposureProperty();
@@ -127,6 +130,34 @@ DynamicPropertyRcPtr ECRendererBase::getDynamicProperty(DynamicPropertyType type
     throw Exception("ExposureContrast property is not dynamic.");
 }
 
+ConstOpCPURcPtr ECRendererBase::overrideDynamicProperties(const DynamicPropertyOverrides & values) const
+{
+    const bool exposure = m_exposure->isDynamic() && values.hasValue(DYNAMIC_PROPERTY_EXPOSURE);
+    const bool contrast = m_contrast->isDynamic() && values.hasValue(DYNAMIC_PROPERTY_CONTRAST);
+    const bool gamma    = m_gamma->isDynamic() && values.hasValue(DYNAMIC_PROPERTY_GAMMA);
+
+    if (!exposure && !contrast && !gamma)
+    {
+        return ConstOpCPURcPtr();
+    }
+
+    ExposureContrastOpDataRcPtr data = std::make_shared<ExposureContrastOpData>(m_data->getStyle());
+    data->setPivot(m_data->getPivot());
+    data->setLogExposureStep(m_data->getLogExposureStep());
+    data->setLogMidGray(m_data->getLogMidGray());
+
+    // The properties which are not overridden keep their current values.
+    data->setExposure(exposure ? values.getDouble(DYNAMIC_PROPERTY_EXPOSURE)
+                               : m_exposure->getValue());
+    data->setContrast(contrast ? values.getDouble(DYNAMIC_PROPERTY_CONTRAST)
+                               : m_contrast->getValue());
+    data->setGamma(gamma ? values.getDouble(DYNAMIC_PROPERTY_GAMMA)
+                         : m_gamma->getValue());
+
+    ConstExposureContrastOpDataRcPtr constData = data;
+    return GetExposureContrastCPURenderer(constData);
+}
+
 
 class ECLinearRenderer : public ECRendererBase
 {
@@ -28,9 +28,7 @@ void AddUniform(GpuShaderCreatorRcPtr & shaderCreator,
                                                         prop.get());
     shaderCreator->addUniform(name.c_str(), getDouble);
     // Declare uniform.
-    GpuShaderText stDecl(shaderCreator->getLanguage());
-    stDecl.declareUniformFloat(name);
-    shaderCreator->addToDeclareShaderCode(stDecl.string().c_str());
+    DeclareUniform(shaderCreator, name, UNIFORM_DOUBLE);
 }
 
 std::string AddProperty(GpuShaderCreatorRcPtr & shaderCreator,
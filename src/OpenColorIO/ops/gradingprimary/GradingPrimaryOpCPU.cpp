@@ -28,13 +28,16 @@ public:
     bool isDynamic() const override;
     bool hasDynamicProperty(DynamicPropertyType type) const override;
     DynamicPropertyRcPtr getDynamicProperty(DynamicPropertyType type) const override;
+    ConstOpCPURcPtr overrideDynamicProperties(const DynamicPropertyOverrides & values) const override;
 
 protected:
+    ConstGradingPrimaryOpDataRcPtr m_data;
     DynamicPropertyGradingPrimaryImplRcPtr m_gp;
 };
 
 GradingPrimaryOpCPU::GradingPrimaryOpCPU(ConstGradingPrimaryOpDataRcPtr & gp)
     : OpCPU()
+    , m_data(gp)
 {
     m_gp = gp->getDynamicPropertyInternal();
     if (m_gp->isDynamic())
@@ -75,6 +78,22 @@ DynamicPropertyRcPtr GradingPrimaryOpCPU::getDynamicProperty(DynamicPropertyType
     throw Exception("GradingPrimary property is not dynamic.");
 }
 
+ConstOpCPURcPtr GradingPrimaryOpCPU::overrideDynamicProperties(const DynamicPropertyOverrides & values) const
+{
+    if (!m_gp->isDynamic() || !values.hasValue(DYNAMIC_PROPERTY_GRADING_PRIMARY))
+    {
+        return ConstOpCPURcPtr();
+    }
+
+    // The dynamic property of the op data validates and precomputes the value.
+    GradingPrimaryOpDataRcPtr data = std::make_shared<GradingPrimaryOpData>(m_data->getStyle());
+    data->setDirection(m_data->getDirection());
+    data->setValue(values.getGradingPrimary());
+
+    ConstGradingPrimaryOpDataRcPtr constData = data;
+    return GetGradingPrimaryCPURenderer(constData);
+}
+
 class GradingPrimaryLogFwdOpCPU : public GradingPrimaryOpCPU
 {
 public:
@@ -258,7 +277,9 @@ GradingPrimaryLogFwdOpCPU::GradingPrimaryLogFwdOpCPU(ConstGradingPrimaryOpDataRc
 
 void GradingPrimaryLogFwdOpCPU::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    if (m_gp->getLocalBypass())
+    // Use the same values for all the pixels, even if they change meanwhile.
+    const auto snapshot = m_gp->getSnapshot();
+    if (snapshot->m_computed.getLocalBypass())
     {
         if (inImg != outImg)
         {
@@ -270,8 +291,8 @@ void GradingPrimaryLogFwdOpCPU::apply(const void * inImg, void * outImg, long nu
     const float * in = (float *)inImg;
     float * out = (float *)outImg;
 
-    auto & v = m_gp->getValue();
-    auto & comp = m_gp->getComputedValue();
+    auto & v = snapshot->m_value;
+    auto & comp = snapshot->m_computed;
 
     const bool isGammaIdentity = comp.isGammaIdentity();
 
@@ -437,7 +458,9 @@ GradingPrimaryLogRevOpCPU::GradingPrimaryLogRevOpCPU(ConstGradingPrimaryOpDataRc
 
 void GradingPrimaryLogRevOpCPU::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    if (m_gp->getLocalBypass())
+    // Use the same values for all the pixels, even if they change meanwhile.
+    const auto snapshot = m_gp->getSnapshot();
+    if (snapshot->m_computed.getLocalBypass())
     {
         if (inImg != outImg)
         {
@@ -449,8 +472,8 @@ void GradingPrimaryLogRevOpCPU::apply(const void * inImg, void * outImg, long nu
     const float * in = (float *)inImg;
     float * out = (float *)outImg;
 
-    auto & v = m_gp->getValue();
-    auto & comp = m_gp->getComputedValue();
+    auto & v = snapshot->m_value;
+    auto & comp = snapshot->m_computed;
 
     const bool isGammaIdentity = comp.isGammaIdentity();
 
@@ -611,7 +634,9 @@ GradingPrimaryLinFwdOpCPU::GradingPrimaryLinFwdOpCPU(ConstGradingPrimaryOpDataRc
 
 void GradingPrimaryLinFwdOpCPU::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    if (m_gp->getLocalBypass())
+    // Use the same values for all the pixels, even if they change meanwhile.
+    const auto snapshot = m_gp->getSnapshot();
+    if (snapshot->m_computed.getLocalBypass())
     {
         if (inImg != outImg)
         {
@@ -623,8 +648,8 @@ void GradingPrimaryLinFwdOpCPU::apply(const void * inImg, void * outImg, long nu
     const float * in = (float *)inImg;
     float * out = (float *)outImg;
 
-    auto & v = m_gp->getValue();
-    auto & comp = m_gp->getComputedValue();
+    auto & v = snapshot->m_value;
+    auto & comp = snapshot->m_computed;
 
     const bool isContrastIdentity = comp.isContrastIdentity();
 
@@ -785,7 +810,9 @@ GradingPrimaryLinRevOpCPU::GradingPrimaryLinRevOpCPU(ConstGradingPrimaryOpDataRc
 
 void GradingPrimaryLinRevOpCPU::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    if (m_gp->getLocalBypass())
+    // Use the same values for all the pixels, even if they change meanwhile.
+    const auto snapshot = m_gp->getSnapshot();
+    if (snapshot->m_computed.getLocalBypass())
     {
         if (inImg != outImg)
         {
@@ -797,8 +824,8 @@ void GradingPrimaryLinRevOpCPU::apply(const void * inImg, void * outImg, long nu
     const float * in = (float *)inImg;
     float * out = (float *)outImg;
 
-    auto & v = m_gp->getValue();
-    auto & comp = m_gp->getComputedValue();
+    auto & v = snapshot->m_value;
+    auto & comp = snapshot->m_computed;
 
     const bool isContrastIdentity = comp.isContrastIdentity();
 
@@ -953,7 +980,9 @@ GradingPrimaryVidFwdOpCPU::GradingPrimaryVidFwdOpCPU(ConstGradingPrimaryOpDataRc
 
 void GradingPrimaryVidFwdOpCPU::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    if (m_gp->getLocalBypass())
+    // Use the same values for all the pixels, even if they change meanwhile.
+    const auto snapshot = m_gp->getSnapshot();
+    if (snapshot->m_computed.getLocalBypass())
     {
         if (inImg != outImg)
         {
@@ -965,8 +994,8 @@ void GradingPrimaryVidFwdOpCPU::apply(const void * inImg, void * outImg, long nu
     const float * in = (float *)inImg;
     float * out = (float *)outImg;
 
-    auto & v = m_gp->getValue();
-    auto & comp = m_gp->getComputedValue();
+    auto & v = snapshot->m_value;
+    auto & comp = snapshot->m_computed;
 
     const bool isGammaIdentity = comp.isGammaIdentity();
 
@@ -1133,7 +1162,9 @@ GradingPrimaryVidRevOpCPU::GradingPrimaryVidRevOpCPU(ConstGradingPrimaryOpDataRc
 
 void GradingPrimaryVidRevOpCPU::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    if (m_gp->getLocalBypass())
+    // Use the same values for all the pixels, even if they change meanwhile.
+    const auto snapshot = m_gp->getSnapshot();
+    if (snapshot->m_computed.getLocalBypass())
     {
         if (inImg != outImg)
         {
@@ -1145,8 +1176,8 @@ void GradingPrimaryVidRevOpCPU::apply(const void * inImg, void * outImg, long nu
     const float * in = (float *)inImg;
     float * out = (float *)outImg;
 
-    auto & v = m_gp->getValue();
-    auto & comp = m_gp->getComputedValue();
+    auto & v = snapshot->m_value;
+    auto & comp = snapshot->m_computed;
 
     const bool isGammaIdentity = comp.isGammaIdentity();
 
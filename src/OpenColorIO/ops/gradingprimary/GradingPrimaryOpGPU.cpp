@@ -40,9 +40,7 @@ void AddUniform(GpuShaderCreatorRcPtr & shaderCreator,
     if (shaderCreator->addUniform(name.c_str(), getter))
     {
         // Declare uniform.
-        GpuShaderText stDecl(shaderCreator->getLanguage());
-        stDecl.declareUniformFloat(name);
-        shaderCreator->addToDeclareShaderCode(stDecl.string().c_str());
+        DeclareUniform(shaderCreator, name, UNIFORM_DOUBLE);
     }
 }
 
@@ -54,9 +52,7 @@ void AddBoolUniform(GpuShaderCreatorRcPtr & shaderCreator,
     if (shaderCreator->addUniform(name.c_str(), getBool))
     {
         // Declare uniform.
-        GpuShaderText stDecl(shaderCreator->getLanguage());
-        stDecl.declareUniformBool(name);
-        shaderCreator->addToDeclareShaderCode(stDecl.string().c_str());
+        DeclareUniform(shaderCreator, name, UNIFORM_BOOL);
     }
 }
 
@@ -68,9 +64,7 @@ void AddUniform(GpuShaderCreatorRcPtr & shaderCreator,
     if (shaderCreator->addUniform(name.c_str(), getter))
     {
         // Declare uniform.
-        GpuShaderText stDecl(shaderCreator->getLanguage());
-        stDecl.declareUniformFloat3(name);
-        shaderCreator->addToDeclareShaderCode(stDecl.string().c_str());
+        DeclareUniform(shaderCreator, name, UNIFORM_FLOAT3);
     }
 }
 
@@ -28,6 +28,7 @@ public:
     bool isDynamic() const override;
     bool hasDynamicProperty(DynamicPropertyType type) const override;
     DynamicPropertyRcPtr getDynamicProperty(DynamicPropertyType type) const override;
+    ConstOpCPURcPtr overrideDynamicProperties(const DynamicPropertyOverrides & values) const override;
 
 protected:
     void eval(const GradingBSplineCurveImpl::KnotsCoefs & knotsCoefs,
@@ -52,11 +53,13 @@ protected:
         out[2] = knotsCoefs.evalCurveRev(static_cast<int>(RGB_BLUE), out[2]);
     }
 
+    ConstGradingRGBCurveOpDataRcPtr m_data;
     DynamicPropertyGradingRGBCurveImplRcPtr m_grgbcurve;
 };
 
 GradingRGBCurveOpCPU::GradingRGBCurveOpCPU(ConstGradingRGBCurveOpDataRcPtr & grgbc)
     : OpCPU()
+    , m_data(grgbc)
 {
     m_grgbcurve = grgbc->getDynamicPropertyInternal();
     if (m_grgbcurve->isDynamic())
@@ -97,6 +100,23 @@ DynamicPropertyRcPtr GradingRGBCurveOpCPU::getDynamicProperty(DynamicPropertyTyp
     throw Exception("GradingRGBCurve property is not dynamic.");
 }
 
+ConstOpCPURcPtr GradingRGBCurveOpCPU::overrideDynamicProperties(const DynamicPropertyOverrides & values) const
+{
+    if (!m_grgbcurve->isDynamic() || !values.hasValue(DYNAMIC_PROPERTY_GRADING_RGBCURVE))
+    {
+        return ConstOpCPURcPtr();
+    }
+
+    // The dynamic property of the op data validates and precomputes the value.
+    GradingRGBCurveOpDataRcPtr data = std::make_shared<GradingRGBCurveOpData>(m_data->getStyle());
+    data->setDirection(m_data->getDirection());
+    data->setBypassLinToLog(m_data->getBypassLinToLog());
+    data->setValue(values.getGradingRGBCurve());
+
+    ConstGradingRGBCurveOpDataRcPtr constData = data;
+    return GetGradingRGBCurveCPURenderer(constData);
+}
+
 class GradingRGBCurveFwdOpCPU : public GradingRGBCurveOpCPU
 {
 public:
@@ -117,7 +137,9 @@ static constexpr auto PixelSize = 4 * sizeof(float);
 
 void GradingRGBCurveFwdOpCPU::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    if (m_grgbcurve->getLocalBypass())
+    // Use the same values for all the pixels, even if they change meanwhile.
+    const auto snapshot = m_grgbcurve->getSnapshot();
+    if (snapshot->m_localBypass)
     {
         if (inImg != outImg)
         {
@@ -131,7 +153,7 @@ void GradingRGBCurveFwdOpCPU::apply(const void * inImg, void * outImg, long numP
 
     for (long idx = 0; idx < numPixels; ++idx)
     {
-        eval(m_grgbcurve->getKnotsCoefs(), out, in);
+        eval(*snapshot, out, in);
 
         out[3] = in[3];
 
@@ -242,7 +264,9 @@ inline void LogLin(float * out)
 
 void GradingRGBCurveLinearFwdOpCPU::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    if (m_grgbcurve->getLocalBypass())
+    // Use the same values for all the pixels, even if they change meanwhile.
+    const auto snapshot = m_grgbcurve->getSnapshot();
+    if (snapshot->m_localBypass)
     {
         if (inImg != outImg)
         {
@@ -259,7 +283,7 @@ void GradingRGBCurveLinearFwdOpCPU::apply(const void * inImg, void * outImg, lon
         LinLog(in, out);
 
         // Curves.
-        eval(m_grgbcurve->getKnotsCoefs(), out, out);
+        eval(*snapshot, out, out);
 
         LogLin(out);
 
@@ -287,7 +311,9 @@ GradingRGBCurveRevOpCPU::GradingRGBCurveRevOpCPU(ConstGradingRGBCurveOpDataRcPtr
 
 void GradingRGBCurveRevOpCPU::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    if (m_grgbcurve->getLocalBypass())
+    // Use the same values for all the pixels, even if they change meanwhile.
+    const auto snapshot = m_grgbcurve->getSnapshot();
+    if (snapshot->m_localBypass)
     {
         if (inImg != outImg)
         {
@@ -301,7 +327,7 @@ void GradingRGBCurveRevOpCPU::apply(const void * inImg, void * outImg, long numP
 
     for (long idx = 0; idx < numPixels; ++idx)
     {
-        evalRev(m_grgbcurve->getKnotsCoefs(), out, in);
+        evalRev(*snapshot, out, in);
 
         out[3] = in[3];
 
@@ -327,7 +353,9 @@ GradingRGBCurveLinearRevOpCPU::GradingRGBCurveLinearRevOpCPU(ConstGradingRGBCurv
 
 void GradingRGBCurveLinearRevOpCPU::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    if (m_grgbcurve->getLocalBypass())
+    // Use the same values for all the pixels, even if they change meanwhile.
+    const auto snapshot = m_grgbcurve->getSnapshot();
+    if (snapshot->m_localBypass)
     {
         if (inImg != outImg)
         {
@@ -344,7 +372,7 @@ void GradingRGBCurveLinearRevOpCPU::apply(const void * inImg, void * outImg, lon
         LinLog(in, out);
 
         // Curves.
-        evalRev(m_grgbcurve->getKnotsCoefs(), out, out);
+        evalRev(*snapshot, out, out);
 
         LogLin(out);
 
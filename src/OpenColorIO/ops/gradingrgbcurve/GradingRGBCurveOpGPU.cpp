@@ -4,6 +4,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "HashUtils.h"
 #include "Logging.h"
 #include "ops/gradingrgbcurve/GradingRGBCurveOpGPU.h"
 #include "utils/StringUtils.h"
@@ -89,9 +90,7 @@ void AddUniform(GpuShaderCreatorRcPtr & shaderCreator,
     if (shaderCreator->addUniform(name.c_str(), getSize, getVector))
     {
         // Declare uniform.
-        GpuShaderText stDecl(shaderCreator->getLanguage());
-        stDecl.declareUniformArrayFloat(name, maxSize);
-        shaderCreator->addToDeclareShaderCode(stDecl.string().c_str());
+        DeclareUniform(shaderCreator, name, UNIFORM_VECTOR_FLOAT, maxSize);
     }
 }
 
@@ -104,10 +103,8 @@ void AddUniform(GpuShaderCreatorRcPtr & shaderCreator,
     if (shaderCreator->addUniform(name.c_str(), getSize, getVector))
     {
         // Declare uniform.
-        GpuShaderText stDecl(shaderCreator->getLanguage());
         // Need 2 ints for each RGBM curve.
-        stDecl.declareUniformArrayInt(name, 8);
-        shaderCreator->addToDeclareShaderCode(stDecl.string().c_str());
+        DeclareUniform(shaderCreator, name, UNIFORM_VECTOR_INT, 8);
     }
 }
 
@@ -119,18 +116,16 @@ void AddUniform(GpuShaderCreatorRcPtr & shaderCreator,
     if (shaderCreator->addUniform(name.c_str(), getBool))
     {
         // Declare uniform.
-        GpuShaderText stDecl(shaderCreator->getLanguage());
-        stDecl.declareUniformBool(name);
-        shaderCreator->addToDeclareShaderCode(stDecl.string().c_str());
+        DeclareUniform(shaderCreator, name, UNIFORM_BOOL);
     }
 }
 
 std::string BuildResourceNameIndexed(GpuShaderCreatorRcPtr & shaderCreator, const std::string & prefix,
-                                     const std::string & base, unsigned int index)
+                                     const std::string & base, const std::string & index)
 {
     std::string name{ BuildResourceName(shaderCreator, prefix, base) };
     name += "_";
-    name += std::to_string(index);
+    name += index;
     // Note: Remove potentially problematic double underscores from GLSL resource names.
     StringUtils::ReplaceInPlace(name, "__", "_");
     return name;
@@ -138,7 +133,27 @@ std::string BuildResourceNameIndexed(GpuShaderCreatorRcPtr & shaderCreator, cons
 
 static const std::string opPrefix{ "grading_rgbcurve" };
 
-void SetGCProperties(GpuShaderCreatorRcPtr & shaderCreator, bool dynamic, GCProperties & propNames)
+// Identify the curve values and the direction i.e. the content of the helper function.
+std::string GetCurveContentID(ConstGradingRGBCurveOpDataRcPtr & gcData)
+{
+    auto propGC = gcData->getDynamicPropertyInternal();
+
+    Hasher hasher;
+    hasher.addValues(propGC->getKnotsOffsetsArray(), 4 * 2);
+    hasher.addValues(propGC->getKnotsArray(), propGC->getNumKnots());
+    hasher.addValues(propGC->getCoefsOffsetsArray(), 4 * 2);
+    hasher.addValues(propGC->getCoefsArray(), propGC->getNumCoefs());
+    hasher.addValue(gcData->getDirection());
+
+    std::ostringstream oss;
+    oss << std::hex << hasher.digest();
+    return oss.str();
+}
+
+void SetGCProperties(GpuShaderCreatorRcPtr & shaderCreator,
+                     ConstGradingRGBCurveOpDataRcPtr & gcData,
+                     bool dynamic,
+                     GCProperties & propNames)
 {
     if (dynamic)
     {
@@ -155,8 +170,12 @@ void SetGCProperties(GpuShaderCreatorRcPtr & shaderCreator, bool dynamic, GCProp
     }
     else
     {
-        // Non-dynamic ops need an helper function for each op.
-        const auto resIndex = shaderCreator->getNextResourceIndex();
+        // Non-dynamic ops need an helper function for each op. When the shader text is
+        // compacted, the ops with identical curves share the helper function and the constant
+        // arrays instead.
+        const std::string resIndex = shaderCreator->getCompactShaderText()
+                                         ? GetCurveContentID(gcData)
+                                         : std::to_string(shaderCreator->getNextResourceIndex());
 
         propNames.m_knotsOffsets = BuildResourceNameIndexed(shaderCreator, opPrefix,
                                                             propNames.m_knotsOffsets, resIndex);
@@ -384,7 +403,7 @@ void GetGradingRGBCurveGPUShaderProgram(GpuShaderCreatorRcPtr & shaderCreator,
     st.indent();
 
     GCProperties properties;
-    SetGCProperties(shaderCreator, dyn, properties);
+    SetGCProperties(shaderCreator, gcData, dyn, properties);
 
     if (dyn)
     {
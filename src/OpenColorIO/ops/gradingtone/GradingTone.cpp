@@ -308,9 +308,12 @@ void GradingTonePreRender::setStyle(GradingStyle style)
 {
     if (m_style != style)
     {
-    m_style = style;
-    FromStyle(style, m_top, m_topSC, m_bottom, m_pivot);
-}
+        m_style = style;
+        FromStyle(style, m_top, m_topSC, m_bottom, m_pivot);
+
+        // All the constants depend on the style.
+        m_isComputed = false;
+    }
 }
 
 namespace
@@ -406,6 +409,18 @@ void GradingTonePreRender::update(const GradingTone & v)
     m_localBypass = IsIdentity(v);
     if (m_localBypass) return;
 
+    // Interactive edits usually change one control at a time so only recompute the constants
+    // depending on the controls that changed since the previous computation.
+
+    const bool all        = !m_isComputed;
+    const bool blacks     = all || v.m_blacks     != m_computedValue.m_blacks;
+    const bool shadows    = all || v.m_shadows    != m_computedValue.m_shadows;
+    const bool midtones   = all || v.m_midtones   != m_computedValue.m_midtones;
+    const bool highlights = all || v.m_highlights != m_computedValue.m_highlights;
+    const bool whites     = all || v.m_whites     != m_computedValue.m_whites;
+    const bool scontrast  = all || v.m_scontrast  != m_computedValue.m_scontrast;
+
+    if (highlights || whites)
     {
         const double master = v.m_highlights.m_master;
         const double start  = v.m_highlights.m_start;
@@ -423,6 +438,7 @@ void GradingTonePreRender::update(const GradingTone & v)
         m_whitesStart = new_start;
         m_whitesWidth = new_end - new_start;
     }
+    if (shadows || blacks)
     {
         const double master = v.m_shadows.m_master;
         const double start  = v.m_shadows.m_start;
@@ -440,11 +456,26 @@ void GradingTonePreRender::update(const GradingTone & v)
         m_blacksWidth = new_start - new_end;
     }
 
+    if (midtones)
+    {
+        mids_precompute(v, m_top, m_bottom);
+    }
+    if (highlights || shadows)
+    {
+        highlightShadow_precompute(v);
+    }
+    // The whites & blacks ranges depend on the highlights & shadows.
+    if (highlights || shadows || whites || blacks)
+    {
+        whiteBlack_precompute(v);
+    }
+    if (scontrast)
+    {
+        scontrast_precompute(v, m_topSC, m_bottom, m_pivot);
+    }
 
-    mids_precompute(v, m_top, m_bottom);
-    highlightShadow_precompute(v);
-    whiteBlack_precompute(v);
-    scontrast_precompute(v, m_topSC, m_bottom, m_pivot);
+    m_computedValue = v;
+    m_isComputed    = true;
 }
 
 void GradingTonePreRender::mids_precompute(const GradingTone & v, float top, float bottom)
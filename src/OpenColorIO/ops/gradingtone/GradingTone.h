@@ -80,6 +80,11 @@ struct GradingTonePreRender
 private:
     GradingStyle m_style{ GRADING_LOG };
 
+    // The value the constants were last computed from, so that update() only recomputes the
+    // constants depending on the controls that changed.
+    GradingTone m_computedValue{ GRADING_LOG };
+    bool m_isComputed{ false };
+
     void mids_precompute(const GradingTone & v, float top, float bottom);
     void highlightShadow_precompute(const GradingTone & v);
     void whiteBlack_precompute(const GradingTone & v);
@@ -28,14 +28,17 @@ public:
     bool isDynamic() const override;
     bool hasDynamicProperty(DynamicPropertyType type) const override;
     DynamicPropertyRcPtr getDynamicProperty(DynamicPropertyType type) const override;
+    ConstOpCPURcPtr overrideDynamicProperties(const DynamicPropertyOverrides & values) const override;
 
 protected:
+    ConstGradingToneOpDataRcPtr m_data;
     DynamicPropertyGradingToneImplRcPtr m_gt;
     GradingStyle m_style;
 };
 
 GradingToneOpCPU::GradingToneOpCPU(ConstGradingToneOpDataRcPtr & gt)
     : OpCPU()
+    , m_data(gt)
 {
     m_gt = gt->getDynamicPropertyInternal();
     m_style = gt->getStyle();
@@ -76,6 +79,22 @@ DynamicPropertyRcPtr GradingToneOpCPU::getDynamicProperty(DynamicPropertyType ty
     throw Exception("Dynamic property type not supported by GradingTone.");
 }
 
+ConstOpCPURcPtr GradingToneOpCPU::overrideDynamicProperties(const DynamicPropertyOverrides & values) const
+{
+    if (!m_gt->isDynamic() || !values.hasValue(DYNAMIC_PROPERTY_GRADING_TONE))
+    {
+        return ConstOpCPURcPtr();
+    }
+
+    // The dynamic property of the op data validates and precomputes the value.
+    GradingToneOpDataRcPtr data = std::make_shared<GradingToneOpData>(m_style);
+    data->setDirection(m_data->getDirection());
+    data->setValue(values.getGradingTone());
+
+    ConstGradingToneOpDataRcPtr constData = data;
+    return GetGradingToneCPURenderer(constData);
+}
+
 class GradingToneFwdOpCPU : public GradingToneOpCPU
 {
 public:
@@ -949,7 +968,9 @@ static constexpr auto PixelSize = 4 * sizeof(float);
 
 void GradingToneFwdOpCPU::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    if (m_gt->getLocalBypass())
+    // Use the same values for all the pixels, even if they change meanwhile.
+    const auto snapshot = m_gt->getSnapshot();
+    if (snapshot->m_computed.m_localBypass)
     {
         if (inImg != outImg)
         {
@@ -961,8 +982,8 @@ void GradingToneFwdOpCPU::apply(const void * inImg, void * outImg, long numPixel
     const float * in = (float *)inImg;
     float * out = (float *)outImg;
 
-    auto & v = m_gt->getValue();
-    auto & vpr = m_gt->getComputedValue();
+    auto & v = snapshot->m_value;
+    auto & vpr = snapshot->m_computed;
 
     for (long idx = 0; idx < numPixels; ++idx)
     {
@@ -1006,7 +1027,9 @@ void GradingToneFwdOpCPU::apply(const void * inImg, void * outImg, long numPixel
 void GradingToneRevOpCPU::apply(const void * inImg, void * outImg, long numPixels) const
 {
 
-    if (m_gt->getLocalBypass())
+    // Use the same values for all the pixels, even if they change meanwhile.
+    const auto snapshot = m_gt->getSnapshot();
+    if (snapshot->m_computed.m_localBypass)
     {
         if (inImg != outImg)
         {
@@ -1018,8 +1041,8 @@ void GradingToneRevOpCPU::apply(const void * inImg, void * outImg, long numPixel
     const float * in = (float *)inImg;
     float * out = (float *)outImg;
 
-    auto & v = m_gt->getValue();
-    auto & vpr = m_gt->getComputedValue();
+    auto & v = snapshot->m_value;
+    auto & vpr = snapshot->m_computed;
 
     for (long idx = 0; idx < numPixels; ++idx)
     {
@@ -1146,7 +1169,9 @@ inline void LogLin(float * out)
 
 void GradingToneLinearFwdOpCPU::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    if (m_gt->getLocalBypass())
+    // Use the same values for all the pixels, even if they change meanwhile.
+    const auto snapshot = m_gt->getSnapshot();
+    if (snapshot->m_computed.m_localBypass)
     {
         if (inImg != outImg)
         {
@@ -1158,8 +1183,8 @@ void GradingToneLinearFwdOpCPU::apply(const void * inImg, void * outImg, long nu
     const float * in = (float *)inImg;
     float * out = (float *)outImg;
 
-    auto & v = m_gt->getValue();
-    auto & vpr = m_gt->getComputedValue();
+    auto & v = snapshot->m_value;
+    auto & vpr = snapshot->m_computed;
 
     for (long idx = 0; idx < numPixels; ++idx)
     {
@@ -1203,7 +1228,9 @@ void GradingToneLinearFwdOpCPU::apply(const void * inImg, void * outImg, long nu
 
 void GradingToneLinearRevOpCPU::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    if (m_gt->getLocalBypass())
+    // Use the same values for all the pixels, even if they change meanwhile.
+    const auto snapshot = m_gt->getSnapshot();
+    if (snapshot->m_computed.m_localBypass)
     {
         if (inImg != outImg)
         {
@@ -1215,8 +1242,8 @@ void GradingToneLinearRevOpCPU::apply(const void * inImg, void * outImg, long nu
     const float * in = (float *)inImg;
     float * out = (float *)outImg;
 
-    auto & v = m_gt->getValue();
-    auto & vpr = m_gt->getComputedValue();
+    auto & v = snapshot->m_value;
+    auto & vpr = snapshot->m_computed;
 
     for (long idx = 0; idx < numPixels; ++idx)
     {
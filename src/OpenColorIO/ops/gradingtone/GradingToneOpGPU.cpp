@@ -64,9 +64,7 @@ void AddUniform(GpuShaderCreatorRcPtr & shaderCreator,
     if (shaderCreator->addUniform(name.c_str(), getter))
     {
         // Declare uniform.
-        GpuShaderText stDecl(shaderCreator->getLanguage());
-        stDecl.declareUniformFloat(name);
-        shaderCreator->addToDeclareShaderCode(stDecl.string().c_str());
+        DeclareUniform(shaderCreator, name, UNIFORM_DOUBLE);
     }
 }
 
@@ -78,9 +76,7 @@ void AddBoolUniform(GpuShaderCreatorRcPtr & shaderCreator,
     if (shaderCreator->addUniform(name.c_str(), getBool))
     {
         // Declare uniform.
-        GpuShaderText stDecl(shaderCreator->getLanguage());
-        stDecl.declareUniformBool(name);
-        shaderCreator->addToDeclareShaderCode(stDecl.string().c_str());
+        DeclareUniform(shaderCreator, name, UNIFORM_BOOL);
     }
 }
 
@@ -6,6 +6,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "GpuShader.h"
 #include "GpuShaderUtils.h"
 #include "MathUtils.h"
 #include "ops/lut1d/Lut1DOpGPU.h"
@@ -164,17 +165,45 @@ void GetLut1DGPUShaderProgram(GpuShaderCreatorRcPtr & shaderCreator,
     const bool singleChannel = (numChannels == 1);
 
     // Adjust LUT texture to allow for correct 2d linear interpolation, if needed.
+    // The padded values only depend on the LUT and texture sizes so identical LUTs share them
+    // (using CacheID to identify them).
 
-    std::vector<float> values;
-    values.reserve(width * height * numChannels);
+    std::ostringstream contentKey;
+    contentKey << "lut1d " << lutData->getCacheID() << " " << width << "x" << height << "x" << numChannels;
 
-    if (singleChannel) // i.e. numChannels == 1.
+    const ConstGpuTextureValuesRcPtr values = GetSharedTextureValues(
+        contentKey.str(),
+        [&lutData, width, height, numChannels, singleChannel]()
+        {
+            auto padded = std::make_shared<std::vector<float>>();
+            padded->reserve(width * height * numChannels);
+
+            if (singleChannel) // i.e. numChannels == 1.
+            {
+                CreatePaddedRedChannel(width, height, lutData->getArray().getValues(), *padded);
+            }
+            else
+            {
+                CreatePaddedLutChannels(width, height, lutData->getArray().getValues(), *padded);
+            }
+
+            return ConstGpuTextureValuesRcPtr(padded, padded->data());
+        });
+
+    // The 16-bit texture formats need packed values. The half domain LUTs cover the full range
+    // of the half float values so they always use them rather than the normalized integers.
+    GpuShaderCreator::TextureFormat format = GetSupportedTextureFormat(shaderCreator);
+    if (format == GpuShaderCreator::TEXTURE_FORMAT_UNORM16 && lutData->isInputHalfDomain())
     {
-        CreatePaddedRedChannel(width, height, lutData->getArray().getValues(), values);
+        format = GpuShaderCreator::TEXTURE_FORMAT_HALF;
     }
-    else
+
+    ConstGpuTexturePackedValuesRcPtr packedValues;
+    if (format != GpuShaderCreator::TEXTURE_FORMAT_FLOAT32)
     {
-        CreatePaddedLutChannels(width, height, lutData->getArray().getValues(), values);
+        packedValues = GetSharedTexturePackedValues(contentKey.str(), format, values,
+                                                    size_t(width) * height * numChannels,
+                                                    unsigned(numChannels));
     }
 
     // Register the RGB LUT.
@@ -198,19 +227,34 @@ void GetLut1DGPUShaderProgram(GpuShaderCreatorRcPtr & shaderCreator,
         dimensions = GpuShaderDesc::TEXTURE_2D;
     }
 
-    // (Using CacheID here to potentially allow reuse of existing textures.)
-    shaderCreator->addTexture(name.c_str(),
-                              GpuShaderText::getSamplerName(name).c_str(),
-                              width,
-                              height,
-                              singleChannel ? GpuShaderCreator::TEXTURE_RED_CHANNEL
-                                            : GpuShaderCreator::TEXTURE_RGB_CHANNEL,
-                              dimensions,
-                              lutData->getConcreteInterpolation(),
-                              &values[0]);
+    AddTexture(shaderCreator,
+               name.c_str(),
+               GpuShaderText::getSamplerName(name).c_str(),
+               width,
+               height,
+               singleChannel ? GpuShaderCreator::TEXTURE_RED_CHANNEL
+                             : GpuShaderCreator::TEXTURE_RGB_CHANNEL,
+               dimensions,
+               lutData->getConcreteInterpolation(),
+               values,
+               packedValues);
 
     // Add the LUT code to the OCIO shader program.
 
+    // The position computation only depends on the LUT & texture sizes so, identical ones share
+    // the helper when the shader text is compacted.
+
+    std::string computePos(name + "_computePos");
+    if (shaderCreator->getCompactShaderText())
+    {
+        std::ostringstream posName;
+        posName << shaderCreator->getResourcePrefix() << "_lut1d_computePos_"
+                << length << "_" << width << "x" << height
+                << (lutData->isInputHalfDomain() ? "_half" : "");
+        computePos = posName.str();
+        StringUtils::ReplaceInPlace(computePos, "__", "_");
+    }
+
     if (dimensions == GpuShaderDesc::TEXTURE_2D)
     {
         // In case the 1D LUT length exceeds the 1D texture maximum length,
@@ -226,7 +270,7 @@ void GetLut1DGPUShaderProgram(GpuShaderCreatorRcPtr & shaderCreator,
         {
             GpuShaderText ss(shaderCreator->getLanguage());
 
-            ss.newLine() << ss.float2Keyword() << " " << name << "_computePos(float f)";
+            ss.newLine() << ss.float2Keyword() << " " << computePos << "(float f)";
             ss.newLine() << "{";
             ss.indent();
 
@@ -333,7 +377,7 @@ void GetLut1DGPUShaderProgram(GpuShaderCreatorRcPtr & shaderCreator,
 
     if (dimensions == GpuShaderDesc::TEXTURE_2D)
     {
-        const std::string str = name + "_computePos(" + shaderCreator->getPixelName();
+        const std::string str = computePos + "(" + shaderCreator->getPixelName();
 
         ss.newLine() << shaderCreator->getPixelName() << ".r = " 
                      << ss.sampleTex2D(name, str + ".r)") << ".r;";
@@ -364,6 +408,19 @@ void GetLut1DGPUShaderProgram(GpuShaderCreatorRcPtr & shaderCreator,
                         << ss.sampleTex1D(name, name + "_coords.b") << (singleChannel ? ".r;" : ".b;");
     }
 
+    // The packing falls back to the half float values when the normalized integers are not
+    // precise enough.
+    if (packedValues && packedValues->m_format == GpuShaderCreator::TEXTURE_FORMAT_UNORM16)
+    {
+        const float * scale  = packedValues->m_scale;
+        const float * offset = packedValues->m_offset;
+        ss.newLine() << "// Rescale the normalized texture values";
+        ss.newLine() << shaderCreator->getPixelName() << ".rgb = "
+                     << shaderCreator->getPixelName() << ".rgb * "
+                     << ss.float3Const(scale[0], scale[1], scale[2]) << " + "
+                     << ss.float3Const(offset[0], offset[1], offset[2]) << ";";
+    }
+
     if (lutData->getHueAdjust() == HUE_DW3)
     {
         ss.newLine() << "";
@@ -5,6 +5,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "GpuShader.h"
 #include "GpuShaderUtils.h"
 #include "MathUtils.h"
 #include "ops/lut3d/Lut3DOpGPU.h"
@@ -38,12 +39,33 @@ void GetLut3DGPUShaderProgram(GpuShaderCreatorRcPtr & shaderCreator, ConstLut3DO
     {
         samplerInterpolation = INTERP_NEAREST;
     }
-    // (Using CacheID here to potentially allow reuse of existing textures.)
-    shaderCreator->add3DTexture(name.c_str(),
-                                GpuShaderText::getSamplerName(name).c_str(),
-                                lutData->getGridSize(),
-                                samplerInterpolation,
-                                &lutData->getArray()[0]);
+    // The texture directly uses the LUT values, which are immutable once in a processor, and
+    // identical LUTs share the same values (using CacheID to identify them).
+    const ConstGpuTextureValuesRcPtr values = GetSharedTextureValues(
+        "lut3d " + lutData->getCacheID(),
+        [&lutData]()
+        {
+            // The texture values keep the LUT alive.
+            return ConstGpuTextureValuesRcPtr(lutData, &lutData->getArray()[0]);
+        });
+
+    // The 16-bit texture formats need packed values.
+    const GpuShaderCreator::TextureFormat format = GetSupportedTextureFormat(shaderCreator);
+    ConstGpuTexturePackedValuesRcPtr packedValues;
+    if (format != GpuShaderCreator::TEXTURE_FORMAT_FLOAT32)
+    {
+        const size_t edgelen = lutData->getGridSize();
+        packedValues = GetSharedTexturePackedValues("lut3d " + lutData->getCacheID(), format, values,
+                                                    edgelen * edgelen * edgelen * 3, 3);
+    }
+
+    Add3DTexture(shaderCreator,
+                 name.c_str(),
+                 GpuShaderText::getSamplerName(name).c_str(),
+                 lutData->getGridSize(),
+                 samplerInterpolation,
+                 values,
+                 packedValues);
 
     {
         GpuShaderText ss(shaderCreator->getLanguage());
@@ -239,6 +261,20 @@ void GetLut3DGPUShaderProgram(GpuShaderCreatorRcPtr & shaderCreator, ConstLut3DO
                          << ss.sampleTex3D(name, name + "_coords") << ".rgb;";
         }
 
+        // The packing falls back to the half float values when the normalized integers are not
+        // precise enough.
+        if (packedValues && packedValues->m_format == GpuShaderCreator::TEXTURE_FORMAT_UNORM16)
+        {
+            // The interpolations are weighted averages so the rescaling is done afterwards.
+            const float * scale  = packedValues->m_scale;
+            const float * offset = packedValues->m_offset;
+            ss.newLine() << "// Rescale the normalized texture values";
+            ss.newLine() << shaderCreator->getPixelName() << ".rgb = "
+                         << shaderCreator->getPixelName() << ".rgb * "
+                         << ss.float3Const(scale[0], scale[1], scale[2]) << " + "
+                         << ss.float3Const(offset[0], offset[1], offset[2]) << ";";
+        }
+
         shaderCreator->addToFunctionShaderCode(ss.string().c_str());
     }
 }
@@ -2,16 +2,20 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 
+#include <memory>
 #include <sstream>
 #include <string.h>
+#include <vector>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Caching.h"
 #include "ops/allocation/AllocationOp.h"
 #include "NoOps.h"
 #include "OpBuilders.h"
 #include "Op.h"
 #include "ops/lut3d/Lut3DOp.h"
+#include "utils/ParallelUtils.h"
 
 
 namespace OCIO_NAMESPACE
@@ -170,6 +174,66 @@ bool GetGpuAllocation(AllocationData & allocation,
     allocationNoOpRcPtr->getGpuAllocation(allocation);
     return true;
 }
+
+using LatticeRcPtr = std::shared_ptr<const std::vector<float>>;
+
+// The lattices processed by the leading static (i.e. not dynamic) ops, using the ops cache IDs
+// and the edge length as key.
+ProcessorCache<std::string, LatticeRcPtr> g_latticeCache;
+
+// The entries are large (e.g. a 129^3 RGBA lattice is 34 MB, a 65^3 one is 4.4 MB) so limit the
+// memory they use. A lattice larger than the limit is not cached.
+constexpr size_t LatticeCacheMaxBytes = 64 * 1024 * 1024;
+
+// Get the memory used by the cached lattices.
+// To only use when lock is on to protect the cache access.
+size_t GetLatticeCacheBytes()
+{
+    size_t numBytes = 0;
+    for (const auto & entry : g_latticeCache)
+    {
+        if (entry.second)
+        {
+            numBytes += entry.second->size() * sizeof(float);
+        }
+    }
+    return numBytes;
+}
+
+// Below this edge length, the threads cost more than what they save.
+constexpr unsigned MinParallelEdgeLen = 17;
+
+// Apply the ops from first to last (excluded) to the RGBA lattice.
+void ProcessLattice(const OpRcPtrVec & ops, size_t first, size_t last,
+                    unsigned edgelen, std::vector<float> & lattice)
+{
+    if (first >= last) return;
+
+    std::vector<ConstOpCPURcPtr> cpuOps;
+    for (size_t idx = first; idx < last; ++idx)
+    {
+        cpuOps.push_back(ops[idx]->getCPUOp(false));
+    }
+
+    // The pixels sharing the same red index (i.e. a slab) are contiguous in the lattice so, each
+    // slab is processed by all the ops while it is in the cache.
+    const long slabNumPixels = long(edgelen) * edgelen;
+
+    // The host could limit (or disable) the threads of the library, see SetMaxThreads().
+    ParallelFor(edgelen, edgelen < MinParallelEdgeLen ? 1 : GetMaxThreads(), [&](size_t slab)
+    {
+        float * pixels = &lattice[slab * slabNumPixels * 4];
+        for (const auto & cpuOp : cpuOps)
+        {
+            cpuOp->apply(pixels, pixels, slabNumPixels);
+        }
+    });
+}
+}
+
+void ClearLatticeCaches()
+{
+    g_latticeCache.clear();
 }
 
 OpRcPtrVec Create3DLut(const OpRcPtrVec & ops, unsigned edgelen)
@@ -181,17 +245,68 @@ OpRcPtrVec Create3DLut(const OpRcPtrVec & ops, unsigned edgelen)
 
     Lut3DOpDataRcPtr lut = std::make_shared<Lut3DOpData>(lut3DEdgeLen);
 
-    // Allocate 3D LUT image, RGBA
-    std::vector<float> lut3D(lut3DNumPixels*4);
-    GenerateIdentityLut3D(&lut3D[0], lut3DEdgeLen, 4, LUT3DORDER_FAST_BLUE);
+    // The lattice processed by the static ops does not change when dynamic values move so, only
+    // the ops starting at the first dynamic one are applied again.
+
+    size_t numStaticOps = 0;
+    while (numStaticOps < ops.size() && !ops[numStaticOps]->isDynamic())
+    {
+        ++numStaticOps;
+    }
+
+    std::ostringstream key;
+    if (numStaticOps > 0 && g_latticeCache.isEnabled())
+    {
+        key << lut3DEdgeLen;
+        for (size_t idx = 0; idx < numStaticOps; ++idx)
+        {
+            key << " " << ops[idx]->getCacheID();
+        }
+    }
+
+    LatticeRcPtr staticLattice;
+    if (!key.str().empty())
+    {
+        AutoMutex guard(g_latticeCache.lock());
+        if (g_latticeCache.exists(key.str()))
+        {
+            staticLattice = g_latticeCache[key.str()];
+        }
+    }
+
+    if (!staticLattice)
+    {
+        // Allocate 3D LUT image, RGBA
+        auto lattice = std::make_shared<std::vector<float>>(lut3DNumPixels*4);
+        GenerateIdentityLut3D(lattice->data(), lut3DEdgeLen, 4, LUT3DORDER_FAST_BLUE);
+
+        ProcessLattice(ops, 0, numStaticOps, lut3DEdgeLen, *lattice);
+        staticLattice = lattice;
+
+        const size_t latticeBytes = lattice->size() * sizeof(float);
+        if (!key.str().empty() && latticeBytes <= LatticeCacheMaxBytes)
+        {
+            AutoMutex guard(g_latticeCache.lock());
+            if (GetLatticeCacheBytes() + latticeBytes > LatticeCacheMaxBytes)
+            {
+                g_latticeCache.clearEntries();
+            }
+            g_latticeCache[key.str()] = staticLattice;
+        }
+    }
 
-    // Apply the lattice ops to it
-    for(const auto & op : ops)
+    // Apply the dynamic ops, if any, to a copy of the lattice.
+    std::vector<float> dynamicLattice;
+    if (numStaticOps < ops.size())
     {
-        op->apply(&lut3D[0], &lut3D[0], lut3DNumPixels);
+        dynamicLattice = *staticLattice;
+        ProcessLattice(ops, numStaticOps, ops.size(), lut3DEdgeLen, dynamicLattice);
     }
 
-    // Convert the RGBA image to an RGB image, in place.
+    const std::vector<float> & lut3D
+        = numStaticOps < ops.size() ? dynamicLattice : *staticLattice;
+
+    // Convert the RGBA image to an RGB image.
     auto & lutArray = lut->getArray();
     for(unsigned i=0; i<lut3DNumPixels; ++i)
     {
@@ -14,9 +14,14 @@
 namespace OCIO_NAMESPACE
 {
 
-// Create a 3D LUT from an arbitrary list of ops.
+// Create a 3D LUT from an arbitrary list of ops. The lattice is processed on several threads and
+// the part processed by the leading static ops is cached, so only the dynamic ops are applied
+// again when the dynamic values change.
 OpRcPtrVec Create3DLut(const OpRcPtrVec & ops, unsigned edgelen);
 
+// Clear the lattices cached by Create3DLut.
+void ClearLatticeCaches();
+
 // Partition an opvec into 3 segments for GPU Processing
 //
 // gpuLatticeOps need not support analytical gpu shader generation
@@ -8,6 +8,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "HashUtils.h"
 #include "transforms/Lut1DTransform.h"
 
 namespace OCIO_NAMESPACE
@@ -39,6 +40,22 @@ Lut1DTransformImpl::Lut1DTransformImpl(Lut1DOpData::HalfFlags halfFlag, unsigned
 {
 }
 
+std::uint64_t Lut1DTransformImpl::getValuesHash() const noexcept
+{
+    std::uint64_t hash = m_valuesHash;
+    if (hash == 0)
+    {
+        const auto & values = m_data.getArray().getValues();
+
+        Hasher hasher;
+        hasher.addValues(values.data(), values.size());
+        hash = hasher.digest();
+
+        m_valuesHash = hash;
+    }
+    return hash;
+}
+
 TransformRcPtr Lut1DTransformImpl::createEditableCopy() const
 {
     Lut1DTransformRcPtr transform = Lut1DTransform::Create();
@@ -100,7 +117,7 @@ bool Lut1DTransformImpl::equals(const Lut1DTransform & other) const noexcept
 
 void Lut1DTransformImpl::setLength(unsigned long length)
 {
-    auto & lutArray = m_data.getArray();
+    auto & lutArray = data().getArray();
     // Use NaNs for the 2048 NaN values in the domain.
     lutArray = Lut1DOpData::Lut3by1DArray(m_data.getHalfFlags(), 3, length, false);
 }
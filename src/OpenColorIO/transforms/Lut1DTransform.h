@@ -5,6 +5,9 @@
 #ifndef INCLUDED_OCIO_LUT1DTRANSFORM_H
 #define INCLUDED_OCIO_LUT1DTRANSFORM_H
 
+#include <atomic>
+#include <cstdint>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "ops/lut1d/Lut1DOpData.h"
@@ -55,13 +58,19 @@ public:
     Interpolation getInterpolation() const override;
     void setInterpolation(Interpolation algo) override;
 
-    Lut1DOpData & data() noexcept { return m_data; }
+    // Note that any mutable access resets the hash of the LUT values.
+    Lut1DOpData & data() noexcept { m_valuesHash = 0; return m_data; }
     const Lut1DOpData & data() const noexcept { return m_data; }
 
+    // Get the hash of the LUT values. It is only computed once until the next mutable access.
+    std::uint64_t getValuesHash() const noexcept;
+
     static void deleter(Lut1DTransform * t);
 
 private:
     Lut1DOpData m_data{ 2 };
+    // The hash of the LUT values, zero when not computed yet.
+    mutable std::atomic<std::uint64_t> m_valuesHash{ 0 };
 };
 
 
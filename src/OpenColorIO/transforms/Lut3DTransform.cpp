@@ -8,6 +8,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "HashUtils.h"
 #include "transforms/Lut3DTransform.h"
 
 namespace OCIO_NAMESPACE
@@ -37,6 +38,22 @@ Lut3DTransformImpl::Lut3DTransformImpl(unsigned long gridSize)
 {
 }
 
+std::uint64_t Lut3DTransformImpl::getValuesHash() const noexcept
+{
+    std::uint64_t hash = m_valuesHash;
+    if (hash == 0)
+    {
+        const auto & values = m_data.getArray().getValues();
+
+        Hasher hasher;
+        hasher.addValues(values.data(), values.size());
+        hash = hasher.digest();
+
+        m_valuesHash = hash;
+    }
+    return hash;
+}
+
 TransformRcPtr Lut3DTransformImpl::createEditableCopy() const
 {
     Lut3DTransformRcPtr transform = Lut3DTransform::Create();
@@ -102,7 +119,7 @@ unsigned long Lut3DTransformImpl::getGridSize() const
 
 void Lut3DTransformImpl::setGridSize(unsigned long gridSize)
 {
-    auto & lutArray = m_data.getArray();
+    auto & lutArray = data().getArray();
     lutArray = Lut3DOpData::Lut3DArray(gridSize);
 }
 
@@ -138,9 +155,10 @@ void Lut3DTransformImpl::setValue(unsigned long indexR,
 
     // Array is stored in blue-fastest order.
     const unsigned long arrayIdx = 3 * ((indexR*gs + indexG)*gs + indexB);
-    m_data.getArray()[arrayIdx] = r;
-    m_data.getArray()[arrayIdx + 1] = g;
-    m_data.getArray()[arrayIdx + 2] = b;
+    auto & lutArray = data().getArray();
+    lutArray[arrayIdx] = r;
+    lutArray[arrayIdx + 1] = g;
+    lutArray[arrayIdx + 2] = b;
 }
 
 
@@ -163,7 +181,7 @@ void Lut3DTransformImpl::getValue(unsigned long indexR,
 
 void Lut3DTransformImpl::setInterpolation(Interpolation algo)
 {
-    m_data.setInterpolation(algo);
+    data().setInterpolation(algo);
 }
 
 Interpolation Lut3DTransformImpl::getInterpolation() const
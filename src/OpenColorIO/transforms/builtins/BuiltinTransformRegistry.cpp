@@ -7,6 +7,8 @@
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "Mutex.h"
+#include "ops/lut1d/Lut1DOp.h"
+#include "ops/lut3d/Lut3DOp.h"
 #include "ops/matrix/MatrixOp.h"
 #include "OpBuilders.h"
 #include "Platform.h"
@@ -55,6 +57,7 @@ void BuiltinTransformRegistryImpl::addBuiltin(const char * style, const char * d
         if (0==Platform::Strcasecmp(data.m_style.c_str(), builtin.m_style.c_str()))
         {
             builtin = data;
+            clearCaches();
             return;
         }
     }
@@ -93,13 +96,62 @@ void BuiltinTransformRegistryImpl::createOps(size_t index, OpRcPtrVec & ops) con
     {
         throw Exception("Invalid index.");
     }
-    
-    m_builtins[index].m_creator(ops);
+
+    OpRcPtrVec generatedOps;
+
+    {
+        AutoMutex guard(m_opsCache.lock());
+
+        if (m_opsCache.exists(index))
+        {
+            generatedOps = m_opsCache[index];
+        }
+        else
+        {
+            m_builtins[index].m_creator(generatedOps);
+
+            // Finalize the ops once so that finalizing the shared LUT data again (i.e. when
+            // building a processor) does not change it anymore.
+            generatedOps.finalize();
+
+            m_opsCache[index] = generatedOps;
+        }
+    }
+
+    for (const auto & op : generatedOps)
+    {
+        // The generated LUTs are the expensive part so the data of the forward LUTs is shared
+        // (it is never modified once finalized), the other ops only hold a few parameters and
+        // are copied.
+        ConstOpRcPtr constOp = op;
+        auto lut1D = DynamicPtrCast<const Lut1DOpData>(constOp->data());
+        auto lut3D = DynamicPtrCast<const Lut3DOpData>(constOp->data());
+        if (lut1D && lut1D->getDirection() == TRANSFORM_DIR_FORWARD)
+        {
+            auto lut = std::const_pointer_cast<Lut1DOpData>(lut1D);
+            CreateLut1DOp(ops, lut, TRANSFORM_DIR_FORWARD);
+        }
+        else if (lut3D && lut3D->getDirection() == TRANSFORM_DIR_FORWARD)
+        {
+            auto lut = std::const_pointer_cast<Lut3DOpData>(lut3D);
+            CreateLut3DOp(ops, lut, TRANSFORM_DIR_FORWARD);
+        }
+        else
+        {
+            ops.push_back(op->clone());
+        }
+    }
+}
+
+void BuiltinTransformRegistryImpl::clearCaches() noexcept
+{
+    m_opsCache.clear();
 }
 
 void BuiltinTransformRegistryImpl::registerAll() noexcept
 {
     m_builtins.clear();
+    clearCaches();
 
     m_builtins.push_back({"IDENTITY", "", [](OpRcPtrVec & ops) -> void
                                             {
@@ -151,5 +203,15 @@ void CreateBuiltinTransformOps(OpRcPtrVec & ops, size_t nameIndex, TransformDire
     }
 }
 
+void ClearBuiltinTransformCaches()
+{
+    AutoMutex guard(globalRegistryMutex);
+
+    if (globalRegistry)
+    {
+        DynamicPtrCast<BuiltinTransformRegistryImpl>(globalRegistry)->clearCaches();
+    }
+}
+
 
 } // namespace OCIO_NAMESPACE
@@ -10,6 +10,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Caching.h"
 #include "Op.h"
 
 
@@ -61,16 +62,26 @@ public:
 
     void addBuiltin(const char * style, const char * description, OpCreator creator);
 
+    // Create the ops of a built-in transform. The ops are only generated and finalized once, the
+    // following calls share the LUT data of the generated ops and copy the other ops.
     void createOps(size_t index, OpRcPtrVec & ops) const;
 
     void registerAll() noexcept;
 
+    // Flush the generated ops.
+    void clearCaches() noexcept;
+
 private:
     Builtins m_builtins;
+
+    // Generated ops per built-in transform index.
+    mutable GenericCache<size_t, OpRcPtrVec> m_opsCache;
 };
 
 void CreateBuiltinTransformOps(OpRcPtrVec & ops, size_t nameIndex, TransformDirection direction);
 
+void ClearBuiltinTransformCaches();
+
 
 } // namespace OCIO_NAMESPACE
 
@@ -1,10 +1,14 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
+#include <iomanip>
 #include <iostream>
 #include <fstream>
 #include <set>
+#include <sstream>
 #include <vector>
 
 #include <OpenColorIO/OpenColorIO.h>
@@ -12,6 +16,7 @@ namespace OCIO = OCIO_NAMESPACE;
 
 #include "apputils/argparse.h"
 #include "apputils/logGuard.h"
+#include "utils/ParallelUtils.h"
 #include "utils/StringUtils.h"
 
 
@@ -24,11 +29,137 @@ const char * DESC_STRING = "\n\n"
 "All display/view pairs, color spaces, and named transforms are checked,\n"
 "regardless of whether they are active or inactive.\n\n"
 "Ociocheck can also be used to clean up formatting on an existing profile\n"
-"that has been manually edited, using the '-o' option.\n";
+"that has been manually edited, using the '-o' option.\n\n"
+"The processors are built on several threads. Use the '--timing' option to\n"
+"print the time spent per element and flag the unusually slow ones.\n";
+
+namespace
+{
+
+// An element is flagged as slow when its processors take more than this factor of the median
+// time of its section (and more than the minimum duration).
+constexpr double SlowFactor      = 10.0;
+constexpr double SlowMinDuration = 10.0; // in ms
+
+// Result of the processor creations for one config element (or one display/view pair).
+struct ElementCheck
+{
+    std::string m_name;
+    std::vector<std::string> m_errors;
+    double m_duration = 0.0; // in ms
+};
+
+using ElementChecks = std::vector<ElementCheck>;
+
+// Build the processor of the transform (if any) to load all the LUTs.
+void CheckTransform(const OCIO::ConstConfigRcPtr & config,
+                    const OCIO::ConstTransformRcPtr & transform,
+                    ElementCheck & check)
+{
+    if (!transform)
+    {
+        return;
+    }
+
+    try
+    {
+        OCIO::ConstProcessorRcPtr p = config->getProcessor(transform);
+    }
+    catch (OCIO::Exception & exception)
+    {
+        check.m_errors.push_back(exception.what());
+    }
+}
+
+// Run the checks using several threads. The results are stored per element so the output order
+// does not depend on the thread scheduling.
+template<typename Func>
+ElementChecks RunChecks(size_t numElements, int numThreads, Func checkFunc)
+{
+    ElementChecks checks(numElements);
+
+    OCIO::ParallelFor(numElements, static_cast<unsigned>(numThreads), [&](size_t idx)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        checkFunc(idx, checks[idx]);
+        const std::chrono::duration<double, std::milli> duration
+            = std::chrono::steady_clock::now() - start;
+        checks[idx].m_duration = duration.count();
+    });
+
+    return checks;
+}
+
+double GetSlowThreshold(const ElementChecks & checks)
+{
+    if (checks.empty())
+    {
+        return 0.0;
+    }
+
+    std::vector<double> durations;
+    durations.reserve(checks.size());
+    for (const auto & check : checks)
+    {
+        durations.push_back(check.m_duration);
+    }
+
+    std::nth_element(durations.begin(), durations.begin() + durations.size() / 2, durations.end());
+    const double median = durations[durations.size() / 2];
+
+    return std::max(median * SlowFactor, SlowMinDuration);
+}
+
+std::string GetTiming(const ElementCheck & check, double slowThreshold)
+{
+    std::ostringstream oss;
+    oss << " (" << std::fixed << std::setprecision(2) << check.m_duration << " ms)";
+    if (check.m_duration > slowThreshold)
+    {
+        oss << " -- slow";
+    }
+    return oss.str();
+}
+
+// Print the results of the config element checks and return the number of failed elements.
+int PrintChecks(const ElementChecks & checks, bool printTiming)
+{
+    const double slowThreshold = GetSlowThreshold(checks);
+
+    int errorcount = 0;
+    for (const auto & check : checks)
+    {
+        std::cout << check.m_name;
+        if (!check.m_errors.empty())
+        {
+            std::cout << " -- error";
+        }
+        if (printTiming)
+        {
+            std::cout << GetTiming(check, slowThreshold);
+        }
+        std::cout << std::endl;
+
+        for (const auto & error : check.m_errors)
+        {
+            std::cout << "\t" << error << std::endl;
+        }
+
+        if (!check.m_errors.empty())
+        {
+            errorcount += 1;
+        }
+    }
+    return errorcount;
+}
+
+} // anon.
 
 int main(int argc, const char **argv)
 {
     bool help = false;
+    bool timing = false;
+    int numThreads = 0;
     int errorcount = 0;
     std::string inputconfig;
     std::string outputconfig;
@@ -39,6 +170,9 @@ int main(int argc, const char **argv)
                "--help", &help, "Print help message",
                "--iconfig %s", &inputconfig, "Input .ocio configuration file (default: $OCIO)",
                "--oconfig %s", &outputconfig, "Output .ocio file",
+               "--threads %d", &numThreads, "Number of threads used to build the processors "
+                                            "(default: 0 i.e. all the cores)",
+               "--timing", &timing, "Print the time spent to build the processors of each element",
                NULL);
 
     if (ap.parse(argc, argv) < 0)
@@ -56,6 +190,12 @@ int main(int argc, const char **argv)
         return 1;
     }
 
+    if (numThreads < 0)
+    {
+        std::cout << "ERROR: The number of threads must be positive." << std::endl;
+        return 1;
+    }
+
     // Set the logging level to INFO.
     OCIO::SetLoggingLevel(OCIO::LOGGING_LEVEL_INFO);
 
@@ -157,6 +297,7 @@ int main(int argc, const char **argv)
 
                 // Iterate over all displays & views (active & inactive).
 
+                std::vector<std::pair<std::string, std::string>> displayViews;
                 for (int idxDisp = 0; idxDisp < config->getNumDisplaysAll(); ++idxDisp)
                 {
                     const char * displayName = config->getDisplayAll(idxDisp);
@@ -168,22 +309,7 @@ int main(int argc, const char **argv)
                         const char * viewName = config->getView(OCIO::VIEW_SHARED, 
                                                                 displayName, 
                                                                 idxView);
-                        try
-                        {
-                            OCIO::ConstProcessorRcPtr process 
-                                = displayTestConfig->getProcessor(srcColorSpace.c_str(), 
-                                                                  displayName,
-                                                                  viewName,
-                                                                  OCIO::TRANSFORM_DIR_FORWARD);
-
-                            std::cout << "(" << displayName << ", " << viewName << ")"
-                                      << std::endl;
-                        }
-                        catch(OCIO::Exception & exception)
-                        {
-                            std::cout << "ERROR: " << exception.what() << std::endl;
-                            errorcount += 1;
-                        }
+                        displayViews.emplace_back(displayName, viewName);
                     }
 
                     // Iterate over display-defined views.
@@ -192,22 +318,49 @@ int main(int argc, const char **argv)
                     {
                         const char * viewName = config->getView(OCIO::VIEW_DISPLAY_DEFINED, 
                                                                 displayName, idxView);
-                        try
-                        {
-                            OCIO::ConstProcessorRcPtr process 
-                                = displayTestConfig->getProcessor(srcColorSpace.c_str(), 
-                                                                  displayName,
-                                                                  viewName,
-                                                                  OCIO::TRANSFORM_DIR_FORWARD);
-
-                            std::cout << "(" << displayName << ", " << viewName << ")"
-                                      << std::endl;
-                        }
-                        catch(OCIO::Exception & exception)
+                        displayViews.emplace_back(displayName, viewName);
+                    }
+                }
+
+                const ElementChecks checks
+                    = RunChecks(displayViews.size(), numThreads,
+                                [&](size_t idx, ElementCheck & check)
+                {
+                    const std::string & displayName = displayViews[idx].first;
+                    const std::string & viewName    = displayViews[idx].second;
+
+                    check.m_name = "(" + displayName + ", " + viewName + ")";
+
+                    try
+                    {
+                        OCIO::ConstProcessorRcPtr process 
+                            = displayTestConfig->getProcessor(srcColorSpace.c_str(), 
+                                                              displayName.c_str(),
+                                                              viewName.c_str(),
+                                                              OCIO::TRANSFORM_DIR_FORWARD);
+                    }
+                    catch(OCIO::Exception & exception)
+                    {
+                        check.m_errors.push_back(exception.what());
+                    }
+                });
+
+                const double slowThreshold = GetSlowThreshold(checks);
+                for (const auto & check : checks)
+                {
+                    if (check.m_errors.empty())
+                    {
+                        std::cout << check.m_name;
+                        if (timing)
                         {
-                            std::cout << "ERROR: " << exception.what() << std::endl;
-                            errorcount += 1;
+                            std::cout << GetTiming(check, slowThreshold);
                         }
+                        std::cout << std::endl;
+                    }
+                    else
+                    {
+                        std::cout << "ERROR: " << check.m_errors.front() << std::endl;
+                        errorcount += 1;
                     }
                 }
             }
@@ -291,68 +444,22 @@ int main(int argc, const char **argv)
                 OCIO::SEARCH_REFERENCE_SPACE_ALL,   // Iterate over scene & display color spaces.
                 OCIO::COLORSPACE_ALL);              // Iterate over active & inactive color spaces.
 
-            for(int i=0; i<numCS; ++i)
+            const ElementChecks checks = RunChecks(numCS, numThreads,
+                                                   [&](size_t idx, ElementCheck & check)
             {
                 OCIO::ConstColorSpaceRcPtr cs = config->getColorSpace(config->getColorSpaceNameByIndex(
                     OCIO::SEARCH_REFERENCE_SPACE_ALL,
                     OCIO::COLORSPACE_ALL,
-                    i));
+                    static_cast<int>(idx)));
 
-                // Try to load the transform for the to_ref direction -- this will load any LUTs.
-                bool toRefOK = true;
-                std::string toRefErrorText;
-                try
-                {
-                    OCIO::ConstTransformRcPtr t = cs->getTransform(OCIO::COLORSPACE_DIR_TO_REFERENCE);
-                    if(t)
-                    {
-                        OCIO::ConstProcessorRcPtr p = config->getProcessor(t);
-                    }
-                }
-                catch(OCIO::Exception & exception)
-                {
-                    toRefOK = false;
-                    toRefErrorText = exception.what();
-                }
+                check.m_name = cs->getName();
 
-                // Try to load the transform for the from_ref direction -- this will load any LUTs.
-                bool fromRefOK = true;
-                std::string fromRefErrorText;
-                try
-                {
-                    OCIO::ConstTransformRcPtr t = cs->getTransform(OCIO::COLORSPACE_DIR_FROM_REFERENCE);
-                    if(t)
-                    {
-                        OCIO::ConstProcessorRcPtr p = config->getProcessor(t);
-                    }
-                }
-                catch(OCIO::Exception & exception)
-                {
-                    fromRefOK = false;
-                    fromRefErrorText = exception.what();
-                }
+                // Try to load the transforms for both directions -- this will load any LUTs.
+                CheckTransform(config, cs->getTransform(OCIO::COLORSPACE_DIR_TO_REFERENCE), check);
+                CheckTransform(config, cs->getTransform(OCIO::COLORSPACE_DIR_FROM_REFERENCE), check);
+            });
 
-                if(!toRefOK || !fromRefOK)
-                {
-                    // There was a problem with one of the color space's transforms.
-                    std::cout << cs->getName();
-                    std::cout << " -- error" << std::endl;
-                    if(!toRefOK)
-                    {
-                        std::cout << "\t" << toRefErrorText << std::endl;
-                    }
-                    if(!fromRefOK)
-                    {
-                        std::cout << "\t" << fromRefErrorText << std::endl;
-                    }
-                    errorcount += 1;
-                }
-                else
-                {
-                    // The color space's transforms load ok.
-                    std::cout << cs->getName() << std::endl;
-                }
-            }
+            errorcount += PrintChecks(checks, timing);
         }
 
         {
@@ -366,66 +473,21 @@ int main(int argc, const char **argv)
                 std::cout << "no named transforms defined" << std::endl;
             }
 
-            for(int i = 0; i<numNT; ++i)
+            const ElementChecks checks = RunChecks(numNT, numThreads,
+                                                   [&](size_t idx, ElementCheck & check)
             {
                 OCIO::ConstNamedTransformRcPtr nt = config->getNamedTransform(
-                    config->getNamedTransformNameByIndex(OCIO::NAMEDTRANSFORM_ALL, i));
+                    config->getNamedTransformNameByIndex(OCIO::NAMEDTRANSFORM_ALL,
+                                                         static_cast<int>(idx)));
 
-                // Try to load the transform -- this will load any LUTs.
-                bool fwdOK = true;
-                std::string fwdErrorText;
-                try
-                {
-                    OCIO::ConstTransformRcPtr t = nt->getTransform(OCIO::TRANSFORM_DIR_FORWARD);
-                    if(t)
-                    {
-                        OCIO::ConstProcessorRcPtr p = config->getProcessor(t);
-                    }
-                }
-                catch(OCIO::Exception & exception)
-                {
-                    fwdOK = false;
-                    fwdErrorText = exception.what();
-                }
+                check.m_name = nt->getName();
 
-                // Try to load the inverse_transform -- this will load any LUTs.
-                bool invOK = true;
-                std::string invErrorText;
-                try
-                {
-                    OCIO::ConstTransformRcPtr t = nt->getTransform(OCIO::TRANSFORM_DIR_INVERSE);
-                    if(t)
-                    {
-                        OCIO::ConstProcessorRcPtr p = config->getProcessor(t);
-                    }
-                }
-                catch(OCIO::Exception & exception)
-                {
-                    invOK = false;
-                    invErrorText = exception.what();
-                }
+                // Try to load the transform & inverse transform -- this will load any LUTs.
+                CheckTransform(config, nt->getTransform(OCIO::TRANSFORM_DIR_FORWARD), check);
+                CheckTransform(config, nt->getTransform(OCIO::TRANSFORM_DIR_INVERSE), check);
+            });
 
-                if(!fwdOK || !invOK)
-                {
-                    // There was a problem with one of the named transform's transforms.
-                    std::cout << nt->getName();
-                    std::cout << " -- error" << std::endl;
-                    if(!fwdOK)
-                    {
-                        std::cout << "\t" << fwdErrorText << std::endl;
-                    }
-                    if(!invOK)
-                    {
-                        std::cout << "\t" << invErrorText << std::endl;
-                    }
-                    errorcount += 1;
-                }
-                else
-                {
-                    // The named transform's transforms load ok.
-                    std::cout << nt->getName() << std::endl;
-                }
-            }
+            errorcount += PrintChecks(checks, timing);
         }
 
         {
@@ -438,65 +500,20 @@ int main(int argc, const char **argv)
                 std::cout << "no looks defined" << std::endl;
             }
 
-            for(int i=0; i<numL; ++i)
+            const ElementChecks checks = RunChecks(numL, numThreads,
+                                                   [&](size_t idx, ElementCheck & check)
             {
-                OCIO::ConstLookRcPtr look = config->getLook(config->getLookNameByIndex(i)); 
+                OCIO::ConstLookRcPtr look
+                    = config->getLook(config->getLookNameByIndex(static_cast<int>(idx)));
 
-                // Try to load the transform -- this will load any LUTs.
-                bool fwdOK = true;
-                std::string fwdErrorText;
-                try
-                {
-                    OCIO::ConstTransformRcPtr t = look->getTransform();
-                    if(t)
-                    {
-                        OCIO::ConstProcessorRcPtr p = config->getProcessor(t);
-                    }
-                }
-                catch(OCIO::Exception & exception)
-                {
-                    fwdOK = false;
-                    fwdErrorText = exception.what();
-                }
+                check.m_name = look->getName();
 
-                // Try to load the inverse transform -- this will load any LUTs.
-                bool invOK = true;
-                std::string invErrorText;
-                try
-                {
-                    OCIO::ConstTransformRcPtr t = look->getInverseTransform();
-                    if(t)
-                    {
-                        OCIO::ConstProcessorRcPtr p = config->getProcessor(t);
-                    }
-                }
-                catch(OCIO::Exception & exception)
-                {
-                    invOK = false;
-                    invErrorText = exception.what();
-                }
+                // Try to load the transform & inverse transform -- this will load any LUTs.
+                CheckTransform(config, look->getTransform(), check);
+                CheckTransform(config, look->getInverseTransform(), check);
+            });
 
-                if(!fwdOK || !invOK)
-                {
-                    // There was a problem with one of the look transform's transforms.
-                    std::cout << look->getName();
-                    std::cout << " -- error" << std::endl;
-                    if(!fwdOK)
-                    {
-                        std::cout << "\t" << fwdErrorText << std::endl;
-                    }
-                    if(!invOK)
-                    {
-                        std::cout << "\t" << invErrorText << std::endl;
-                    }
-                    errorcount += 1;
-                }
-                else
-                {
-                    // The look transform's transforms load ok.
-                    std::cout << look->getName() << std::endl;
-                }
-            }
+            errorcount += PrintChecks(checks, timing);
         }
 
         std::cout << std::endl;
@@ -5,16 +5,262 @@
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "apputils/argparse.h"
+#include "utils/ParallelUtils.h"
 #include "utils/StringUtils.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iterator>
 #include <limits>
 #include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
 
 
 namespace OCIO = OCIO_NAMESPACE;
 
+// The statistics of a series of durations in ms.
+struct Statistics
+{
+    size_t m_count    { 0 }; // Number of durations used by the statistics.
+    size_t m_rejected { 0 }; // Number of rejected outliers.
+
+    double m_min    { 0.0 };
+    double m_median { 0.0 };
+    double m_p90    { 0.0 };
+    double m_p99    { 0.0 };
+    double m_mean   { 0.0 };
+    double m_stdDev { 0.0 };
+};
+
+// Get a percentile of sorted values using the nearest-rank method.
+double GetPercentile(const std::vector<double> & sorted, double percentile)
+{
+    const size_t rank = size_t(std::ceil(percentile / 100.0 * double(sorted.size())));
+    return sorted[std::min(std::max(rank, size_t(1)), sorted.size()) - 1];
+}
+
+Statistics ComputeStatistics(std::vector<double> durations, bool rejectOutliers)
+{
+    Statistics stats;
+    if (durations.empty())
+    {
+        return stats;
+    }
+
+    std::sort(durations.begin(), durations.end());
+
+    if (rejectOutliers && durations.size() >= 4)
+    {
+        // Tukey's fences i.e. reject the durations farther than 1.5 times the interquartile
+        // range from the first or third quartile.
+        const double q1  = GetPercentile(durations, 25.0);
+        const double q3  = GetPercentile(durations, 75.0);
+        const double iqr = q3 - q1;
+
+        std::vector<double> kept;
+        std::copy_if(durations.begin(), durations.end(), std::back_inserter(kept),
+                     [&](double value)
+                     {
+                         return value >= q1 - 1.5 * iqr && value <= q3 + 1.5 * iqr;
+                     });
+
+        stats.m_rejected = durations.size() - kept.size();
+        durations.swap(kept);
+    }
+
+    const size_t count = durations.size();
+    const size_t mid   = count / 2;
+
+    stats.m_count  = count;
+    stats.m_min    = durations.front();
+    stats.m_median = (count % 2) ? durations[mid] : (durations[mid - 1] + durations[mid]) / 2.0;
+    stats.m_p90    = GetPercentile(durations, 90.0);
+    stats.m_p99    = GetPercentile(durations, 99.0);
+
+    for (const double value : durations)
+    {
+        stats.m_mean += value;
+    }
+    stats.m_mean /= double(count);
+
+    for (const double value : durations)
+    {
+        stats.m_stdDev += (value - stats.m_mean) * (value - stats.m_mean);
+    }
+    stats.m_stdDev = std::sqrt(stats.m_stdDev / double(count));
+
+    return stats;
+}
+
+// The measurement settings & results of a run, to be saved in JSON or CSV files and compared
+// with the ones of another run.
+class Report
+{
+public:
+    struct Result
+    {
+        std::string m_name;
+        Statistics m_stats;
+        double m_mpixPerSec { 0.0 }; // Zero when not processing an image.
+    };
+
+    static Report & Instance()
+    {
+        static Report report;
+        return report;
+    }
+
+    // Number of iterations to run, and exclude from the statistics, before the measured ones.
+    unsigned m_warmup { 0 };
+    bool m_rejectOutliers { false };
+
+    std::string m_commandLine;
+    unsigned m_iterations { 0 };
+    // The CPU renderers processing the image.
+    std::vector<std::string> m_renderers;
+
+    std::vector<Result> m_results;
+
+    void saveJson(const std::string & filename) const;
+    void saveCsv(const std::string & filename) const;
+
+private:
+    Report() = default;
+};
+
+std::string JsonString(const std::string & str)
+{
+    std::ostringstream oss;
+    oss << "\"";
+    for (const char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            oss << '\\' << c;
+        }
+        else if (c == '\t')
+        {
+            oss << "\\t";
+        }
+        else if (c == '\n')
+        {
+            oss << "\\n";
+        }
+        else
+        {
+            oss << c;
+        }
+    }
+    oss << "\"";
+    return oss.str();
+}
+
+void Report::saveJson(const std::string & filename) const
+{
+    std::ofstream out(filename);
+    if (!out)
+    {
+        std::string err("Could not open the file: ");
+        err += filename;
+        throw OCIO::Exception(err.c_str());
+    }
+
+    out << std::setprecision(9);
+
+    out << "{" << std::endl
+        << "  \"ocio_version\": " << JsonString(OCIO::GetVersion()) << "," << std::endl
+        << "  \"cpu\": " << JsonString(OCIO::GetCPUInfo()) << "," << std::endl
+        << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << "," << std::endl
+        << "  \"command\": " << JsonString(m_commandLine) << "," << std::endl
+        << "  \"iterations\": " << m_iterations << "," << std::endl
+        << "  \"warmup\": " << m_warmup << "," << std::endl
+        << "  \"reject_outliers\": " << (m_rejectOutliers ? "true" : "false") << "," << std::endl;
+
+    out << "  \"renderers\": [";
+    for (size_t idx = 0; idx < m_renderers.size(); ++idx)
+    {
+        out << (idx ? ", " : "") << JsonString(m_renderers[idx]);
+    }
+    out << "]," << std::endl;
+
+    // Note that the compare mode expects one result per line.
+    out << "  \"results\": [" << std::endl;
+    for (size_t idx = 0; idx < m_results.size(); ++idx)
+    {
+        const Result & res = m_results[idx];
+        out << "    { \"name\": "     << JsonString(res.m_name)
+            << ", \"count\": "        << res.m_stats.m_count
+            << ", \"rejected\": "     << res.m_stats.m_rejected
+            << ", \"min_ms\": "       << res.m_stats.m_min
+            << ", \"median_ms\": "    << res.m_stats.m_median
+            << ", \"p90_ms\": "       << res.m_stats.m_p90
+            << ", \"p99_ms\": "       << res.m_stats.m_p99
+            << ", \"mean_ms\": "      << res.m_stats.m_mean
+            << ", \"stddev_ms\": "    << res.m_stats.m_stdDev
+            << ", \"mpix_per_s\": "   << res.m_mpixPerSec
+            << " }" << (idx + 1 < m_results.size() ? "," : "") << std::endl;
+    }
+    out << "  ]" << std::endl
+        << "}" << std::endl;
+}
+
+std::string CsvString(const std::string & str)
+{
+    return "\"" + StringUtils::Replace(str, "\"", "\"\"") + "\"";
+}
+
+void Report::saveCsv(const std::string & filename) const
+{
+    std::ofstream out(filename);
+    if (!out)
+    {
+        std::string err("Could not open the file: ");
+        err += filename;
+        throw OCIO::Exception(err.c_str());
+    }
+
+    out << std::setprecision(9);
+
+    // The run information is repeated on each line so that the rows could be concatenated
+    // from several files.
+    const std::string cpu = CsvString(OCIO::GetCPUInfo());
+
+    std::string renderers;
+    for (const auto & renderer : m_renderers)
+    {
+        renderers += (renderers.empty() ? "" : " | ") + renderer;
+    }
+    renderers = CsvString(renderers);
+
+    out << "name,count,rejected,min_ms,median_ms,p90_ms,p99_ms,mean_ms,stddev_ms,mpix_per_s,"
+        << "ocio_version,cpu,renderers" << std::endl;
+
+    for (const auto & res : m_results)
+    {
+        out << CsvString(res.m_name)
+            << "," << res.m_stats.m_count
+            << "," << res.m_stats.m_rejected
+            << "," << res.m_stats.m_min
+            << "," << res.m_stats.m_median
+            << "," << res.m_stats.m_p90
+            << "," << res.m_stats.m_p99
+            << "," << res.m_stats.m_mean
+            << "," << res.m_stats.m_stdDev
+            << "," << res.m_mpixPerSec
+            << "," << OCIO::GetVersion()
+            << "," << cpu
+            << "," << renderers << std::endl;
+    }
+}
+
 // Utility to measure time in ms.
 class CustomMeasure
 {
@@ -25,147 +271,1078 @@ public:
     explicit CustomMeasure(const char * explanation)
         :   m_explanations(explanation)
         ,   m_iterations(1)
+        ,   m_warmup(0)
     {
         resume();
     }
 
+    // The first Report::m_warmup measures are excluded from the statistics i.e. the caller
+    // loops over m_warmup + iterations.
     explicit CustomMeasure(const char * explanation, unsigned iterations)
         :   m_explanations(explanation)
         ,   m_iterations(iterations)
+        ,   m_warmup(Report::Instance().m_warmup)
+    {
+    }
+
+    ~CustomMeasure()
+    {
+        if(m_started)
+        {
+            pause();
+        }
+
+        std::vector<double> durations;
+        for (size_t idx = m_warmup; idx < m_durations.size(); ++idx)
+        {
+            durations.push_back(m_durations[idx].count());
+        }
+
+        if (m_iterations > 0 && !durations.empty())
+        {
+            const size_t count = durations.size();
+
+            double total = 0.0;
+            for (const double value : durations)
+            {
+                total += value;
+            }
+
+            std::ostringstream oss;
+            oss.width(9);
+            oss.precision(6);
+
+            oss << m_explanations
+                << "For " << count << " iterations, it took: ["
+                << durations[0];
+
+            if (count > 1)
+            {
+                oss << ", "
+                    << ((total - durations[0]) / double(count - 1))
+                    << ", "
+                    << (total / double(count));
+            }
+
+            oss << "] ms";
+
+            const Statistics stats
+                = ComputeStatistics(durations, Report::Instance().m_rejectOutliers);
+
+            const double mpixPerSec = m_numPixels > 0 && stats.m_median > 0.0
+                ? double(m_numPixels) / 1e6 / (stats.m_median / 1000.0)
+                : 0.0;
+
+            if (count > 1)
+            {
+                oss << std::endl << "\t"
+                    << "min: " << stats.m_min
+                    << ", median: " << stats.m_median
+                    << ", p90: " << stats.m_p90
+                    << ", p99: " << stats.m_p99
+                    << ", stddev: " << stats.m_stdDev << " ms";
+
+                if (stats.m_rejected > 0)
+                {
+                    oss << " (" << stats.m_rejected << " outliers rejected)";
+                }
+
+                if (mpixPerSec > 0.0)
+                {
+                    oss << ", " << mpixPerSec << " Mpix/s";
+                }
+            }
+
+            std::cout << oss.str() << std::endl;
+
+            // The name is the explanation without the formatting.
+            Report::Result result;
+            result.m_name = StringUtils::Trim(StringUtils::Trim(m_explanations), ':');
+            result.m_stats = stats;
+            result.m_mpixPerSec = mpixPerSec;
+            Report::Instance().m_results.push_back(result);
+        }
+    }
+
+    // Report the processing speed of an image of that size.
+    void setNumPixels(size_t numPixels)
+    {
+        m_numPixels = numPixels;
+    }
+
+    void resume()
+    {
+        if(m_started)
+        {
+            throw OCIO::Exception("Measure already started.");
+        }
+
+        m_started = true;
+        m_start = std::chrono::high_resolution_clock::now();
+    }
+
+    void pause()
+    {
+        std::chrono::high_resolution_clock::time_point end
+           = std::chrono::high_resolution_clock::now();
+
+        if(m_started)
+        {
+            std::chrono::duration<float, std::milli> duration = end - m_start;
+
+            m_durations.push_back(duration);
+            m_duration += duration;
+        }
+        else
+        {
+            throw OCIO::Exception("Measure already stopped.");
+        }
+
+        m_started = false;
+    }
+
+private:
+    const std::string m_explanations;
+    const unsigned m_iterations { 1 };
+    const unsigned m_warmup { 0 };
+    size_t m_numPixels { 0 };
+
+    bool m_started { false };
+    std::chrono::high_resolution_clock::time_point m_start;
+
+    std::chrono::duration<float, std::milli> m_duration { 0 };
+    std::vector<std::chrono::duration<float, std::milli>> m_durations;
+};
+
+// Process the complete image line by line.
+void ProcessLines(CustomMeasure & m,
+                  OCIO::ConstCPUProcessorRcPtr & cpuProcessor,
+                  const OCIO::PackedImageDesc & img)
+{
+    // Always process the same complete image.
+    char * lineToProcess = reinterpret_cast<char *>(img.getData());
+
+    m.resume();
+
+    for(int h=0; h<img.getHeight(); ++h)
     {
+        OCIO::PackedImageDesc imageDesc((void*)lineToProcess,
+                                        img.getWidth(),
+                                        1, // Only one line.
+                                        img.getNumChannels(),
+                                        img.getBitDepth(),
+                                        OCIO::AutoStride,
+                                        OCIO::AutoStride,
+                                        OCIO::AutoStride);
+
+        // Apply the color transformation (in place).
+        cpuProcessor->apply(imageDesc);
+
+        // Find the next line.
+        lineToProcess += img.getYStrideBytes();
+    }
+
+    m.pause();
+}
+
+// Process the complete image pixel per pixel.
+void ProcessPixels(CustomMeasure & m,
+                   OCIO::ConstCPUProcessorRcPtr & cpuProcessor,
+                   const OCIO::PackedImageDesc & img)
+{
+    // Always process the same complete image.
+    char * lineToProcess = reinterpret_cast<char *>(img.getData());
+
+    m.resume();
+
+    for(int h=0; h<img.getHeight(); ++h)
+    {
+        char * pixelToProcess = lineToProcess;
+        for(int w=0; w<img.getWidth(); ++w)
+        {
+            cpuProcessor->applyRGBA(reinterpret_cast<float*>(pixelToProcess));
+
+            // Find the next pixel.
+            pixelToProcess += img.getXStrideBytes();
+        }
+
+        // Find the next line.
+        lineToProcess += img.getYStrideBytes();
+    }
+
+    m.pause();
+}
+
+OCIO::BitDepth GetBitDepthFromString(const std::string & str)
+{
+    if (str == "f32")
+    {
+        return OCIO::BIT_DEPTH_F32;
+    }
+    else if (str == "f16")
+    {
+        return OCIO::BIT_DEPTH_F16;
+    }
+    else if (str == "ui16")
+    {
+        return OCIO::BIT_DEPTH_UINT16;
+    }
+    else if (str == "ui12")
+    {
+        return OCIO::BIT_DEPTH_UINT12;
+    }
+    else if (str == "ui10")
+    {
+        return OCIO::BIT_DEPTH_UINT10;
+    }
+    else if (str == "ui8")
+    {
+        return OCIO::BIT_DEPTH_UINT8;
+    }
+
+    std::string err("Unsupported bit-depth: ");
+    err += str;
+    throw OCIO::Exception(err.c_str());
+}
+
+size_t GetChannelSizeInBytes(OCIO::BitDepth bitDepth)
+{
+    switch (bitDepth)
+    {
+        case OCIO::BIT_DEPTH_UINT8:
+            return 1;
+        case OCIO::BIT_DEPTH_UINT10:
+        case OCIO::BIT_DEPTH_UINT12:
+        case OCIO::BIT_DEPTH_UINT16:
+        case OCIO::BIT_DEPTH_F16:
+            return 2;
+        case OCIO::BIT_DEPTH_F32:
+            return 4;
+        default:
+            throw OCIO::Exception("Unsupported bit-depth.");
+    }
+}
+
+// The image layouts of the scaling matrix test.
+enum ImageLayout
+{
+    LAYOUT_RGBA = 0,
+    LAYOUT_RGB,
+    LAYOUT_BGRA,
+    LAYOUT_PLANAR
+};
+
+ImageLayout GetLayoutFromString(const std::string & str)
+{
+    if (str == "rgba")
+    {
+        return LAYOUT_RGBA;
+    }
+    else if (str == "rgb")
+    {
+        return LAYOUT_RGB;
+    }
+    else if (str == "bgra")
+    {
+        return LAYOUT_BGRA;
+    }
+    else if (str == "planar")
+    {
+        return LAYOUT_PLANAR;
+    }
+
+    std::string err("Unsupported image layout: ");
+    err += str;
+    throw OCIO::Exception(err.c_str());
+}
+
+// An image buffer of a given layout & bit-depth. The planar images store the R, G, B and A planes
+// one after the other.
+class MatrixImage
+{
+public:
+    MatrixImage() = delete;
+    MatrixImage(const MatrixImage &) = delete;
+
+    MatrixImage(long width, long height, ImageLayout layout, OCIO::BitDepth bitDepth)
+        :   m_width(width)
+        ,   m_height(height)
+        ,   m_layout(layout)
+        ,   m_bitDepth(bitDepth)
+        ,   m_numChannels(layout == LAYOUT_RGB ? 3 : 4)
+        ,   m_channelSize(GetChannelSizeInBytes(bitDepth))
+        ,   m_buffer(size_t(width) * size_t(height) * m_numChannels * m_channelSize, 0)
+    {
+    }
+
+    // Describe the lines [y, y + numLines) of the image.
+    std::shared_ptr<OCIO::ImageDesc> createDesc(long y, long numLines) const
+    {
+        char * data = const_cast<char *>(m_buffer.data());
+
+        if (m_layout == LAYOUT_PLANAR)
+        {
+            const size_t planeSize = size_t(m_width) * size_t(m_height) * m_channelSize;
+            char * first = data + size_t(y) * size_t(m_width) * m_channelSize;
+
+            return std::make_shared<OCIO::PlanarImageDesc>(first,
+                                                           first + planeSize,
+                                                           first + 2 * planeSize,
+                                                           first + 3 * planeSize,
+                                                           m_width,
+                                                           numLines,
+                                                           m_bitDepth,
+                                                           OCIO::AutoStride,
+                                                           OCIO::AutoStride);
+        }
+
+        const OCIO::ChannelOrdering order
+            = m_layout == LAYOUT_RGB  ? OCIO::CHANNEL_ORDERING_RGB
+            : m_layout == LAYOUT_BGRA ? OCIO::CHANNEL_ORDERING_BGRA
+                                      : OCIO::CHANNEL_ORDERING_RGBA;
+
+        return std::make_shared<OCIO::PackedImageDesc>(data
+                                                         + size_t(y) * size_t(m_width)
+                                                             * m_numChannels * m_channelSize,
+                                                       m_width,
+                                                       numLines,
+                                                       order,
+                                                       m_bitDepth,
+                                                       OCIO::AutoStride,
+                                                       OCIO::AutoStride,
+                                                       OCIO::AutoStride);
+    }
+
+    // Fill the image with random colors. The same seed always produces the same image.
+    void fillRandom(unsigned seed)
+    {
+        // Float images also contain values outside of [0, 1].
+        const bool isFloat = m_bitDepth == OCIO::BIT_DEPTH_F32 || m_bitDepth == OCIO::BIT_DEPTH_F16;
+        std::uniform_real_distribution<float> dist(isFloat ? -1.0f : 0.0f, isFloat ? 2.0f : 1.0f);
+        std::mt19937 generator(seed);
+
+        std::vector<float> values(size_t(m_width) * size_t(m_height) * 4);
+        for (auto & value : values)
+        {
+            value = dist(generator);
+        }
+
+        // Use an identity processor to convert the random values in the layout & bit-depth.
+        OCIO::ConstProcessorRcPtr identity
+            = OCIO::Config::CreateRaw()->getProcessor(OCIO::MatrixTransform::Create());
+        OCIO::ConstCPUProcessorRcPtr convert
+            = identity->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32,
+                                                 m_bitDepth,
+                                                 OCIO::OPTIMIZATION_DEFAULT);
+
+        OCIO::PackedImageDesc src(values.data(), m_width, m_height, 4);
+        convert->apply(src, *createDesc(0, m_height));
+    }
+
+private:
+    const long m_width;
+    const long m_height;
+    const ImageLayout m_layout;
+    const OCIO::BitDepth m_bitDepth;
+    const long m_numChannels;
+    const size_t m_channelSize;
+
+    std::vector<char> m_buffer;
+};
+
+struct MatrixOptions
+{
+    unsigned m_maxThreads { 1 };
+    std::vector<std::pair<long, long>> m_sizes;
+    std::vector<std::string> m_layouts;
+    std::vector<std::pair<std::string, std::string>> m_bitDepths;
+};
+
+// The fixed seed of the synthetic images so that all the runs process the same pixels.
+static constexpr unsigned RandomSeed = 20240701;
+
+// Measure the processing of a synthetic image split in horizontal bands, one per thread, for
+// each image size, layout, bit-depth pair and thread count. Reported values are:
+//  * Mpix/s: the image size divided by the median time to process the complete image.
+//  * efficiency: the Mpix/s divided by the thread count times the Mpix/s of one thread.
+//  * thread stddev: the standard deviation of the thread processing times (as a percentage of
+//    their mean), averaged over the iterations, to show the imbalance between the threads.
+// The warm-up iterations are excluded from the measures.
+void ProcessScalingMatrix(const OCIO::ConstProcessorRcPtr & optProcessor,
+                          OCIO::OptimizationFlags optimFlags,
+                          const MatrixOptions & options,
+                          unsigned iterations)
+{
+    if (iterations == 0)
+    {
+        throw OCIO::Exception("The scaling matrix needs at least one iteration.");
+    }
+
+    const unsigned warmup = Report::Instance().m_warmup;
+
+    std::cout << "Scaling matrix (random seed " << RandomSeed << ", "
+              << std::thread::hardware_concurrency() << " hardware threads):" << std::endl;
+
+    for (const auto & size : options.m_sizes)
+    {
+        const long width  = size.first;
+        const long height = size.second;
+        const double numMPixels = double(width) * double(height) / 1e6;
+
+        // The thread counts are 1, 2, 4, ... up to the maximum number of threads. Each thread
+        // processes at least one line of the image.
+        const unsigned maxThreads
+            = unsigned(std::min(long(std::max(1u, options.m_maxThreads)), height));
+
+        std::vector<unsigned> threadCounts;
+        for (unsigned numThreads = 1; numThreads < maxThreads; numThreads *= 2)
+        {
+            threadCounts.push_back(numThreads);
+        }
+        threadCounts.push_back(maxThreads);
+
+        for (const auto & layoutStr : options.m_layouts)
+        {
+            const ImageLayout layout = GetLayoutFromString(layoutStr);
+
+            for (const auto & bitDepths : options.m_bitDepths)
+            {
+                const OCIO::BitDepth inBitDepth  = GetBitDepthFromString(bitDepths.first);
+                const OCIO::BitDepth outBitDepth = GetBitDepthFromString(bitDepths.second);
+
+                OCIO::ConstCPUProcessorRcPtr cpu
+                    = optProcessor->getOptimizedCPUProcessor(inBitDepth, outBitDepth, optimFlags);
+
+                MatrixImage src(width, height, layout, inBitDepth);
+                src.fillRandom(RandomSeed);
+                MatrixImage dst(width, height, layout, outBitDepth);
+
+                std::cout << std::endl
+                          << "  " << width << "x" << height << " " << layoutStr << " "
+                          << bitDepths.first << " -> " << bitDepths.second << std::endl
+                          << "    threads      Mpix/s   efficiency   thread stddev" << std::endl;
+
+                double singleThreadMPixels = 0.0;
+
+                for (const unsigned numThreads : threadCounts)
+                {
+                    // Split the image in horizontal bands.
+                    std::vector<std::shared_ptr<OCIO::ImageDesc>> srcBands, dstBands;
+                    for (unsigned idx = 0; idx < numThreads; ++idx)
+                    {
+                        const long start = long(height * idx / numThreads);
+                        const long end   = long(height * (idx + 1) / numThreads);
+                        srcBands.push_back(src.createDesc(start, end - start));
+                        dstBands.push_back(dst.createDesc(start, end - start));
+                    }
+
+                    std::vector<double> durations;
+                    double threadStdDev = 0.0;
+
+                    for (unsigned iter = 0; iter < warmup + iterations; ++iter)
+                    {
+                        std::atomic<bool> go { false };
+                        std::vector<double> threadDurations(numThreads, 0.0);
+
+                        std::vector<std::thread> threads;
+                        for (unsigned idx = 0; idx < numThreads; ++idx)
+                        {
+                            threads.emplace_back([&, idx]()
+                            {
+                                while (!go)
+                                {
+                                    std::this_thread::yield();
+                                }
+
+                                const auto start = std::chrono::high_resolution_clock::now();
+                                cpu->apply(*srcBands[idx], *dstBands[idx]);
+                                const std::chrono::duration<double, std::milli> duration
+                                    = std::chrono::high_resolution_clock::now() - start;
+
+                                threadDurations[idx] = duration.count();
+                            });
+                        }
+
+                        // Only measure the processing, not the thread creation.
+                        const auto start = std::chrono::high_resolution_clock::now();
+                        go = true;
+                        for (auto & thread : threads)
+                        {
+                            thread.join();
+                        }
+                        const std::chrono::duration<double, std::milli> duration
+                            = std::chrono::high_resolution_clock::now() - start;
+
+                        if (iter < warmup)
+                        {
+                            continue;
+                        }
+
+                        durations.push_back(duration.count());
+
+                        double mean = 0.0;
+                        for (const double value : threadDurations)
+                        {
+                            mean += value;
+                        }
+                        mean /= numThreads;
+
+                        double variance = 0.0;
+                        for (const double value : threadDurations)
+                        {
+                            variance += (value - mean) * (value - mean);
+                        }
+                        variance /= numThreads;
+
+                        threadStdDev += mean > 0.0 ? std::sqrt(variance) / mean : 0.0;
+                    }
+
+                    const Statistics stats
+                        = ComputeStatistics(durations, Report::Instance().m_rejectOutliers);
+
+                    const double mpixels = numMPixels / (stats.m_median / 1000.0);
+                    if (numThreads == 1)
+                    {
+                        singleThreadMPixels = mpixels;
+                    }
+
+                    std::cout << std::fixed << std::setprecision(2)
+                              << "    " << std::setw(7) << numThreads
+                              << "  " << std::setw(10) << mpixels
+                              << "  " << std::setw(9) << std::setprecision(1)
+                              << (100.0 * mpixels / (numThreads * singleThreadMPixels)) << " %"
+                              << "  " << std::setw(12)
+                              << (100.0 * threadStdDev / iterations) << " %"
+                              << std::defaultfloat << std::endl;
+
+                    std::ostringstream name;
+                    name << "Scaling matrix " << width << "x" << height << " " << layoutStr << " "
+                         << bitDepths.first << ":" << bitDepths.second << " " << numThreads
+                         << " threads";
+
+                    Report::Result result;
+                    result.m_name = name.str();
+                    result.m_stats = stats;
+                    result.m_mpixPerSec = mpixels;
+                    Report::Instance().m_results.push_back(result);
+                }
+            }
+        }
+    }
+}
+
+// A color transformation of the config i.e. a color space pair or a (display, view) pair.
+struct ConfigTransform
+{
+    std::string m_name;
+    std::function<OCIO::ConstProcessorRcPtr(const OCIO::ConstConfigRcPtr &)> m_getProcessor;
+};
+
+// Get all the color space pairs, and all the (display, view) pairs from the scene_linear role
+// (or from the first color space), of the active color spaces & displays of the config.
+std::vector<ConfigTransform> GetConfigTransforms(const OCIO::ConstConfigRcPtr & config)
+{
+    std::vector<ConfigTransform> transforms;
+
+    StringUtils::StringVec colorSpaces;
+    for (int idx = 0; idx < config->getNumColorSpaces(); ++idx)
+    {
+        colorSpaces.push_back(config->getColorSpaceNameByIndex(idx));
+    }
+
+    for (const auto & src : colorSpaces)
+    {
+        for (const auto & dst : colorSpaces)
+        {
+            if (src == dst)
+            {
+                continue;
+            }
+
+            transforms.push_back({ src + " -> " + dst,
+                                   [src, dst](const OCIO::ConstConfigRcPtr & cfg)
+                                   {
+                                       return cfg->getProcessor(src.c_str(), dst.c_str());
+                                   } });
+        }
+    }
+
+    if (colorSpaces.empty())
+    {
+        return transforms;
+    }
+
+    const std::string src = config->hasRole(OCIO::ROLE_SCENE_LINEAR)
+                                ? std::string(OCIO::ROLE_SCENE_LINEAR) : colorSpaces.front();
+
+    for (int dispIdx = 0; dispIdx < config->getNumDisplays(); ++dispIdx)
+    {
+        const std::string display = config->getDisplay(dispIdx);
+        for (int viewIdx = 0; viewIdx < config->getNumViews(display.c_str()); ++viewIdx)
+        {
+            const std::string view = config->getView(display.c_str(), viewIdx);
+
+            transforms.push_back({ src + " -> (" + display + ", " + view + ")",
+                                   [src, display, view](const OCIO::ConstConfigRcPtr & cfg)
+                                   {
+                                       return cfg->getProcessor(src.c_str(),
+                                                                display.c_str(),
+                                                                view.c_str(),
+                                                                OCIO::TRANSFORM_DIR_FORWARD);
+                                   } });
+        }
+    }
+
+    return transforms;
+}
+
+// The phases of a processor creation, from the transform to the CPU renderers & GPU shader.
+enum CreationPhase
+{
+    PHASE_PROCESSOR = 0, // Config::getProcessor i.e. resolve the transform & build the ops.
+    PHASE_OPTIMIZE,      // Processor::getOptimizedProcessor i.e. optimize the ops.
+    PHASE_CPU,           // Processor::getOptimizedCPUProcessor i.e. create the CPU renderers.
+    PHASE_GPU,           // Processor::getOptimizedGPUProcessor.
+    PHASE_SHADER,        // GPUProcessor::extractGpuShaderInfo i.e. create the GPU shader.
+    PHASE_TOTAL,
+    NUM_PHASES
+};
+
+const char * const PhaseNames[NUM_PHASES]
+    = { "processor", "optimize", "cpu", "gpu", "shader", "total" };
+
+// Measure the creation of all the processors of one transform.
+void MeasureCreation(const ConfigTransform & transform,
+                     const OCIO::ConstConfigRcPtr & config,
+                     OCIO::OptimizationFlags optimFlags,
+                     double (&durations)[NUM_PHASES])
+{
+    auto elapsed = [](std::chrono::high_resolution_clock::time_point & start) -> double
+    {
+        const auto end = std::chrono::high_resolution_clock::now();
+        const std::chrono::duration<double, std::milli> duration = end - start;
+        start = end;
+        return duration.count();
+    };
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    OCIO::ConstProcessorRcPtr processor = transform.m_getProcessor(config);
+    durations[PHASE_PROCESSOR] = elapsed(start);
+
+    OCIO::ConstProcessorRcPtr optProcessor
+        = processor->getOptimizedProcessor(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32, optimFlags);
+    durations[PHASE_OPTIMIZE] = elapsed(start);
+
+    optProcessor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32, optimFlags);
+    durations[PHASE_CPU] = elapsed(start);
+
+    OCIO::ConstGPUProcessorRcPtr gpuProcessor = optProcessor->getOptimizedGPUProcessor(optimFlags);
+    durations[PHASE_GPU] = elapsed(start);
+
+    // The shader description is not part of the measure.
+    OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_2);
+    start = std::chrono::high_resolution_clock::now();
+
+    gpuProcessor->extractGpuShaderInfo(shaderDesc);
+    durations[PHASE_SHADER] = elapsed(start);
+
+    durations[PHASE_TOTAL] = 0.0;
+    for (int phase = 0; phase < PHASE_TOTAL; ++phase)
+    {
+        durations[PHASE_TOTAL] += durations[phase];
+    }
+}
+
+// Measure the processor creation latency of all the color transformations of the config:
+//  * cold: all the caches are cleared & disabled i.e. the first creation in a session.
+//  * warm: the processor caches are enabled & filled i.e. a later creation in the session.
+// The median of each phase is reported for the complete config, then the slowest
+// transformations (i.e. cold total) are listed with their phase breakdown.
+void ProcessConfigLatency(const OCIO::ConstConfigRcPtr & config,
+                          OCIO::OptimizationFlags optimFlags,
+                          unsigned iterations,
+                          unsigned numSlowest)
+{
+    const std::vector<ConfigTransform> transforms = GetConfigTransforms(config);
+    if (transforms.empty())
+    {
+        throw OCIO::Exception("The config does not have any color transformation to measure.");
+    }
+
+    OCIO::ConfigRcPtr coldConfig = config->createEditableCopy();
+    coldConfig->setProcessorCacheFlags(OCIO::PROCESSOR_CACHE_OFF);
+
+    OCIO::ConfigRcPtr warmConfig = config->createEditableCopy();
+    warmConfig->setProcessorCacheFlags(OCIO::PROCESSOR_CACHE_DEFAULT);
+
+    const unsigned warmup = Report::Instance().m_warmup;
+
+    // Durations (in ms) of each phase for each transform & measured iteration.
+    enum Temperature { COLD = 0, WARM, NUM_TEMPERATURES };
+    std::vector<std::vector<double>> durations[NUM_TEMPERATURES][NUM_PHASES];
+    for (auto & temperature : durations)
+    {
+        for (auto & phase : temperature)
+        {
+            phase.resize(transforms.size());
+        }
+    }
+
+    // Some color transformations could fail (e.g. missing LUT files) so they are reported
+    // but not measured.
+    std::vector<bool> failed(transforms.size(), false);
+
+    // Fill the caches of the warm config.
+    for (size_t idx = 0; idx < transforms.size(); ++idx)
+    {
+        double ignored[NUM_PHASES];
+        try
+        {
+            MeasureCreation(transforms[idx], warmConfig, optimFlags, ignored);
+        }
+        catch (OCIO::Exception & ex)
+        {
+            failed[idx] = true;
+            std::cerr << "WARNING: Skipping '" << transforms[idx].m_name << "': "
+                      << ex.what() << std::endl;
+        }
+    }
+
+    for (unsigned iter = 0; iter < warmup + iterations; ++iter)
+    {
+        for (size_t idx = 0; idx < transforms.size(); ++idx)
+        {
+            if (failed[idx])
+            {
+                continue;
+            }
+
+            double cold[NUM_PHASES], warm[NUM_PHASES];
+
+            // Flush all the global internal caches (e.g. the file caches).
+            OCIO::ClearAllCaches();
+            MeasureCreation(transforms[idx], coldConfig, optimFlags, cold);
+
+            MeasureCreation(transforms[idx], warmConfig, optimFlags, warm);
+
+            if (iter < warmup)
+            {
+                continue;
+            }
+
+            for (int phase = 0; phase < NUM_PHASES; ++phase)
+            {
+                durations[COLD][phase][idx].push_back(cold[phase]);
+                durations[WARM][phase][idx].push_back(warm[phase]);
+            }
+        }
     }
 
-    ~CustomMeasure()
+    const bool rejectOutliers = Report::Instance().m_rejectOutliers;
+
+    // The median durations of each phase of each transform.
+    std::vector<double> medians[NUM_TEMPERATURES][NUM_PHASES];
+    for (int temp = 0; temp < NUM_TEMPERATURES; ++temp)
     {
-        if(m_started)
+        for (int phase = 0; phase < NUM_PHASES; ++phase)
         {
-            pause();
+            for (size_t idx = 0; idx < transforms.size(); ++idx)
+            {
+                medians[temp][phase].push_back(
+                    ComputeStatistics(durations[temp][phase][idx], rejectOutliers).m_median);
+            }
         }
+    }
 
-        if (m_iterations > 0)
-        {
-            std::ostringstream oss;
-            oss.width(9);
-            oss.precision(6);
+    const size_t numMeasured = std::count(failed.begin(), failed.end(), false);
 
-            oss << m_explanations
-                << "For " << m_iterations << " iterations, it took: ["
-                << m_durations[0].count();
+    std::cout << "Processor creation latency of " << numMeasured << " color transformations ("
+              << (transforms.size() - numMeasured) << " skipped):" << std::endl << std::endl
+              << "    phase           cold sum (ms)   cold max (ms)   warm sum (ms)" << std::endl;
 
-            if (m_iterations > 1)
+    for (int phase = 0; phase < NUM_PHASES; ++phase)
+    {
+        double sum[NUM_TEMPERATURES] = { 0.0, 0.0 };
+        for (int temp = 0; temp < NUM_TEMPERATURES; ++temp)
+        {
+            for (const double value : medians[temp][phase])
             {
-                oss << ", "
-                    << (std::chrono::duration<float, std::milli>(m_duration - m_durations[0]).count()
-                                / float(m_iterations-1))
-                    << ", "
-                    << (m_duration.count()/float(m_iterations));
+                sum[temp] += value;
             }
+        }
 
-            oss << "] ms";
+        const double coldMax
+            = *std::max_element(medians[COLD][phase].begin(), medians[COLD][phase].end());
 
-            std::cout << oss.str() << std::endl;
-        }
+        std::cout << std::fixed << std::setprecision(3)
+                  << "    " << std::left << std::setw(10) << PhaseNames[phase] << std::right
+                  << std::setw(16) << sum[COLD]
+                  << std::setw(16) << coldMax
+                  << std::setw(16) << sum[WARM]
+                  << std::defaultfloat << std::setprecision(6) << std::endl;
     }
 
-    void resume()
+    // List the slowest transforms.
+
+    std::vector<size_t> order;
+    for (size_t idx = 0; idx < transforms.size(); ++idx)
     {
-        if(m_started)
+        if (!failed[idx])
         {
-            throw OCIO::Exception("Measure already started.");
+            order.push_back(idx);
         }
-
-        m_started = true;
-        m_start = std::chrono::high_resolution_clock::now();
     }
 
-    void pause()
+    std::stable_sort(order.begin(), order.end(),
+                     [&medians](size_t lhs, size_t rhs)
+                     {
+                         return medians[COLD][PHASE_TOTAL][lhs] > medians[COLD][PHASE_TOTAL][rhs];
+                     });
+
+    order.resize(std::min(order.size(), size_t(numSlowest)));
+
+    std::cout << std::endl << "Slowest color transformations (cold median in ms):" << std::endl
+              << std::endl << "    ";
+    for (int phase = NUM_PHASES - 1; phase >= 0; --phase)
     {
-        std::chrono::high_resolution_clock::time_point end
-           = std::chrono::high_resolution_clock::now();
+        std::cout << std::setw(10) << PhaseNames[phase];
+    }
+    std::cout << "   transformation" << std::endl;
 
-        if(m_started)
+    for (const size_t idx : order)
+    {
+        std::cout << std::fixed << std::setprecision(3) << "    ";
+        for (int phase = NUM_PHASES - 1; phase >= 0; --phase)
         {
-            std::chrono::duration<float, std::milli> duration = end - m_start;
+            std::cout << std::setw(10) << medians[COLD][phase][idx];
+        }
+        std::cout << std::defaultfloat << std::setprecision(6)
+                  << "   " << transforms[idx].m_name << std::endl;
+    }
 
-            m_durations.push_back(duration);
-            m_duration += duration;
+    // Report the total durations of each transform.
+    for (size_t idx = 0; idx < transforms.size(); ++idx)
+    {
+        if (failed[idx])
+        {
+            continue;
         }
-        else
+
+        for (int temp = 0; temp < NUM_TEMPERATURES; ++temp)
         {
-            throw OCIO::Exception("Measure already stopped.");
+            Report::Result result;
+            result.m_name = "Create the processor (" + std::string(temp == COLD ? "cold" : "warm")
+                          + ") " + transforms[idx].m_name;
+            result.m_stats = ComputeStatistics(durations[temp][PHASE_TOTAL][idx], rejectOutliers);
+            Report::Instance().m_results.push_back(result);
         }
+    }
+}
 
-        m_started = false;
+// Split a CSV line where the fields could be quoted.
+StringUtils::StringVec SplitCsvLine(const std::string & line)
+{
+    StringUtils::StringVec fields(1);
+    bool quoted = false;
+    for (size_t idx = 0; idx < line.size(); ++idx)
+    {
+        const char c = line[idx];
+        if (quoted)
+        {
+            if (c == '"' && idx + 1 < line.size() && line[idx + 1] == '"')
+            {
+                fields.back() += c;
+                ++idx;
+            }
+            else if (c == '"')
+            {
+                quoted = false;
+            }
+            else
+            {
+                fields.back() += c;
+            }
+        }
+        else if (c == '"')
+        {
+            quoted = true;
+        }
+        else if (c == ',')
+        {
+            fields.emplace_back();
+        }
+        else if (c != '\r')
+        {
+            fields.back() += c;
+        }
     }
+    return fields;
+}
 
-private:
-    const std::string m_explanations;
-    const unsigned m_iterations { 1 };
+// Find the value following the "key": in a line of the JSON report.
+bool FindJsonValue(const std::string & line, const std::string & key, std::string & value)
+{
+    const std::string search = "\"" + key + "\": ";
+    size_t pos = line.find(search);
+    if (pos == std::string::npos)
+    {
+        return false;
+    }
+    pos += search.size();
 
-    bool m_started { false };
-    std::chrono::high_resolution_clock::time_point m_start;
+    value.clear();
+    if (pos < line.size() && line[pos] == '"')
+    {
+        for (++pos; pos < line.size() && line[pos] != '"'; ++pos)
+        {
+            if (line[pos] == '\\' && pos + 1 < line.size())
+            {
+                ++pos;
+                value += line[pos] == 't' ? '\t' : line[pos] == 'n' ? '\n' : line[pos];
+            }
+            else
+            {
+                value += line[pos];
+            }
+        }
+    }
+    else
+    {
+        const size_t end = line.find_first_of(",}", pos);
+        value = StringUtils::Trim(line.substr(pos, end == std::string::npos ? end : end - pos));
+    }
 
-    std::chrono::duration<float, std::milli> m_duration { 0 };
-    std::vector<std::chrono::duration<float, std::milli>> m_durations;
-};
+    return true;
+}
 
-// Process the complete image line by line.
-void ProcessLines(CustomMeasure & m,
-                  OCIO::ConstCPUProcessorRcPtr & cpuProcessor,
-                  const OCIO::PackedImageDesc & img)
+// Read the median durations (in ms) of the results of a JSON or CSV report.
+std::vector<std::pair<std::string, double>> ReadReport(const std::string & filename)
 {
-    // Always process the same complete image.
-    char * lineToProcess = reinterpret_cast<char *>(img.getData());
+    std::ifstream in(filename);
+    if (!in)
+    {
+        std::string err("Could not open the file: ");
+        err += filename;
+        throw OCIO::Exception(err.c_str());
+    }
 
-    m.resume();
+    std::vector<std::pair<std::string, double>> medians;
 
-    for(int h=0; h<img.getHeight(); ++h)
+    std::string line;
+    if (StringUtils::EndsWith(StringUtils::Lower(filename), ".csv"))
     {
-        OCIO::PackedImageDesc imageDesc((void*)lineToProcess,
-                                        img.getWidth(),
-                                        1, // Only one line.
-                                        img.getNumChannels(),
-                                        img.getBitDepth(),
-                                        OCIO::AutoStride,
-                                        OCIO::AutoStride,
-                                        OCIO::AutoStride);
+        std::getline(in, line);
+        const StringUtils::StringVec header = SplitCsvLine(line);
+        const auto nameIt   = std::find(header.begin(), header.end(), "name");
+        const auto medianIt = std::find(header.begin(), header.end(), "median_ms");
+        if (nameIt == header.end() || medianIt == header.end())
+        {
+            std::string err("Invalid CSV report: ");
+            err += filename;
+            throw OCIO::Exception(err.c_str());
+        }
 
-        // Apply the color transformation (in place).
-        cpuProcessor->apply(imageDesc);
+        const size_t nameIdx   = size_t(nameIt - header.begin());
+        const size_t medianIdx = size_t(medianIt - header.begin());
 
-        // Find the next line.
-        lineToProcess += img.getYStrideBytes();
+        while (std::getline(in, line))
+        {
+            const StringUtils::StringVec fields = SplitCsvLine(line);
+            if (fields.size() > std::max(nameIdx, medianIdx))
+            {
+                medians.emplace_back(fields[nameIdx], std::atof(fields[medianIdx].c_str()));
+            }
+        }
+    }
+    else
+    {
+        while (std::getline(in, line))
+        {
+            std::string name, median;
+            if (FindJsonValue(line, "name", name) && FindJsonValue(line, "median_ms", median))
+            {
+                medians.emplace_back(name, std::atof(median.c_str()));
+            }
+        }
     }
 
-    m.pause();
+    if (medians.empty())
+    {
+        std::string err("No results found in: ");
+        err += filename;
+        throw OCIO::Exception(err.c_str());
+    }
+
+    return medians;
 }
 
-// Process the complete image pixel per pixel.
-void ProcessPixels(CustomMeasure & m,
-                   OCIO::ConstCPUProcessorRcPtr & cpuProcessor,
-                   const OCIO::PackedImageDesc & img)
+// Compare the median durations of two reports and flag the slowdowns beyond the threshold
+// (in percent). Returns the number of failures i.e. the slowdowns and, unless allowed, the
+// reference results missing from the new report (e.g. a benchmark which now fails to run).
+unsigned CompareReports(const std::string & refFilename,
+                        const std::string & filename,
+                        double threshold,
+                        bool allowMissing)
 {
-    // Always process the same complete image.
-    char * lineToProcess = reinterpret_cast<char *>(img.getData());
+    const auto refMedians = ReadReport(refFilename);
+    const auto medians    = ReadReport(filename);
 
-    m.resume();
+    std::cout << "Comparing '" << filename << "' to '" << refFilename << "' (threshold "
+              << threshold << " %):" << std::endl << std::endl;
 
-    for(int h=0; h<img.getHeight(); ++h)
+    size_t nameWidth = 4;
+    for (const auto & ref : refMedians)
     {
-        char * pixelToProcess = lineToProcess;
-        for(int w=0; w<img.getWidth(); ++w)
+        nameWidth = std::max(nameWidth, ref.first.size());
+    }
+
+    std::cout << "  " << std::left << std::setw(int(nameWidth)) << "name" << std::right
+              << "   ref (ms)   new (ms)     change" << std::endl;
+
+    unsigned numSlowdowns = 0;
+    unsigned numMissing   = 0;
+    for (const auto & ref : refMedians)
+    {
+        std::cout << "  " << std::left << std::setw(int(nameWidth)) << ref.first << std::right;
+
+        const auto it = std::find_if(medians.begin(), medians.end(),
+                                     [&ref](const std::pair<std::string, double> & res)
+                                     {
+                                         return res.first == ref.first;
+                                     });
+        if (it == medians.end())
         {
-            cpuProcessor->applyRGBA(reinterpret_cast<float*>(pixelToProcess));
+            std::cout << "  missing" << std::endl;
+            ++numMissing;
+            continue;
+        }
 
-            // Find the next pixel.
-            pixelToProcess += img.getXStrideBytes();
+        const double change = ref.second > 0.0 ? (it->second / ref.second - 1.0) * 100.0 : 0.0;
+
+        std::cout << std::fixed << std::setprecision(4)
+                  << " " << std::setw(10) << ref.second
+                  << " " << std::setw(10) << it->second
+                  << " " << std::setw(8) << std::setprecision(1) << std::showpos << change
+                  << std::noshowpos << " %" << std::defaultfloat << std::setprecision(6);
+
+        if (change > threshold)
+        {
+            std::cout << "  SLOWER";
+            ++numSlowdowns;
         }
+        std::cout << std::endl;
+    }
 
-        // Find the next line.
-        lineToProcess += img.getYStrideBytes();
+    std::cout << std::endl << numSlowdowns << " slowdown(s) beyond the threshold." << std::endl;
+    if (numMissing > 0)
+    {
+        std::cout << numMissing << " missing result(s)"
+                  << (allowMissing ? " (allowed)." : ".") << std::endl;
     }
 
-    m.pause();
+    return numSlowdowns + (allowMissing ? 0 : numMissing);
 }
 
 int main(int argc, const char **argv)
@@ -174,10 +1351,23 @@ int main(int argc, const char **argv)
     bool verbose = false;
     signed int testType = -1;
     std::string transformFile;
+    std::string builtinConfigName;
+    std::string configFile;
     std::string inColorSpace, outColorSpace, display, view;
     std::string inBitDepthStr("f32"), outBitDepthStr("f32");
     unsigned iterations = 50;
     bool nocache = false, nooptim = false;
+    int maxThreads = 0;
+    std::string sizesStr("1920x1080,3840x2160");
+    std::string layoutsStr("rgba,rgb,bgra,planar");
+    std::string bitDepthPairsStr;
+    int warmup = 0;
+    bool rejectOutliers = false;
+    std::string jsonFile, csvFile;
+    std::string compareRefFile, compareFile;
+    float threshold = 5.0f;
+    bool allowMissing = false;
+    int numSlowest = 10;
 
     bool useColorspaces = false;
     bool useDisplayview = false;
@@ -195,9 +1385,15 @@ int main(int argc, const char **argv)
                "--test %d",                 &testType,          
                                             "Define the type of processing to measure: "\
                                             "0 means on the complete image (the default), 1 is line-by-line, "\
-                                            "2 is pixel-per-pixel and -1 performs all the test types",
+                                            "2 is pixel-per-pixel and -1 performs all these test types. "\
+                                            "3 is the thread scaling and image layout matrix. "\
+                                            "4 is the processor creation latency of all the color "\
+                                            "transformations of the config",
                "--transform %s",            &transformFile, 
                                             "Provide the transform file to apply on the image",
+               "--builtinconfig %s",        &builtinConfigName,
+                                            "Measure the creation of a built-in config (e.g. default) "\
+                                            "and use it instead of $OCIO for the color space options",
                "--colorspaces %s %s",       &inColorSpace, &outColorSpace,
                                             "Provide the input and output color spaces to apply on the image",
                "--view %s %s %s",           &inColorSpace, &display, &view,
@@ -213,6 +1409,48 @@ int main(int argc, const char **argv)
                                             "Bypass all caches. Default is false",
                "--nooptim",                 &nooptim, 
                                             "Disable the processor optimizations. Default is false",
+               "<SEPARATOR>",               "Thread scaling and image layout matrix (i.e. --test 3) options:",
+               "--threads %d",              &maxThreads,
+                                            "Maximum number of threads i.e. 1, 2, 4... up to this number. "\
+                                            "Default is 0 i.e. all the hardware threads",
+               "--sizes %s",                &sizesStr,
+                                            "Comma separated list of image sizes. Default is 1920x1080,3840x2160",
+               "--layouts %s",              &layoutsStr,
+                                            "Comma separated list of image layouts among rgba, rgb, bgra "\
+                                            "and planar. Default is all of them",
+               "--bitdepthpairs %s",        &bitDepthPairsStr,
+                                            "Comma separated list of input:output bit-depths among ui8, ui10, "\
+                                            "ui12, ui16, f16 and f32 (i.e. ui8:f32,f32:f32). Default is the "\
+                                            "--bitdepths pair",
+               "<SEPARATOR>",               "Processor creation latency (i.e. --test 4) options:",
+               "--config %s",               &configFile,
+                                            "The config file or URI (e.g. ocio://studio-config-latest) "\
+                                            "to use instead of $OCIO. Default is --builtinconfig or $OCIO",
+               "--slowest %d",              &numSlowest,
+                                            "Number of the slowest color transformations to list. "\
+                                            "Default is 10",
+               "<SEPARATOR>",               "Statistics and report options:",
+               "--warmup %d",               &warmup,
+                                            "Number of iterations to run before the measured ones "\
+                                            "i.e. excluded from the statistics. Default is 0",
+               "--rejectoutliers",          &rejectOutliers,
+                                            "Exclude the outliers (i.e. Tukey's fences) from the statistics. "\
+                                            "Default is false",
+               "--json %s",                 &jsonFile,
+                                            "Save the statistics, the CPU information and the CPU "\
+                                            "renderers in a JSON file",
+               "--csv %s",                  &csvFile,
+                                            "Save the statistics, the CPU information and the CPU "\
+                                            "renderers in a CSV file",
+               "--compare %s %s",           &compareRefFile, &compareFile,
+                                            "Compare the median times of a JSON or CSV file to the ones of "\
+                                            "a reference file and exit i.e. no processing. Exits with an "\
+                                            "error if a result is slower than the threshold or missing",
+               "--threshold %f",            &threshold,
+                                            "The slowdown threshold of --compare in percent. Default is 5",
+               "--allowmissing",            &allowMissing,
+                                            "Do not fail --compare when results of the reference file "\
+                                            "are missing from the other file",
                NULL);
 
     if (ap.parse (argc, argv) < 0)
@@ -228,10 +1466,61 @@ int main(int argc, const char **argv)
         return 0;
     }
 
+    if (maxThreads < 0)
+    {
+        std::cerr << "ERROR: The number of threads must be positive." << std::endl;
+        return 1;
+    }
+
+    if (warmup < 0)
+    {
+        std::cerr << "ERROR: The number of warm-up iterations must be positive." << std::endl;
+        return 1;
+    }
+
+    if (!compareFile.empty())
+    {
+        try
+        {
+            return CompareReports(compareRefFile, compareFile, threshold, allowMissing) > 0 ? 1 : 0;
+        }
+        catch (std::exception & ex)
+        {
+            std::cerr << "ERROR: " << ex.what() << std::endl;
+            return 1;
+        }
+    }
+
+    Report & report = Report::Instance();
+    report.m_warmup = unsigned(warmup);
+    report.m_rejectOutliers = rejectOutliers;
+    report.m_iterations = iterations;
+    for (int idx = 0; idx < argc; ++idx)
+    {
+        report.m_commandLine += (idx ? " " : "") + std::string(argv[idx]);
+    }
+
+    // Save the reports once all the measures are done.
+    auto saveReports = [&report, &jsonFile, &csvFile]()
+    {
+        if (!jsonFile.empty())
+        {
+            report.saveJson(jsonFile);
+        }
+        if (!csvFile.empty())
+        {
+            report.saveCsv(csvFile);
+        }
+    };
+
+    // Each measure loops over the warm-up and the measured iterations.
+    const unsigned numRuns = report.m_warmup + iterations;
+
     if (verbose)
     {
         std::cout << std::endl;
         std::cout << "OCIO Version: " << OCIO::GetVersion() << std::endl;
+        std::cout << "CPU:          " << OCIO::GetCPUInfo() << std::endl;
         const char * env = OCIO::GetEnvVariable("OCIO");
         if(env && *env)
         {
@@ -265,6 +1554,66 @@ int main(int argc, const char **argv)
     // Process the image.
     try
     {
+        OCIO::ConstConfigRcPtr builtinConfig;
+        if (!builtinConfigName.empty())
+        {
+            {
+                // Note that the first iteration includes the config parsing.
+                CustomMeasure m("Create the built-in config:\t\t", iterations);
+                for (unsigned iter = 0; iter < numRuns; ++iter)
+                {
+                    if (nocache)
+                    {
+                        OCIO::ClearAllCaches();
+                    }
+
+                    m.resume();
+                    builtinConfig = OCIO::Config::CreateFromBuiltinConfig(builtinConfigName.c_str());
+                    m.pause();
+                }
+            }
+
+            if (testType != 4 && transformFile.empty() && inColorSpace.empty()
+                && (display.empty() || view.empty()))
+            {
+                // Only measure the built-in config creation.
+                std::cout << std::endl << std::endl;
+                saveReports();
+                return 0;
+            }
+        }
+
+        if (testType == 4)
+        {
+            if (numSlowest < 0)
+            {
+                throw OCIO::Exception("The number of slowest color transformations must be positive.");
+            }
+
+            OCIO::ConstConfigRcPtr config = builtinConfig;
+            if (!configFile.empty())
+            {
+                CustomMeasure m("Load the config:\t\t\t");
+                config = OCIO::Config::CreateFromFile(configFile.c_str());
+            }
+            else if (!config)
+            {
+                CustomMeasure m("Load the config:\t\t\t");
+                config = OCIO::Config::CreateFromEnv();
+            }
+
+            std::cout << std::endl << std::endl;
+
+            ProcessConfigLatency(config,
+                                 nooptim ? OCIO::OPTIMIZATION_NONE : OCIO::OPTIMIZATION_DEFAULT,
+                                 iterations,
+                                 unsigned(numSlowest));
+
+            std::cout << std::endl << std::endl;
+            saveReports();
+            return 0;
+        }
+
         // Load the current config.
 
         OCIO::ConstProcessorRcPtr processor;
@@ -280,7 +1629,7 @@ int main(int argc, const char **argv)
 
             {
                 CustomMeasure m("Create the processor:\t\t\t", iterations);
-                for (unsigned iter = 0; iter < iterations; ++iter)
+                for (unsigned iter = 0; iter < numRuns; ++iter)
                 {
                     if (nocache)
                     {
@@ -296,7 +1645,7 @@ int main(int argc, const char **argv)
         // Checking for an input colorspace or input (display, view) pair.
         else if (!inColorSpace.empty() || (!display.empty() && !view.empty()))
         {
-            if (verbose)
+            if (verbose && !builtinConfig)
             {
                 const char * env = OCIO::GetEnvVariable("OCIO");
                 if (env && *env)
@@ -314,13 +1663,14 @@ int main(int argc, const char **argv)
                 }
             }
 
-            OCIO::ConfigRcPtr config  = OCIO::Config::CreateFromEnv()->createEditableCopy();
+            OCIO::ConfigRcPtr config = builtinConfig ? builtinConfig->createEditableCopy()
+                                                     : OCIO::Config::CreateFromEnv()->createEditableCopy();
             config->setProcessorCacheFlags(nocache ? OCIO::PROCESSOR_CACHE_OFF 
                                                    : OCIO::PROCESSOR_CACHE_DEFAULT);
 
             {
                 CustomMeasure m("Create the config identifier:\t\t", iterations);
-                for (unsigned iter = 0; iter < iterations; ++iter)
+                for (unsigned iter = 0; iter < numRuns; ++iter)
                 {
                     m.resume();
                     config->getCacheID();
@@ -330,7 +1680,7 @@ int main(int argc, const char **argv)
 
             {
                 CustomMeasure m("Create the context identifier:\t\t", iterations);
-                for (unsigned iter = 0; iter < iterations; ++iter)
+                for (unsigned iter = 0; iter < numRuns; ++iter)
                 {
                     m.resume();
                     config->getCurrentContext()->getCacheID();
@@ -370,7 +1720,7 @@ int main(int argc, const char **argv)
                 }
 
                 CustomMeasure m(msg.c_str(), iterations);
-                for (unsigned iter = 0; iter < iterations; ++iter)
+                for (unsigned iter = 0; iter < numRuns; ++iter)
                 {
                     if (nocache)
                     {
@@ -424,30 +1774,19 @@ int main(int argc, const char **argv)
         const OCIO::OptimizationFlags optimFlags
             = nooptim ? OCIO::OPTIMIZATION_NONE : OCIO::OPTIMIZATION_DEFAULT;
 
-        auto GetBitDepthFromString = [](const std::string & str) -> OCIO::BitDepth 
+        const OCIO::BitDepth inBitDepth  = GetBitDepthFromString(inBitDepthStr);
+        const OCIO::BitDepth outBitDepth = GetBitDepthFromString(outBitDepthStr);
+
+        // The other test types only support f32 & ui16 images.
+        for (const OCIO::BitDepth bitDepth : { inBitDepth, outBitDepth })
         {
-            OCIO::BitDepth bd = OCIO::BIT_DEPTH_F32;
-    
-            if (str == "f32")
-            {
-                bd = OCIO::BIT_DEPTH_F32;
-            }
-            else if (str == "ui16")
-            {
-                bd = OCIO::BIT_DEPTH_UINT16;
-            }
-            else
+            if (testType != 3 && bitDepth != OCIO::BIT_DEPTH_F32 && bitDepth != OCIO::BIT_DEPTH_UINT16)
             {
                 std::string err("Unsupported bit-depth: ");
-                err += str;
+                err += OCIO::BitDepthToString(bitDepth);
                 throw OCIO::Exception(err.c_str());
             }
-
-            return bd;
-        };
-
-        const OCIO::BitDepth inBitDepth  = GetBitDepthFromString(inBitDepthStr);
-        const OCIO::BitDepth outBitDepth = GetBitDepthFromString(outBitDepthStr);
+        }
 
         // Get the optimized processor.
         OCIO::ConstProcessorRcPtr optProcessor;
@@ -455,7 +1794,7 @@ int main(int argc, const char **argv)
         {
             CustomMeasure m("Create the optimized processor:\t\t", iterations);
 
-            for(unsigned iter=0; iter<iterations; ++iter)
+            for(unsigned iter=0; iter<numRuns; ++iter)
             {
                 m.resume();
                 optProcessor = processor->getOptimizedProcessor(inBitDepth,
@@ -471,7 +1810,7 @@ int main(int argc, const char **argv)
         {
             CustomMeasure m("Create the GPU processor:\t\t", iterations);
 
-            for(unsigned iter=0; iter<iterations; ++iter)
+            for(unsigned iter=0; iter<numRuns; ++iter)
             {
                 m.resume();
                 gpuProcessor = optProcessor->getOptimizedGPUProcessor(optimFlags);
@@ -485,7 +1824,7 @@ int main(int argc, const char **argv)
         {
             CustomMeasure m("Create the GPU shader:\t\t\t", iterations);
 
-            for(unsigned iter=0; iter<iterations; ++iter)
+            for(unsigned iter=0; iter<numRuns; ++iter)
             {
                 shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
                 shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_2);
@@ -502,7 +1841,7 @@ int main(int argc, const char **argv)
         {
             CustomMeasure m("Create the CPU processor:\t\t", iterations);
 
-            for(unsigned iter=0; iter<iterations; ++iter)
+            for(unsigned iter=0; iter<numRuns; ++iter)
             {
                 m.resume();
                 cpuProcessor = optProcessor->getOptimizedCPUProcessor(inBitDepth,
@@ -512,9 +1851,78 @@ int main(int argc, const char **argv)
             }
         }
 
+        for (unsigned idx = 0; idx < cpuProcessor->getNumRenderers(); ++idx)
+        {
+            report.m_renderers.push_back(cpuProcessor->getRendererName(idx));
+        }
+
+        if (verbose)
+        {
+            std::cout << std::endl << "CPU renderers:" << std::endl;
+            for (const auto & renderer : report.m_renderers)
+            {
+                std::cout << "\t" << renderer << std::endl;
+            }
+        }
+
         std::cout << std::endl << std::endl;
         std::cout << "Image processing statistics:" << std::endl << std::endl;
 
+        if (testType == 3)
+        {
+            MatrixOptions options;
+            options.m_maxThreads = OCIO::GetNumThreads(unsigned(maxThreads));
+
+            for (const auto & sizeStr : StringUtils::Split(sizesStr, ','))
+            {
+                const StringUtils::StringVec dims = StringUtils::Split(StringUtils::Trim(sizeStr), 'x');
+                const long width  = dims.size() == 2 ? std::atol(dims[0].c_str()) : 0;
+                const long height = dims.size() == 2 ? std::atol(dims[1].c_str()) : 0;
+                if (width <= 0 || height <= 0)
+                {
+                    std::string err("Invalid image size: ");
+                    err += sizeStr;
+                    throw OCIO::Exception(err.c_str());
+                }
+                options.m_sizes.emplace_back(width, height);
+            }
+
+            for (const auto & layoutStr : StringUtils::Split(layoutsStr, ','))
+            {
+                options.m_layouts.push_back(StringUtils::Lower(StringUtils::Trim(layoutStr)));
+                // Validate the layout before starting.
+                GetLayoutFromString(options.m_layouts.back());
+            }
+
+            if (bitDepthPairsStr.empty())
+            {
+                options.m_bitDepths.emplace_back(inBitDepthStr, outBitDepthStr);
+            }
+            else
+            {
+                for (const auto & pairStr : StringUtils::Split(bitDepthPairsStr, ','))
+                {
+                    const StringUtils::StringVec pair = StringUtils::Split(StringUtils::Trim(pairStr), ':');
+                    if (pair.size() != 2)
+                    {
+                        std::string err("Invalid bit-depth pair: ");
+                        err += pairStr;
+                        throw OCIO::Exception(err.c_str());
+                    }
+                    // Validate the bit-depths before starting.
+                    GetBitDepthFromString(pair[0]);
+                    GetBitDepthFromString(pair[1]);
+                    options.m_bitDepths.emplace_back(pair[0], pair[1]);
+                }
+            }
+
+            ProcessScalingMatrix(optProcessor, optimFlags, options, iterations);
+
+            std::cout << std::endl << std::endl;
+            saveReports();
+            return 0;
+        }
+
         // Create an arbitrary 4K RGBA image.
 
         static constexpr size_t width  = 3840;
@@ -585,8 +1993,9 @@ int main(int argc, const char **argv)
             if (inBitDepth == outBitDepth)
             {
                 CustomMeasure m("Process the complete image (in place):\t\t\t\t", iterations);
+                m.setNumPixels(width * height);
 
-                for(unsigned iter=0; iter<iterations; ++iter)
+                for(unsigned iter=0; iter<numRuns; ++iter)
                 {
                     std::vector<float>    inImg_f32  = img_f32_ref;
                     std::vector<uint16_t> inImg_ui16 = img_ui16_ref;
@@ -646,8 +2055,9 @@ int main(int argc, const char **argv)
                                                                   optimFlags);
 
                 CustomMeasure m("Process the complete image (two buffers):\t\t\t", iterations);
+                m.setNumPixels(width * height);
 
-                for(unsigned iter=0; iter<iterations; ++iter)
+                for(unsigned iter=0; iter<numRuns; ++iter)
                 {
                     // Apply the color transformation.
                     m.resume();
@@ -675,8 +2085,9 @@ int main(int argc, const char **argv)
                                             OCIO::AutoStride);
 
             CustomMeasure m("Process the complete image (in place) but line by line:\t\t", iterations);
+            m.setNumPixels(width * height);
 
-            for(unsigned iter=0; iter<iterations; ++iter)
+            for(unsigned iter=0; iter<numRuns; ++iter)
             {
                 ProcessLines(m, cpuProcessor, inImgDesc);
             }
@@ -694,8 +2105,9 @@ int main(int argc, const char **argv)
                                             numChannels);
 
             CustomMeasure m("Process the complete image (in place) but pixel per pixel:\t", iterations);
+            m.setNumPixels(width * height);
 
-            for(unsigned iter=0; iter<iterations; ++iter)
+            for(unsigned iter=0; iter<numRuns; ++iter)
             {
                 ProcessPixels(m, cpuProcessor, inImgDesc);
             }
@@ -703,6 +2115,7 @@ int main(int argc, const char **argv)
 
         std::cout << std::endl << std::endl;
 
+        saveReports();
     }
     catch (OCIO::Exception & ex)
     {
@@ -43,6 +43,10 @@ void bindPyCPUProcessor(py::module & m)
              DOC(CPUProcessor, hasDynamicProperty))
         .def("isDynamic", &CPUProcessor::isDynamic,
              DOC(CPUProcessor, isDynamic))
+        .def("getNumRenderers", &CPUProcessor::getNumRenderers,
+             DOC(CPUProcessor, getNumRenderers))
+        .def("getRendererName", &CPUProcessor::getRendererName, "index"_a,
+             DOC(CPUProcessor, getRendererName))
 
         .def("apply", [](CPUProcessorRcPtr & self, PyImageDesc & imgDesc) 
             {
@@ -90,6 +94,44 @@ written to the dstImgDesc image, leaving srcImgDesc unchanged.
     pointer. The dedicated packed ``apply*`` methods utilize 
     ``ImageDesc`` on the C++ side so avoid the copy.
 
+)doc")
+        .def("apply", [](CPUProcessorRcPtr & self,
+                         PyImageDesc & imgDesc,
+                         const DynamicPropertyOverridesRcPtr & values)
+            {
+                self->apply((*imgDesc.m_img), *values);
+            },
+             "imgDesc"_a, "values"_a,
+             py::call_guard<py::gil_scoped_release>(),
+             R"doc(
+Apply to an image using the dynamic property values from the
+DynamicPropertyOverrides in place of the values of the dynamic
+properties of the processor. Image values are modified in place.
+
+.. note::
+    The GIL is released during processing, freeing up Python to execute
+    other threads concurrently.
+
+)doc")
+        .def("apply", [](CPUProcessorRcPtr & self,
+                         PyImageDesc & srcImgDesc,
+                         PyImageDesc & dstImgDesc,
+                         const DynamicPropertyOverridesRcPtr & values)
+            {
+                self->apply((*srcImgDesc.m_img), (*dstImgDesc.m_img), *values);
+            },
+             "srcImgDesc"_a, "dstImgDesc"_a, "values"_a,
+             py::call_guard<py::gil_scoped_release>(),
+             R"doc(
+Apply to an image using the dynamic property values from the
+DynamicPropertyOverrides in place of the values of the dynamic
+properties of the processor. Modified srcImgDesc image values are
+written to the dstImgDesc image, leaving srcImgDesc unchanged.
+
+.. note::
+    The GIL is released during processing, freeing up Python to execute
+    other threads concurrently.
+
 )doc")
         .def("applyRGB", [](CPUProcessorRcPtr & self, py::buffer & data) 
             {
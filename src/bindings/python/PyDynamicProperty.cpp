@@ -31,6 +31,36 @@ void bindPyDynamicProperty(py::module & m)
              DOC(DynamicPropertyValue, AsGradingTone))
         .def("setGradingTone", &PyDynamicProperty::setGradingTone, "val"_a, 
              DOC(DynamicPropertyValue, AsGradingTone));
+
+    auto clsDynamicPropertyOverrides = 
+        py::class_<DynamicPropertyOverrides, DynamicPropertyOverridesRcPtr /* holder */>(
+            m.attr("DynamicPropertyOverrides"))
+
+        .def(py::init(&DynamicPropertyOverrides::Create),
+             DOC(DynamicPropertyOverrides, Create))
+
+        .def("hasValue", &DynamicPropertyOverrides::hasValue, "type"_a,
+             DOC(DynamicPropertyOverrides, hasValue))
+        .def("removeValue", &DynamicPropertyOverrides::removeValue, "type"_a,
+             DOC(DynamicPropertyOverrides, removeValue))
+        .def("clear", &DynamicPropertyOverrides::clear,
+             DOC(DynamicPropertyOverrides, clear))
+        .def("getDouble", &DynamicPropertyOverrides::getDouble, "type"_a,
+             DOC(DynamicPropertyOverrides, getDouble))
+        .def("setDouble", &DynamicPropertyOverrides::setDouble, "type"_a, "val"_a,
+             DOC(DynamicPropertyOverrides, setDouble))
+        .def("getGradingPrimary", &DynamicPropertyOverrides::getGradingPrimary,
+             DOC(DynamicPropertyOverrides, getGradingPrimary))
+        .def("setGradingPrimary", &DynamicPropertyOverrides::setGradingPrimary, "val"_a,
+             DOC(DynamicPropertyOverrides, setGradingPrimary))
+        .def("getGradingRGBCurve", &DynamicPropertyOverrides::getGradingRGBCurve,
+             DOC(DynamicPropertyOverrides, getGradingRGBCurve))
+        .def("setGradingRGBCurve", &DynamicPropertyOverrides::setGradingRGBCurve, "val"_a,
+             DOC(DynamicPropertyOverrides, setGradingRGBCurve))
+        .def("getGradingTone", &DynamicPropertyOverrides::getGradingTone,
+             DOC(DynamicPropertyOverrides, getGradingTone))
+        .def("setGradingTone", &DynamicPropertyOverrides::setGradingTone, "val"_a,
+             DOC(DynamicPropertyOverrides, setGradingTone));
 }
 
 } // namespace OCIO_NAMESPACE
@@ -35,6 +35,16 @@ void bindPyGpuShaderCreator(py::module & m)
             clsGpuShaderCreator, "TextureDimensions",
             DOC(GpuShaderCreator, TextureDimensions));
 
+    auto enumTextureFormat =
+        py::enum_<GpuShaderCreator::TextureFormat>(
+            clsGpuShaderCreator, "TextureFormat",
+            DOC(GpuShaderCreator, TextureFormat));
+
+    auto enumComputeBufferFormat =
+        py::enum_<GpuShaderCreator::ComputeBufferFormat>(
+            clsGpuShaderCreator, "ComputeBufferFormat",
+            DOC(GpuShaderCreator, ComputeBufferFormat));
+
     auto clsDynamicPropertyIterator = 
         py::class_<DynamicPropertyIterator>(
             clsGpuShaderCreator, "DynamicPropertyIterator");
@@ -76,6 +86,36 @@ void bindPyGpuShaderCreator(py::module & m)
             DOC(GpuShaderCreator, setAllowTexture1D))
         .def("getAllowTexture1D", &GpuShaderCreator::getAllowTexture1D,
              DOC(GpuShaderCreator, getAllowTexture1D))
+        .def("setTextureFormat", &GpuShaderCreator::setTextureFormat, "format"_a,
+             DOC(GpuShaderCreator, setTextureFormat))
+        .def("getTextureFormat", &GpuShaderCreator::getTextureFormat,
+             DOC(GpuShaderCreator, getTextureFormat))
+        .def("setUseUniformBlock", &GpuShaderCreator::setUseUniformBlock, "use"_a,
+             DOC(GpuShaderCreator, setUseUniformBlock))
+        .def("getUseUniformBlock", &GpuShaderCreator::getUseUniformBlock,
+             DOC(GpuShaderCreator, getUseUniformBlock))
+        .def("setComputeKernel", &GpuShaderCreator::setComputeKernel, "enabled"_a,
+             DOC(GpuShaderCreator, setComputeKernel))
+        .def("getComputeKernel", &GpuShaderCreator::getComputeKernel,
+             DOC(GpuShaderCreator, getComputeKernel))
+        .def("setComputeBufferFormats", &GpuShaderCreator::setComputeBufferFormats,
+             "inFormat"_a, "outFormat"_a,
+             DOC(GpuShaderCreator, setComputeBufferFormats))
+        .def("getComputeInputFormat", &GpuShaderCreator::getComputeInputFormat,
+             DOC(GpuShaderCreator, getComputeInputFormat))
+        .def("getComputeOutputFormat", &GpuShaderCreator::getComputeOutputFormat,
+             DOC(GpuShaderCreator, getComputeOutputFormat))
+        .def("setComputeWorkgroupSize", &GpuShaderCreator::setComputeWorkgroupSize,
+             "width"_a, "height"_a,
+             DOC(GpuShaderCreator, setComputeWorkgroupSize))
+        .def("getComputeWorkgroupWidth", &GpuShaderCreator::getComputeWorkgroupWidth,
+             DOC(GpuShaderCreator, getComputeWorkgroupWidth))
+        .def("getComputeWorkgroupHeight", &GpuShaderCreator::getComputeWorkgroupHeight,
+             DOC(GpuShaderCreator, getComputeWorkgroupHeight))
+        .def("setCompactShaderText", &GpuShaderCreator::setCompactShaderText, "compact"_a,
+             DOC(GpuShaderCreator, setCompactShaderText))
+        .def("getCompactShaderText", &GpuShaderCreator::getCompactShaderText,
+             DOC(GpuShaderCreator, getCompactShaderText))
         .def("getNextResourceIndex", &GpuShaderCreator::getNextResourceIndex,
             DOC(GpuShaderCreator, getNextResourceIndex))
 
@@ -125,6 +165,19 @@ void bindPyGpuShaderCreator(py::module & m)
         .value("TEXTURE_2D", GpuShaderCreator::TEXTURE_2D)
         .export_values();
 
+    enumTextureFormat
+        .value("TEXTURE_FORMAT_FLOAT32", GpuShaderCreator::TEXTURE_FORMAT_FLOAT32)
+        .value("TEXTURE_FORMAT_HALF", GpuShaderCreator::TEXTURE_FORMAT_HALF)
+        .value("TEXTURE_FORMAT_UNORM16", GpuShaderCreator::TEXTURE_FORMAT_UNORM16)
+        .export_values();
+
+    enumComputeBufferFormat
+        .value("COMPUTE_BUFFER_RGBA_FLOAT32", GpuShaderCreator::COMPUTE_BUFFER_RGBA_FLOAT32)
+        .value("COMPUTE_BUFFER_RGBA_HALF", GpuShaderCreator::COMPUTE_BUFFER_RGBA_HALF)
+        .value("COMPUTE_BUFFER_RGBA_UINT8", GpuShaderCreator::COMPUTE_BUFFER_RGBA_UINT8)
+        .value("COMPUTE_BUFFER_RGBA_UINT16", GpuShaderCreator::COMPUTE_BUFFER_RGBA_UINT16)
+        .export_values();
+
     clsDynamicPropertyIterator
         .def("__len__", [](DynamicPropertyIterator & it) 
             { 
@@ -107,6 +107,23 @@ void bindPyGpuShaderDesc(py::module & m)
             {
                 return UniformIterator(self);
             })
+        .def("getUniformBlockSize", &GpuShaderDesc::getUniformBlockSize,
+             DOC(GpuShaderDesc, getUniformBlockSize))
+        .def("getUniformBlockName", &GpuShaderDesc::getUniformBlockName,
+             DOC(GpuShaderDesc, getUniformBlockName))
+        .def("getUniformBlockOffset", &GpuShaderDesc::getUniformBlockOffset, "index"_a,
+             DOC(GpuShaderDesc, getUniformBlockOffset))
+        .def("getUniformBlock", [](GpuShaderDescRcPtr & self)
+            {
+                std::string buffer(self->getUniformBlockSize(), '\0');
+                self->fillUniformBlock(&buffer[0]);
+                return py::bytes(buffer);
+            },
+             DOC(GpuShaderDesc, fillUniformBlock))
+        .def("updateChangedUniforms", &GpuShaderDesc::updateChangedUniforms,
+             DOC(GpuShaderDesc, updateChangedUniforms))
+        .def("getChangedUniform", &GpuShaderDesc::getChangedUniform, "index"_a,
+             DOC(GpuShaderDesc, getChangedUniform))
 
         // 1D lut related methods
         .def("addTexture", [](GpuShaderDescRcPtr & self,
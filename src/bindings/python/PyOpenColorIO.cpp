@@ -44,6 +44,12 @@ PYBIND11_MODULE(PyOpenColorIO, m)
           DOC(PyOpenColorIO, GetVersion));
     m.def("GetVersionHex", &GetVersionHex,
           DOC(PyOpenColorIO, GetVersionHex));
+    m.def("GetCPUInfo", &GetCPUInfo,
+          DOC(PyOpenColorIO, GetCPUInfo));
+    m.def("SetMaxThreads", &SetMaxThreads, "maxThreads"_a,
+          DOC(PyOpenColorIO, SetMaxThreads));
+    m.def("GetMaxThreads", &GetMaxThreads,
+          DOC(PyOpenColorIO, GetMaxThreads));
     m.def("GetLoggingLevel", &GetLoggingLevel,
           DOC(PyOpenColorIO, GetLoggingLevel));
     m.def("SetLoggingLevel", &SetLoggingLevel, "level"_a,
@@ -107,6 +107,10 @@ void bindPyTypes(py::module & m)
         m, "DynamicProperty", 
         DOC(DynamicProperty));
 
+    py::class_<DynamicPropertyOverrides, DynamicPropertyOverridesRcPtr /* holder */>(
+        m, "DynamicPropertyOverrides", 
+        DOC(DynamicPropertyOverrides));
+
     py::class_<FormatMetadata>(
         m, "FormatMetadata", 
         DOC(FormatMetadata));
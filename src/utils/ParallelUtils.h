@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#ifndef INCLUDED_OCIO_PARALLELUTILS_H
+#define INCLUDED_OCIO_PARALLELUTILS_H
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace OCIO_NAMESPACE
+{
+
+// Get the number of threads to use where 0 means all the hardware threads.
+inline unsigned GetNumThreads(unsigned requestedThreads)
+{
+    if (requestedThreads == 0)
+    {
+        requestedThreads = std::thread::hardware_concurrency();
+    }
+    return std::max(1u, requestedThreads);
+}
+
+// Call func(index) for all the indices from 0 to numItems - 1 using up to numThreads threads
+// (0 means all the hardware threads). The items are processed in any order so the caller must
+// store the results by index to have a deterministic output. The first exception thrown by
+// func is rethrown once all the threads are done. When a thread cannot be created, the threads
+// already started and the calling thread process all the items.
+template<typename Func>
+void ParallelFor(size_t numItems, unsigned numThreads, Func func)
+{
+    const size_t numWorkers = std::min(static_cast<size_t>(GetNumThreads(numThreads)), numItems);
+
+    if (numWorkers <= 1)
+    {
+        for (size_t idx = 0; idx < numItems; ++idx)
+        {
+            func(idx);
+        }
+        return;
+    }
+
+    std::atomic<size_t> nextItem{ 0 };
+    std::exception_ptr error;
+    std::mutex errorMutex;
+
+    auto worker = [&]()
+    {
+        for (size_t idx = nextItem++; idx < numItems; idx = nextItem++)
+        {
+            try
+            {
+                func(idx);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error)
+                {
+                    error = std::current_exception();
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numWorkers - 1);
+    for (size_t idx = 1; idx < numWorkers; ++idx)
+    {
+        try
+        {
+            threads.emplace_back(worker);
+        }
+        catch (...)
+        {
+            // i.e. std::system_error when the system cannot create more threads.
+            break;
+        }
+    }
+
+    // The calling thread also processes items.
+    worker();
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace OCIO_NAMESPACE
+
+
+#endif // INCLUDED_OCIO_PARALLELUTILS_H
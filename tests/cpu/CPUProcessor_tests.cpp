@@ -2,6 +2,9 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 
+#include <thread>
+#include <vector>
+
 #include "CPUProcessor.cpp"
 
 #include "ops/lut1d/Lut1DOp.h"
@@ -34,6 +37,293 @@ OCIO_ADD_TEST(CPUProcessor, dynamic_properties)
                           "Cannot find dynamic property; not used by CPU processor.");
 }
 
+OCIO_ADD_TEST(CPUProcessor, dynamic_property_overrides)
+{
+    OCIO::ExposureContrastTransformRcPtr ec = OCIO::ExposureContrastTransform::Create();
+    ec->makeExposureDynamic();
+
+    OCIO::GradingPrimaryTransformRcPtr prim = OCIO::GradingPrimaryTransform::Create(OCIO::GRADING_LOG);
+    prim->makeDynamic();
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->appendTransform(ec);
+    group->appendTransform(prim);
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    OCIO::ConstCPUProcessorRcPtr cpuProc;
+    OCIO_CHECK_NO_THROW(cpuProc = config->getProcessor(group)->getDefaultCPUProcessor());
+
+    OCIO::DynamicPropertyRcPtr dp;
+    OCIO_CHECK_NO_THROW(dp = cpuProc->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_EXPOSURE));
+    OCIO::DynamicPropertyDoubleRcPtr exposure = OCIO::DynamicPropertyValue::AsDouble(dp);
+    OCIO_CHECK_NO_THROW(dp = cpuProc->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_GRADING_PRIMARY));
+    OCIO::DynamicPropertyGradingPrimaryRcPtr primary = OCIO::DynamicPropertyValue::AsGradingPrimary(dp);
+
+    const std::vector<float> inImg{ 0.1f, 0.2f, 0.3f, 1.0f,
+                                    0.5f, 0.4f, 0.9f, 0.5f };
+
+    auto apply = [&](const OCIO::DynamicPropertyOverrides * values)
+    {
+        std::vector<float> img = inImg;
+        OCIO::PackedImageDesc desc(img.data(), 2, 1, 4);
+        if (values)
+        {
+            cpuProc->apply(desc, *values);
+        }
+        else
+        {
+            cpuProc->apply(desc);
+        }
+        return img;
+    };
+
+    const std::vector<float> defaultImg = apply(nullptr);
+
+    OCIO::GradingPrimary gp(OCIO::GRADING_LOG);
+    gp.m_saturation = 1.3;
+    gp.m_contrast   = OCIO::GradingRGBM(1.1, 0.9, 1.0, 1.2);
+
+    OCIO::DynamicPropertyOverridesRcPtr values = OCIO::DynamicPropertyOverrides::Create();
+
+    // Without values, the processor values are used.
+    OCIO_CHECK_ASSERT(apply(values.get()) == defaultImg);
+
+    OCIO_CHECK_NO_THROW(values->setDouble(OCIO::DYNAMIC_PROPERTY_EXPOSURE, 0.5));
+    OCIO_CHECK_NO_THROW(values->setGradingPrimary(gp));
+    // The processor does not have a dynamic gamma, so it is ignored.
+    OCIO_CHECK_NO_THROW(values->setDouble(OCIO::DYNAMIC_PROPERTY_GAMMA, 2.0));
+
+    const std::vector<float> overriddenImg = apply(values.get());
+    OCIO_CHECK_ASSERT(overriddenImg != defaultImg);
+
+    // The dynamic properties of the processor are not changed.
+    OCIO_CHECK_EQUAL(exposure->getValue(), 0.);
+    OCIO_CHECK_EQUAL(primary->getValue(), OCIO::GradingPrimary(OCIO::GRADING_LOG));
+    OCIO_CHECK_ASSERT(apply(nullptr) == defaultImg);
+
+    // Same result as changing the dynamic properties of the processor.
+    exposure->setValue(0.5);
+    primary->setValue(gp);
+    OCIO_CHECK_ASSERT(apply(nullptr) == overriddenImg);
+
+    // The properties which are not overridden use the values of the processor.
+    values->removeValue(OCIO::DYNAMIC_PROPERTY_GRADING_PRIMARY);
+    OCIO_CHECK_ASSERT(apply(values.get()) == overriddenImg);
+
+    exposure->setValue(0.);
+    primary->setValue(OCIO::GradingPrimary(OCIO::GRADING_LOG));
+    std::vector<float> srcImg = inImg;
+    std::vector<float> dstImg(inImg.size(), 0.f);
+    OCIO::PackedImageDesc srcDesc(srcImg.data(), 2, 1, 4);
+    OCIO::PackedImageDesc dstDesc(dstImg.data(), 2, 1, 4);
+    values->setGradingPrimary(gp);
+    OCIO_CHECK_NO_THROW(cpuProc->apply(srcDesc, dstDesc, *values));
+    OCIO_CHECK_ASSERT(dstImg == overriddenImg);
+    OCIO_CHECK_ASSERT(srcImg == inImg);
+
+    // The values are validated when applied.
+    gp.m_gamma = OCIO::GradingRGBM(0., 1., 1., 1.);
+    values->setGradingPrimary(gp);
+    OCIO_CHECK_THROW_WHAT(apply(values.get()), OCIO::Exception, "GradingPrimary gamma");
+
+    // Errors.
+    values->clear();
+    OCIO_CHECK_ASSERT(!values->hasValue(OCIO::DYNAMIC_PROPERTY_EXPOSURE));
+    OCIO_CHECK_THROW_WHAT(values->getDouble(OCIO::DYNAMIC_PROPERTY_EXPOSURE),
+                          OCIO::Exception,
+                          "Dynamic property override value is not set.");
+    OCIO_CHECK_THROW_WHAT(values->setDouble(OCIO::DYNAMIC_PROPERTY_GRADING_TONE, 1.),
+                          OCIO::Exception,
+                          "Dynamic property override value is not a double.");
+    OCIO_CHECK_THROW_WHAT(values->setGradingRGBCurve(OCIO::ConstGradingRGBCurveRcPtr()),
+                          OCIO::Exception,
+                          "null grading RGB curve");
+}
+
+namespace
+{
+// A processor with all the types of dynamic properties handled by the overrides.
+OCIO::ConstCPUProcessorRcPtr CreateAllDynamicCPUProcessor()
+{
+    OCIO::ExposureContrastTransformRcPtr ec = OCIO::ExposureContrastTransform::Create();
+    ec->setPivot(0.18);
+    ec->makeExposureDynamic();
+    ec->makeContrastDynamic();
+
+    OCIO::GradingPrimaryTransformRcPtr prim = OCIO::GradingPrimaryTransform::Create(OCIO::GRADING_LOG);
+    prim->makeDynamic();
+
+    OCIO::GradingToneTransformRcPtr tone = OCIO::GradingToneTransform::Create(OCIO::GRADING_LOG);
+    tone->makeDynamic();
+
+    OCIO::GradingRGBCurveTransformRcPtr curve = OCIO::GradingRGBCurveTransform::Create(OCIO::GRADING_LOG);
+    curve->makeDynamic();
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->appendTransform(ec);
+    group->appendTransform(prim);
+    group->appendTransform(tone);
+    group->appendTransform(curve);
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    return config->getProcessor(group)->getDefaultCPUProcessor();
+}
+
+// Values of all the dynamic properties, different for each index.
+OCIO::DynamicPropertyOverridesRcPtr CreateOverrides(int index)
+{
+    OCIO::DynamicPropertyOverridesRcPtr values = OCIO::DynamicPropertyOverrides::Create();
+    values->setDouble(OCIO::DYNAMIC_PROPERTY_EXPOSURE, 0.25 * index);
+    values->setDouble(OCIO::DYNAMIC_PROPERTY_CONTRAST, 1.0 + 0.1 * index);
+
+    OCIO::GradingPrimary gp(OCIO::GRADING_LOG);
+    gp.m_saturation = 1.0 + 0.05 * index;
+    values->setGradingPrimary(gp);
+
+    OCIO::GradingTone gt(OCIO::GRADING_LOG);
+    gt.m_midtones.m_master = 1.0 + 0.05 * index;
+    gt.m_scontrast = 1.0 + 0.02 * index;
+    values->setGradingTone(gt);
+
+    const float y = 0.1f * float(index);
+    auto master = OCIO::GradingBSplineCurve::Create(
+        { { -5.f, -5.f }, { 0.f, y }, { 5.f, 5.f } });
+    auto identity = OCIO::GradingBSplineCurve::Create({ { 0.f, 0.f }, { 1.f, 1.f } });
+    values->setGradingRGBCurve(OCIO::GradingRGBCurve::Create(identity, identity, identity, master));
+
+    return values;
+}
+
+std::vector<float> ApplyOverrides(const OCIO::ConstCPUProcessorRcPtr & cpuProc,
+                                  const std::vector<float> & inImg,
+                                  const OCIO::DynamicPropertyOverrides & values)
+{
+    std::vector<float> img = inImg;
+    OCIO::PackedImageDesc desc(img.data(), long(img.size() / 4), 1, 4);
+    cpuProc->apply(desc, values);
+    return img;
+}
+} // anon.
+
+OCIO_ADD_TEST(CPUProcessor, dynamic_property_overrides_tone_curve)
+{
+    // The overrides of the contrast, grading tone & grading RGB curve give the same results as
+    // changing the dynamic properties of the processor.
+
+    OCIO::ConstCPUProcessorRcPtr cpuProc;
+    OCIO_CHECK_NO_THROW(cpuProc = CreateAllDynamicCPUProcessor());
+
+    const std::vector<float> inImg{ 0.1f, 0.2f, 0.3f, 1.0f,
+                                    0.5f, 0.4f, 0.9f, 0.5f,
+                                    0.02f, 0.8f, 0.6f, 1.0f };
+
+    OCIO::DynamicPropertyOverridesRcPtr defaults = OCIO::DynamicPropertyOverrides::Create();
+    const std::vector<float> defaultImg = ApplyOverrides(cpuProc, inImg, *defaults);
+
+    OCIO::DynamicPropertyOverridesRcPtr values = CreateOverrides(3);
+    // Only override the contrast, the grading tone & the grading RGB curve.
+    values->removeValue(OCIO::DYNAMIC_PROPERTY_EXPOSURE);
+    values->removeValue(OCIO::DYNAMIC_PROPERTY_GRADING_PRIMARY);
+
+    const std::vector<float> overriddenImg = ApplyOverrides(cpuProc, inImg, *values);
+    OCIO_CHECK_ASSERT(overriddenImg != defaultImg);
+
+    // Each override changes the result.
+    for (const auto type : { OCIO::DYNAMIC_PROPERTY_CONTRAST,
+                             OCIO::DYNAMIC_PROPERTY_GRADING_TONE,
+                             OCIO::DYNAMIC_PROPERTY_GRADING_RGBCURVE })
+    {
+        OCIO::DynamicPropertyOverridesRcPtr partial = values->createEditableCopy();
+        partial->removeValue(type);
+        OCIO_CHECK_ASSERT(ApplyOverrides(cpuProc, inImg, *partial) != overriddenImg);
+    }
+
+    OCIO::DynamicPropertyRcPtr dp;
+    OCIO_CHECK_NO_THROW(dp = cpuProc->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_CONTRAST));
+    OCIO::DynamicPropertyDoubleRcPtr contrast = OCIO::DynamicPropertyValue::AsDouble(dp);
+    OCIO_CHECK_NO_THROW(dp = cpuProc->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_GRADING_TONE));
+    OCIO::DynamicPropertyGradingToneRcPtr tone = OCIO::DynamicPropertyValue::AsGradingTone(dp);
+    OCIO_CHECK_NO_THROW(dp = cpuProc->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_GRADING_RGBCURVE));
+    OCIO::DynamicPropertyGradingRGBCurveRcPtr curve = OCIO::DynamicPropertyValue::AsGradingRGBCurve(dp);
+
+    // The dynamic properties of the processor are not changed.
+    OCIO_CHECK_EQUAL(contrast->getValue(), 1.);
+    OCIO_CHECK_EQUAL(tone->getValue(), OCIO::GradingTone(OCIO::GRADING_LOG));
+    OCIO_CHECK_ASSERT(*curve->getValue() == *OCIO::GradingRGBCurve::Create(OCIO::GRADING_LOG));
+    OCIO_CHECK_ASSERT(ApplyOverrides(cpuProc, inImg, *defaults) == defaultImg);
+
+    // Same result as changing the dynamic properties of the processor.
+    contrast->setValue(values->getDouble(OCIO::DYNAMIC_PROPERTY_CONTRAST));
+    tone->setValue(values->getGradingTone());
+    curve->setValue(values->getGradingRGBCurve());
+    OCIO_CHECK_ASSERT(ApplyOverrides(cpuProc, inImg, *defaults) == overriddenImg);
+
+    // The values are validated when applied.
+    OCIO::GradingTone gt = values->getGradingTone();
+    gt.m_scontrast = 0.;
+    values->setGradingTone(gt);
+    OCIO_CHECK_THROW_WHAT(ApplyOverrides(cpuProc, inImg, *values), OCIO::Exception,
+                          "GradingTone s-contrast");
+}
+
+OCIO_ADD_TEST(CPUProcessor, dynamic_property_overrides_concurrent)
+{
+    // Threads sharing the same processor with different values get the same results as the
+    // serial calls.
+
+    OCIO::ConstCPUProcessorRcPtr cpuProc;
+    OCIO_CHECK_NO_THROW(cpuProc = CreateAllDynamicCPUProcessor());
+
+    std::vector<float> inImg(4 * 64);
+    for (size_t idx = 0; idx < inImg.size(); ++idx)
+    {
+        inImg[idx] = float(idx % 37) / 36.0f;
+    }
+
+    constexpr int numThreads = 8;
+    constexpr int numIterations = 50;
+
+    std::vector<OCIO::DynamicPropertyOverridesRcPtr> values;
+    std::vector<std::vector<float>> serialImgs;
+    for (int idx = 0; idx < numThreads; ++idx)
+    {
+        values.push_back(CreateOverrides(idx));
+        serialImgs.push_back(ApplyOverrides(cpuProc, inImg, *values.back()));
+    }
+
+    // The values are all different.
+    for (int idx = 1; idx < numThreads; ++idx)
+    {
+        OCIO_CHECK_ASSERT(serialImgs[idx] != serialImgs[idx - 1]);
+    }
+
+    std::vector<long> numErrors(numThreads, 0);
+    std::vector<std::thread> threads;
+    for (int idx = 0; idx < numThreads; ++idx)
+    {
+        threads.emplace_back([&, idx]()
+        {
+            for (int iter = 0; iter < numIterations; ++iter)
+            {
+                if (ApplyOverrides(cpuProc, inImg, *values[idx]) != serialImgs[idx])
+                {
+                    ++numErrors[idx];
+                }
+            }
+        });
+    }
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    for (int idx = 0; idx < numThreads; ++idx)
+    {
+        OCIO_CHECK_EQUAL(numErrors[idx], 0);
+    }
+}
+
 OCIO_ADD_TEST(CPUProcessor, flag_composition)
 {
     // The test validates the build of a custom optimization flag.
@@ -50,6 +340,82 @@ OCIO_ADD_TEST(CPUProcessor, flag_composition)
                      OCIO::OPTIMIZATION_COMP_LUT1D);
 }
 
+OCIO_ADD_TEST(CPUProcessor, renderer_names)
+{
+    // The test validates the names of the CPU renderers selected for the processing.
+
+    OCIO::MatrixTransformRcPtr scale = OCIO::MatrixTransform::Create();
+    const double m44[16] = { 2., 0., 0., 0.,
+                             0., 2., 0., 0.,
+                             0., 0., 2., 0.,
+                             0., 0., 0., 1. };
+    scale->setMatrix(m44);
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    OCIO::ConstProcessorRcPtr proc = config->getProcessor(scale);
+
+    // The first op also converts from the input bit-depth.
+
+    OCIO::ConstCPUProcessorRcPtr cpuProc = proc->getDefaultCPUProcessor();
+    OCIO_REQUIRE_EQUAL(cpuProc->getNumRenderers(), 2);
+    OCIO_CHECK_EQUAL(std::string(cpuProc->getRendererName(0)), "ScaleRenderer");
+    OCIO_CHECK_ASSERT(StringUtils::StartsWith(cpuProc->getRendererName(1),
+                                                    "BitDepthCast<"));
+
+    OCIO_CHECK_THROW_WHAT(cpuProc->getRendererName(2),
+                          OCIO::Exception,
+                          "CPU renderer access error: index = 2 where size = 2");
+
+    // The bit-depth conversions need their own renderers.
+
+    cpuProc = proc->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8,
+                                             OCIO::BIT_DEPTH_UINT16,
+                                             OCIO::OPTIMIZATION_DEFAULT);
+    OCIO_REQUIRE_EQUAL(cpuProc->getNumRenderers(), 3);
+    OCIO_CHECK_ASSERT(StringUtils::StartsWith(cpuProc->getRendererName(0),
+                                                    "BitDepthCast<"));
+    OCIO_CHECK_EQUAL(std::string(cpuProc->getRendererName(1)), "ScaleRenderer");
+    OCIO_CHECK_ASSERT(StringUtils::StartsWith(cpuProc->getRendererName(2),
+                                                    "BitDepthCast<"));
+
+    // The library namespace is not part of the names.
+
+    for (unsigned idx = 0; idx < cpuProc->getNumRenderers(); ++idx)
+    {
+        const std::string name(cpuProc->getRendererName(idx));
+        OCIO_CHECK_EQUAL(name.find("::"), std::string::npos);
+    }
+}
+
+OCIO_ADD_TEST(CPUProcessor, remove_type_keywords)
+{
+    // The MSVC type names include the keywords, in the template arguments too.
+
+    std::string name = "class OpenColorIO_v2_4::BitDepthCast<enum OpenColorIO_v2_4::BitDepth 1,"
+                       "enum OpenColorIO_v2_4::BitDepth 7>";
+    OCIO::RemoveTypeKeywords(name);
+    OCIO_CHECK_EQUAL(name, "OpenColorIO_v2_4::BitDepthCast<OpenColorIO_v2_4::BitDepth 1,"
+                           "OpenColorIO_v2_4::BitDepth 7>");
+
+    name = "struct `anonymous namespace'::Renderer<class OpenColorIO_v2_4::Foo>";
+    OCIO::RemoveTypeKeywords(name);
+    OCIO_CHECK_EQUAL(name, "`anonymous namespace'::Renderer<OpenColorIO_v2_4::Foo>");
+
+    // Only the whole words are removed.
+    name = "Subclass Myenum ";
+    OCIO::RemoveTypeKeywords(name);
+    OCIO_CHECK_EQUAL(name, "Subclass Myenum ");
+}
+
+OCIO_ADD_TEST(CPUProcessor, cpu_info)
+{
+    const std::string info(OCIO::GetCPUInfo());
+    OCIO_CHECK_ASSERT(!info.empty());
+    OCIO_CHECK_ASSERT(StringUtils::EndsWith(info, ")"));
+    // The description is computed once.
+    OCIO_CHECK_EQUAL(OCIO::GetCPUInfo(), OCIO::GetCPUInfo());
+}
+
 
 // TODO: CPUProcessor being part of the OCIO public API limits the ability
 //       to inspect the CPUProcessor instance content i.e. the list of CPUOps.
@@ -314,3 +314,86 @@ OCIO_ADD_TEST(ColorSpaceSet, operations_on_set)
 
     OCIO_CHECK_EQUAL(css4->getNumColorSpaces(), 0);
 }
+
+OCIO_ADD_TEST(ColorSpaceSet, index_with_aliases)
+{
+    // Validate that the name & alias lookups stay in sync with the color space list when
+    // color spaces are added, replaced and removed.
+
+    OCIO::ColorSpaceSetRcPtr css = OCIO::ColorSpaceSet::Create();
+
+    OCIO::ColorSpaceRcPtr cs1 = OCIO::ColorSpace::Create();
+    cs1->setName("cs1");
+    cs1->addAlias("alias1");
+    OCIO::ColorSpaceRcPtr cs2 = OCIO::ColorSpace::Create();
+    cs2->setName("cs2");
+    cs2->addAlias("alias2");
+    OCIO::ColorSpaceRcPtr cs3 = OCIO::ColorSpace::Create();
+    cs3->setName("cs3");
+
+    OCIO_CHECK_NO_THROW(css->addColorSpace(cs1));
+    OCIO_CHECK_NO_THROW(css->addColorSpace(cs2));
+    OCIO_CHECK_NO_THROW(css->addColorSpace(cs3));
+
+    OCIO_CHECK_EQUAL(css->getColorSpaceIndex("CS2"), 1);
+    OCIO_CHECK_EQUAL(css->getColorSpaceIndex("Alias2"), 1);
+    OCIO_CHECK_EQUAL(css->getColorSpaceIndex("cs3"), 2);
+    OCIO_CHECK_EQUAL(css->getColorSpaceIndex("unknown"), -1);
+    OCIO_CHECK_EQUAL(css->getColorSpaceIndex(""), -1);
+    OCIO_CHECK_EQUAL(css->getColorSpaceIndex(nullptr), -1);
+
+    // An alias can't be used as a name, nor as an alias of another color space.
+
+    OCIO::ColorSpaceRcPtr csAlias = OCIO::ColorSpace::Create();
+    csAlias->setName("alias1");
+    OCIO_CHECK_THROW_WHAT(css->addColorSpace(csAlias), OCIO::Exception,
+                          "Cannot add 'alias1' color space, existing color space, 'cs1' is "
+                          "using this name as an alias.");
+    csAlias->setName("cs4");
+    csAlias->addAlias("ALIAS2");
+    OCIO_CHECK_THROW_WHAT(css->addColorSpace(csAlias), OCIO::Exception,
+                          "Cannot add 'cs4' color space, it has 'ALIAS2' alias and existing "
+                          "color space, 'cs2' is using the same alias.");
+
+    // Replacing a color space drops its previous aliases.
+
+    OCIO::ColorSpaceRcPtr cs2Bis = OCIO::ColorSpace::Create();
+    cs2Bis->setName("cs2");
+    cs2Bis->addAlias("alias2bis");
+    OCIO_CHECK_NO_THROW(css->addColorSpace(cs2Bis));
+    OCIO_CHECK_EQUAL(css->getNumColorSpaces(), 3);
+    OCIO_CHECK_EQUAL(css->getColorSpaceIndex("cs2"), 1);
+    OCIO_CHECK_EQUAL(css->getColorSpaceIndex("alias2bis"), 1);
+    OCIO_CHECK_EQUAL(css->getColorSpaceIndex("alias2"), -1);
+
+    // Removing by alias does nothing, removing by name shifts the following color spaces.
+
+    OCIO_CHECK_NO_THROW(css->removeColorSpace("alias1"));
+    OCIO_CHECK_EQUAL(css->getNumColorSpaces(), 3);
+    OCIO_CHECK_NO_THROW(css->removeColorSpace("CS1"));
+    OCIO_REQUIRE_EQUAL(css->getNumColorSpaces(), 2);
+    OCIO_CHECK_EQUAL(css->getColorSpaceIndex("cs1"), -1);
+    OCIO_CHECK_EQUAL(css->getColorSpaceIndex("alias1"), -1);
+    OCIO_CHECK_EQUAL(css->getColorSpaceIndex("cs2"), 0);
+    OCIO_CHECK_EQUAL(css->getColorSpaceIndex("alias2bis"), 0);
+    OCIO_CHECK_EQUAL(css->getColorSpaceIndex("cs3"), 1);
+    OCIO_CHECK_EQUAL(std::string(css->getColorSpace("alias2bis")->getName()), "cs2");
+
+    // The copy has its own index.
+
+    OCIO::ColorSpaceSetRcPtr cssCopy = css->createEditableCopy();
+    OCIO_CHECK_NO_THROW(css->clearColorSpaces());
+    OCIO_CHECK_EQUAL(css->getColorSpaceIndex("cs3"), -1);
+    OCIO_CHECK_EQUAL(cssCopy->getColorSpaceIndex("cs3"), 1);
+    OCIO_CHECK_EQUAL(cssCopy->getColorSpaceIndex("alias2bis"), 0);
+    OCIO_CHECK_ASSERT(*cssCopy != *css);
+
+    // Alias re-use is possible once the owning color space is removed.
+
+    OCIO_CHECK_NO_THROW(cssCopy->removeColorSpace("cs2"));
+    OCIO::ColorSpaceRcPtr cs5 = OCIO::ColorSpace::Create();
+    cs5->setName("cs5");
+    cs5->addAlias("alias2bis");
+    OCIO_CHECK_NO_THROW(cssCopy->addColorSpace(cs5));
+    OCIO_CHECK_EQUAL(cssCopy->getColorSpaceIndex("alias2bis"), 1);
+}
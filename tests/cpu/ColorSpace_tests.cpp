@@ -1687,4 +1687,43 @@ colorspaces:
             "The heuristics currently only support scene-referred color spaces. Please set the interchange roles."
         );
     }
+
+    //
+    // Test that the results of the heuristics are reused.
+    //
+
+    editableCfg->setInactiveColorSpaces("ACES2065-1");
+    {
+        const char * csname = OCIO::Config::IdentifyBuiltinColorSpace(editableCfg, builtinConfig, "Linear P3-D65");
+        OCIO_CHECK_EQUAL(std::string(csname), std::string("scene-linear P3-D65"));
+
+        // A cached processor is not flushed when the result of the heuristics is already known.
+        OCIO::ConstProcessorRcPtr proc = editableCfg->getProcessor("texture sRGB", "scene-linear P3-D65");
+        csname = OCIO::Config::IdentifyBuiltinColorSpace(editableCfg, builtinConfig, "Linear P3-D65");
+        OCIO_CHECK_EQUAL(std::string(csname), std::string("scene-linear P3-D65"));
+        OCIO_CHECK_EQUAL(proc.get(), editableCfg->getProcessor("texture sRGB", "scene-linear P3-D65").get());
+
+        // Failures are also reused.
+        for (int i = 0; i < 2; ++i)
+        {
+            OCIO_CHECK_THROW_WHAT(
+                OCIO::Config::IdentifyBuiltinColorSpace(editableCfg, builtinConfig, "ACES2065-1"),
+                OCIO::Exception,
+                "Heuristics were not able to find an equivalent to the requested color space: ACES2065-1."
+            );
+        }
+
+        // Editing the config leads to a new search.
+        editableCfg->setInactiveColorSpaces("ACES2065-1, scene-linear P3-D65");
+        OCIO_CHECK_THROW_WHAT(
+            OCIO::Config::IdentifyBuiltinColorSpace(editableCfg, builtinConfig, "Linear P3-D65"),
+            OCIO::Exception,
+            "Heuristics were not able to find an equivalent to the requested color space: Linear P3-D65."
+        );
+
+        editableCfg->setInactiveColorSpaces("ACES2065-1");
+        OCIO::ClearAllCaches();
+        csname = OCIO::Config::IdentifyBuiltinColorSpace(editableCfg, builtinConfig, "Linear P3-D65");
+        OCIO_CHECK_EQUAL(std::string(csname), std::string("scene-linear P3-D65"));
+    }
 }
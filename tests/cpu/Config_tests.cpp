@@ -7440,6 +7440,131 @@ OCIO_ADD_TEST(Config, config_context_cacheids)
     }
 }
 
+OCIO_ADD_TEST(Config, cache_id_structural)
+{
+    // The config cache id is built from the structural hashes of the config elements so it
+    // only depends on the config content.
+
+    OCIO::ConfigRcPtr cfg = OCIO::Config::CreateRaw()->createEditableCopy();
+
+    auto cs = OCIO::ColorSpace::Create();
+    cs->setName("cs1");
+    auto mat = OCIO::MatrixTransform::Create();
+    const double offset[4] = { 0.1, 0.2, 0.3, 0. };
+    mat->setOffset(offset);
+    cs->setTransform(mat, OCIO::COLORSPACE_DIR_FROM_REFERENCE);
+    cfg->addColorSpace(cs);
+
+    auto look = OCIO::Look::Create();
+    look->setName("look1");
+    look->setProcessSpace("cs1");
+    look->setTransform(OCIO::ExponentTransform::Create());
+    cfg->addLook(look);
+
+    const std::string cacheID = cfg->getCacheID();
+
+    // A copy has the same cache id.
+    OCIO::ConfigRcPtr copy = cfg->createEditableCopy();
+    OCIO_CHECK_EQUAL(cacheID, std::string(copy->getCacheID()));
+
+    // Only the added color space changes.
+    const double offset2[4] = { 0.1, 0.2, 0.4, 0. };
+    mat->setOffset(offset2);
+    cs->setTransform(mat, OCIO::COLORSPACE_DIR_FROM_REFERENCE);
+    cfg->addColorSpace(cs);
+    const std::string cacheID2 = cfg->getCacheID();
+    OCIO_CHECK_NE(cacheID, cacheID2);
+
+    // Restoring the color space restores the cache id.
+    mat->setOffset(offset);
+    cs->setTransform(mat, OCIO::COLORSPACE_DIR_FROM_REFERENCE);
+    cfg->addColorSpace(cs);
+    OCIO_CHECK_EQUAL(cacheID, std::string(cfg->getCacheID()));
+
+    // Any element property is part of the cache id.
+    cs->setDescription("some description");
+    cfg->addColorSpace(cs);
+    OCIO_CHECK_NE(cacheID, std::string(cfg->getCacheID()));
+    cs->setDescription("");
+    cfg->addColorSpace(cs);
+    OCIO_CHECK_EQUAL(cacheID, std::string(cfg->getCacheID()));
+
+    look->setProcessSpace("raw");
+    cfg->addLook(look);
+    OCIO_CHECK_NE(cacheID, std::string(cfg->getCacheID()));
+    look->setProcessSpace("cs1");
+    cfg->addLook(look);
+    OCIO_CHECK_EQUAL(cacheID, std::string(cfg->getCacheID()));
+
+    // As well as the other config properties.
+    cfg->setRole("role1", "cs1");
+    OCIO_CHECK_NE(cacheID, std::string(cfg->getCacheID()));
+    cfg->setRole("role1", nullptr);
+    OCIO_CHECK_EQUAL(cacheID, std::string(cfg->getCacheID()));
+
+    cfg->addDisplayView("disp1", "view1", "cs1", "");
+    OCIO_CHECK_NE(cacheID, std::string(cfg->getCacheID()));
+    cfg->removeDisplayView("disp1", "view1");
+    OCIO_CHECK_EQUAL(cacheID, std::string(cfg->getCacheID()));
+
+    // The element order is part of the cache id.
+    auto cs2 = cs->createEditableCopy();
+    cs2->setName("cs2");
+    cfg->addColorSpace(cs2);
+    const std::string cacheID3 = cfg->getCacheID();
+    cfg->removeColorSpace("cs1");
+    cfg->addColorSpace(cs);
+    OCIO_CHECK_NE(cacheID3, std::string(cfg->getCacheID()));
+}
+
+OCIO_ADD_TEST(Config, editable_copy_sharing)
+{
+    // The config copies share the unchanged elements.
+
+    OCIO::ConfigRcPtr cfg = OCIO::Config::CreateRaw()->createEditableCopy();
+
+    auto cs = OCIO::ColorSpace::Create();
+    cs->setName("cs1");
+    cs->setTransform(OCIO::MatrixTransform::Create(), OCIO::COLORSPACE_DIR_FROM_REFERENCE);
+    cfg->addColorSpace(cs);
+
+    auto look = OCIO::Look::Create();
+    look->setName("look1");
+    look->setProcessSpace("cs1");
+    cfg->addLook(look);
+
+    OCIO::ConstProcessorRcPtr proc;
+    OCIO_CHECK_NO_THROW(proc = cfg->getProcessor("raw", "cs1"));
+
+    OCIO::ConfigRcPtr copy = cfg->createEditableCopy();
+    OCIO_CHECK_EQUAL(copy->getColorSpace("cs1").get(), cfg->getColorSpace("cs1").get());
+    OCIO_CHECK_EQUAL(copy->getLook("look1").get(), cfg->getLook("look1").get());
+
+    // The processors are still valid for the copy.
+    OCIO_CHECK_EQUAL(copy->getProcessor("raw", "cs1").get(), proc.get());
+
+    // Only the modified elements are duplicated.
+
+    cs->setName("cs2");
+    copy->addColorSpace(cs);
+    OCIO_CHECK_EQUAL(copy->getNumColorSpaces(), 3);
+    OCIO_CHECK_EQUAL(cfg->getNumColorSpaces(), 2);
+    OCIO_CHECK_ASSERT(!cfg->getColorSpace("cs2"));
+    OCIO_CHECK_EQUAL(copy->getColorSpace("cs1").get(), cfg->getColorSpace("cs1").get());
+
+    look->setProcessSpace("cs2");
+    copy->addLook(look);
+    OCIO_CHECK_EQUAL(std::string(cfg->getLook("look1")->getProcessSpace()), "cs1");
+    OCIO_CHECK_EQUAL(std::string(copy->getLook("look1")->getProcessSpace()), "cs2");
+
+    copy->removeColorSpace("cs1");
+    OCIO_CHECK_ASSERT(!copy->getColorSpace("cs1"));
+    OCIO_REQUIRE_ASSERT(cfg->getColorSpace("cs1"));
+
+    // The source config is still usable.
+    OCIO_CHECK_EQUAL(cfg->getProcessor("raw", "cs1").get(), proc.get());
+}
+
 OCIO_ADD_TEST(Config, processor_cache_with_context_variables)
 {
     // Validation of the processor cache of the Config class with context variables.
@@ -7509,15 +7634,19 @@ colorspaces:
         OCIO_CHECK_EQUAL(config->getProcessor("ref", "cs2").get(),
                          config->getProcessor("ref", "cs3").get());
 
-        // Making a copy also flushes the internal processor cache.
+        // A copy starts with the processors of the source config.
         OCIO::ConfigRcPtr cfg = config->createEditableCopy();
 
-        // Check that caches are different between Config instances.
-        OCIO_CHECK_NE(config->getProcessor("ref", "cs1").get(),
-                      cfg->getProcessor("ref", "cs1").get());
+        OCIO_CHECK_EQUAL(config->getProcessor("ref", "cs1").get(),
+                         cfg->getProcessor("ref", "cs1").get());
 
+        // But any change flushes the internal processor cache of the copy.
         OCIO_CHECK_NO_THROW(cfg->addEnvironmentVar("VAR", "ref"));
 
+        // Check that caches are now different between Config instances.
+        OCIO_CHECK_NE(config->getProcessor("ref", "cs1").get(),
+                      cfg->getProcessor("ref", "cs1").get());
+
         // Keys are different but processors are identical
         // i.e. unchanged because it does not need $VAR.
         OCIO_CHECK_EQUAL(cfg->getProcessor("ref", "cs1").get(),
@@ -137,3 +137,92 @@ OCIO_ADD_TEST(ContextVariableUtils, env_expand)
     }
 }
 
+
+OCIO_ADD_TEST(ContextVariableUtils, env_template)
+{
+    // Test that the compiled strings resolve like ResolveContextVariables().
+
+    OCIO::EnvMap env_map;
+    env_map.insert(OCIO::EnvMap::value_type("SHOT", "sh010"));
+    env_map.insert(OCIO::EnvMap::value_type("SEQ", "sq01"));
+    env_map.insert(OCIO::EnvMap::value_type("TEST1", "foo.bar"));
+    env_map.insert(OCIO::EnvMap::value_type("TEST1NG", "bar.foo"));
+    env_map.insert(OCIO::EnvMap::value_type("FOO_foo.bar", "cheese"));
+    env_map.insert(OCIO::EnvMap::value_type("ZZZ", "S"));
+    env_map.insert(OCIO::EnvMap::value_type("P", "%"));
+
+    {
+        const std::string str = "/shows/${SEQ}/$SHOT/%SHOT%_$SEQ.$SHOT.cc";
+        const OCIO::ContextVariableTemplate tmpl(str, env_map);
+        OCIO_CHECK_ASSERT(tmpl.isCompiled());
+        OCIO_REQUIRE_EQUAL(tmpl.getVariableNames().size(), 2);
+
+        std::string result;
+        OCIO::UsedEnvs usedEnvs;
+        OCIO_CHECK_ASSERT(tmpl.resolve(env_map, result, usedEnvs));
+        OCIO_CHECK_EQUAL(result, "/shows/sq01/sh010/sh010_sq01.sh010.cc");
+        OCIO_CHECK_EQUAL(usedEnvs.size(), 2);
+        OCIO_CHECK_EQUAL(usedEnvs["SHOT"], "sh010");
+        OCIO_CHECK_EQUAL(usedEnvs["SEQ"], "sq01");
+
+        // The same template resolves new values.
+        OCIO::EnvMap other = env_map;
+        other["SHOT"] = "sh020";
+        usedEnvs.clear();
+        OCIO_CHECK_ASSERT(tmpl.resolve(other, result, usedEnvs));
+        OCIO_CHECK_EQUAL(result, "/shows/sq01/sh020/sh020_sq01.sh020.cc");
+        OCIO_CHECK_EQUAL(usedEnvs["SHOT"], "sh020");
+
+        // A removed variable needs the generic resolution.
+        other.erase("SEQ");
+        usedEnvs.clear();
+        OCIO_CHECK_ASSERT(!tmpl.resolve(other, result, usedEnvs));
+        OCIO_CHECK_EQUAL(usedEnvs.size(), 0);
+    }
+
+    {
+        // Strings without any context variable.
+        const OCIO::ContextVariableTemplate tmpl("/a/b/c.spi1d", env_map);
+        OCIO_CHECK_ASSERT(tmpl.isCompiled());
+        OCIO_CHECK_ASSERT(tmpl.getVariableNames().empty());
+    }
+
+    {
+        // Nested variables need a recursive expansion.
+        const OCIO::ContextVariableTemplate tmpl("${FOO_${TEST1}}", env_map);
+        OCIO_CHECK_ASSERT(!tmpl.isCompiled());
+    }
+
+    {
+        // '$S' is matched across the literal and the value of ZZZ when resolving.
+        const OCIO::ContextVariableTemplate tmpl("$$ZZZHOT", env_map);
+        OCIO_CHECK_ASSERT(!tmpl.isCompiled());
+    }
+
+    // Whatever the path, the result is always identical to ResolveContextVariables().
+
+    static const std::vector<std::string> strings = {
+        "/shows/${SEQ}/$SHOT/%SHOT%_$SEQ.$SHOT.cc",
+        "/a/b/${TEST1}/${TEST1NG}/%TEST1%/$TEST1NG/${FOO_${TEST1}}/",
+        "$TEST1NG$TEST1$TEST1N",
+        "$$ZZZHOT",
+        "%ZZZ%SHOT%",
+        "$P$SHOT%SHOT%",
+        "${TEST1",
+        "%TEST1",
+        "$UNKNOWN/$SHOT",
+        "100%/$SHOT",
+        "",
+    };
+
+    for (const auto & str : strings)
+    {
+        OCIO::UsedEnvs expectedEnvs;
+        const std::string expected = OCIO::ResolveContextVariables(str, env_map, expectedEnvs);
+
+        const OCIO::ContextVariableTemplate tmpl(str, env_map);
+        OCIO::UsedEnvs usedEnvs;
+        OCIO_CHECK_EQUAL(OCIO::ResolveContextVariables(tmpl, str, env_map, usedEnvs), expected);
+        OCIO_CHECK_ASSERT(usedEnvs == expectedEnvs);
+    }
+}
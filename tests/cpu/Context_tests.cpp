@@ -172,3 +172,39 @@ OCIO_ADD_TEST(Context, string_vars)
     OCIO_CHECK_EQUAL(std::string("var3"), ctx1->getStringVarNameByIndex(2));
     OCIO_CHECK_EQUAL(std::string("val3"), ctx1->getStringVarByIndex(2));
 }
+
+OCIO_ADD_TEST(Context, compiled_string_vars)
+{
+    // The resolved strings follow the changes of the context variables, the compiled strings
+    // being kept when only the values change.
+
+    OCIO::ContextRcPtr ctx = OCIO::Context::Create();
+    ctx->setStringVar("SEQ", "sq01");
+    ctx->setStringVar("SHOT", "sh010");
+
+    OCIO_CHECK_EQUAL(std::string("/shows/sq01/sh010.cc"), ctx->resolveStringVar("/shows/$SEQ/${SHOT}.cc"));
+
+    ctx->setStringVar("SHOT", "sh020");
+    OCIO_CHECK_EQUAL(std::string("/shows/sq01/sh020.cc"), ctx->resolveStringVar("/shows/$SEQ/${SHOT}.cc"));
+
+    OCIO::ContextRcPtr usedContextVars = OCIO::Context::Create();
+    OCIO_CHECK_EQUAL(std::string("sh020_sq01"), ctx->resolveStringVar("%SHOT%_$SEQ", usedContextVars));
+    OCIO_CHECK_EQUAL(2, usedContextVars->getNumStringVars());
+
+    // A copy shares the compiled strings.
+    OCIO::ContextRcPtr copy = ctx->createEditableCopy();
+    copy->setStringVar("SEQ", "sq02");
+    OCIO_CHECK_EQUAL(std::string("/shows/sq02/sh020.cc"), copy->resolveStringVar("/shows/$SEQ/${SHOT}.cc"));
+    OCIO_CHECK_EQUAL(std::string("/shows/sq01/sh020.cc"), ctx->resolveStringVar("/shows/$SEQ/${SHOT}.cc"));
+
+    // Adding or removing a context variable flushes the compiled strings.
+    OCIO_CHECK_EQUAL(std::string("sh020_NAME"), ctx->resolveStringVar("$SHOT_NAME"));
+    ctx->setStringVar("SHOT_NAME", "name");
+    OCIO_CHECK_EQUAL(std::string("name"), ctx->resolveStringVar("$SHOT_NAME"));
+
+    ctx->setStringVar("SHOT_NAME", nullptr);
+    OCIO_CHECK_EQUAL(std::string("sh020_NAME"), ctx->resolveStringVar("$SHOT_NAME"));
+
+    ctx->clearStringVars();
+    OCIO_CHECK_EQUAL(std::string("$SEQ"), ctx->resolveStringVar("$SEQ"));
+}
@@ -2,7 +2,13 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include "DynamicProperty.cpp"
 
@@ -399,6 +405,145 @@ OCIO_ADD_TEST(DynamicPropertyImpl, grading_rgb_curve_knots)
     OCIO_CHECK_EQUAL(dpPointer, dpPointerAfterSet);
 }
 
+namespace
+{
+void CheckSameKnotsCoefs(const OCIO::DynamicPropertyGradingRGBCurveImpl & dp,
+                         const OCIO::ConstGradingRGBCurveRcPtr & value,
+                         unsigned line)
+{
+    // The knots & coefs of a property created with the value are fully computed.
+    OCIO::DynamicPropertyGradingRGBCurveImpl expected(value, false);
+
+    const auto & computed = dp.getKnotsCoefs();
+    const auto & full     = expected.getKnotsCoefs();
+    OCIO_CHECK_EQUAL_FROM(computed.m_localBypass, full.m_localBypass, line);
+    OCIO_CHECK_ASSERT_FROM(computed.m_knotsOffsetsArray == full.m_knotsOffsetsArray, line);
+    OCIO_CHECK_ASSERT_FROM(computed.m_coefsOffsetsArray == full.m_coefsOffsetsArray, line);
+    OCIO_CHECK_ASSERT_FROM(computed.m_knotsArray == full.m_knotsArray, line);
+    OCIO_CHECK_ASSERT_FROM(computed.m_coefsArray == full.m_coefsArray, line);
+}
+}
+
+OCIO_ADD_TEST(DynamicPropertyImpl, grading_rgb_curve_incremental_update)
+{
+    // Only the curves that changed are fit again, the result must be the same as fitting all
+    // the curves.
+
+    auto curve11 = OCIO::GradingBSplineCurve::Create({ { 0.f, 10.f },{ 2.f, 10.f },{ 3.f, 10.f },
+    { 5.f, 10.f },{ 6.f, 10.f },{ 8.f, 10.f },{ 9.f, 10.5f },{ 11.f, 15.f },{ 12.f, 50.f },
+    { 14.f, 60.f },{ 15.f, 85.f } });
+    auto curve3 = OCIO::GradingBSplineCurve::Create({ { 0.f, 0.f },{ 0.5f, 0.7f },{ 1.f, 1.f } });
+    // Identity curve.
+    auto curve = OCIO::GradingBSplineCurve::Create({ { 0.f, 0.f },{ 1.f, 1.f } });
+
+    auto curves = OCIO::GradingRGBCurve::Create(curve11, curve, curve, curve);
+    OCIO::DynamicPropertyGradingRGBCurveImpl dp(curves, true);
+    CheckSameKnotsCoefs(dp, curves, __LINE__);
+
+    // Edit the green curve, the packed red curve does not move.
+    curves = OCIO::GradingRGBCurve::Create(curve11, curve3, curve, curve);
+    dp.setValue(curves);
+    CheckSameKnotsCoefs(dp, curves, __LINE__);
+
+    // Edit the red curve, the packed green curve moves.
+    curves = OCIO::GradingRGBCurve::Create(curve, curve3, curve, curve);
+    dp.setValue(curves);
+    CheckSameKnotsCoefs(dp, curves, __LINE__);
+    OCIO_CHECK_EQUAL(dp.getKnotsOffsetsArray()[2], 0);
+
+    // A slope edit is also a curve change.
+    const std::vector<float> coefs = dp.getKnotsCoefs().m_coefsArray;
+    auto curve3Slope = curve3->createEditableCopy();
+    curve3Slope->setSlope(1, 0.5f);
+    curves = OCIO::GradingRGBCurve::Create(curve, curve3Slope, curve, curve);
+    dp.setValue(curves);
+    CheckSameKnotsCoefs(dp, curves, __LINE__);
+    OCIO_CHECK_ASSERT(dp.getKnotsCoefs().m_coefsArray != coefs);
+
+    // The maximum number of knots applies to all the curves.
+    curves = OCIO::GradingRGBCurve::Create(curve11, curve11, curve11, curve11);
+    OCIO_CHECK_THROW_WHAT(dp.setValue(curves), OCIO::Exception,
+                          "RGB curve: maximum number of control points reached");
+
+    curves = OCIO::GradingRGBCurve::Create(curve11, curve, curve11, curve3);
+    dp.setValue(curves);
+    CheckSameKnotsCoefs(dp, curves, __LINE__);
+
+    // Back to identity.
+    curves = OCIO::GradingRGBCurve::Create(curve, curve, curve, curve);
+    dp.setValue(curves);
+    CheckSameKnotsCoefs(dp, curves, __LINE__);
+    OCIO_CHECK_ASSERT(dp.getLocalBypass());
+}
+
+OCIO_ADD_TEST(DynamicPropertyImpl, grading_incremental_updates)
+{
+    // An interactive edit i.e. a UI slider changing one control of a grading dynamic property.
+    // Each incremental update must give the same result as a full computation. Note that the
+    // update latency is measured by the benchmarks (see tests/perf).
+
+    // Tone: one control changes per update.
+
+    OCIO::GradingTone tone{ OCIO::GRADING_LOG };
+    OCIO::DynamicPropertyGradingToneImpl toneProp(tone, OCIO::GRADING_LOG, true);
+    OCIO::GradingTonePreRender full(OCIO::GRADING_LOG);
+
+    for (int i = 0; i < 20; ++i)
+    {
+        tone.m_midtones.m_master = 0.5 + i / 10.;
+        tone.m_highlights.m_red  = (i % 4 == 0) ? 1.2 : 1.;
+        toneProp.setValue(tone);
+
+        // A style change forces a full computation.
+        full.setStyle(OCIO::GRADING_LIN);
+        full.setStyle(OCIO::GRADING_LOG);
+        full.update(tone);
+
+        const OCIO::GradingTonePreRender & computed = toneProp.getComputedValue();
+        OCIO_REQUIRE_EQUAL(computed.m_localBypass, full.m_localBypass);
+        if (full.m_localBypass) continue;
+
+        OCIO_CHECK_EQUAL(computed.m_highlightsStart, full.m_highlightsStart);
+        OCIO_CHECK_EQUAL(computed.m_highlightsWidth, full.m_highlightsWidth);
+        OCIO_CHECK_EQUAL(computed.m_whitesStart, full.m_whitesStart);
+        OCIO_CHECK_EQUAL(computed.m_whitesWidth, full.m_whitesWidth);
+
+#define CHECK_SAME_ARRAY(member) \
+        OCIO_CHECK_ASSERT(std::memcmp(computed.member, full.member, sizeof(full.member)) == 0)
+
+        CHECK_SAME_ARRAY(m_midX);
+        CHECK_SAME_ARRAY(m_midY);
+        CHECK_SAME_ARRAY(m_midM);
+        CHECK_SAME_ARRAY(m_hsX);
+        CHECK_SAME_ARRAY(m_hsY);
+        CHECK_SAME_ARRAY(m_hsM);
+
+#undef CHECK_SAME_ARRAY
+    }
+
+    // RGB curve: one of the curves changes per update.
+
+    auto curve11 = OCIO::GradingBSplineCurve::Create({ { 0.f, 10.f },{ 2.f, 10.f },{ 3.f, 10.f },
+    { 5.f, 10.f },{ 6.f, 10.f },{ 8.f, 10.f },{ 9.f, 10.5f },{ 11.f, 15.f },{ 12.f, 50.f },
+    { 14.f, 60.f },{ 15.f, 85.f } });
+    auto edited = OCIO::GradingBSplineCurve::Create({ { 0.f, 0.f },{ 0.5f, 0.7f },{ 1.f, 1.f } });
+    auto curve = OCIO::GradingBSplineCurve::Create({ { 0.f, 0.f },{ 1.f, 1.f } });
+
+    OCIO::DynamicPropertyGradingRGBCurveImpl curveProp(
+        OCIO::GradingRGBCurve::Create(curve11, curve, curve11, edited), true);
+
+    for (int i = 0; i < 20; ++i)
+    {
+        edited->getControlPoint(1).m_y = 0.5f + i / 40.f;
+        if (i % 5 == 0)
+        {
+            edited->setSlope(1, 0.8f + i / 100.f);
+        }
+        curveProp.setValue(OCIO::GradingRGBCurve::Create(curve11, curve, curve11, edited));
+        CheckSameKnotsCoefs(curveProp, curveProp.getValue(), __LINE__);
+    }
+}
+
 OCIO_ADD_TEST(DynamicPropertyImpl, get_as)
 {
     OCIO::GradingPrimary gplog{ OCIO::GRADING_LOG };
@@ -422,4 +567,236 @@ OCIO_ADD_TEST(DynamicPropertyImpl, get_as)
     gplog.m_pivot = 0.12;
     asPrimary->setValue(gplog);
     OCIO_CHECK_EQUAL(dpImpl0->getValue(), gplog);
-}
\ No newline at end of file
+}
+
+OCIO_ADD_TEST(DynamicPropertyImpl, snapshot_buffer)
+{
+    // The second value is always twice the first one so, a torn read breaks the relation.
+    using Values = std::pair<long, long>;
+    OCIO::SnapshotBuffer<Values> buffer;
+    buffer.publish(std::make_shared<const Values>(0, 0));
+
+    constexpr long numUpdates = 20000;
+    std::atomic<bool> done{ false };
+    std::atomic<long> numErrors{ 0 };
+
+    std::vector<std::thread> readers;
+    for (int idx = 0; idx < 4; ++idx)
+    {
+        readers.emplace_back([&]()
+        {
+            long previous = 0;
+            while (!done)
+            {
+                const auto snapshot = buffer.get();
+                // The values are consistent and never go back in time.
+                if (snapshot->second != 2 * snapshot->first || snapshot->first < previous)
+                {
+                    ++numErrors;
+                }
+                previous = snapshot->first;
+            }
+        });
+    }
+
+    for (long idx = 1; idx <= numUpdates; ++idx)
+    {
+        buffer.publish(std::make_shared<const Values>(idx, 2 * idx));
+    }
+    done = true;
+
+    for (auto & reader : readers)
+    {
+        reader.join();
+    }
+
+    OCIO_CHECK_EQUAL(numErrors, 0);
+    OCIO_CHECK_EQUAL(buffer.get()->first, numUpdates);
+}
+
+OCIO_ADD_TEST(DynamicPropertyImpl, grading_primary_snapshot)
+{
+    OCIO::GradingPrimary gp(OCIO::GRADING_LOG);
+    auto dp = std::make_shared<OCIO::DynamicPropertyGradingPrimaryImpl>(
+        OCIO::GRADING_LOG, OCIO::TRANSFORM_DIR_FORWARD, gp, true);
+
+    auto snapshot = dp->getSnapshot();
+    OCIO_REQUIRE_ASSERT(snapshot);
+    OCIO_CHECK_EQUAL(snapshot->m_value, gp);
+    OCIO_CHECK_ASSERT(snapshot->m_computed.getLocalBypass());
+
+    // A new value does not change the snapshot in use by a renderer.
+    gp.m_brightness.m_red = 0.1;
+    dp->setValue(gp);
+
+    OCIO_CHECK_NE(snapshot->m_value, gp);
+    OCIO_CHECK_ASSERT(snapshot->m_computed.getLocalBypass());
+
+    auto newSnapshot = dp->getSnapshot();
+    OCIO_CHECK_EQUAL(newSnapshot->m_value, gp);
+    OCIO_CHECK_ASSERT(!newSnapshot->m_computed.getLocalBypass());
+    OCIO_CHECK_EQUAL(newSnapshot->m_computed.getBrightness()[0],
+                     dp->getComputedValue().getBrightness()[0]);
+
+    // The copy has its own snapshots.
+    auto copy = dp->createEditableCopy();
+    OCIO_CHECK_EQUAL(copy->getSnapshot()->m_value, gp);
+}
+
+namespace
+{
+// Several threads (e.g. a UI & a host script) change the same property while a renderer reads
+// its snapshots. Each writer sets its own value so that a snapshot mixing the updates of two
+// setters is detected by the check (which returns false for an inconsistent snapshot).
+void RunConcurrentSetters(const std::function<void(int writer)> & setValue,
+                          const std::function<bool()> & checkSnapshot)
+{
+    constexpr int numWriters = 4;
+    constexpr int numUpdates = 500;
+
+    std::atomic<bool> done{ false };
+    std::atomic<long> numErrors{ 0 };
+
+    std::thread reader([&]()
+    {
+        while (!done)
+        {
+            if (!checkSnapshot())
+            {
+                ++numErrors;
+            }
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int writer = 0; writer < numWriters; ++writer)
+    {
+        writers.emplace_back([&, writer]()
+        {
+            for (int idx = 0; idx < numUpdates; ++idx)
+            {
+                setValue(writer);
+            }
+        });
+    }
+
+    for (auto & writer : writers)
+    {
+        writer.join();
+    }
+    done = true;
+    reader.join();
+
+    OCIO_CHECK_EQUAL(numErrors, 0);
+    // The last snapshot is also consistent.
+    OCIO_CHECK_ASSERT(checkSnapshot());
+}
+} // anon.
+
+OCIO_ADD_TEST(DynamicPropertyImpl, concurrent_setters)
+{
+    // Grading primary: the computed values of a snapshot match its value.
+    {
+        std::vector<OCIO::GradingPrimary> values(4, OCIO::GradingPrimary(OCIO::GRADING_LOG));
+        std::vector<OCIO::GradingPrimaryPreRender> computed;
+        for (size_t idx = 0; idx < values.size(); ++idx)
+        {
+            values[idx].m_brightness.m_red = 0.1 * double(idx + 1);
+            values[idx].m_contrast.m_master = 1.0 + 0.1 * double(idx);
+            computed.emplace_back();
+            computed.back().update(OCIO::GRADING_LOG, OCIO::TRANSFORM_DIR_FORWARD, values[idx]);
+        }
+
+        auto dp = std::make_shared<OCIO::DynamicPropertyGradingPrimaryImpl>(
+            OCIO::GRADING_LOG, OCIO::TRANSFORM_DIR_FORWARD, values[0], true);
+
+        RunConcurrentSetters(
+            [&](int writer) { dp->setValue(values[writer]); },
+            [&]()
+            {
+                const auto snapshot = dp->getSnapshot();
+                for (size_t idx = 0; idx < values.size(); ++idx)
+                {
+                    if (snapshot->m_value == values[idx])
+                    {
+                        return snapshot->m_computed.getBrightness() == computed[idx].getBrightness()
+                            && snapshot->m_computed.getContrast() == computed[idx].getContrast();
+                    }
+                }
+                return false;
+            });
+    }
+
+    // Grading tone: the values are incrementally updated so a race between two setters would
+    // mix their controls.
+    {
+        std::vector<OCIO::GradingTone> values(4, OCIO::GradingTone(OCIO::GRADING_LOG));
+        std::vector<OCIO::GradingTonePreRender> computed;
+        for (size_t idx = 0; idx < values.size(); ++idx)
+        {
+            values[idx].m_midtones.m_master = 1.0 + 0.1 * double(idx);
+            values[idx].m_shadows.m_red = 1.0 + 0.05 * double(idx);
+            computed.emplace_back(OCIO::GRADING_LOG);
+            computed.back().update(values[idx]);
+        }
+
+        auto dp = std::make_shared<OCIO::DynamicPropertyGradingToneImpl>(
+            values[0], OCIO::GRADING_LOG, true);
+
+        RunConcurrentSetters(
+            [&](int writer) { dp->setValue(values[writer]); },
+            [&]()
+            {
+                const auto snapshot = dp->getSnapshot();
+                for (size_t idx = 0; idx < values.size(); ++idx)
+                {
+                    if (snapshot->m_value == values[idx])
+                    {
+                        const auto & lhs = snapshot->m_computed;
+                        const auto & rhs = computed[idx];
+                        return 0 == std::memcmp(lhs.m_midX, rhs.m_midX, sizeof(lhs.m_midX))
+                            && 0 == std::memcmp(lhs.m_midY, rhs.m_midY, sizeof(lhs.m_midY))
+                            && 0 == std::memcmp(lhs.m_hsY, rhs.m_hsY, sizeof(lhs.m_hsY));
+                    }
+                }
+                return false;
+            });
+    }
+
+    // Grading RGB curve: only the curves that changed are fit again so a race between two
+    // setters would mix their knots.
+    {
+        std::vector<OCIO::ConstGradingRGBCurveRcPtr> values;
+        std::vector<std::vector<float>> knots;
+        for (int idx = 0; idx < 4; ++idx)
+        {
+            auto curve = OCIO::GradingBSplineCurve::Create(
+                { { 0.f, 0.f }, { 0.5f, 0.3f + 0.1f * float(idx) }, { 1.f, 1.f } });
+            auto identity = OCIO::GradingBSplineCurve::Create({ { 0.f, 0.f }, { 1.f, 1.f } });
+            values.push_back(idx % 2 ? OCIO::GradingRGBCurve::Create(curve, identity, identity, identity)
+                                     : OCIO::GradingRGBCurve::Create(identity, curve, identity, curve));
+
+            OCIO::DynamicPropertyGradingRGBCurveImpl reference(values.back(), true);
+            knots.emplace_back(reference.getKnotsCoefs().m_coefsArray);
+        }
+
+        auto dp = std::make_shared<OCIO::DynamicPropertyGradingRGBCurveImpl>(values[0], true);
+
+        RunConcurrentSetters(
+            [&](int writer) { dp->setValue(values[writer]); },
+            [&]()
+            {
+                const auto snapshot = dp->getSnapshot();
+                return std::find(knots.begin(), knots.end(), snapshot->m_coefsArray) != knots.end();
+            });
+
+        // The value & the snapshot match.
+        const auto last = std::find_if(values.begin(), values.end(),
+                                       [&](const OCIO::ConstGradingRGBCurveRcPtr & value)
+                                       {
+                                           return *value == *dp->getValue();
+                                       });
+        OCIO_REQUIRE_ASSERT(last != values.end());
+        OCIO_CHECK_ASSERT(dp->getSnapshot()->m_coefsArray == knots[last - values.begin()]);
+    }
+}
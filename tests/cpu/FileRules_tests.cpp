@@ -1998,3 +1998,101 @@ OCIO_ADD_TEST(FileRules, isDefault)
     const auto config = OCIO::Config::CreateRaw();
     OCIO_CHECK_ASSERT(config->getFileRules()->isDefault());
 }
+
+OCIO_ADD_TEST(FileRules, glob_fast_match)
+{
+    // Some glob rules are evaluated without the regular expression so check that the results
+    // are identical to the ones from the regular expression.
+
+    const std::vector<std::pair<std::string, std::string>> globs = {
+        { "*", "exr" }, { "*", "EXR" }, { "*", "tar.gz" }, { "**", "my_ext-1" },
+        { "*", "*" }, { "**", "**" }, { "*", "e?r" }, { "*", "[eE][xX][r]" }, { "*gamma*", "exr" }
+    };
+
+    const std::vector<std::string> paths = {
+        "", ".", "exr", ".exr", "a.exr", "/a/b/c.EXR", "/a/b/c.eXr", "/a/b/c.exr.jpg",
+        "/a.exr/b/c", "/a/b/cexr", "a.tar.gz", "a.TAR.GZ", "a.tar_gz", "a.my_ext-1",
+        "a.MY_EXT-1", "/a/gamma/b.exr", "a\nb.exr", "a.e\nxr", "a.exr\n", "a.\r"
+    };
+
+    for (const auto & glob : globs)
+    {
+        auto rules = OCIO::FileRules::Create();
+        OCIO_CHECK_NO_THROW(rules->insertRule(0, "rule", "cs1",
+                                              glob.first.c_str(), glob.second.c_str()));
+
+        auto config = OCIO::Config::CreateRaw()->createEditableCopy();
+        config->setFileRules(rules);
+
+        const std::regex reg(OCIO::BuildRegularExpression(glob.first.c_str(),
+                                                          glob.second.c_str()));
+
+        for (const auto & path : paths)
+        {
+            size_t rulePosition = 0;
+            config->getColorSpaceFromFilepath(path.c_str(), rulePosition);
+
+            OCIO_CHECK_EQUAL(rulePosition == 0, std::regex_match(path, reg));
+        }
+    }
+}
+
+OCIO_ADD_TEST(FileRules, results_cache)
+{
+    std::istringstream is;
+    is.str(g_config);
+    OCIO::ConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is)->createEditableCopy());
+
+    auto rules = config->getFileRules()->createEditableCopy();
+    OCIO_CHECK_NO_THROW(rules->insertRule(0, g_name, "cs1", g_filePattern, g_fileExt));
+    OCIO_CHECK_NO_THROW(rules->insertPathSearchRule(0));
+    config->setFileRules(rules);
+
+    size_t rulePosition = 42;
+    OCIO_CHECK_EQUAL(std::string("cs1"), config->getColorSpaceFromFilepath("/a/b.exr", rulePosition));
+    OCIO_CHECK_EQUAL(rulePosition, 1);
+
+    // Same results from the cache.
+    rulePosition = 42;
+    OCIO_CHECK_EQUAL(std::string("cs1"), config->getColorSpaceFromFilepath("/a/b.exr", rulePosition));
+    OCIO_CHECK_EQUAL(rulePosition, 1);
+    OCIO_CHECK_ASSERT(!config->filepathOnlyMatchesDefaultRule("/a/b.exr"));
+
+    OCIO_CHECK_EQUAL(std::string("default"), config->getColorSpaceFromFilepath("/a/new_cs.dpx", rulePosition));
+    OCIO_CHECK_EQUAL(rulePosition, 2);
+    OCIO_CHECK_ASSERT(config->filepathOnlyMatchesDefaultRule("/a/new_cs.dpx"));
+
+    // A config change flushes the cache.
+
+    auto cs = OCIO::ColorSpace::Create();
+    cs->setName("new_cs");
+    config->addColorSpace(cs);
+
+    OCIO_CHECK_EQUAL(std::string("new_cs"), config->getColorSpaceFromFilepath("/a/new_cs.dpx", rulePosition));
+    OCIO_CHECK_EQUAL(rulePosition, 0);
+    OCIO_CHECK_ASSERT(!config->filepathOnlyMatchesDefaultRule("/a/new_cs.dpx"));
+
+    OCIO_CHECK_NO_THROW(rules->setColorSpace(1, "cs2"));
+    config->setFileRules(rules);
+    OCIO_CHECK_EQUAL(std::string("cs2"), config->getColorSpaceFromFilepath("/a/b.exr", rulePosition));
+    OCIO_CHECK_EQUAL(rulePosition, 1);
+
+    // The cache is bounded so it is flushed when full.
+
+    for (size_t idx = 0; idx < 10000; ++idx)
+    {
+        const std::string path = "/a/b" + std::to_string(idx) + ".exr";
+        OCIO_CHECK_EQUAL(std::string("cs2"), config->getColorSpaceFromFilepath(path.c_str()));
+    }
+    OCIO_CHECK_EQUAL(std::string("cs2"), config->getColorSpaceFromFilepath("/a/b.exr", rulePosition));
+    OCIO_CHECK_EQUAL(rulePosition, 1);
+
+    // Same results without the cache.
+
+    config->setProcessorCacheFlags(OCIO::PROCESSOR_CACHE_OFF);
+    OCIO_CHECK_EQUAL(std::string("cs2"), config->getColorSpaceFromFilepath("/a/b.exr", rulePosition));
+    OCIO_CHECK_EQUAL(rulePosition, 1);
+    OCIO_CHECK_EQUAL(std::string("new_cs"), config->getColorSpaceFromFilepath("/a/new_cs.dpx", rulePosition));
+    OCIO_CHECK_EQUAL(rulePosition, 0);
+}
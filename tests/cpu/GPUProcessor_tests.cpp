@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#include "GPUProcessor.cpp"
+
+#include "testutils/UnitTest.h"
+#include "UnitTestUtils.h"
+
+namespace OCIO = OCIO_NAMESPACE;
+
+
+OCIO_ADD_TEST(GPUProcessor, shader_cache)
+{
+    OCIO::ClearGpuShaderCaches();
+
+    auto lut3d = OCIO::Lut3DTransform::Create(2);
+    lut3d->setValue(1, 1, 1, 2.0f, 1.0f, 0.5f);
+
+    auto lut1d = OCIO::Lut1DTransform::Create(16, false);
+    lut1d->setValue(15, 2.0f, 1.0f, 0.5f);
+
+    auto group = OCIO::GroupTransform::Create();
+    group->appendTransform(lut1d);
+    group->appendTransform(lut3d);
+
+    OCIO::ConfigRcPtr config = OCIO::Config::CreateRaw()->createEditableCopy();
+    OCIO::ConstGPUProcessorRcPtr gpu
+        = config->getProcessor(group)->getOptimizedGPUProcessor(OCIO::OPTIMIZATION_NONE);
+
+    OCIO::GpuShaderDescRcPtr desc1 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(desc1));
+    OCIO_CHECK_EQUAL(OCIO::g_shaderCache.size(), 1);
+
+    // The second extraction reuses the cached shader program.
+
+    OCIO::GpuShaderDescRcPtr desc2 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(desc2));
+    OCIO_CHECK_EQUAL(OCIO::g_shaderCache.size(), 1);
+
+    OCIO_CHECK_EQUAL(std::string(desc2->getShaderText()), std::string(desc1->getShaderText()));
+    OCIO_CHECK_EQUAL(std::string(desc2->getCacheID()), std::string(desc1->getCacheID()));
+    OCIO_CHECK_EQUAL(desc2->getNextResourceIndex(), desc1->getNextResourceIndex());
+
+    OCIO_REQUIRE_EQUAL(desc2->getNumTextures(), 1);
+    OCIO_REQUIRE_EQUAL(desc2->getNum3DTextures(), 1);
+
+    const char * textureName1 = nullptr;
+    const char * textureName2 = nullptr;
+    const char * samplerName = nullptr;
+    unsigned edgelen = 0;
+    OCIO::Interpolation interpolation = OCIO::INTERP_UNKNOWN;
+    desc1->get3DTexture(0, textureName1, samplerName, edgelen, interpolation);
+    desc2->get3DTexture(0, textureName2, samplerName, edgelen, interpolation);
+    OCIO_CHECK_EQUAL(std::string(textureName2), std::string(textureName1));
+    OCIO_CHECK_EQUAL(edgelen, 2);
+
+    const float * values1 = nullptr;
+    const float * values2 = nullptr;
+    desc1->getTextureValues(0, values1);
+    desc2->getTextureValues(0, values2);
+    OCIO_CHECK_EQUAL(values1, values2);
+
+    // A different texture limit needs another shader program.
+
+    OCIO::GpuShaderDescRcPtr desc3 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    desc3->setAllowTexture1D(false);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(desc3));
+    OCIO_CHECK_EQUAL(OCIO::g_shaderCache.size(), 2);
+    OCIO_CHECK_NE(std::string(desc3->getShaderText()), std::string(desc1->getShaderText()));
+
+    // A shader desc already holding some shader code does not use the cache.
+
+    OCIO::GpuShaderDescRcPtr desc4 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    desc4->addToDeclareShaderCode("// Custom declaration\n");
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(desc4));
+    OCIO_CHECK_EQUAL(OCIO::g_shaderCache.size(), 2);
+    OCIO_CHECK_NE(std::string(desc4->getShaderText()).find("// Custom declaration"),
+                  std::string::npos);
+
+    // The shader programs with uniforms are not cached.
+
+    auto ec = OCIO::ExposureContrastTransform::Create();
+    ec->makeExposureDynamic();
+    OCIO::ConstGPUProcessorRcPtr gpuDyn = config->getProcessor(ec)->getDefaultGPUProcessor();
+
+    OCIO::GpuShaderDescRcPtr desc5 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    OCIO_CHECK_NO_THROW(gpuDyn->extractGpuShaderInfo(desc5));
+    OCIO_CHECK_EQUAL(OCIO::g_shaderCache.size(), 2);
+    OCIO_CHECK_EQUAL(desc5->getNumUniforms(), 1);
+
+    OCIO::ClearGpuShaderCaches();
+    OCIO_CHECK_EQUAL(OCIO::g_shaderCache.size(), 0);
+}
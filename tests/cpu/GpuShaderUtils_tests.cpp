@@ -21,3 +21,28 @@ OCIO_ADD_TEST(GpuShaderUtils, float_to_string)
     OCIO_CHECK_EQUAL(OCIO::getFloatString((float)1, OCIO::GPU_LANGUAGE_GLSL_1_3), "1.");
 }
 
+OCIO_ADD_TEST(GpuShaderUtils, compact_shader_text)
+{
+    const std::string text = "\n"
+                             "// Declaration of the OCIO shader function\n"
+                             "\n"
+                             "vec4 OCIOMain(vec4 inPixel)\n"
+                             "{\n"
+                             "  vec4 outColor = inPixel;  // Keep the alpha.\n"
+                             "  /* C-style comment */\n"
+                             "  outColor.rgb = outColor.rgb * 2.;\n"
+                             "\n"
+                             "  return outColor;\n"
+                             "}\n";
+
+    OCIO_CHECK_EQUAL(OCIO::CompactShaderText(text),
+                     "vec4 OCIOMain(vec4 inPixel)\n"
+                     "{\n"
+                     "vec4 outColor = inPixel;\n"
+                     "outColor.rgb = outColor.rgb * 2.;\n"
+                     "return outColor;\n"
+                     "}\n");
+
+    OCIO_CHECK_EQUAL(OCIO::CompactShaderText(""), "");
+    OCIO_CHECK_EQUAL(OCIO::CompactShaderText("#version 430\n"), "#version 430\n");
+}
@@ -197,6 +197,646 @@ OCIO_ADD_TEST(GpuShader, generic_shader)
     }
 }
 
+OCIO_ADD_TEST(GpuShader, shared_texture_values)
+{
+    // The LUT textures are shared between the shader descs rather than copied.
+
+    auto lut3d = OCIO::Lut3DTransform::Create(2);
+    lut3d->setValue(1, 1, 1, 0.5f, 0.6f, 0.7f);
+
+    auto lut1d = OCIO::Lut1DTransform::Create(16, false);
+    lut1d->setValue(15, 0.5f, 0.6f, 0.7f);
+
+    auto group = OCIO::GroupTransform::Create();
+    group->appendTransform(lut1d);
+    group->appendTransform(lut3d);
+
+    OCIO::ConfigRcPtr config = OCIO::Config::CreateRaw()->createEditableCopy();
+
+    OCIO::ConstGPUProcessorRcPtr gpu
+        = config->getProcessor(group)->getOptimizedGPUProcessor(OCIO::OPTIMIZATION_NONE);
+
+    OCIO::GpuShaderDescRcPtr shaderDesc1 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc1));
+    OCIO_REQUIRE_EQUAL(shaderDesc1->getNumTextures(), 1U);
+    OCIO_REQUIRE_EQUAL(shaderDesc1->getNum3DTextures(), 1U);
+
+    // A processor built separately from an identical transform i.e. the processor cache is off
+    // so the processor is not shared.
+    OCIO::ConfigRcPtr config2 = OCIO::Config::CreateRaw()->createEditableCopy();
+    config2->setProcessorCacheFlags(OCIO::PROCESSOR_CACHE_OFF);
+
+    OCIO::ConstProcessorRcPtr proc2 = config2->getProcessor(group->createEditableCopy());
+    OCIO_CHECK_NE(proc2.get(), config->getProcessor(group).get());
+    OCIO::ConstGPUProcessorRcPtr gpu2 = proc2->getOptimizedGPUProcessor(OCIO::OPTIMIZATION_NONE);
+    OCIO_CHECK_NE(gpu2.get(), gpu.get());
+
+    // Use another shading language so the shader program is not restored from the shader cache
+    // but is generated again (i.e. only the texture values are shared).
+    OCIO::GpuShaderDescRcPtr shaderDesc2 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc2->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+    OCIO_CHECK_NO_THROW(gpu2->extractGpuShaderInfo(shaderDesc2));
+    OCIO_CHECK_NE(std::string(shaderDesc2->getShaderText()),
+                  std::string(shaderDesc1->getShaderText()));
+
+    const float * values1 = nullptr;
+    const float * values2 = nullptr;
+
+    OCIO_CHECK_NO_THROW(shaderDesc1->getTextureValues(0, values1));
+    OCIO_CHECK_NO_THROW(shaderDesc2->getTextureValues(0, values2));
+    OCIO_CHECK_ASSERT(values1 != nullptr);
+    OCIO_CHECK_EQUAL(values1, values2);
+
+    OCIO_CHECK_NO_THROW(shaderDesc1->get3DTextureValues(0, values1));
+    OCIO_CHECK_NO_THROW(shaderDesc2->get3DTextureValues(0, values2));
+    OCIO_CHECK_ASSERT(values1 != nullptr);
+    OCIO_CHECK_EQUAL(values1, values2);
+
+    // The values outlive the processors and the other shader desc.
+    gpu.reset();
+    gpu2.reset();
+    shaderDesc1.reset();
+
+    OCIO_CHECK_NO_THROW(shaderDesc2->get3DTextureValues(0, values2));
+    // Last entry of the 3D LUT.
+    OCIO_CHECK_EQUAL(values2[21], 0.5f);
+    OCIO_CHECK_EQUAL(values2[22], 0.6f);
+    OCIO_CHECK_EQUAL(values2[23], 0.7f);
+
+    OCIO_CHECK_NO_THROW(shaderDesc2->getTextureValues(0, values2));
+    // Last entry of the 1D LUT.
+    OCIO_CHECK_EQUAL(values2[45], 0.5f);
+    OCIO_CHECK_EQUAL(values2[46], 0.6f);
+    OCIO_CHECK_EQUAL(values2[47], 0.7f);
+}
+
+OCIO_ADD_TEST(GpuShader, texture_formats)
+{
+    auto lut3d = OCIO::Lut3DTransform::Create(2);
+    lut3d->setValue(1, 1, 1, 2.0f, 1.0f, 0.5f);
+
+    auto lut1d = OCIO::Lut1DTransform::Create(16, false);
+    lut1d->setValue(15, 1e6f, 1.0f, 0.5f);
+
+    auto group = OCIO::GroupTransform::Create();
+    group->appendTransform(lut1d);
+    group->appendTransform(lut3d);
+
+    OCIO::ConfigRcPtr config = OCIO::Config::CreateRaw()->createEditableCopy();
+    OCIO::ConstGPUProcessorRcPtr gpu
+        = config->getProcessor(group)->getOptimizedGPUProcessor(OCIO::OPTIMIZATION_NONE);
+
+    // 32-bit float values by default.
+
+    OCIO::GpuShaderDescRcPtr floatDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    OCIO_CHECK_EQUAL(floatDesc->getTextureFormat(), OCIO::GpuShaderCreator::TEXTURE_FORMAT_FLOAT32);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(floatDesc));
+
+    OCIO_CHECK_EQUAL(floatDesc->getTexturePackedFormat(0), OCIO::GpuShaderCreator::TEXTURE_FORMAT_FLOAT32);
+    OCIO_CHECK_EQUAL(floatDesc->get3DTexturePackedFormat(0), OCIO::GpuShaderCreator::TEXTURE_FORMAT_FLOAT32);
+
+    const uint16_t * packed = nullptr;
+    OCIO_CHECK_THROW_WHAT(floatDesc->getTexturePackedValues(0, packed), OCIO::Exception,
+                          "The 1D LUT texture values are not packed.");
+    OCIO_CHECK_THROW_WHAT(floatDesc->get3DTexturePackedValues(0, packed), OCIO::Exception,
+                          "The 3D LUT texture values are not packed.");
+
+    // Half float values.
+
+    OCIO::GpuShaderDescRcPtr halfDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    halfDesc->setTextureFormat(OCIO::GpuShaderCreator::TEXTURE_FORMAT_HALF);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(halfDesc));
+    OCIO_CHECK_NE(std::string(halfDesc->getCacheID()), std::string(floatDesc->getCacheID()));
+    // The shader program is unchanged.
+    OCIO_CHECK_EQUAL(std::string(halfDesc->getShaderText()), std::string(floatDesc->getShaderText()));
+    OCIO_CHECK_EQUAL(halfDesc->getTexturePackedFormat(0), OCIO::GpuShaderCreator::TEXTURE_FORMAT_HALF);
+    OCIO_CHECK_EQUAL(halfDesc->get3DTexturePackedFormat(0), OCIO::GpuShaderCreator::TEXTURE_FORMAT_HALF);
+
+    OCIO_CHECK_NO_THROW(halfDesc->get3DTexturePackedValues(0, packed));
+    OCIO_CHECK_EQUAL(packed[21], 0x4000); // 2.0
+    OCIO_CHECK_EQUAL(packed[22], 0x3C00); // 1.0
+    OCIO_CHECK_EQUAL(packed[23], 0x3800); // 0.5
+
+    OCIO_CHECK_NO_THROW(halfDesc->getTexturePackedValues(0, packed));
+    OCIO_CHECK_EQUAL(packed[45], 0x7BFF); // Clamped to the largest half value.
+    OCIO_CHECK_EQUAL(packed[46], 0x3C00);
+    OCIO_CHECK_EQUAL(packed[47], 0x3800);
+
+    // The float values are still available.
+    const float * values = nullptr;
+    OCIO_CHECK_NO_THROW(halfDesc->get3DTextureValues(0, values));
+    OCIO_CHECK_EQUAL(values[21], 2.0f);
+
+    // Normalized integer values.
+
+    OCIO::GpuShaderDescRcPtr unormDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    unormDesc->setTextureFormat(OCIO::GpuShaderCreator::TEXTURE_FORMAT_UNORM16);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(unormDesc));
+
+    // The 3D LUT values are on [0, 2] for the red channel and on [0, 1] for the other ones.
+    OCIO_CHECK_EQUAL(unormDesc->get3DTexturePackedFormat(0), OCIO::GpuShaderCreator::TEXTURE_FORMAT_UNORM16);
+    OCIO_CHECK_NO_THROW(unormDesc->get3DTexturePackedValues(0, packed));
+    OCIO_CHECK_EQUAL(packed[0], 0);
+    OCIO_CHECK_EQUAL(packed[21], 65535);
+    OCIO_CHECK_EQUAL(packed[22], 65535);
+    OCIO_CHECK_EQUAL(packed[23], 32768);
+
+    // The range of the 1D LUT values is too wide so the half float values are used instead.
+    OCIO_CHECK_EQUAL(unormDesc->getTexturePackedFormat(0), OCIO::GpuShaderCreator::TEXTURE_FORMAT_HALF);
+    OCIO_CHECK_NO_THROW(unormDesc->getTexturePackedValues(0, packed));
+    OCIO_CHECK_EQUAL(packed[45], 0x7BFF);
+    OCIO_CHECK_EQUAL(packed[46], 0x3C00);
+    OCIO_CHECK_EQUAL(packed[47], 0x3800);
+
+    // The shader program only rescales the sampled values of the 3D LUT.
+    const std::string text(unormDesc->getShaderText());
+    OCIO_CHECK_EQUAL(text.find("// Rescale the normalized texture values"),
+                     text.rfind("// Rescale the normalized texture values"));
+    OCIO_CHECK_NE(text.find(" * vec3(2., 1., 1.) + vec3(0., 0., 0.);"), std::string::npos);
+}
+
+OCIO_ADD_TEST(GpuShader, texture_format_unorm16_precision)
+{
+    // The 3D LUT values use a distinct range per channel.
+
+    constexpr unsigned gridSize = 17;
+    auto lut3d = OCIO::Lut3DTransform::Create(gridSize);
+    for (unsigned r = 0; r < gridSize; ++r)
+    {
+        for (unsigned g = 0; g < gridSize; ++g)
+        {
+            for (unsigned b = 0; b < gridSize; ++b)
+            {
+                const float x = float(r + g + b) / float(3 * (gridSize - 1));
+                lut3d->setValue(r, g, b, -0.5f + 4.0f * x * x, std::sqrt(x), 0.25f + 0.5f * x);
+            }
+        }
+    }
+
+    OCIO::ConfigRcPtr config = OCIO::Config::CreateRaw()->createEditableCopy();
+    OCIO::ConstGPUProcessorRcPtr gpu
+        = config->getProcessor(lut3d)->getOptimizedGPUProcessor(OCIO::OPTIMIZATION_NONE);
+
+    OCIO::GpuShaderDescRcPtr unormDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    unormDesc->setTextureFormat(OCIO::GpuShaderCreator::TEXTURE_FORMAT_UNORM16);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(unormDesc));
+    OCIO_REQUIRE_EQUAL(unormDesc->get3DTexturePackedFormat(0),
+                       OCIO::GpuShaderCreator::TEXTURE_FORMAT_UNORM16);
+
+    OCIO::ConstGpuTextureValuesRcPtr values;
+    OCIO::ConstGpuTexturePackedValuesRcPtr packed;
+    auto generic = OCIO::DynamicPtrCast<OCIO::GenericGpuShaderDesc>(unormDesc);
+    OCIO_REQUIRE_ASSERT(generic);
+    OCIO_CHECK_NO_THROW(generic->getShared3DTextureValues(0, values, packed));
+    OCIO_REQUIRE_ASSERT(values && packed);
+
+    OCIO_CHECK_CLOSE(packed->m_offset[0], -0.5f, 1e-6f);
+    OCIO_CHECK_CLOSE(packed->m_scale[0], 4.0f, 1e-6f);
+    OCIO_CHECK_CLOSE(packed->m_offset[1], 0.0f, 1e-6f);
+    OCIO_CHECK_CLOSE(packed->m_scale[1], 1.0f, 1e-6f);
+    OCIO_CHECK_CLOSE(packed->m_offset[2], 0.25f, 1e-6f);
+    OCIO_CHECK_CLOSE(packed->m_scale[2], 0.5f, 1e-6f);
+
+    // The decoded values (i.e. the shader program rescaling the sampled values) are within half
+    // of a quantization step of the float values, i.e. at most 2^-13 for the widest range.
+    const size_t numValues = size_t(gridSize) * gridSize * gridSize * 3;
+    for (size_t idx = 0; idx < numValues; ++idx)
+    {
+        const size_t c = idx % 3;
+        const float decoded = float(packed->m_values[idx]) / 65535.0f * packed->m_scale[c]
+                            + packed->m_offset[c];
+        const float tolerance = packed->m_scale[c] / 131070.0f + 1e-6f;
+        OCIO_CHECK_ASSERT(std::abs(decoded - values.get()[idx]) <= tolerance);
+        OCIO_CHECK_ASSERT(tolerance <= 1.0f / 8192.0f);
+    }
+}
+
+OCIO_ADD_TEST(GpuShader, texture_format_unorm16_half_domain)
+{
+    // The half domain LUTs cover the full range of the half float values, which is much too wide
+    // for the normalized integers, so the half float values are used instead.
+
+    auto lut1d = OCIO::Lut1DTransform::Create(65536, true);
+
+    OCIO::ConfigRcPtr config = OCIO::Config::CreateRaw()->createEditableCopy();
+    OCIO::ConstGPUProcessorRcPtr gpu
+        = config->getProcessor(lut1d)->getOptimizedGPUProcessor(OCIO::OPTIMIZATION_NONE);
+
+    OCIO::GpuShaderDescRcPtr unormDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    unormDesc->setTextureFormat(OCIO::GpuShaderCreator::TEXTURE_FORMAT_UNORM16);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(unormDesc));
+    OCIO_CHECK_EQUAL(unormDesc->getTexturePackedFormat(0), OCIO::GpuShaderCreator::TEXTURE_FORMAT_HALF);
+
+    // The sampled values are used as is.
+    const std::string text(unormDesc->getShaderText());
+    OCIO_CHECK_EQUAL(text.find("// Rescale the normalized texture values"), std::string::npos);
+
+    const float * values = nullptr;
+    const uint16_t * packed = nullptr;
+    OCIO_CHECK_NO_THROW(unormDesc->getTextureValues(0, values));
+    OCIO_CHECK_NO_THROW(unormDesc->getTexturePackedValues(0, packed));
+
+    const char * textureName = nullptr;
+    const char * samplerName = nullptr;
+    unsigned width = 0, height = 0;
+    OCIO::GpuShaderDesc::TextureType channel = OCIO::GpuShaderDesc::TEXTURE_RGB_CHANNEL;
+    OCIO::GpuShaderDesc::TextureDimensions dimensions = OCIO::GpuShaderDesc::TEXTURE_2D;
+    OCIO::Interpolation interpolation = OCIO::INTERP_LINEAR;
+    OCIO_CHECK_NO_THROW(unormDesc->getTexture(0, textureName, samplerName, width, height,
+                                              channel, dimensions, interpolation));
+    const size_t numValues = size_t(width) * height
+                           * (channel == OCIO::GpuShaderDesc::TEXTURE_RED_CHANNEL ? 1 : 3);
+
+    // The values of the identity LUT are half float values so they are decoded without any
+    // error, the (sanitized) infinities being clamped to the largest half float values.
+    for (size_t idx = 0; idx < numValues; ++idx)
+    {
+        half decoded;
+        decoded.setBits(packed[idx]);
+        OCIO_CHECK_EQUAL(float(decoded), OCIO::Clamp(values[idx], -HALF_MAX, HALF_MAX));
+    }
+}
+
+OCIO_ADD_TEST(GpuShader, uniform_block)
+{
+    auto ec = OCIO::ExposureContrastTransform::Create();
+    ec->setExposure(1.5);
+    ec->makeExposureDynamic();
+    ec->makeGammaDynamic();
+
+    auto curve = OCIO::GradingRGBCurveTransform::Create(OCIO::GRADING_LOG);
+    curve->makeDynamic();
+
+    auto group = OCIO::GroupTransform::Create();
+    group->appendTransform(ec);
+    group->appendTransform(curve);
+
+    OCIO::ConfigRcPtr config = OCIO::Config::CreateRaw()->createEditableCopy();
+    OCIO::ConstGPUProcessorRcPtr gpu = config->getProcessor(group)->getDefaultGPUProcessor();
+
+    // The uniforms are declared individually by default.
+    {
+        OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+        shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+        OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc));
+
+        OCIO_CHECK_EQUAL(shaderDesc->getUniformBlockSize(), 0);
+        OCIO_CHECK_EQUAL(std::string(shaderDesc->getUniformBlockName()), "");
+        const std::string text(shaderDesc->getShaderText());
+        OCIO_CHECK_NE(text.find("uniform float ocio_exposure_contrast_exposureVal;"),
+                      std::string::npos);
+
+        std::vector<char> buffer(16);
+        OCIO_CHECK_THROW_WHAT(shaderDesc->fillUniformBlock(buffer.data()), OCIO::Exception,
+                              "There is no uniform block.");
+    }
+
+    // The GPU language does not support the uniform block.
+    {
+        OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+        shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_2);
+        shaderDesc->setUseUniformBlock(true);
+        OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc));
+
+        OCIO_CHECK_EQUAL(shaderDesc->getUniformBlockSize(), 0);
+        const std::string text(shaderDesc->getShaderText());
+        OCIO_CHECK_NE(text.find("uniform float ocio_exposure_contrast_exposureVal;"),
+                      std::string::npos);
+    }
+
+    OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+    shaderDesc->setUseUniformBlock(true);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc));
+
+    const std::string text(shaderDesc->getShaderText());
+    OCIO_CHECK_NE(text.find("layout(std140) uniform ocio_uniforms\n{\n"
+                            "  float ocio_exposure_contrast_exposureVal;\n"
+                            "  float ocio_exposure_contrast_gammaVal;\n"
+                            "  int ocio_grading_rgbcurve_knotsOffsets[8];\n"),
+                  std::string::npos);
+    OCIO_CHECK_EQUAL(text.find("uniform float ocio_exposure_contrast_exposureVal;"),
+                     std::string::npos);
+    OCIO_CHECK_EQUAL(std::string(shaderDesc->getUniformBlockName()), "ocio_uniforms");
+
+    // Check the std140 offsets.
+
+    OCIO_REQUIRE_EQUAL(shaderDesc->getNumUniforms(), 7);
+
+    const unsigned maxKnots = OCIO::DynamicPropertyGradingRGBCurveImpl::GetMaxKnots();
+    const unsigned maxCoefs = OCIO::DynamicPropertyGradingRGBCurveImpl::GetMaxCoefs();
+
+    OCIO_CHECK_EQUAL(shaderDesc->getUniformBlockOffset(0), 0);   // Exposure.
+    OCIO_CHECK_EQUAL(shaderDesc->getUniformBlockOffset(1), 4);   // Gamma.
+    OCIO_CHECK_EQUAL(shaderDesc->getUniformBlockOffset(2), 16);  // Knots offsets.
+    OCIO_CHECK_EQUAL(shaderDesc->getUniformBlockOffset(3), 144); // Knots.
+    OCIO_CHECK_EQUAL(shaderDesc->getUniformBlockOffset(4), 144 + 16 * maxKnots);
+    OCIO_CHECK_EQUAL(shaderDesc->getUniformBlockOffset(5), 272 + 16 * maxKnots);
+    OCIO_CHECK_EQUAL(shaderDesc->getUniformBlockOffset(6), 272 + 16 * (maxKnots + maxCoefs));
+    OCIO_CHECK_EQUAL(shaderDesc->getUniformBlockSize(), 288 + 16 * (maxKnots + maxCoefs));
+
+    OCIO_CHECK_THROW_WHAT(shaderDesc->getUniformBlockOffset(7), OCIO::Exception,
+                          "the uniform 7 is not in the uniform block");
+
+    // Check the values.
+
+    std::vector<char> buffer(shaderDesc->getUniformBlockSize());
+    OCIO_CHECK_NO_THROW(shaderDesc->fillUniformBlock(buffer.data()));
+
+    float value = 0.f;
+    std::memcpy(&value, &buffer[0], sizeof(float));
+    OCIO_CHECK_EQUAL(value, 1.5f);
+
+    OCIO::GpuShaderDesc::UniformData data;
+    shaderDesc->getUniform(3, data);
+    OCIO_REQUIRE_ASSERT(data.m_vectorFloat.m_getSize() > 1);
+    std::memcpy(&value, &buffer[144 + 16], sizeof(float));
+    OCIO_CHECK_EQUAL(value, data.m_vectorFloat.m_getVector()[1]);
+
+    shaderDesc->getUniform(6, data);
+    uint32_t bypass = 2;
+    std::memcpy(&bypass, &buffer[shaderDesc->getUniformBlockOffset(6)], sizeof(uint32_t));
+    OCIO_CHECK_EQUAL(bypass, data.m_getBool() ? 1u : 0u);
+
+    // A frame update only needs to fill the buffer again.
+
+    auto dp = shaderDesc->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_EXPOSURE);
+    OCIO::DynamicPropertyDoubleRcPtr exposure = OCIO::DynamicPropertyValue::AsDouble(dp);
+    exposure->setValue(2.0);
+
+    OCIO_CHECK_NO_THROW(shaderDesc->fillUniformBlock(buffer.data()));
+    std::memcpy(&value, &buffer[0], sizeof(float));
+    OCIO_CHECK_EQUAL(value, 2.0f);
+
+    // HLSL uses a cbuffer with the same layout.
+    {
+        OCIO::GpuShaderDescRcPtr hlslDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+        hlslDesc->setLanguage(OCIO::GPU_LANGUAGE_HLSL_DX11);
+        hlslDesc->setUseUniformBlock(true);
+        OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(hlslDesc));
+
+        const std::string hlsl(hlslDesc->getShaderText());
+        OCIO_CHECK_NE(hlsl.find("cbuffer ocio_uniforms\n{\n"
+                                "  float ocio_exposure_contrast_exposureVal : packoffset(c0.x);\n"
+                                "  float ocio_exposure_contrast_gammaVal : packoffset(c0.y);\n"
+                                "  int ocio_grading_rgbcurve_knotsOffsets[8] : packoffset(c1.x);\n"),
+                      std::string::npos);
+        OCIO_CHECK_EQUAL(hlslDesc->getUniformBlockSize(), shaderDesc->getUniformBlockSize());
+    }
+}
+
+OCIO_ADD_TEST(GpuShader, changed_uniforms)
+{
+    auto ec = OCIO::ExposureContrastTransform::Create();
+    ec->makeExposureDynamic();
+    ec->makeGammaDynamic();
+
+    auto curve = OCIO::GradingRGBCurveTransform::Create(OCIO::GRADING_LOG);
+    curve->makeDynamic();
+
+    auto group = OCIO::GroupTransform::Create();
+    group->appendTransform(ec);
+    group->appendTransform(curve);
+
+    OCIO::ConfigRcPtr config = OCIO::Config::CreateRaw()->createEditableCopy();
+    OCIO::ConstGPUProcessorRcPtr gpu = config->getProcessor(group)->getDefaultGPUProcessor();
+
+    OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc));
+    OCIO_REQUIRE_EQUAL(shaderDesc->getNumUniforms(), 7);
+
+    // All the uniforms are changed at the first call.
+
+    OCIO_CHECK_EQUAL(shaderDesc->updateChangedUniforms(), 7);
+    OCIO_CHECK_EQUAL(shaderDesc->getChangedUniform(0), 0);
+    OCIO_CHECK_EQUAL(shaderDesc->getChangedUniform(6), 6);
+
+    // Nothing changed.
+
+    OCIO_CHECK_EQUAL(shaderDesc->updateChangedUniforms(), 0);
+    OCIO_CHECK_THROW_WHAT(shaderDesc->getChangedUniform(0), OCIO::Exception,
+                          "Changed uniforms access error: index = 0 where size = 0");
+
+    // Only the exposure changed.
+
+    auto dp = shaderDesc->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_EXPOSURE);
+    OCIO::DynamicPropertyDoubleRcPtr exposure = OCIO::DynamicPropertyValue::AsDouble(dp);
+    exposure->setValue(2.0);
+
+    OCIO_REQUIRE_EQUAL(shaderDesc->updateChangedUniforms(), 1);
+    OCIO_CHECK_EQUAL(shaderDesc->getChangedUniform(0), 0);
+
+    // Setting the same value again is not a change.
+
+    exposure->setValue(2.0);
+    OCIO_CHECK_EQUAL(shaderDesc->updateChangedUniforms(), 0);
+
+    // A curve edit changes the knots, the coefs, their offsets and the local bypass but not the
+    // exposure & gamma.
+
+    dp = shaderDesc->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_GRADING_RGBCURVE);
+    OCIO::DynamicPropertyGradingRGBCurveRcPtr curveProp
+        = OCIO::DynamicPropertyValue::AsGradingRGBCurve(dp);
+
+    auto identity = OCIO::GradingBSplineCurve::Create({ { 0.f, 0.f }, { 1.f, 1.f } });
+    auto green = OCIO::GradingBSplineCurve::Create({ { 0.f, 0.f }, { 0.5f, 0.7f }, { 1.f, 1.f } });
+    curveProp->setValue(OCIO::GradingRGBCurve::Create(identity, green, identity, identity));
+
+    OCIO_REQUIRE_EQUAL(shaderDesc->updateChangedUniforms(), 5);
+    for (unsigned idx = 0; idx < 5; ++idx)
+    {
+        OCIO_CHECK_EQUAL(shaderDesc->getChangedUniform(idx), idx + 2);
+    }
+    OCIO_CHECK_EQUAL(shaderDesc->updateChangedUniforms(), 0);
+}
+
+namespace
+{
+size_t CountOccurrences(const std::string & text, const std::string & pattern)
+{
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos;
+         pos = text.find(pattern, pos + pattern.size()))
+    {
+        ++count;
+    }
+    return count;
+}
+}
+
+OCIO_ADD_TEST(GpuShader, compact_shader_text)
+{
+    auto curve = OCIO::GradingBSplineCurve::Create({ { 0.1f, 0.15f }, { 0.55f, 0.45f },
+                                                     { 0.9f, 1.1f } });
+    auto curves = OCIO::GradingRGBCurve::Create(curve, curve, curve, curve);
+
+    auto lut1 = OCIO::Lut1DTransform::Create();
+    lut1->setLength(32);
+    lut1->setValue(31, 0.9f, 0.8f, 0.7f);
+    auto lut2 = OCIO::Lut1DTransform::Create();
+    lut2->setLength(32);
+    lut2->setValue(0, 0.1f, 0.2f, 0.3f);
+
+    auto mat = OCIO::MatrixTransform::Create();
+    mat->setOffset(std::array<double, 4>{ 0.1, 0.2, 0.3, 0. }.data());
+
+    // Ops with identical helpers, separated to avoid their combination.
+    auto group = OCIO::GroupTransform::Create();
+    group->appendTransform(lut1);
+    group->appendTransform(mat);
+    group->appendTransform(lut2);
+    group->appendTransform(mat);
+    for (int i = 0; i < 2; ++i)
+    {
+        auto gc = OCIO::GradingRGBCurveTransform::Create(OCIO::GRADING_LIN);
+        gc->setValue(curves);
+        group->appendTransform(gc);
+        group->appendTransform(mat);
+    }
+
+    OCIO::ConfigRcPtr config = OCIO::Config::CreateRaw()->createEditableCopy();
+    OCIO::ConstGPUProcessorRcPtr gpu = config->getProcessor(group)->getDefaultGPUProcessor();
+
+    OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+    shaderDesc->setAllowTexture1D(false);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc));
+    const std::string text(shaderDesc->getShaderText());
+
+    OCIO_CHECK_EQUAL(CountOccurrences(text, "vec2 ocio_lut1d_"), 2);
+    OCIO_CHECK_EQUAL(CountOccurrences(text, "float ocio_grading_rgbcurve_evalBSplineCurve_"), 2);
+
+    OCIO::GpuShaderDescRcPtr compactDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    compactDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+    compactDesc->setAllowTexture1D(false);
+    compactDesc->setCompactShaderText(true);
+    OCIO_CHECK_NE(std::string(compactDesc->getCacheID()), std::string(shaderDesc->getCacheID()));
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(compactDesc));
+    const std::string compact(compactDesc->getShaderText());
+
+    // The identical helpers and constant arrays are only declared once.
+    OCIO_CHECK_EQUAL(CountOccurrences(compact, "vec2 ocio_lut1d_computePos_32_32x1(float f)"), 1);
+    OCIO_CHECK_EQUAL(CountOccurrences(compact, "ocio_lut1d_computePos_32_32x1(outColor.r)"), 2);
+    OCIO_CHECK_EQUAL(CountOccurrences(compact, "float ocio_grading_rgbcurve_evalBSplineCurve_"), 1);
+    OCIO_CHECK_EQUAL(CountOccurrences(compact, "const float ocio_grading_rgbcurve_knots_"), 1);
+
+    // Nothing else than the code.
+    OCIO_CHECK_EQUAL(compact.find("//"), std::string::npos);
+    OCIO_CHECK_EQUAL(compact.find("\n "), std::string::npos);
+    OCIO_CHECK_EQUAL(compact.find("\n\n"), std::string::npos);
+    OCIO_CHECK_LT(compact.size(), text.size());
+
+    // The resources are unchanged.
+    OCIO_CHECK_EQUAL(compactDesc->getNumTextures(), shaderDesc->getNumTextures());
+    OCIO_CHECK_EQUAL(compactDesc->getNumUniforms(), shaderDesc->getNumUniforms());
+}
+
+OCIO_ADD_TEST(GpuShader, compute_kernel)
+{
+    auto lut = OCIO::Lut1DTransform::Create();
+    lut->setLength(32);
+    lut->setValue(31, 0.9f, 0.8f, 0.7f);
+    auto mat = OCIO::MatrixTransform::Create();
+    mat->setOffset(std::array<double, 4>{ 0.1, 0.2, 0.3, 0. }.data());
+
+    auto group = OCIO::GroupTransform::Create();
+    group->appendTransform(lut);
+    group->appendTransform(mat);
+
+    OCIO::ConfigRcPtr config = OCIO::Config::CreateRaw()->createEditableCopy();
+    OCIO::ConstGPUProcessorRcPtr gpu = config->getProcessor(group)->getDefaultGPUProcessor();
+
+    // The default shader program has no kernel.
+    {
+        OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+        shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+        OCIO_CHECK_ASSERT(!shaderDesc->getComputeKernel());
+        OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc));
+
+        const std::string text(shaderDesc->getShaderText());
+        OCIO_CHECK_EQUAL(text.find("void main()"), std::string::npos);
+        OCIO_CHECK_EQUAL(text.find("ocio_inputPixels"), std::string::npos);
+    }
+
+    // The GPU language does not support the compute kernel.
+    {
+        OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+        shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_2);
+        shaderDesc->setComputeKernel(true);
+        OCIO_CHECK_THROW_WHAT(gpu->extractGpuShaderInfo(shaderDesc), OCIO::Exception,
+                              "The compute kernel is not supported for the GPU language "
+                              "'glsl_1.2'.");
+    }
+
+    // GLSL compute shader.
+    {
+        OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+        shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+        const std::string defaultID(shaderDesc->getCacheID());
+
+        shaderDesc->setComputeKernel(true);
+        shaderDesc->setComputeBufferFormats(OCIO::GpuShaderCreator::COMPUTE_BUFFER_RGBA_HALF,
+                                            OCIO::GpuShaderCreator::COMPUTE_BUFFER_RGBA_UINT8);
+        OCIO_CHECK_THROW_WHAT(shaderDesc->setComputeWorkgroupSize(16, 0), OCIO::Exception,
+                              "The compute workgroup size must not be null.");
+        OCIO_CHECK_NO_THROW(shaderDesc->setComputeWorkgroupSize(16, 4));
+        OCIO_CHECK_EQUAL(shaderDesc->getComputeWorkgroupWidth(), 16);
+        OCIO_CHECK_EQUAL(shaderDesc->getComputeWorkgroupHeight(), 4);
+        OCIO_CHECK_NE(std::string(shaderDesc->getCacheID()), defaultID);
+
+        OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc));
+
+        const std::string text(shaderDesc->getShaderText());
+        OCIO_CHECK_NE(text.find("layout(local_size_x = 16, local_size_y = 4) in;"),
+                      std::string::npos);
+        OCIO_CHECK_NE(text.find("layout(std430, binding = 0) readonly buffer ocio_inputBuffer "
+                                "{ uvec2 ocio_inputPixels[]; };"),
+                      std::string::npos);
+        OCIO_CHECK_NE(text.find("layout(std430, binding = 1) writeonly buffer ocio_outputBuffer "
+                                "{ uint ocio_outputPixels[]; };"),
+                      std::string::npos);
+        OCIO_CHECK_NE(text.find("uniform uvec2 ocio_imageSize;"), std::string::npos);
+        OCIO_CHECK_NE(text.find("return vec4(unpackHalf2x16(pixel.x), unpackHalf2x16(pixel.y));"),
+                      std::string::npos);
+        OCIO_CHECK_NE(text.find("return packUnorm4x8(pixel);"), std::string::npos);
+
+        // The kernel calls the OCIO function so, it follows it.
+        const size_t mainPos = text.find("void main()");
+        OCIO_REQUIRE_ASSERT(mainPos != std::string::npos);
+        OCIO_CHECK_LT(text.find("vec4 OCIOMain(vec4 inPixel)"), mainPos);
+        OCIO_CHECK_NE(text.find("ocio_outputPixels[index] = "
+                                "ocio_packPixel(OCIOMain(ocio_unpackPixel(ocio_inputPixels[index])));"),
+                      std::string::npos);
+
+        // The LUT texture is still declared.
+        OCIO_CHECK_EQUAL(shaderDesc->getNumTextures(), 1);
+    }
+
+    // HLSL compute shader.
+    {
+        OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+        shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_HLSL_DX11);
+        shaderDesc->setComputeKernel(true);
+        shaderDesc->setComputeBufferFormats(OCIO::GpuShaderCreator::COMPUTE_BUFFER_RGBA_FLOAT32,
+                                            OCIO::GpuShaderCreator::COMPUTE_BUFFER_RGBA_UINT16);
+        OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc));
+
+        const std::string text(shaderDesc->getShaderText());
+        OCIO_CHECK_NE(text.find("StructuredBuffer<float4> ocio_inputPixels;"), std::string::npos);
+        OCIO_CHECK_NE(text.find("RWStructuredBuffer<uint2> ocio_outputPixels;"), std::string::npos);
+        OCIO_CHECK_NE(text.find("uint4 c = uint4(round(saturate(pixel) * 65535.0));"),
+                      std::string::npos);
+        OCIO_CHECK_NE(text.find("[numthreads(8, 8, 1)]\n"
+                                "void OCIOMainKernel(uint3 id : SV_DispatchThreadID)"),
+                      std::string::npos);
+
+        // Sample() is not available to the compute shaders.
+        OCIO_CHECK_NE(text.find(".SampleLevel("), std::string::npos);
+        OCIO_CHECK_EQUAL(text.find(".Sample("), std::string::npos);
+    }
+}
+
 OCIO_ADD_TEST(GpuShader, MetalLutTest)
 {
     static constexpr char sFromSpace[] = "ACEScg";
@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#include "TransformHash.cpp"
+
+#include "testutils/UnitTest.h"
+
+namespace OCIO = OCIO_NAMESPACE;
+
+
+OCIO_ADD_TEST(TransformHash, basic)
+{
+    OCIO::MatrixTransformRcPtr mat1 = OCIO::MatrixTransform::Create();
+    const double offset[4] = { 0.1, 0.2, 0.3, 0.0 };
+    mat1->setOffset(offset);
+
+    // Same values means same hash, whatever the instance is.
+
+    OCIO::MatrixTransformRcPtr mat2
+        = OCIO::DynamicPtrCast<OCIO::MatrixTransform>(mat1->createEditableCopy());
+    OCIO_CHECK_EQUAL(OCIO::GetTransformHash(*mat1), OCIO::GetTransformHash(*mat2));
+
+    // The format metadata are not part of the hash.
+
+    mat2->getFormatMetadata().addAttribute("name", "some name");
+    OCIO_CHECK_EQUAL(OCIO::GetTransformHash(*mat1), OCIO::GetTransformHash(*mat2));
+
+    // But the direction is.
+
+    mat2->setDirection(OCIO::TRANSFORM_DIR_INVERSE);
+    OCIO_CHECK_NE(OCIO::GetTransformHash(*mat1), OCIO::GetTransformHash(*mat2));
+    mat2->setDirection(OCIO::TRANSFORM_DIR_FORWARD);
+
+    // And the values.
+
+    const double offset2[4] = { 0.1, 0.2, 0.3, 0.4 };
+    mat2->setOffset(offset2);
+    OCIO_CHECK_NE(OCIO::GetTransformHash(*mat1), OCIO::GetTransformHash(*mat2));
+
+    // Two transform types with similar values have different hashes.
+
+    OCIO::LogTransformRcPtr log = OCIO::LogTransform::Create();
+    OCIO::ExponentTransformRcPtr exp = OCIO::ExponentTransform::Create();
+    OCIO_CHECK_NE(OCIO::GetTransformHash(*log), OCIO::GetTransformHash(*exp));
+}
+
+OCIO_ADD_TEST(TransformHash, strings)
+{
+    OCIO::ColorSpaceTransformRcPtr cst1 = OCIO::ColorSpaceTransform::Create();
+    cst1->setSrc("ab");
+    cst1->setDst("c");
+
+    OCIO::ColorSpaceTransformRcPtr cst2 = OCIO::ColorSpaceTransform::Create();
+    cst2->setSrc("a");
+    cst2->setDst("bc");
+
+    // The string boundaries are part of the hash.
+    OCIO_CHECK_NE(OCIO::GetTransformHash(*cst1), OCIO::GetTransformHash(*cst2));
+
+    cst2->setSrc("ab");
+    cst2->setDst("c");
+    OCIO_CHECK_EQUAL(OCIO::GetTransformHash(*cst1), OCIO::GetTransformHash(*cst2));
+
+    cst2->setDataBypass(false);
+    OCIO_CHECK_NE(OCIO::GetTransformHash(*cst1), OCIO::GetTransformHash(*cst2));
+}
+
+OCIO_ADD_TEST(TransformHash, lut_values)
+{
+    // The LUT values are fully part of the hash, not only their range.
+
+    OCIO::Lut3DTransformRcPtr lut1 = OCIO::Lut3DTransform::Create(2);
+    OCIO::TransformRcPtr lut2 = lut1->createEditableCopy();
+    OCIO_CHECK_EQUAL(OCIO::GetTransformHash(*lut1), OCIO::GetTransformHash(*lut2));
+
+    // Swap two entries: the min & max values are unchanged.
+    float r0 = 0.f, g0 = 0.f, b0 = 0.f;
+    float r1 = 0.f, g1 = 0.f, b1 = 0.f;
+    lut1->getValue(0, 0, 0, r0, g0, b0);
+    lut1->getValue(1, 1, 1, r1, g1, b1);
+    auto lut3d2 = OCIO::DynamicPtrCast<OCIO::Lut3DTransform>(lut2);
+    lut3d2->setValue(0, 0, 0, r1, g1, b1);
+    lut3d2->setValue(1, 1, 1, r0, g0, b0);
+    OCIO_CHECK_NE(OCIO::GetTransformHash(*lut1), OCIO::GetTransformHash(*lut2));
+
+    OCIO::Lut1DTransformRcPtr lut1d1 = OCIO::Lut1DTransform::Create(16, false);
+    OCIO::TransformRcPtr lut1d2 = lut1d1->createEditableCopy();
+    OCIO_CHECK_EQUAL(OCIO::GetTransformHash(*lut1d1), OCIO::GetTransformHash(*lut1d2));
+    OCIO::DynamicPtrCast<OCIO::Lut1DTransform>(lut1d2)->setValue(3, 0.5f, 0.5f, 0.5f);
+    OCIO_CHECK_NE(OCIO::GetTransformHash(*lut1d1), OCIO::GetTransformHash(*lut1d2));
+
+    // The hash of the LUT values is cached but any later change must still be detected.
+
+    const auto lut1Hash = OCIO::GetTransformHash(*lut1);
+    lut1->setValue(0, 0, 0, r1, g1, b1);
+    lut1->setValue(1, 1, 1, r0, g0, b0);
+    OCIO_CHECK_NE(lut1Hash, OCIO::GetTransformHash(*lut1));
+    OCIO_CHECK_EQUAL(OCIO::GetTransformHash(*lut1), OCIO::GetTransformHash(*lut2));
+
+    const auto lut1d1Hash = OCIO::GetTransformHash(*lut1d1);
+    lut1d1->setValue(3, 0.5f, 0.5f, 0.5f);
+    OCIO_CHECK_NE(lut1d1Hash, OCIO::GetTransformHash(*lut1d1));
+    OCIO_CHECK_EQUAL(OCIO::GetTransformHash(*lut1d1), OCIO::GetTransformHash(*lut1d2));
+}
+
+OCIO_ADD_TEST(TransformHash, group)
+{
+    OCIO::GroupTransformRcPtr group1 = OCIO::GroupTransform::Create();
+    group1->appendTransform(OCIO::MatrixTransform::Create());
+    OCIO::ExponentTransformRcPtr exp = OCIO::ExponentTransform::Create();
+    group1->appendTransform(exp);
+
+    // Two groups with equal (but distinct) nested transforms have the same hash.
+    OCIO::GroupTransformRcPtr group2 = OCIO::GroupTransform::Create();
+    group2->appendTransform(OCIO::MatrixTransform::Create());
+    group2->appendTransform(OCIO::ExponentTransform::Create());
+    OCIO_CHECK_EQUAL(OCIO::GetTransformHash(*group1), OCIO::GetTransformHash(*group2));
+
+    // A change in a nested transform changes the hash of the group.
+
+    const double values[4] = { 2., 2., 2., 1. };
+    exp->setValue(values);
+    OCIO_CHECK_NE(OCIO::GetTransformHash(*group1), OCIO::GetTransformHash(*group2));
+
+    // The order of the nested transforms is part of the hash.
+
+    OCIO::GroupTransformRcPtr group3 = OCIO::GroupTransform::Create();
+    group3->appendTransform(exp);
+    group3->appendTransform(OCIO::MatrixTransform::Create());
+    OCIO_CHECK_NE(OCIO::GetTransformHash(*group1), OCIO::GetTransformHash(*group3));
+}
+
+OCIO_ADD_TEST(TransformHash, processor_cache)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::CreateRaw()->createEditableCopy();
+
+    // Two Lut3D transforms with the same value range must not share a processor.
+
+    OCIO::Lut3DTransformRcPtr lut1 = OCIO::Lut3DTransform::Create(2);
+    OCIO::Lut3DTransformRcPtr lut2 = OCIO::DynamicPtrCast<OCIO::Lut3DTransform>(
+        lut1->createEditableCopy());
+    lut2->setValue(0, 0, 0, 1.f, 1.f, 1.f);
+    lut2->setValue(1, 1, 1, 0.f, 0.f, 0.f);
+
+    OCIO::ConstProcessorRcPtr proc1 = config->getProcessor(lut1);
+    OCIO::ConstProcessorRcPtr proc2 = config->getProcessor(lut2);
+    OCIO_CHECK_NE(proc1.get(), proc2.get());
+    OCIO_CHECK_NE(std::string(proc1->getCacheID()), std::string(proc2->getCacheID()));
+
+    // An identical transform hits the cache.
+
+    OCIO::ConstProcessorRcPtr proc3 = config->getProcessor(lut1->createEditableCopy());
+    OCIO_CHECK_EQUAL(proc1.get(), proc3.get());
+
+    // The same transform instance hits the cache, until it is changed.
+
+    OCIO_CHECK_EQUAL(proc1.get(), config->getProcessor(lut1).get());
+    lut1->setValue(0, 0, 0, 1.f, 1.f, 1.f);
+    lut1->setValue(1, 1, 1, 0.f, 0.f, 0.f);
+    OCIO_CHECK_EQUAL(proc2.get(), config->getProcessor(lut1).get());
+
+    // A different context with the same used variables shares the processor.
+
+    OCIO::ContextRcPtr context = config->getCurrentContext()->createEditableCopy();
+    context->setStringVar("UNUSED_VAR", "value");
+    OCIO_CHECK_EQUAL(proc2.get(), config->getProcessor(context, lut1,
+                                                       OCIO::TRANSFORM_DIR_FORWARD).get());
+}
@@ -399,6 +399,88 @@ OCIO_ADD_TEST(BuiltinConfigs, create_builtin_config)
     }
 }
 
+OCIO_ADD_TEST(BuiltinConfigs, parsed_once)
+{
+    // A built-in config is only parsed once, each call returns a copy sharing the config elements.
+
+    OCIO::ConstConfigRcPtr config1;
+    OCIO_CHECK_NO_THROW(config1 = OCIO::Config::CreateFromBuiltinConfig("default"));
+    OCIO::ConstConfigRcPtr config2;
+    OCIO_CHECK_NO_THROW(config2 = OCIO::Config::CreateFromFile("ocio://default"));
+    OCIO_REQUIRE_ASSERT(config1);
+    OCIO_REQUIRE_ASSERT(config2);
+
+    OCIO_CHECK_NE(config1.get(), config2.get());
+    OCIO_CHECK_NE(config1->getCurrentContext().get(), config2->getCurrentContext().get());
+    OCIO_CHECK_EQUAL(std::string(config1->getCacheID()), std::string(config2->getCacheID()));
+
+    const char * csName = config1->getColorSpaceNameByIndex(0);
+    OCIO_CHECK_EQUAL(config1->getColorSpace(csName).get(), config2->getColorSpace(csName).get());
+
+    // Editing a copy does not change the other ones.
+    OCIO::ConfigRcPtr config3 = OCIO::Config::CreateFromBuiltinConfig("default")->createEditableCopy();
+    OCIO::ColorSpaceRcPtr cs = config3->getColorSpace(csName)->createEditableCopy();
+    cs->setDescription("edited");
+    config3->addColorSpace(cs);
+    OCIO_CHECK_EQUAL(std::string(config3->getColorSpace(csName)->getDescription()), "edited");
+
+    OCIO::ConstConfigRcPtr config4 = OCIO::Config::CreateFromBuiltinConfig("default");
+    OCIO_CHECK_EQUAL(config4->getColorSpace(csName).get(), config1->getColorSpace(csName).get());
+    OCIO_CHECK_EQUAL(std::string(config4->getCacheID()), std::string(config1->getCacheID()));
+
+    // Flushing the caches parses the config again.
+    OCIO::ClearAllCaches();
+    OCIO::ConstConfigRcPtr config5 = OCIO::Config::CreateFromBuiltinConfig("default");
+    OCIO_CHECK_NE(config5->getColorSpace(csName).get(), config1->getColorSpace(csName).get());
+    OCIO_CHECK_EQUAL(std::string(config5->getCacheID()), std::string(config1->getCacheID()));
+}
+
+OCIO_ADD_TEST(BuiltinConfigs, parsed_once_env_overrides)
+{
+    // The copies of the parsed config must reflect the current active displays & views and the
+    // inactive color spaces env. variables.
+
+    const auto countActiveColorSpaces = [](const OCIO::ConstConfigRcPtr & config)
+    {
+        return config->getNumColorSpaces(OCIO::SEARCH_REFERENCE_SPACE_ALL,
+                                         OCIO::COLORSPACE_ACTIVE);
+    };
+
+    OCIO::ConstConfigRcPtr config1 = OCIO::Config::CreateFromBuiltinConfig("default");
+    OCIO_CHECK_EQUAL(config1->getNumDisplays(), 6);
+    OCIO_CHECK_EQUAL(config1->getNumViews("sRGB - Display"), 3);
+    OCIO_CHECK_NE(config1->getIndexForColorSpace("ACEScg"), -1);
+    OCIO_CHECK_EQUAL(config1->getIndexForColorSpace("CIE-XYZ-D65"), -1);
+    const int numActiveColorSpaces = countActiveColorSpaces(config1);
+
+    {
+        OCIO::EnvironmentVariableGuard displays("OCIO_ACTIVE_DISPLAYS", "sRGB - Display");
+        OCIO::EnvironmentVariableGuard views("OCIO_ACTIVE_VIEWS", "Raw");
+        OCIO::EnvironmentVariableGuard inactive("OCIO_INACTIVE_COLORSPACES", "ACEScg");
+
+        OCIO::ConstConfigRcPtr config2 = OCIO::Config::CreateFromBuiltinConfig("default");
+        OCIO_CHECK_EQUAL(config2->getNumDisplays(), 1);
+        OCIO_CHECK_EQUAL(std::string(config2->getDisplay(0)), "sRGB - Display");
+        OCIO_CHECK_EQUAL(config2->getNumViews("sRGB - Display"), 1);
+        OCIO_CHECK_EQUAL(std::string(config2->getView("sRGB - Display", 0)), "Raw");
+
+        // The env. variable supersedes the inactive color spaces of the config.
+        OCIO_CHECK_EQUAL(config2->getIndexForColorSpace("ACEScg"), -1);
+        OCIO_CHECK_NE(config2->getIndexForColorSpace("CIE-XYZ-D65"), -1);
+        OCIO_CHECK_NE(std::string(config2->getCacheID()), std::string(config1->getCacheID()));
+
+        // The existing copies are unchanged.
+        OCIO_CHECK_EQUAL(config1->getNumDisplays(), 6);
+        OCIO_CHECK_EQUAL(countActiveColorSpaces(config1), numActiveColorSpaces);
+    }
+
+    OCIO::ConstConfigRcPtr config3 = OCIO::Config::CreateFromBuiltinConfig("default");
+    OCIO_CHECK_EQUAL(config3->getNumDisplays(), 6);
+    OCIO_CHECK_EQUAL(config3->getNumViews("sRGB - Display"), 3);
+    OCIO_CHECK_EQUAL(countActiveColorSpaces(config3), numActiveColorSpaces);
+    OCIO_CHECK_EQUAL(std::string(config3->getCacheID()), std::string(config1->getCacheID()));
+}
+
 OCIO_ADD_TEST(BuiltinConfigs, resolve_config_path)
 {
     OCIO_CHECK_EQUAL(
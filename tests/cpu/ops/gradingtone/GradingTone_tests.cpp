@@ -2,6 +2,8 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 
+#include <cstring>
+
 #include "ops/gradingtone/GradingTone.cpp"
 
 #include "testutils/UnitTest.h"
@@ -116,3 +118,101 @@ OCIO_ADD_TEST(GradingTone, validate)
     OCIO_CHECK_THROW_WHAT(tone.validate(), OCIO::Exception, "is above upper bound");
     tone.m_scontrast = temp;
 }
+
+namespace
+{
+void CheckSamePreRender(const OCIO::GradingTonePreRender & computed,
+                        const OCIO::GradingTonePreRender & expected,
+                        unsigned line)
+{
+    OCIO_CHECK_EQUAL_FROM(computed.m_localBypass, expected.m_localBypass, line);
+    if (expected.m_localBypass) return;
+
+    OCIO_CHECK_EQUAL_FROM(computed.m_shadowsStart, expected.m_shadowsStart, line);
+    OCIO_CHECK_EQUAL_FROM(computed.m_shadowsWidth, expected.m_shadowsWidth, line);
+    OCIO_CHECK_EQUAL_FROM(computed.m_highlightsStart, expected.m_highlightsStart, line);
+    OCIO_CHECK_EQUAL_FROM(computed.m_highlightsWidth, expected.m_highlightsWidth, line);
+    OCIO_CHECK_EQUAL_FROM(computed.m_blacksStart, expected.m_blacksStart, line);
+    OCIO_CHECK_EQUAL_FROM(computed.m_blacksWidth, expected.m_blacksWidth, line);
+    OCIO_CHECK_EQUAL_FROM(computed.m_whitesStart, expected.m_whitesStart, line);
+    OCIO_CHECK_EQUAL_FROM(computed.m_whitesWidth, expected.m_whitesWidth, line);
+
+#define CHECK_SAME_ARRAY(member) \
+    OCIO_CHECK_ASSERT_FROM(std::memcmp(computed.member, expected.member, \
+                                       sizeof(expected.member)) == 0, line)
+
+    CHECK_SAME_ARRAY(m_midX);
+    CHECK_SAME_ARRAY(m_midY);
+    CHECK_SAME_ARRAY(m_midM);
+    CHECK_SAME_ARRAY(m_hsX);
+    CHECK_SAME_ARRAY(m_hsY);
+    CHECK_SAME_ARRAY(m_hsM);
+    CHECK_SAME_ARRAY(m_wbX);
+    CHECK_SAME_ARRAY(m_wbY);
+    CHECK_SAME_ARRAY(m_wbM);
+    CHECK_SAME_ARRAY(m_wbGain);
+    CHECK_SAME_ARRAY(m_scX);
+    CHECK_SAME_ARRAY(m_scY);
+    CHECK_SAME_ARRAY(m_scM);
+
+#undef CHECK_SAME_ARRAY
+}
+}
+
+OCIO_ADD_TEST(GradingTone, pre_render_incremental_update)
+{
+    // Only the constants depending on the edited controls are recomputed, the result must be
+    // the same as a full computation.
+
+    OCIO::GradingTone tone{ OCIO::GRADING_LOG };
+    OCIO::GradingTonePreRender pre{ OCIO::GRADING_LOG };
+    OCIO::GradingTonePreRender full{ OCIO::GRADING_LOG };
+
+    auto checkUpdate = [&pre, &full](const OCIO::GradingTone & value, unsigned line)
+    {
+        pre.update(value);
+
+        // A style change forces a full computation. Note that the constants of the identity
+        // channels are not computed (nor used), so both have to follow the same edits.
+        full.setStyle(OCIO::GRADING_LIN);
+        full.setStyle(OCIO::GRADING_LOG);
+        full.update(value);
+
+        CheckSamePreRender(pre, full, line);
+    };
+
+    tone.m_midtones.m_red = 1.2;
+    checkUpdate(tone, __LINE__);
+
+    tone.m_highlights.m_master = 0.8;
+    checkUpdate(tone, __LINE__);
+
+    tone.m_whites.m_green = 1.3;
+    checkUpdate(tone, __LINE__);
+
+    tone.m_shadows.m_start = 0.6;
+    checkUpdate(tone, __LINE__);
+
+    tone.m_blacks.m_blue = 0.9;
+    checkUpdate(tone, __LINE__);
+
+    tone.m_scontrast = 1.4;
+    checkUpdate(tone, __LINE__);
+
+    tone.m_midtones.m_red = 1.;
+    tone.m_whites.m_green = 1.1;
+    checkUpdate(tone, __LINE__);
+
+    // Back to identity then a single edit.
+    checkUpdate(OCIO::GradingTone{ OCIO::GRADING_LOG }, __LINE__);
+    tone.m_midtones.m_red = 0.7;
+    checkUpdate(tone, __LINE__);
+
+    // A style change recomputes everything.
+    pre.setStyle(OCIO::GRADING_LIN);
+    pre.update(tone);
+
+    full.setStyle(OCIO::GRADING_LIN);
+    full.update(tone);
+    CheckSamePreRender(pre, full, __LINE__);
+}
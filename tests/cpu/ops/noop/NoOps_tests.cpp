@@ -4,6 +4,7 @@
 
 #include "ops/noop/NoOps.cpp"
 
+#include "ops/exposurecontrast/ExposureContrastOp.h"
 #include "ops/lut1d/Lut1DOp.h"
 #include "ops/matrix/MatrixOp.h"
 #include "testutils/UnitTest.h"
@@ -344,3 +345,100 @@ OCIO_ADD_TEST(NoOps, look_op)
     OCIO_CHECK_EQUAL(clonedOp->supportedByLegacyShader(), true);
 }
 
+namespace
+{
+// Apply the ops one after the other to the whole lattice.
+std::vector<float> ProcessLatticeSerially(const OCIO::OpRcPtrVec & ops, unsigned edgelen)
+{
+    const long numPixels = long(edgelen) * edgelen * edgelen;
+
+    std::vector<float> lattice(numPixels * 4);
+    OCIO::GenerateIdentityLut3D(lattice.data(), edgelen, 4, OCIO::LUT3DORDER_FAST_BLUE);
+    for (const auto & op : ops)
+    {
+        op->apply(lattice.data(), lattice.data(), numPixels);
+    }
+    return lattice;
+}
+
+// Note that the SIMD & scalar code paths process different pixels when the image is split.
+void CheckLut3D(const OCIO::OpRcPtrVec & lutOps, const std::vector<float> & lattice)
+{
+    OCIO_REQUIRE_EQUAL(lutOps.size(), 1);
+    OCIO::ConstOpRcPtr op = lutOps[0];
+    auto lut = OCIO::DynamicPtrCast<const OCIO::Lut3DOpData>(op->data());
+    OCIO_REQUIRE_ASSERT(lut);
+
+    const auto & values = lut->getArray().getValues();
+    OCIO_REQUIRE_EQUAL(values.size(), lattice.size() / 4 * 3);
+    for (size_t idx = 0; idx < values.size() / 3; ++idx)
+    {
+        OCIO_CHECK_CLOSE(values[3 * idx + 0], lattice[4 * idx + 0], 1e-6f);
+        OCIO_CHECK_CLOSE(values[3 * idx + 1], lattice[4 * idx + 1], 1e-6f);
+        OCIO_CHECK_CLOSE(values[3 * idx + 2], lattice[4 * idx + 2], 1e-6f);
+    }
+}
+} // anon.
+
+OCIO_ADD_TEST(NoOps, create_3d_lut)
+{
+    OCIO::OpRcPtrVec ops;
+    CreateGenericScaleOp(ops);
+    CreateGenericLutOp(ops);
+
+    auto ec = std::make_shared<OCIO::ExposureContrastOpData>(
+        OCIO::ExposureContrastOpData::STYLE_LINEAR);
+    ec->setExposure(0.5);
+    ec->getExposureProperty()->makeDynamic();
+    OCIO::CreateExposureContrastOp(ops, ec, OCIO::TRANSFORM_DIR_FORWARD);
+
+    OCIO_CHECK_NO_THROW(ops.finalize());
+    OCIO_REQUIRE_EQUAL(ops.size(), 3);
+
+    OCIO::ClearLatticeCaches();
+
+    // The edge length is large enough to use several threads.
+    const unsigned edgelen = 33;
+    OCIO_REQUIRE_ASSERT(edgelen >= OCIO::MinParallelEdgeLen);
+
+    OCIO::OpRcPtrVec lutOps = OCIO::Create3DLut(ops, edgelen);
+    CheckLut3D(lutOps, ProcessLatticeSerially(ops, edgelen));
+
+    // Only the lattice processed by the static ops is cached.
+    if (OCIO::g_latticeCache.isEnabled())
+    {
+        OCIO::AutoMutex guard(OCIO::g_latticeCache.lock());
+        OCIO_CHECK_EQUAL(OCIO::g_latticeCache.size(), 1);
+    }
+
+    // Changing the dynamic value only applies the dynamic op again.
+    auto dp = ops[2]->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_EXPOSURE);
+    OCIO::DynamicPropertyValue::AsDouble(dp)->setValue(-1.5);
+
+    lutOps = OCIO::Create3DLut(ops, edgelen);
+    CheckLut3D(lutOps, ProcessLatticeSerially(ops, edgelen));
+
+    if (OCIO::g_latticeCache.isEnabled())
+    {
+        OCIO::AutoMutex guard(OCIO::g_latticeCache.lock());
+        OCIO_CHECK_EQUAL(OCIO::g_latticeCache.size(), 1);
+    }
+
+    // A small lattice is processed by the calling thread.
+    lutOps = OCIO::Create3DLut(ops, 5);
+    CheckLut3D(lutOps, ProcessLatticeSerially(ops, 5));
+
+    // The host could disable the threads of the library.
+    OCIO::SetMaxThreads(1);
+    OCIO_CHECK_EQUAL(OCIO::GetMaxThreads(), 1u);
+    OCIO::ClearLatticeCaches();
+    lutOps = OCIO::Create3DLut(ops, edgelen);
+    CheckLut3D(lutOps, ProcessLatticeSerially(ops, edgelen));
+    OCIO::SetMaxThreads(0);
+
+    OCIO::ClearLatticeCaches();
+    {
+        OCIO::AutoMutex guard(OCIO::g_latticeCache.lock());
+        OCIO_CHECK_EQUAL(OCIO::g_latticeCache.size(), 0);
+    }
+}
@@ -90,6 +90,64 @@ OCIO_ADD_TEST(Builtins, aces)
     }
 }
 
+OCIO_ADD_TEST(Builtins, ops_cache)
+{
+    // The ops of a built-in transform are only generated once.
+
+    OCIO::BuiltinTransformRegistryImpl registry;
+
+    int numCalls = 0;
+    auto Creator = [&numCalls](OCIO::OpRcPtrVec & ops)
+    {
+        ++numCalls;
+
+        OCIO::Lut1DOpDataRcPtr lut = std::make_shared<OCIO::Lut1DOpData>(1024);
+        OCIO::CreateLut1DOp(ops, lut, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateIdentityMatrixOp(ops);
+    };
+    OCIO_CHECK_NO_THROW(registry.addBuiltin("trans1", nullptr, Creator));
+
+    OCIO::OpRcPtrVec ops1;
+    OCIO_CHECK_NO_THROW(registry.createOps(0, ops1));
+    OCIO::OpRcPtrVec ops2;
+    OCIO_CHECK_NO_THROW(registry.createOps(0, ops2));
+    OCIO_CHECK_EQUAL(numCalls, 1);
+
+    OCIO_REQUIRE_EQUAL(ops1.size(), 2);
+    OCIO_REQUIRE_EQUAL(ops2.size(), 2);
+
+    // The ops are distinct instances but the LUT data is shared.
+    OCIO_CHECK_NE(ops1[0].get(), ops2[0].get());
+    OCIO::ConstOpRcPtr op1 = ops1[0];
+    OCIO::ConstOpRcPtr op2 = ops2[0];
+    OCIO_CHECK_EQUAL(op1->data().get(), op2->data().get());
+    OCIO_CHECK_NE(ops1[1].get(), ops2[1].get());
+    op1 = ops1[1];
+    op2 = ops2[1];
+    OCIO_CHECK_NE(op1->data().get(), op2->data().get());
+    OCIO_CHECK_EQUAL(ops1[1]->getCacheID(), ops2[1]->getCacheID());
+
+    // The inverse is built from the generated ops.
+    OCIO::OpRcPtrVec ops3 = ops2.invert();
+    OCIO_REQUIRE_EQUAL(ops3.size(), 2);
+    OCIO::ConstOpRcPtr op3 = ops3[1];
+    op2 = ops2[0];
+    OCIO_CHECK_NE(op3->data().get(), op2->data().get());
+    OCIO_CHECK_NO_THROW(ops3.finalize());
+    auto lut = OCIO::DynamicPtrCast<const OCIO::Lut1DOpData>(op2->data());
+    OCIO_REQUIRE_ASSERT(lut);
+    OCIO_CHECK_EQUAL(lut->getDirection(), OCIO::TRANSFORM_DIR_FORWARD);
+
+    // Replacing the built-in transform flushes its ops.
+    OCIO_CHECK_NO_THROW(registry.addBuiltin("trans1", nullptr, Creator));
+    OCIO_CHECK_NO_THROW(registry.createOps(0, ops1));
+    OCIO_CHECK_EQUAL(numCalls, 2);
+
+    registry.clearCaches();
+    OCIO_CHECK_NO_THROW(registry.createOps(0, ops1));
+    OCIO_CHECK_EQUAL(numCalls, 3);
+}
+
 OCIO_ADD_TEST(Builtins, read_write)
 {
     // The unit test validates the read/write and the processor creation for all the existing
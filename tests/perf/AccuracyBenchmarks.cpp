@@ -0,0 +1,492 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "Benchmarks.h"
+#include "BitDepthUtils.h"
+#include "CPUInfo.h"
+#include "CPUProcessor.h"
+
+namespace OCIO = OCIO_NAMESPACE;
+
+
+namespace
+{
+
+// The fixed seed of the stratified input sets so that all the runs process the same pixels.
+constexpr unsigned RandomSeed = 20240815;
+
+// The relative errors are computed against max(|reference|, MinRelativeDenominator) i.e. the
+// smallest normal half value, to not report huge relative errors around zero.
+constexpr double MinRelativeDenominator = 6.103515625e-05;
+
+// A dense RGBA F32 input set and the input bit-depths to process it with.
+struct InputSet
+{
+    std::string m_name;
+    std::vector<float> m_pixels;
+    std::vector<OCIO::BitDepth> m_bitDepths;
+};
+
+void AddPixel(std::vector<float> & pixels, float r, float g, float b)
+{
+    pixels.push_back(r);
+    pixels.push_back(g);
+    pixels.push_back(b);
+    pixels.push_back(1.0f);
+}
+
+// All the half values (including the Inf & NaN ones) where each channel starts at a different
+// offset so that the pixels are not neutral.
+InputSet CreateHalfSet()
+{
+    std::vector<float> values(65536);
+    for (size_t idx = 0; idx < values.size(); ++idx)
+    {
+        half value;
+        value.setBits(static_cast<unsigned short>(idx));
+        values[idx] = float(value);
+    }
+
+    InputSet set{ "half", {}, { OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F16 } };
+    for (size_t idx = 0; idx < values.size(); ++idx)
+    {
+        AddPixel(set.m_pixels,
+                 values[idx],
+                 values[(idx + 21845) % values.size()],
+                 values[(idx + 43690) % values.size()]);
+    }
+    return set;
+}
+
+// All the combinations of the edge case values e.g. signed zeros, denormals, the limits of the
+// half & float types, the values around one, Inf & NaN.
+InputSet CreateEdgeSet()
+{
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    const std::vector<float> values
+        = { 0.0f, -0.0f,
+            std::numeric_limits<float>::denorm_min(), -std::numeric_limits<float>::denorm_min(),
+            std::numeric_limits<float>::min(), -std::numeric_limits<float>::min(),
+            5.96046448e-08f, -5.96046448e-08f,    // Smallest half denormal.
+            6.10351562e-05f, -6.10351562e-05f,    // Smallest half normal.
+            0.18f, -0.18f, 0.5f,
+            1.0f - std::numeric_limits<float>::epsilon(), 1.0f,
+            1.0f + std::numeric_limits<float>::epsilon(), -1.0f,
+            2.0f, 100.0f,
+            65504.0f, -65504.0f,                  // Largest half.
+            1e10f, -1e10f,
+            std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(),
+            inf, -inf, nan };
+
+    InputSet set{ "edges", {}, { OCIO::BIT_DEPTH_F32 } };
+    for (const float r : values)
+    {
+        for (const float g : values)
+        {
+            for (const float b : values)
+            {
+                AddPixel(set.m_pixels, r, g, b);
+            }
+        }
+    }
+    return set;
+}
+
+// A regular grid of the [0, 1] RGB cube i.e. hitting the LUT nodes and the values in between.
+InputSet CreateUnitSet()
+{
+    constexpr int gridSize = 65;
+
+    InputSet set{ "unit",
+                  {},
+                  { OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_UINT16,
+                    OCIO::BIT_DEPTH_UINT10, OCIO::BIT_DEPTH_UINT8 } };
+
+    for (int r = 0; r < gridSize; ++r)
+    {
+        for (int g = 0; g < gridSize; ++g)
+        {
+            for (int b = 0; b < gridSize; ++b)
+            {
+                AddPixel(set.m_pixels,
+                         float(r) / (gridSize - 1),
+                         float(g) / (gridSize - 1),
+                         float(b) / (gridSize - 1));
+            }
+        }
+    }
+    return set;
+}
+
+// Signed values stratified by powers of two from 2^-14 to 2^17, plus zero, where each value is
+// randomly placed in its stratum.
+InputSet CreateHdrSet()
+{
+    constexpr int minExponent = -14;
+    constexpr int maxExponent = 16;
+
+    std::vector<std::pair<float, int>> strata{ { 0.0f, 0 } };
+    for (int exponent = minExponent; exponent <= maxExponent; ++exponent)
+    {
+        strata.push_back({  1.0f, exponent });
+        strata.push_back({ -1.0f, exponent });
+    }
+
+    std::mt19937 generator(RandomSeed);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    auto getValue = [&](const std::pair<float, int> & stratum) -> float
+    {
+        return stratum.first * std::exp2(float(stratum.second) + dist(generator));
+    };
+
+    InputSet set{ "hdr", {}, { OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F16 } };
+    for (const auto & r : strata)
+    {
+        for (const auto & g : strata)
+        {
+            for (const auto & b : strata)
+            {
+                const float rv = getValue(r);
+                const float gv = getValue(g);
+                const float bv = getValue(b);
+                AddPixel(set.m_pixels, rv, gv, bv);
+            }
+        }
+    }
+    return set;
+}
+
+struct AccuracyCase
+{
+    std::string m_name;
+    OCIO::ConstTransformRcPtr m_transform;
+};
+
+// The transforms exercising the fast paths i.e. the approximations of the log, exp & pow
+// functions, the fast inverse LUTs, the 3D LUT composition, the separable prefix and the half
+// domain 1D LUT.
+std::vector<AccuracyCase> CreateAccuracyCases(const std::string & transformFile)
+{
+    std::vector<AccuracyCase> cases;
+
+    {
+        OCIO::ExponentTransformRcPtr exp = OCIO::ExponentTransform::Create();
+        exp->setValue({ 2.2, 2.2, 2.2, 1.0 });
+        exp->setNegativeStyle(OCIO::NEGATIVE_MIRROR);
+
+        OCIO::LogAffineTransformRcPtr log = OCIO::LogAffineTransform::Create();
+        log->setBase(2.0);
+        log->setLogSideSlopeValue({ 0.05, 0.05, 0.05 });
+        log->setLogSideOffsetValue({ 0.6, 0.6, 0.6 });
+        log->setLinSideOffsetValue({ 0.0001, 0.0001, 0.0001 });
+
+        OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+        group->appendTransform(exp);
+        group->appendTransform(log);
+        group->appendTransform(CreateLut3D(33, OCIO::INTERP_TETRAHEDRAL));
+        cases.push_back({ "Gamma log Lut3D", group });
+    }
+
+    {
+        const double slope[3]  = { 1.1, 0.9, 1.05 };
+        const double offset[3] = { 0.01, -0.02, 0.0 };
+        const double power[3]  = { 1.2, 0.9, 1.1 };
+
+        OCIO::CDLTransformRcPtr cdl = OCIO::CDLTransform::Create();
+        cdl->setStyle(OCIO::CDL_NO_CLAMP);
+        cdl->setSlope(slope);
+        cdl->setOffset(offset);
+        cdl->setPower(power);
+        cdl->setSat(1.2);
+        cases.push_back({ "CDL", cdl });
+    }
+
+    {
+        OCIO::TransformRcPtr lut = CreateLut1D(4096, false);
+        lut->setDirection(OCIO::TRANSFORM_DIR_INVERSE);
+        cases.push_back({ "Inverse Lut1D", lut });
+    }
+
+    {
+        OCIO::TransformRcPtr lut = CreateLut3D(33, OCIO::INTERP_TETRAHEDRAL);
+        lut->setDirection(OCIO::TRANSFORM_DIR_INVERSE);
+        cases.push_back({ "Inverse Lut3D", lut });
+    }
+
+    {
+        OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+        group->appendTransform(CreateLut3D(33, OCIO::INTERP_TETRAHEDRAL));
+        group->appendTransform(CreateMatrix(false, false));
+        group->appendTransform(CreateLut3D(17, OCIO::INTERP_TETRAHEDRAL));
+        cases.push_back({ "Lut3D composition", group });
+    }
+
+    {
+        OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+        group->appendTransform(CreateLut1D(65536, true));
+        group->appendTransform(CreateMatrix(false, false));
+        cases.push_back({ "Lut1D half domain", group });
+    }
+
+    if (!transformFile.empty())
+    {
+        OCIO::FileTransformRcPtr file = OCIO::FileTransform::Create();
+        file->setSrc(transformFile.c_str());
+        file->setInterpolation(OCIO::INTERP_BEST);
+        cases.push_back({ transformFile, file });
+    }
+
+    return cases;
+}
+
+std::vector<std::pair<std::string, OCIO::OptimizationFlags>> GetOptimizationFlags()
+{
+    auto withLossless = [](OCIO::OptimizationFlags flag) -> OCIO::OptimizationFlags
+    {
+        return OCIO::OptimizationFlags(OCIO::OPTIMIZATION_LOSSLESS | flag);
+    };
+
+    return { { "lossless",                   OCIO::OPTIMIZATION_LOSSLESS },
+             { "lossless+lut_inv_fast",      withLossless(OCIO::OPTIMIZATION_LUT_INV_FAST) },
+             { "lossless+fast_log_exp_pow",  withLossless(OCIO::OPTIMIZATION_FAST_LOG_EXP_POW) },
+             { "lossless+comp_lut1d",        withLossless(OCIO::OPTIMIZATION_COMP_LUT1D) },
+             { "lossless+comp_lut3d",        withLossless(OCIO::OPTIMIZATION_COMP_LUT3D) },
+             { "lossless+separable_prefix",  withLossless(OCIO::OPTIMIZATION_COMP_SEPARABLE_PREFIX) },
+             { "very_good",                  OCIO::OPTIMIZATION_VERY_GOOD },
+             { "good",                       OCIO::OPTIMIZATION_GOOD },
+             { "draft",                      OCIO::OPTIMIZATION_DRAFT } };
+}
+
+void Apply(const OCIO::ConstCPUProcessorRcPtr & cpu,
+           const void * src,
+           OCIO::BitDepth srcBitDepth,
+           std::vector<float> & dst,
+           long numPixels)
+{
+    const OCIO::PackedImageDesc srcDesc(const_cast<void *>(src), numPixels, 1, 4, srcBitDepth,
+                                        OCIO::AutoStride, OCIO::AutoStride, OCIO::AutoStride);
+    OCIO::PackedImageDesc dstDesc(dst.data(), numPixels, 1, 4);
+
+    cpu->apply(srcDesc, dstDesc);
+}
+
+std::string GetRendererNames(const OCIO::ConstCPUProcessorRcPtr & cpu)
+{
+    std::string names;
+    for (unsigned idx = 0; idx < cpu->getNumRenderers(); ++idx)
+    {
+        names += (idx ? " > " : "") + std::string(cpu->getRendererName(idx));
+    }
+    return names;
+}
+
+// Compare the RGB channels to the reference ones. The alpha channel is ignored.
+void ComputeErrors(const std::vector<float> & ref,
+                   const std::vector<float> & values,
+                   double codeScale,
+                   Benchmarks::Result & res)
+{
+    const size_t numPixels = ref.size() / 4;
+
+    std::vector<double> errors;
+    errors.reserve(numPixels);
+
+    for (size_t px = 0; px < numPixels; ++px)
+    {
+        double pixelError = 0.0;
+        bool mismatch = false;
+
+        for (size_t channel = 0; channel < 3; ++channel)
+        {
+            const double r = ref[4 * px + channel];
+            const double v = values[4 * px + channel];
+
+            if (!std::isfinite(r) || !std::isfinite(v))
+            {
+                // Only the same Inf or a NaN is expected.
+                if (!(r == v || (std::isnan(r) && std::isnan(v))))
+                {
+                    mismatch = true;
+                }
+                continue;
+            }
+
+            const double error = std::fabs(v - r);
+            pixelError = std::max(pixelError, error * codeScale);
+            res.m_maxRelError = std::max(res.m_maxRelError,
+                                         error / std::max(std::fabs(r), MinRelativeDenominator));
+        }
+
+        if (mismatch)
+        {
+            ++res.m_numNonFiniteMismatches;
+        }
+        else
+        {
+            errors.push_back(pixelError);
+        }
+    }
+
+    res.m_hasErrors = true;
+    if (errors.empty())
+    {
+        return;
+    }
+
+    std::sort(errors.begin(), errors.end());
+
+    res.m_maxError  = errors.back();
+    res.m_p99Error  = GetPercentile(errors, 99.0);
+    res.m_p999Error = GetPercentile(errors, 99.9);
+}
+
+// Process the input set with all the optimization flags & instruction sets of the case, for
+// one input bit-depth.
+void RunAccuracyCase(Benchmarks & benchmarks,
+                     const AccuracyCase & ac,
+                     const OCIO::ConstProcessorRcPtr & processor,
+                     const InputSet & set,
+                     OCIO::BitDepth inBitDepth,
+                     double codeScale)
+{
+    const std::string prefix = ac.m_name + " " + set.m_name + " "
+                             + OCIO::BitDepthToString(inBitDepth);
+
+    const long numPixels = long(set.m_pixels.size() / 4);
+
+    // The input pixels in the input bit-depth, and converted back to F32 for the reference.
+    std::vector<char> src(size_t(numPixels) * 4 * OCIO::GetChannelSizeInBytes(inBitDepth));
+    OCIO::CreateGenericBitDepthHelper(OCIO::BIT_DEPTH_F32, inBitDepth)->apply(set.m_pixels.data(),
+                                                                             src.data(),
+                                                                             numPixels);
+    std::vector<float> refSrc(set.m_pixels.size());
+    OCIO::CreateGenericBitDepthHelper(inBitDepth, OCIO::BIT_DEPTH_F32)->apply(src.data(),
+                                                                             refSrc.data(),
+                                                                             numPixels);
+
+    // The reference is the unoptimized processing without any SIMD.
+    std::vector<float> ref(set.m_pixels.size());
+    {
+        IsaGuard guard(0);
+        OCIO::ConstCPUProcessorRcPtr cpu
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32,
+                                                  OCIO::BIT_DEPTH_F32,
+                                                  OCIO::OPTIMIZATION_NONE);
+        Apply(cpu, refSrc.data(), OCIO::BIT_DEPTH_F32, ref, numPixels);
+    }
+
+    bool header = false;
+
+    for (const auto & flags : GetOptimizationFlags())
+    {
+        // Only the LUT renderers depend on the instruction sets.
+        const std::string hostRenderers
+            = GetRendererNames(processor->getOptimizedCPUProcessor(inBitDepth,
+                                                                   OCIO::BIT_DEPTH_F32,
+                                                                   flags.second));
+
+        std::vector<IsaVariant> isaVariants{ { "host", OCIO::CPUInfo::instance().flags } };
+        if (hostRenderers.find("Lut") != std::string::npos)
+        {
+            isaVariants = GetIsaVariants();
+        }
+
+        for (const auto & isa : isaVariants)
+        {
+            const std::string name = prefix + " " + flags.first + " [" + isa.m_name + "]";
+            if (!benchmarks.isEnabled(name))
+            {
+                continue;
+            }
+
+            IsaGuard guard(isa.m_flags);
+
+            OCIO::ConstCPUProcessorRcPtr cpu
+                = processor->getOptimizedCPUProcessor(inBitDepth, OCIO::BIT_DEPTH_F32, flags.second);
+
+            std::vector<float> dst(set.m_pixels.size());
+
+            Benchmarks::Result res
+                = benchmarks.measure(name, GetRendererNames(cpu), isa.m_name, numPixels,
+                                     [&]()
+                                     {
+                                         Apply(cpu, src.data(), inBitDepth, dst, numPixels);
+                                     });
+
+            ComputeErrors(ref, dst, codeScale, res);
+
+            if (!header)
+            {
+                header = true;
+                std::cout << std::endl << prefix << " (" << numPixels << " pixels)" << std::endl
+                          << "    " << std::left << std::setw(28) << "optimization"
+                          << std::setw(11) << "isa" << std::right
+                          << std::setw(11) << "max err" << std::setw(11) << "p99 err"
+                          << std::setw(11) << "p99.9 err" << std::setw(12) << "max rel err"
+                          << std::setw(12) << "non-finite" << std::setw(11) << "ns/pixel"
+                          << std::endl;
+            }
+
+            std::cout << "    " << std::left << std::setw(28) << flags.first
+                      << std::setw(11) << isa.m_name << std::right
+                      << std::fixed << std::setprecision(3)
+                      << std::setw(11) << res.m_maxError
+                      << std::setw(11) << res.m_p99Error
+                      << std::setw(11) << res.m_p999Error
+                      << std::scientific << std::setprecision(2)
+                      << std::setw(12) << res.m_maxRelError
+                      << std::setw(12) << res.m_numNonFiniteMismatches
+                      << std::fixed << std::setprecision(3)
+                      << std::setw(11) << res.m_nsPerPixel
+                      << std::defaultfloat << std::setprecision(6) << std::endl;
+
+            benchmarks.addResult(res);
+        }
+    }
+}
+
+} // anonymous namespace
+
+void RunAccuracyBenchmarks(Benchmarks & benchmarks,
+                           const std::string & transformFile,
+                           unsigned codeBits)
+{
+    const double codeScale = std::exp2(double(codeBits)) - 1.0;
+
+    std::cout << "Errors in " << codeBits << "-bit code values compared to the unoptimized "
+              << "C processing (random seed " << RandomSeed << "):" << std::endl;
+
+    const std::vector<InputSet> sets
+        = { CreateHalfSet(), CreateEdgeSet(), CreateUnitSet(), CreateHdrSet() };
+
+    // Disable the caches as the CPU processors depend on the enabled instruction sets.
+    OCIO::ConfigRcPtr config = OCIO::Config::CreateRaw()->createEditableCopy();
+    config->setProcessorCacheFlags(OCIO::PROCESSOR_CACHE_OFF);
+
+    for (const auto & ac : CreateAccuracyCases(transformFile))
+    {
+        OCIO::ConstProcessorRcPtr processor = config->getProcessor(ac.m_transform);
+
+        for (const auto & set : sets)
+        {
+            for (const OCIO::BitDepth inBitDepth : set.m_bitDepths)
+            {
+                RunAccuracyCase(benchmarks, ac, processor, set, inBitDepth, codeScale);
+            }
+        }
+    }
+}
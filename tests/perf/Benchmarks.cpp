@@ -0,0 +1,369 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "Benchmarks.h"
+#include "CPUInfo.h"
+
+namespace OCIO = OCIO_NAMESPACE;
+
+
+namespace
+{
+
+// 4096 RGBA F32 pixels i.e. 64 KB for each of the input and output buffers.
+constexpr long CacheResidentSize = 4096;
+// 4M RGBA F32 pixels i.e. 64 MB for each of the input and output buffers.
+constexpr long StreamingSize = 4096 * 1024;
+
+// Minimum number of pixels processed by each measured sample.
+constexpr long MinPixelsPerSample      = 4096 * 1024;
+constexpr long MinPixelsPerQuickSample = 256 * 1024;
+
+// Set the statistics of the sample durations (in ms) of the result.
+void SetStatistics(std::vector<double> & durations, Benchmarks::Result & res)
+{
+    std::sort(durations.begin(), durations.end());
+
+    const size_t count = durations.size();
+
+    res.m_minMs    = durations.front();
+    res.m_medianMs = (count % 2) ? durations[count / 2]
+                                 : (durations[count / 2 - 1] + durations[count / 2]) / 2.0;
+    res.m_p90Ms    = GetPercentile(durations, 90.0);
+
+    double mean = 0.0;
+    for (const double value : durations)
+    {
+        mean += value;
+    }
+    mean /= double(count);
+
+    for (const double value : durations)
+    {
+        res.m_stdDevMs += (value - mean) * (value - mean);
+    }
+    res.m_stdDevMs = std::sqrt(res.m_stdDevMs / double(count));
+
+    res.m_nsPerPixel = res.m_medianMs * 1e6 / double(res.m_pixelsPerSample);
+}
+
+std::string JsonString(const std::string & str)
+{
+    std::ostringstream oss;
+    oss << "\"";
+    for (const char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            oss << '\\';
+        }
+        oss << c;
+    }
+    oss << "\"";
+    return oss.str();
+}
+
+} // anonymous namespace
+
+std::vector<Benchmarks::BufferSize> Benchmarks::getBufferSizes() const
+{
+    std::vector<BufferSize> sizes{ { "cache", CacheResidentSize } };
+    if (!m_quick)
+    {
+        sizes.push_back({ "stream", StreamingSize });
+    }
+    return sizes;
+}
+
+bool Benchmarks::isEnabled(const std::string & name) const
+{
+    return m_filter.empty() || name.find(m_filter) != std::string::npos;
+}
+
+Benchmarks::Result Benchmarks::measure(const std::string & name,
+                                      const std::string & renderer,
+                                      const std::string & isa,
+                                      long numPixels,
+                                      const std::function<void()> & process) const
+{
+    const long minPixels = m_quick ? MinPixelsPerQuickSample : MinPixelsPerSample;
+    const long numCalls  = std::max(1L, minPixels / numPixels);
+
+    std::vector<double> durations;
+    for (unsigned iter = 0; iter < m_warmup + m_iterations; ++iter)
+    {
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (long call = 0; call < numCalls; ++call)
+        {
+            process();
+        }
+        const std::chrono::duration<double, std::milli> duration
+            = std::chrono::high_resolution_clock::now() - start;
+
+        if (iter >= m_warmup)
+        {
+            durations.push_back(duration.count());
+        }
+    }
+
+    Result res;
+    res.m_name            = name;
+    res.m_renderer        = renderer;
+    res.m_isa             = isa;
+    res.m_numPixels       = numPixels;
+    res.m_pixelsPerSample = numPixels * numCalls;
+
+    SetStatistics(durations, res);
+
+    return res;
+}
+
+void Benchmarks::run(const std::string & name,
+                     const std::string & renderer,
+                     const std::string & isa,
+                     long numPixels,
+                     const std::function<void()> & process)
+{
+    if (!isEnabled(name))
+    {
+        return;
+    }
+
+    const Result res = measure(name, renderer, isa, numPixels, process);
+
+    std::cout << std::left << std::setw(56) << res.m_name << std::right
+              << std::fixed << std::setprecision(3)
+              << std::setw(10) << res.m_nsPerPixel << " ns/pixel"
+              << std::setw(10) << std::setprecision(1) << (1000.0 / res.m_nsPerPixel) << " Mpix/s"
+              << std::defaultfloat << std::setprecision(6)
+              << "   " << res.m_renderer << std::endl;
+
+    m_results.push_back(res);
+}
+
+void Benchmarks::runUpdates(const std::string & name,
+                            const std::string & renderer,
+                            long numUpdates,
+                            const std::function<void()> & update)
+{
+    if (!isEnabled(name))
+    {
+        return;
+    }
+
+    std::vector<double> durations;
+    for (unsigned iter = 0; iter < m_warmup + m_iterations; ++iter)
+    {
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (long call = 0; call < numUpdates; ++call)
+        {
+            update();
+        }
+        const std::chrono::duration<double, std::milli> duration
+            = std::chrono::high_resolution_clock::now() - start;
+
+        if (iter >= m_warmup)
+        {
+            durations.push_back(duration.count());
+        }
+    }
+
+    Result res;
+    res.m_name            = name;
+    res.m_renderer        = renderer;
+    res.m_isa             = "host";
+    res.m_numPixels       = 1;
+    res.m_pixelsPerSample = numUpdates;
+
+    SetStatistics(durations, res);
+
+    std::cout << std::left << std::setw(56) << res.m_name << std::right
+              << std::fixed << std::setprecision(3)
+              << std::setw(10) << res.m_nsPerPixel << " ns/update"
+              << std::defaultfloat << std::setprecision(6)
+              << "   " << res.m_renderer << std::endl;
+
+    m_results.push_back(res);
+}
+
+void Benchmarks::saveJson(const std::string & filename) const
+{
+    std::ofstream out(filename);
+    if (!out)
+    {
+        std::string err("Could not open the file: ");
+        err += filename;
+        throw OCIO::Exception(err.c_str());
+    }
+
+    out << std::setprecision(9);
+
+    out << "{" << std::endl
+        << "  \"ocio_version\": " << JsonString(OCIO::GetVersion()) << "," << std::endl
+        << "  \"cpu\": " << JsonString(OCIO::GetCPUInfo()) << "," << std::endl
+        << "  \"iterations\": " << m_iterations << "," << std::endl
+        << "  \"warmup\": " << m_warmup << "," << std::endl;
+
+    out << "  \"results\": [" << std::endl;
+    for (size_t idx = 0; idx < m_results.size(); ++idx)
+    {
+        const Result & res = m_results[idx];
+        out << "    { \"name\": "          << JsonString(res.m_name)
+            << ", \"renderer\": "          << JsonString(res.m_renderer)
+            << ", \"isa\": "               << JsonString(res.m_isa)
+            << ", \"pixels\": "            << res.m_numPixels
+            << ", \"pixels_per_sample\": " << res.m_pixelsPerSample
+            << ", \"min_ms\": "            << res.m_minMs
+            << ", \"median_ms\": "         << res.m_medianMs
+            << ", \"p90_ms\": "            << res.m_p90Ms
+            << ", \"stddev_ms\": "         << res.m_stdDevMs
+            << ", \"ns_per_pixel\": "      << res.m_nsPerPixel;
+        if (res.m_hasErrors)
+        {
+            out << ", \"max_error\": "       << res.m_maxError
+                << ", \"p99_error\": "       << res.m_p99Error
+                << ", \"p999_error\": "      << res.m_p999Error
+                << ", \"max_rel_error\": "   << res.m_maxRelError
+                << ", \"nonfinite_mismatches\": " << res.m_numNonFiniteMismatches;
+        }
+        out << " }" << (idx + 1 < m_results.size() ? "," : "") << std::endl;
+    }
+    out << "  ]" << std::endl
+        << "}" << std::endl;
+}
+
+std::vector<IsaVariant> GetIsaVariants()
+{
+    std::vector<IsaVariant> variants{ { "C", 0 } };
+
+#if OCIO_ARCH_X86 || OCIO_USE_SSE2NEON
+    const OCIO::CPUInfo & cpu = OCIO::CPUInfo::instance();
+
+    unsigned flags = 0;
+    if (cpu.hasSSE2())
+    {
+        flags |= X86_CPU_FLAG_SSE2;
+        variants.push_back({ "SSE2", flags });
+    }
+    if (cpu.hasAVX())
+    {
+        flags |= X86_CPU_FLAG_AVX;
+        variants.push_back({ "AVX", flags });
+        if (cpu.hasF16C())
+        {
+            variants.push_back({ "AVX+F16C", flags | X86_CPU_FLAG_F16C });
+        }
+    }
+    if (cpu.hasAVX2())
+    {
+        flags |= X86_CPU_FLAG_AVX2;
+        variants.push_back({ "AVX2", flags });
+        if (cpu.hasF16C())
+        {
+            variants.push_back({ "AVX2+F16C", flags | X86_CPU_FLAG_F16C });
+        }
+    }
+    if (cpu.hasAVX512())
+    {
+        flags |= X86_CPU_FLAG_AVX512;
+        if (cpu.hasF16C())
+        {
+            flags |= X86_CPU_FLAG_F16C;
+        }
+        variants.push_back({ "AVX512", flags });
+    }
+#endif
+
+    return variants;
+}
+
+IsaGuard::IsaGuard(unsigned flags)
+    :   m_hostFlags(OCIO::CPUInfo::instance().flags)
+{
+    OCIO::CPUInfo::instance().flags = flags;
+}
+
+IsaGuard::~IsaGuard()
+{
+    OCIO::CPUInfo::instance().flags = m_hostFlags;
+}
+
+double GetPercentile(const std::vector<double> & sorted, double percentile)
+{
+    const size_t rank = size_t(std::ceil(percentile / 100.0 * double(sorted.size())));
+    return sorted[std::min(std::max(rank, size_t(1)), sorted.size()) - 1];
+}
+
+OCIO::TransformRcPtr CreateLut1D(unsigned long length, bool halfDomain)
+{
+    OCIO::Lut1DTransformRcPtr lut = OCIO::Lut1DTransform::Create(length, halfDomain);
+    for (unsigned long idx = 0; idx < length; ++idx)
+    {
+        // Start from the identity values so that the half domain LUT keeps its Inf & NaN.
+        float r = 0.0f, g = 0.0f, b = 0.0f;
+        lut->getValue(idx, r, g, b);
+
+        auto curve = [](float value) -> float
+        {
+            return (value > 0.0f && std::isfinite(value)) ? std::pow(value, 1.0f / 2.2f) : value;
+        };
+        lut->setValue(idx, curve(r), curve(g) * 0.95f, curve(b) * 1.05f);
+    }
+    return lut;
+}
+
+OCIO::TransformRcPtr CreateLut3D(unsigned long gridSize, OCIO::Interpolation interpolation)
+{
+    OCIO::Lut3DTransformRcPtr lut = OCIO::Lut3DTransform::Create(gridSize);
+    lut->setInterpolation(interpolation);
+
+    const float scale = 1.0f / float(gridSize - 1);
+    for (unsigned long r = 0; r < gridSize; ++r)
+    {
+        for (unsigned long g = 0; g < gridSize; ++g)
+        {
+            for (unsigned long b = 0; b < gridSize; ++b)
+            {
+                const float rv = r * scale, gv = g * scale, bv = b * scale;
+                // Some crosstalk between the channels.
+                lut->setValue(r, g, b,
+                              std::pow(0.8f * rv + 0.1f * gv + 0.1f * bv, 1.0f / 2.2f),
+                              std::pow(0.1f * rv + 0.8f * gv + 0.1f * bv, 1.0f / 2.2f),
+                              std::pow(0.1f * rv + 0.1f * gv + 0.8f * bv, 1.0f / 2.2f));
+            }
+        }
+    }
+    return lut;
+}
+
+OCIO::TransformRcPtr CreateMatrix(bool diagonal, bool offset)
+{
+    const double diag[16] = { 1.1,  0.0,  0.0,  0.0,
+                              0.0,  0.9,  0.0,  0.0,
+                              0.0,  0.0,  1.2,  0.0,
+                              0.0,  0.0,  0.0,  1.0 };
+    const double full[16] = { 0.6131, 0.3395, 0.0474, 0.0,
+                              0.0702, 0.9164, 0.0134, 0.0,
+                              0.0206, 0.1096, 0.8698, 0.0,
+                              0.0,    0.0,    0.0,    1.0 };
+    const double offset4[4] = { 0.01, -0.02, 0.03, 0.0 };
+
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    matrix->setMatrix(diagonal ? diag : full);
+    if (offset)
+    {
+        matrix->setOffset(offset4);
+    }
+    return matrix;
+}
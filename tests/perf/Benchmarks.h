@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_BENCHMARKS_H
+#define INCLUDED_OCIO_BENCHMARKS_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+
+// Small harness to time the CPU renderers on synthetic buffers.
+class Benchmarks
+{
+public:
+    struct Result
+    {
+        std::string m_name;     // Unique name e.g. "Lut3D tetrahedral 33 [AVX2] cache".
+        std::string m_renderer; // Class name of the CPU renderer.
+        std::string m_isa;      // Instruction sets enabled when creating & applying the renderer.
+
+        long m_numPixels { 0 };       // Number of pixels processed by each call.
+        long m_pixelsPerSample { 0 }; // Number of pixels processed by each measured sample.
+
+        // Statistics of the sample durations.
+        double m_minMs    { 0.0 };
+        double m_medianMs { 0.0 };
+        double m_p90Ms    { 0.0 };
+        double m_stdDevMs { 0.0 };
+
+        // Median time to process one pixel.
+        double m_nsPerPixel { 0.0 };
+
+        // Errors compared to a reference processing (i.e. only for the accuracy benchmarks).
+        bool m_hasErrors { false };
+        double m_maxError   { 0.0 }; // In output code values.
+        double m_p99Error   { 0.0 }; // In output code values.
+        double m_p999Error  { 0.0 }; // In output code values.
+        double m_maxRelError { 0.0 };
+        // Number of pixels where the finiteness (i.e. Inf or NaN) differs from the reference.
+        long m_numNonFiniteMismatches { 0 };
+    };
+
+    struct BufferSize
+    {
+        std::string m_name;
+        long m_numPixels;
+    };
+
+    unsigned m_iterations { 10 };
+    unsigned m_warmup { 2 };
+    // Only run the benchmarks whose name contains the filter.
+    std::string m_filter;
+    // Only use the cache resident buffer size and process less pixels per sample.
+    bool m_quick { false };
+
+    // The cache resident (i.e. the input & output buffers fit in L2) and the streaming (i.e. the
+    // buffers do not fit in the last level cache) sizes.
+    std::vector<BufferSize> getBufferSizes() const;
+
+    bool isEnabled(const std::string & name) const;
+
+    // Time the process function which processes numPixels per call. Each sample calls the
+    // function enough times to process a minimum number of pixels so that the cache resident
+    // sizes are not dominated by the timer resolution.
+    Result measure(const std::string & name,
+                   const std::string & renderer,
+                   const std::string & isa,
+                   long numPixels,
+                   const std::function<void()> & process) const;
+
+    // Measure, print and record the result.
+    void run(const std::string & name,
+             const std::string & renderer,
+             const std::string & isa,
+             long numPixels,
+             const std::function<void()> & process);
+
+    // Time, print and record an update function (e.g. the interactive edit of a dynamic property)
+    // called numUpdates times per sample. Note that the pixel fields of the result count the
+    // updates i.e. 'm_nsPerPixel' is the median time of one update.
+    void runUpdates(const std::string & name,
+                    const std::string & renderer,
+                    long numUpdates,
+                    const std::function<void()> & update);
+
+    void addResult(const Result & res) { m_results.push_back(res); }
+    const std::vector<Result> & getResults() const { return m_results; }
+
+    // Save the results in a JSON file. Note that the results use the format of the ocioperf
+    // reports (i.e. one result per line with a 'name' and a 'median_ms') so that
+    // 'ocioperf --compare' could compare the results of two commits.
+    void saveJson(const std::string & filename) const;
+
+private:
+    std::vector<Result> m_results;
+};
+
+// A set of instruction sets to enable when creating & applying the CPU renderers.
+struct IsaVariant
+{
+    std::string m_name;
+    unsigned m_flags;
+};
+
+// Get the instruction sets available on the host and in the build, starting with "C" i.e. no
+// SIMD. Note that the 'slow' flags are ignored so that the named instruction set is always the
+// one used.
+std::vector<IsaVariant> GetIsaVariants();
+
+// Force the instruction sets for the lifetime of the instance.
+class IsaGuard
+{
+public:
+    IsaGuard() = delete;
+    IsaGuard(const IsaGuard &) = delete;
+    IsaGuard & operator=(const IsaGuard &) = delete;
+
+    explicit IsaGuard(unsigned flags);
+    ~IsaGuard();
+
+private:
+    const unsigned m_hostFlags;
+};
+
+// Get a percentile of sorted values using the nearest-rank method.
+double GetPercentile(const std::vector<double> & sorted, double percentile);
+
+// Synthetic transforms shared by the benchmarks. The 1D LUT applies a gamma with a different
+// gain per channel, the 3D LUT adds some crosstalk between the channels and the matrix is
+// either a diagonal or a full (i.e. a gamut conversion) one.
+OCIO_NAMESPACE::TransformRcPtr CreateLut1D(unsigned long length, bool halfDomain);
+OCIO_NAMESPACE::TransformRcPtr CreateLut3D(unsigned long gridSize,
+                                           OCIO_NAMESPACE::Interpolation interpolation);
+OCIO_NAMESPACE::TransformRcPtr CreateMatrix(bool diagonal, bool offset);
+
+// Run all the CPU renderer benchmarks.
+void RunOpBenchmarks(Benchmarks & benchmarks);
+
+// Run the update latency benchmarks of the grading dynamic properties.
+void RunGradingBenchmarks(Benchmarks & benchmarks);
+
+// Run the processors of the fast paths, and of the optional transform file, for several
+// optimization flags & instruction sets on dense input sets, and report their errors compared
+// to the unoptimized C processing in code values of the codeBits integer bit-depth.
+void RunAccuracyBenchmarks(Benchmarks & benchmarks,
+                           const std::string & transformFile,
+                           unsigned codeBits);
+
+#endif // INCLUDED_OCIO_BENCHMARKS_H
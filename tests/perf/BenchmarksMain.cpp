@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#include <iostream>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "apputils/argparse.h"
+#include "Benchmarks.h"
+
+namespace OCIO = OCIO_NAMESPACE;
+
+
+int main(int argc, const char ** argv)
+{
+    bool help  = false;
+    bool quick = false;
+    bool accuracy = false;
+    int codeBits = 10;
+    int iterations = 10;
+    int warmup = 2;
+    std::string filter, jsonFile, transformFile;
+
+    ArgParse ap;
+    ap.options("ocio_benchmarks -- time the CPU renderers of the ops on synthetic buffers, or the "\
+               "accuracy & speed of the fast paths\n\n"
+               "usage: ocio_benchmarks [options]\n\n",
+               "--help",          &help,       "Display the help and exit",
+               "--iter %d",       &iterations, "Number of measured samples. Default is 10",
+               "--warmup %d",     &warmup,     "Number of samples to run before the measured ones. "\
+                                               "Default is 2",
+               "--filter %s",     &filter,     "Only run the benchmarks whose name contains the "\
+                                               "string (e.g. Lut3D, AVX2 or stream)",
+               "--quick",         &quick,      "Only use the cache resident buffers and process "\
+                                               "less pixels per sample",
+               "--json %s",       &jsonFile,   "Save the results in a JSON file. Use 'ocioperf "\
+                                               "--compare' to compare the files of two commits",
+               "<SEPARATOR>",     "Accuracy options:",
+               "--accuracy",      &accuracy,   "Compare the processing of the fast paths, for several "\
+                                               "optimization flags and instruction sets, to the "\
+                                               "unoptimized C processing on dense input sets",
+               "--transform %s",  &transformFile, "Also measure the accuracy of a transform file",
+               "--codebits %d",   &codeBits,   "The bit-depth of the code values of the errors. "\
+                                               "Default is 10",
+               nullptr);
+
+    if (ap.parse(argc, argv) < 0)
+    {
+        std::cerr << ap.geterror() << std::endl;
+        ap.usage();
+        return 1;
+    }
+
+    if (help)
+    {
+        ap.usage();
+        return 0;
+    }
+
+    if (iterations <= 0 || warmup < 0)
+    {
+        std::cerr << "ERROR: Invalid number of iterations." << std::endl;
+        return 1;
+    }
+
+    if (codeBits < 1 || codeBits > 32)
+    {
+        std::cerr << "ERROR: Invalid code value bit-depth." << std::endl;
+        return 1;
+    }
+
+    if (!transformFile.empty() && !accuracy)
+    {
+        std::cerr << "ERROR: The transform file is only used by --accuracy." << std::endl;
+        return 1;
+    }
+
+    std::cout << "OCIO Version: " << OCIO::GetVersion() << std::endl
+              << "CPU:          " << OCIO::GetCPUInfo() << std::endl << std::endl;
+
+    try
+    {
+        Benchmarks benchmarks;
+        benchmarks.m_iterations = unsigned(iterations);
+        benchmarks.m_warmup     = unsigned(warmup);
+        benchmarks.m_filter     = filter;
+        benchmarks.m_quick      = quick;
+
+        if (accuracy)
+        {
+            RunAccuracyBenchmarks(benchmarks, transformFile, unsigned(codeBits));
+        }
+        else
+        {
+            RunOpBenchmarks(benchmarks);
+            RunGradingBenchmarks(benchmarks);
+        }
+
+        if (benchmarks.getResults().empty())
+        {
+            std::cerr << "ERROR: No benchmark matches the filter '" << filter << "'." << std::endl;
+            return 1;
+        }
+
+        if (!jsonFile.empty())
+        {
+            benchmarks.saveJson(jsonFile);
+        }
+    }
+    catch (std::exception & ex)
+    {
+        std::cerr << "ERROR: " << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "Benchmarks.h"
+#include "DynamicProperty.h"
+#include "ops/gradingtone/GradingTone.h"
+
+namespace OCIO = OCIO_NAMESPACE;
+
+
+namespace
+{
+
+// Number of updates per measured sample.
+constexpr long NumUpdates = 10000;
+
+// The update latency of an interactive edit i.e. a UI slider changing one control of the grading
+// tone. The incremental update only recomputes the constants depending on the changed control,
+// the full one recomputes all of them on the same instance (i.e. a style change forces it).
+void RunGradingToneUpdates(Benchmarks & benchmarks)
+{
+    OCIO::GradingTone tone{ OCIO::GRADING_LOG };
+    tone.m_midtones.m_master = 1.2;
+    OCIO::GradingTone edited{ tone };
+    edited.m_midtones.m_master = 1.3;
+
+    OCIO::GradingTonePreRender incremental{ OCIO::GRADING_LOG };
+    long count = 0;
+    benchmarks.runUpdates("GradingTone update incremental",
+                          "GradingTonePreRender",
+                          NumUpdates,
+                          [&]()
+                          {
+                              incremental.update((++count % 2) ? edited : tone);
+                          });
+
+    OCIO::GradingTonePreRender full{ OCIO::GRADING_LOG };
+    benchmarks.runUpdates("GradingTone update full",
+                          "GradingTonePreRender",
+                          NumUpdates,
+                          [&]()
+                          {
+                              full.setStyle(OCIO::GRADING_LIN);
+                              full.setStyle(OCIO::GRADING_LOG);
+                              full.update((++count % 2) ? edited : tone);
+                          });
+}
+
+// The update latency of an interactive edit of one of the RGB curves. The incremental update
+// only fits again the edited curve, the full one changes all the curves so that all of them
+// are fit again. Both use the same dynamic property call.
+void RunGradingRGBCurveUpdates(Benchmarks & benchmarks)
+{
+    auto createCurve11 = [](float lastY)
+    {
+        return OCIO::GradingBSplineCurve::Create(
+            { { 0.f, 10.f }, { 2.f, 10.f }, { 3.f, 10.f }, { 5.f, 10.f }, { 6.f, 10.f },
+              { 8.f, 10.f }, { 9.f, 10.5f }, { 11.f, 15.f }, { 12.f, 50.f }, { 14.f, 60.f },
+              { 15.f, lastY } });
+    };
+    auto createCurve3 = [](float midY)
+    {
+        return OCIO::GradingBSplineCurve::Create({ { 0.f, 0.f }, { 0.5f, midY }, { 1.f, 1.f } });
+    };
+
+    const auto curve1 = createCurve11(85.f);
+    const auto curve2 = createCurve3(0.6f);
+    const auto curve3 = createCurve11(85.f);
+
+    const OCIO::ConstGradingRGBCurveRcPtr values[2]
+        = { OCIO::GradingRGBCurve::Create(curve1, curve2, curve3, createCurve3(0.7f)),
+            OCIO::GradingRGBCurve::Create(curve1, curve2, curve3, createCurve3(0.8f)) };
+
+    const OCIO::ConstGradingRGBCurveRcPtr allValues[2]
+        = { values[0],
+            OCIO::GradingRGBCurve::Create(createCurve11(90.f), createCurve3(0.65f),
+                                          createCurve11(90.f), createCurve3(0.8f)) };
+
+    long count = 0;
+
+    OCIO::DynamicPropertyGradingRGBCurveImpl incremental(values[0], true);
+    benchmarks.runUpdates("GradingRGBCurve update incremental",
+                          "DynamicPropertyGradingRGBCurveImpl",
+                          NumUpdates,
+                          [&]()
+                          {
+                              incremental.setValue(values[++count % 2]);
+                          });
+
+    OCIO::DynamicPropertyGradingRGBCurveImpl full(allValues[0], true);
+    benchmarks.runUpdates("GradingRGBCurve update full",
+                          "DynamicPropertyGradingRGBCurveImpl",
+                          NumUpdates,
+                          [&]()
+                          {
+                              full.setValue(allValues[++count % 2]);
+                          });
+}
+
+} // anonymous namespace
+
+void RunGradingBenchmarks(Benchmarks & benchmarks)
+{
+    RunGradingToneUpdates(benchmarks);
+    RunGradingRGBCurveUpdates(benchmarks);
+}
@@ -0,0 +1,526 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "Benchmarks.h"
+#include "BitDepthUtils.h"
+#include "CPUProcessor.h"
+#include "ImagePacking.h"
+#include "OpBuilders.h"
+#include "ops/lut1d/Lut1DOpCPU.h"
+#include "ops/lut1d/Lut1DOpData.h"
+
+namespace OCIO = OCIO_NAMESPACE;
+
+
+namespace
+{
+
+// The fixed seed of the synthetic buffers so that all the runs process the same pixels.
+constexpr unsigned RandomSeed = 20240801;
+
+// Random RGBA pixels in the bit-depth. The float values are in [-0.25, 1.25] to also exercise
+// the code paths of the out of range values.
+std::vector<char> CreateRandomBuffer(OCIO::BitDepth bitDepth, long numPixels)
+{
+    std::mt19937 generator(RandomSeed);
+    std::uniform_real_distribution<float> dist(-0.25f, 1.25f);
+
+    std::vector<float> values(size_t(numPixels) * 4);
+    for (auto & value : values)
+    {
+        value = dist(generator);
+    }
+
+    std::vector<char> buffer(size_t(numPixels) * 4 * OCIO::GetChannelSizeInBytes(bitDepth));
+    OCIO::CreateGenericBitDepthHelper(OCIO::BIT_DEPTH_F32, bitDepth)->apply(values.data(),
+                                                                          buffer.data(),
+                                                                          numPixels);
+    return buffer;
+}
+
+std::string GetName(const std::string & name, const std::string & isa, const std::string & size)
+{
+    return name + (isa.empty() ? "" : " [" + isa + "]") + " " + size;
+}
+
+// Time the renderer for all the buffer sizes.
+void RunRenderer(Benchmarks & benchmarks,
+                 const std::string & name,
+                 const std::string & isa,
+                 const OCIO::ConstOpCPURcPtr & renderer,
+                 OCIO::BitDepth inBitDepth,
+                 OCIO::BitDepth outBitDepth)
+{
+    for (const auto & size : benchmarks.getBufferSizes())
+    {
+        const std::string fullName = GetName(name, isa, size.m_name);
+        if (!benchmarks.isEnabled(fullName))
+        {
+            continue;
+        }
+
+        const long numPixels = size.m_numPixels;
+
+        const std::vector<char> src = CreateRandomBuffer(inBitDepth, numPixels);
+        std::vector<char> dst(size_t(numPixels) * 4 * OCIO::GetChannelSizeInBytes(outBitDepth));
+
+        benchmarks.run(fullName,
+                       OCIO::GetOpCPUClassName(*renderer),
+                       isa.empty() ? "host" : isa,
+                       numPixels,
+                       [&]()
+                       {
+                           renderer->apply(src.data(), dst.data(), numPixels);
+                       });
+    }
+}
+
+struct TransformCase
+{
+    std::string m_name;
+    OCIO::ConstTransformRcPtr m_transform;
+    // Is the renderer selected from the available instruction sets?
+    bool m_isaVariants;
+    // Is there a faster approximation of the log, exp & pow functions?
+    bool m_fastVariant;
+};
+
+OCIO::ConstTransformRcPtr CreateCDL(OCIO::CDLStyle style)
+{
+    const double slope[3]  = { 1.1, 0.9, 1.05 };
+    const double offset[3] = { 0.01, -0.02, 0.0 };
+    const double power[3]  = { 1.2, 0.9, 1.1 };
+
+    OCIO::CDLTransformRcPtr cdl = OCIO::CDLTransform::Create();
+    cdl->setStyle(style);
+    cdl->setSlope(slope);
+    cdl->setOffset(offset);
+    cdl->setPower(power);
+    cdl->setSat(1.2);
+    return cdl;
+}
+
+OCIO::ConstTransformRcPtr CreateExponent(OCIO::NegativeStyle style)
+{
+    OCIO::ExponentTransformRcPtr exp = OCIO::ExponentTransform::Create();
+    exp->setValue({ 2.2, 2.1, 2.3, 1.0 });
+    exp->setNegativeStyle(style);
+    return exp;
+}
+
+OCIO::ConstTransformRcPtr CreateExponentWithLinear(OCIO::NegativeStyle style)
+{
+    OCIO::ExponentWithLinearTransformRcPtr exp = OCIO::ExponentWithLinearTransform::Create();
+    exp->setGamma({ 2.4, 2.4, 2.4, 1.0 });
+    exp->setOffset({ 0.055, 0.055, 0.055, 0.0 });
+    exp->setNegativeStyle(style);
+    return exp;
+}
+
+OCIO::ConstTransformRcPtr CreateExposureContrast(OCIO::ExposureContrastStyle style)
+{
+    OCIO::ExposureContrastTransformRcPtr ec = OCIO::ExposureContrastTransform::Create();
+    ec->setStyle(style);
+    ec->setExposure(0.5);
+    ec->setContrast(1.2);
+    ec->setGamma(1.1);
+    ec->setPivot(0.18);
+    return ec;
+}
+
+OCIO::ConstTransformRcPtr CreateGradingPrimary(OCIO::GradingStyle style)
+{
+    OCIO::GradingPrimary values(style);
+    values.m_contrast   = OCIO::GradingRGBM(1.1, 1.0, 0.9, 1.2);
+    values.m_gamma      = OCIO::GradingRGBM(1.0, 1.1, 1.0, 0.9);
+    values.m_saturation = 1.2;
+    if (style == OCIO::GRADING_LIN)
+    {
+        values.m_exposure = OCIO::GradingRGBM(0.1, 0.0, -0.1, 0.2);
+    }
+    else
+    {
+        values.m_brightness = OCIO::GradingRGBM(0.02, 0.0, -0.02, 0.05);
+    }
+
+    OCIO::GradingPrimaryTransformRcPtr prim = OCIO::GradingPrimaryTransform::Create(style);
+    prim->setValue(values);
+    return prim;
+}
+
+OCIO::ConstTransformRcPtr CreateGradingRGBCurve(OCIO::GradingStyle style)
+{
+    // The curves are defined in the style domain i.e. their control points are scaled from
+    // the default identity curve of the style.
+    const OCIO::ConstGradingRGBCurveRcPtr identity = OCIO::GradingRGBCurve::Create(style);
+    const OCIO::ConstGradingBSplineCurveRcPtr master = identity->getCurve(OCIO::RGB_MASTER);
+
+    OCIO::GradingBSplineCurveRcPtr curve = master->createEditableCopy();
+    const size_t numPoints = curve->getNumControlPoints();
+    for (size_t idx = 1; idx + 1 < numPoints; ++idx)
+    {
+        curve->getControlPoint(idx).m_y = 0.9f * curve->getControlPoint(idx).m_y
+                                        + 0.1f * curve->getControlPoint(idx + 1).m_y;
+    }
+
+    OCIO::GradingRGBCurveTransformRcPtr rgbCurve = OCIO::GradingRGBCurveTransform::Create(style);
+    rgbCurve->setValue(OCIO::GradingRGBCurve::Create(curve, master, curve, curve));
+    return rgbCurve;
+}
+
+OCIO::ConstTransformRcPtr CreateGradingTone(OCIO::GradingStyle style)
+{
+    OCIO::GradingTone values(style);
+    values.m_midtones.m_master   = 1.2;
+    values.m_highlights.m_master = 0.8;
+    values.m_shadows.m_master    = 1.1;
+    values.m_scontrast           = 1.2;
+
+    OCIO::GradingToneTransformRcPtr tone = OCIO::GradingToneTransform::Create(style);
+    tone->setValue(values);
+    return tone;
+}
+
+std::vector<TransformCase> CreateTransformCases()
+{
+    std::vector<TransformCase> cases;
+
+    cases.push_back({ "Matrix scale",           CreateMatrix(true, false),  false, false });
+    cases.push_back({ "Matrix scale offset",    CreateMatrix(true, true),   false, false });
+    cases.push_back({ "Matrix",                 CreateMatrix(false, false), false, false });
+    cases.push_back({ "Matrix offset",          CreateMatrix(false, true),  false, false });
+
+    OCIO::RangeTransformRcPtr range = OCIO::RangeTransform::Create();
+    range->setMinInValue(0.0);
+    range->setMaxInValue(1.0);
+    range->setMinOutValue(0.1);
+    range->setMaxOutValue(0.9);
+    cases.push_back({ "Range", range, false, false });
+
+    cases.push_back({ "CDL asc",      CreateCDL(OCIO::CDL_ASC),      false, true });
+    cases.push_back({ "CDL no clamp", CreateCDL(OCIO::CDL_NO_CLAMP), false, true });
+
+    OCIO::LogTransformRcPtr log = OCIO::LogTransform::Create();
+    log->setBase(2.0);
+    cases.push_back({ "Log", log, false, true });
+
+    OCIO::LogAffineTransformRcPtr logAffine = OCIO::LogAffineTransform::Create();
+    logAffine->setBase(10.0);
+    logAffine->setLogSideSlopeValue({ 0.25, 0.25, 0.25 });
+    cases.push_back({ "LogAffine", logAffine, false, true });
+
+    OCIO::LogCameraTransformRcPtr logCamera = OCIO::LogCameraTransform::Create({ 0.01, 0.01, 0.01 });
+    logCamera->setBase(2.0);
+    logCamera->setLogSideSlopeValue({ 0.25, 0.25, 0.25 });
+    cases.push_back({ "LogCamera", logCamera, false, true });
+
+    cases.push_back({ "Gamma basic",    CreateExponent(OCIO::NEGATIVE_CLAMP),     false, true });
+    cases.push_back({ "Gamma mirror",   CreateExponent(OCIO::NEGATIVE_MIRROR),    false, true });
+    cases.push_back({ "Gamma passthru", CreateExponent(OCIO::NEGATIVE_PASS_THRU), false, true });
+    cases.push_back({ "Gamma moncurve",
+                      CreateExponentWithLinear(OCIO::NEGATIVE_LINEAR), false, true });
+    cases.push_back({ "Gamma moncurve mirror",
+                      CreateExponentWithLinear(OCIO::NEGATIVE_MIRROR), false, true });
+
+    cases.push_back({ "ExposureContrast linear",
+                      CreateExposureContrast(OCIO::EXPOSURE_CONTRAST_LINEAR), false, false });
+    cases.push_back({ "ExposureContrast video",
+                      CreateExposureContrast(OCIO::EXPOSURE_CONTRAST_VIDEO), false, false });
+    cases.push_back({ "ExposureContrast log",
+                      CreateExposureContrast(OCIO::EXPOSURE_CONTRAST_LOGARITHMIC), false, false });
+
+    const std::vector<std::pair<std::string, OCIO::GradingStyle>> gradingStyles
+        = { { "log", OCIO::GRADING_LOG }, { "lin", OCIO::GRADING_LIN }, { "video", OCIO::GRADING_VIDEO } };
+
+    for (const auto & style : gradingStyles)
+    {
+        cases.push_back({ "GradingPrimary " + style.first,
+                          CreateGradingPrimary(style.second), false, false });
+        cases.push_back({ "GradingRGBCurve " + style.first,
+                          CreateGradingRGBCurve(style.second), false, false });
+        cases.push_back({ "GradingTone " + style.first,
+                          CreateGradingTone(style.second), false, false });
+    }
+
+    const std::vector<std::pair<std::string, OCIO::FixedFunctionStyle>> fixedFunctions
+        = { { "aces_red_mod_03",    OCIO::FIXED_FUNCTION_ACES_RED_MOD_03    },
+            { "aces_red_mod_10",    OCIO::FIXED_FUNCTION_ACES_RED_MOD_10    },
+            { "aces_glow_03",       OCIO::FIXED_FUNCTION_ACES_GLOW_03       },
+            { "aces_glow_10",       OCIO::FIXED_FUNCTION_ACES_GLOW_10       },
+            { "aces_dark_to_dim_10", OCIO::FIXED_FUNCTION_ACES_DARK_TO_DIM_10 },
+            { "rgb_to_hsv",         OCIO::FIXED_FUNCTION_RGB_TO_HSV         },
+            { "xyz_to_xyY",         OCIO::FIXED_FUNCTION_XYZ_TO_xyY         },
+            { "xyz_to_uvY",         OCIO::FIXED_FUNCTION_XYZ_TO_uvY         },
+            { "xyz_to_luv",         OCIO::FIXED_FUNCTION_XYZ_TO_LUV         } };
+
+    for (const auto & func : fixedFunctions)
+    {
+        cases.push_back({ "FixedFunction " + func.first,
+                          OCIO::FixedFunctionTransform::Create(func.second), false, false });
+    }
+
+    const double surround[1] = { 0.78 };
+    cases.push_back({ "FixedFunction rec2100_surround",
+                      OCIO::FixedFunctionTransform::Create(OCIO::FIXED_FUNCTION_REC2100_SURROUND,
+                                                           surround, 1),
+                      false, false });
+
+    const double gamutComp[7] = { 1.147, 1.264, 1.312, 0.815, 0.803, 0.880, 1.2 };
+    cases.push_back({ "FixedFunction aces_gamut_comp_13",
+                      OCIO::FixedFunctionTransform::Create(OCIO::FIXED_FUNCTION_ACES_GAMUT_COMP_13,
+                                                           gamutComp, 7),
+                      false, false });
+
+    cases.push_back({ "Lut1D 4096",        CreateLut1D(4096, false),  true, false });
+    cases.push_back({ "Lut1D half domain", CreateLut1D(65536, true),  true, false });
+
+    for (const unsigned long gridSize : { 17UL, 33UL, 65UL })
+    {
+        const std::string size = std::to_string(gridSize);
+        cases.push_back({ "Lut3D tetrahedral " + size,
+                          CreateLut3D(gridSize, OCIO::INTERP_TETRAHEDRAL), true, false });
+        cases.push_back({ "Lut3D trilinear " + size,
+                          CreateLut3D(gridSize, OCIO::INTERP_LINEAR), true, false });
+    }
+
+    return cases;
+}
+
+// Time the CPU renderers of the ops of each transform.
+void RunTransformCases(Benchmarks & benchmarks)
+{
+    OCIO::ConstConfigRcPtr config = OCIO::Config::CreateRaw();
+
+    const std::vector<IsaVariant> isaVariants = GetIsaVariants();
+
+    for (const auto & tc : CreateTransformCases())
+    {
+        OCIO::OpRcPtrVec ops;
+        OCIO::BuildOps(ops, *config, config->getCurrentContext(), tc.m_transform,
+                       OCIO::TRANSFORM_DIR_FORWARD);
+        ops.finalize();
+
+        for (size_t idx = 0; idx < ops.size(); ++idx)
+        {
+            const std::string name
+                = ops.size() == 1 ? tc.m_name : tc.m_name + " #" + std::to_string(idx);
+
+            if (tc.m_isaVariants)
+            {
+                for (const auto & isa : isaVariants)
+                {
+                    IsaGuard guard(isa.m_flags);
+                    RunRenderer(benchmarks, name, isa.m_name, ops[idx]->getCPUOp(false),
+                                OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32);
+                }
+            }
+            else
+            {
+                RunRenderer(benchmarks, name, "", ops[idx]->getCPUOp(false),
+                            OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32);
+            }
+
+            if (tc.m_fastVariant)
+            {
+                RunRenderer(benchmarks, name + " fast", "", ops[idx]->getCPUOp(true),
+                            OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32);
+            }
+        }
+    }
+}
+
+// Time the 1D LUT renderers also doing the bit-depth conversions i.e. when the LUT is the
+// first or the last op of a CPU processor.
+void RunLut1DBitDepths(Benchmarks & benchmarks)
+{
+    OCIO::ConstConfigRcPtr config = OCIO::Config::CreateRaw();
+
+    const std::vector<std::pair<OCIO::BitDepth, OCIO::BitDepth>> bitDepths
+        = { { OCIO::BIT_DEPTH_UINT8,  OCIO::BIT_DEPTH_F32    },
+            { OCIO::BIT_DEPTH_UINT10, OCIO::BIT_DEPTH_F32    },
+            { OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_F32    },
+            { OCIO::BIT_DEPTH_F16,    OCIO::BIT_DEPTH_F32    },
+            { OCIO::BIT_DEPTH_F32,    OCIO::BIT_DEPTH_UINT8  },
+            { OCIO::BIT_DEPTH_F32,    OCIO::BIT_DEPTH_UINT16 },
+            { OCIO::BIT_DEPTH_F32,    OCIO::BIT_DEPTH_F16    } };
+
+    const std::vector<IsaVariant> isaVariants = GetIsaVariants();
+
+    for (const bool halfDomain : { false, true })
+    {
+        OCIO::OpRcPtrVec ops;
+        OCIO::BuildOps(ops, *config, config->getCurrentContext(),
+                       CreateLut1D(halfDomain ? 65536 : 4096, halfDomain),
+                       OCIO::TRANSFORM_DIR_FORWARD);
+        ops.finalize();
+
+        const OCIO::ConstOpRcPtr op = ops[0];
+        OCIO::ConstLut1DOpDataRcPtr lut = OCIO::DynamicPtrCast<const OCIO::Lut1DOpData>(op->data());
+
+        for (const auto & bd : bitDepths)
+        {
+            const std::string name = std::string(halfDomain ? "Lut1D half domain " : "Lut1D 4096 ")
+                                   + OCIO::BitDepthToString(bd.first) + ":"
+                                   + OCIO::BitDepthToString(bd.second);
+
+            for (const auto & isa : isaVariants)
+            {
+                IsaGuard guard(isa.m_flags);
+                RunRenderer(benchmarks, name, isa.m_name,
+                            OCIO::GetLut1DRenderer(lut, bd.first, bd.second),
+                            bd.first, bd.second);
+            }
+        }
+    }
+}
+
+const std::vector<OCIO::BitDepth> & GetBitDepths()
+{
+    static const std::vector<OCIO::BitDepth> bitDepths
+        = { OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_UINT10, OCIO::BIT_DEPTH_UINT12,
+            OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_F16, OCIO::BIT_DEPTH_F32 };
+    return bitDepths;
+}
+
+// Time the bit-depth conversions done by the CPU processors when the first or the last op
+// cannot do them.
+void RunBitDepthCasts(Benchmarks & benchmarks)
+{
+    for (const OCIO::BitDepth in : GetBitDepths())
+    {
+        for (const OCIO::BitDepth out : GetBitDepths())
+        {
+            const std::string name = std::string("BitDepthCast ")
+                                   + OCIO::BitDepthToString(in) + ":"
+                                   + OCIO::BitDepthToString(out);
+
+            RunRenderer(benchmarks, name, "", OCIO::CreateGenericBitDepthHelper(in, out), in, out);
+        }
+    }
+}
+
+enum ImageLayout
+{
+    LAYOUT_RGBA = 0,
+    LAYOUT_RGB,
+    LAYOUT_BGRA,
+    LAYOUT_ABGR,
+    LAYOUT_PLANAR
+};
+
+// Time the packing to (and the unpacking from) the RGBA F32 line buffers done by the CPU
+// processors for the image layouts which cannot be processed in place.
+template<OCIO::BitDepth BD>
+void RunImagePacking(Benchmarks & benchmarks, const std::string & layoutName, ImageLayout layout)
+{
+    typedef typename OCIO::BitDepthInfo<BD>::Type Type;
+
+    const std::string name = "ImagePacking " + layoutName + " " + OCIO::BitDepthToString(BD);
+
+    for (const auto & size : benchmarks.getBufferSizes())
+    {
+        const std::string fullName = GetName(name, "", size.m_name);
+        if (!benchmarks.isEnabled(fullName))
+        {
+            continue;
+        }
+
+        // Process lines of at most 4096 pixels like an image.
+        const long width  = std::min(size.m_numPixels, 4096L);
+        const long height = size.m_numPixels / width;
+
+        std::vector<char> src = CreateRandomBuffer(BD, width * height);
+        std::vector<char> dst(src.size());
+
+        auto createDesc = [&](std::vector<char> & buffer) -> std::shared_ptr<OCIO::ImageDesc>
+        {
+            if (layout == LAYOUT_PLANAR)
+            {
+                const size_t planeSize = size_t(width * height) * sizeof(Type);
+                return std::make_shared<OCIO::PlanarImageDesc>(&buffer[0],
+                                                               &buffer[planeSize],
+                                                               &buffer[2 * planeSize],
+                                                               &buffer[3 * planeSize],
+                                                               width, height, BD,
+                                                               OCIO::AutoStride,
+                                                               OCIO::AutoStride);
+            }
+
+            const OCIO::ChannelOrdering order
+                = layout == LAYOUT_RGB  ? OCIO::CHANNEL_ORDERING_RGB
+                : layout == LAYOUT_BGRA ? OCIO::CHANNEL_ORDERING_BGRA
+                : layout == LAYOUT_ABGR ? OCIO::CHANNEL_ORDERING_ABGR
+                                        : OCIO::CHANNEL_ORDERING_RGBA;
+
+            return std::make_shared<OCIO::PackedImageDesc>(buffer.data(), width, height, order, BD,
+                                                           OCIO::AutoStride,
+                                                           OCIO::AutoStride,
+                                                           OCIO::AutoStride);
+        };
+
+        const auto srcDesc = createDesc(src);
+        const auto dstDesc = createDesc(dst);
+
+        OCIO::GenericImageDesc srcImg, dstImg;
+        srcImg.init(*srcDesc, BD, OCIO::CreateGenericBitDepthHelper(BD, OCIO::BIT_DEPTH_F32));
+        dstImg.init(*dstDesc, BD, OCIO::CreateGenericBitDepthHelper(OCIO::BIT_DEPTH_F32, BD));
+
+        std::vector<float> rgbaBuffer(size_t(width) * 4);
+        std::vector<Type> inBitDepthBuffer(size_t(width) * 4);
+        std::vector<Type> outBitDepthBuffer(size_t(width) * 4);
+
+        benchmarks.run(fullName,
+                       "Generic<" + std::string(OCIO::BitDepthToString(BD)) + ">",
+                       "host",
+                       width * height,
+                       [&]()
+                       {
+                           for (long y = 0; y < height; ++y)
+                           {
+                               OCIO::Generic<Type>::PackRGBAFromImageDesc(srcImg,
+                                                                          inBitDepthBuffer.data(),
+                                                                          rgbaBuffer.data(),
+                                                                          int(width),
+                                                                          y * width);
+                               OCIO::Generic<Type>::UnpackRGBAToImageDesc(dstImg,
+                                                                          rgbaBuffer.data(),
+                                                                          outBitDepthBuffer.data(),
+                                                                          int(width),
+                                                                          y * width);
+                           }
+                       });
+    }
+}
+
+void RunImagePackings(Benchmarks & benchmarks)
+{
+    const std::vector<std::pair<std::string, ImageLayout>> layouts
+        = { { "rgba", LAYOUT_RGBA }, { "rgb", LAYOUT_RGB }, { "bgra", LAYOUT_BGRA },
+            { "abgr", LAYOUT_ABGR }, { "planar", LAYOUT_PLANAR } };
+
+    for (const auto & layout : layouts)
+    {
+        RunImagePacking<OCIO::BIT_DEPTH_UINT8>(benchmarks, layout.first, layout.second);
+        RunImagePacking<OCIO::BIT_DEPTH_UINT16>(benchmarks, layout.first, layout.second);
+        RunImagePacking<OCIO::BIT_DEPTH_F16>(benchmarks, layout.first, layout.second);
+        RunImagePacking<OCIO::BIT_DEPTH_F32>(benchmarks, layout.first, layout.second);
+    }
+}
+
+} // anonymous namespace
+
+void RunOpBenchmarks(Benchmarks & benchmarks)
+{
+    RunTransformCases(benchmarks);
+    RunLut1DBitDepths(benchmarks);
+    RunBitDepthCasts(benchmarks);
+    RunImagePackings(benchmarks);
+}
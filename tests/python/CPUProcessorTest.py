@@ -224,6 +224,20 @@ class CPUProcessorTest(unittest.TestCase):
             cpu_proc.getCacheID()
         )
 
+    def test_renderer_names(self):
+        # The scale is processed by one renderer followed by a bit-depth cast
+        self.assertEqual(self.default_cpu_proc_fwd.getNumRenderers(), 2)
+        self.assertEqual(
+            self.default_cpu_proc_fwd.getRendererName(0),
+            'ScaleRenderer'
+        )
+        self.assertTrue(
+            self.default_cpu_proc_fwd.getRendererName(1).startswith('BitDepthCast<')
+        )
+
+        with self.assertRaises(OCIO.Exception):
+            self.default_cpu_proc_fwd.getRendererName(2)
+
     def test_bit_depth(self):
         # BIT_DEPTH_F32
         self.assertEqual(
@@ -292,6 +306,84 @@ class CPUProcessorTest(unittest.TestCase):
             [2.0, 2.0, 2.0]
         )
 
+    def test_dynamic_property_overrides(self):
+        values = OCIO.DynamicPropertyOverrides()
+
+        self.assertFalse(values.hasValue(OCIO.DYNAMIC_PROPERTY_EXPOSURE))
+        values.setDouble(OCIO.DYNAMIC_PROPERTY_EXPOSURE, 1.0)
+        self.assertTrue(values.hasValue(OCIO.DYNAMIC_PROPERTY_EXPOSURE))
+        self.assertEqual(values.getDouble(OCIO.DYNAMIC_PROPERTY_EXPOSURE), 1.0)
+
+        values.setDouble(type=OCIO.DYNAMIC_PROPERTY_CONTRAST, val=1.2)
+        self.assertEqual(values.getDouble(OCIO.DYNAMIC_PROPERTY_CONTRAST), 1.2)
+
+        primary = OCIO.GradingPrimary(OCIO.GRADING_LOG)
+        primary.saturation = 1.3
+        values.setGradingPrimary(primary)
+        self.assertEqual(values.getGradingPrimary().saturation, 1.3)
+
+        tone = OCIO.GradingTone(OCIO.GRADING_LOG)
+        tone.scontrast = 1.1
+        values.setGradingTone(tone)
+        self.assertEqual(values.getGradingTone().scontrast, 1.1)
+
+        curve = OCIO.GradingBSplineCurve([0.0, 0.0, 0.5, 0.6, 1.0, 1.0])
+        rgb_curve = OCIO.GradingRGBCurve(curve, curve, curve, curve)
+        values.setGradingRGBCurve(rgb_curve)
+        self.assertTrue(values.hasValue(OCIO.DYNAMIC_PROPERTY_GRADING_RGBCURVE))
+        self.assertEqual(values.getGradingRGBCurve(), rgb_curve)
+
+        values.removeValue(OCIO.DYNAMIC_PROPERTY_EXPOSURE)
+        self.assertFalse(values.hasValue(OCIO.DYNAMIC_PROPERTY_EXPOSURE))
+        self.assertTrue(values.hasValue(OCIO.DYNAMIC_PROPERTY_CONTRAST))
+
+        values.clear()
+        self.assertFalse(values.hasValue(OCIO.DYNAMIC_PROPERTY_CONTRAST))
+        self.assertFalse(values.hasValue(OCIO.DYNAMIC_PROPERTY_GRADING_TONE))
+
+        # Errors.
+        with self.assertRaises(OCIO.Exception):
+            values.getDouble(OCIO.DYNAMIC_PROPERTY_EXPOSURE)
+        with self.assertRaises(OCIO.Exception):
+            values.setDouble(OCIO.DYNAMIC_PROPERTY_GRADING_TONE, 1.0)
+        with self.assertRaises(OCIO.Exception):
+            values.getGradingPrimary()
+
+    def test_apply_dynamic_property_overrides(self):
+        if not np:
+            logger.warning("NumPy not found. Skipping test!")
+            return
+
+        tr = OCIO.ExposureContrastTransform(
+            style=OCIO.EXPOSURE_CONTRAST_LINEAR,
+            dynamicExposure=True
+        )
+        cpu_proc = self.config.getProcessor(tr).getDefaultCPUProcessor()
+
+        values = OCIO.DynamicPropertyOverrides()
+        values.setDouble(OCIO.DYNAMIC_PROPERTY_EXPOSURE, 1.0)
+
+        # +1 stop exposure only for that call, the image is modified in place.
+        arr = np.array([0.5, 1.0, 2.0], dtype=np.float32)
+        image = OCIO.PackedImageDesc(arr, 1, 1, 3)
+        cpu_proc.apply(image, values)
+        self.assertEqual(arr.tolist(), [1.0, 2.0, 4.0])
+
+        # The dynamic property of the processor is unchanged.
+        dyn_prop = cpu_proc.getDynamicProperty(OCIO.DYNAMIC_PROPERTY_EXPOSURE)
+        self.assertEqual(dyn_prop.getDouble(), 0.0)
+        self.assertEqual(cpu_proc.applyRGB([1.0, 1.0, 1.0]), [1.0, 1.0, 1.0])
+
+        # The source image is unchanged.
+        src_arr = np.array([0.5, 1.0, 2.0], dtype=np.float32)
+        dst_arr = np.zeros_like(src_arr)
+        src_image = OCIO.PackedImageDesc(src_arr, 1, 1, 3)
+        dst_image = OCIO.PackedImageDesc(dst_arr, 1, 1, 3)
+        values.setDouble(OCIO.DYNAMIC_PROPERTY_EXPOSURE, -1.0)
+        cpu_proc.apply(src_image, dst_image, values)
+        self.assertEqual(src_arr.tolist(), [0.5, 1.0, 2.0])
+        self.assertEqual(dst_arr.tolist(), [0.25, 0.5, 1.0])
+
     def test_apply(self):
         if not np:
             logger.warning("NumPy not found. Skipping test!")
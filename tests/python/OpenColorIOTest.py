@@ -38,3 +38,14 @@ class OpenColorIOTest(unittest.TestCase):
         OCIO.SetEnvVariable(value='TOTO', name='MY_ENVAR')
         self.assertTrue(OCIO.IsEnvVariablePresent(name='MY_ENVAR'))
         self.assertEqual(OCIO.GetEnvVariable(name='MY_ENVAR'), 'TOTO')
+
+    def test_max_threads(self):
+        """
+        Test Get/SetMaxThreads().
+        """
+        self.assertEqual(OCIO.GetMaxThreads(), 0)
+        OCIO.SetMaxThreads(1)
+        self.assertEqual(OCIO.GetMaxThreads(), 1)
+
+        OCIO.SetMaxThreads(maxThreads=0)
+        self.assertEqual(OCIO.GetMaxThreads(), 0)